@@ -0,0 +1,399 @@
+/*******************************************************************************************
+* @file async_event_logging.cpp
+* @brief This file contains code snippet to log scanner events through an asynchronous log channel
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "scan_data.h"
+#include "async_log.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for barcode events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_BARCODE);
+    event_ids.push_back(EVENT_TYPE_PNP);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Log file sink - one write per drain, the file is flushed by the log thread, not by the caller
+*/
+struct FileSink
+{
+    FILE* file;
+
+    void operator()(const char* text, size_t length) const
+    {
+        fwrite(text, 1, length, file);
+        fflush(file);
+    }
+};
+
+/*
+* Count the record lines of a log file (drop reports excluded)
+*/
+long long CountRecordLines(const char* path)
+{
+    ifstream file(path);
+    string line;
+    long long lines = 0;
+    while (getline(file, line))
+    {
+        if (line.find("log records dropped") == string::npos)
+        {
+            lines++;
+        }
+    }
+    return lines;
+}
+
+/*
+* Time the decode path logging the way the snippets do - ostream and endl (flush per line)
+* return value : Nanoseconds per line
+*/
+double TimeSynchronousLog(const char* path, int count)
+{
+    ofstream log_file(path, ios::trunc);
+    string label = "5012345678900";
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        log_file << "Barcode scanner ID:[" << (i & 7) + 1 << "] type " << ST_EAN13 << " : " << label << endl;
+    }
+    return (double)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count() / count;
+}
+
+/*
+* Time the decode path logging through the log channel on the calling thread
+* return value : Nanoseconds per record
+*/
+double TimeAsyncLog(int count)
+{
+    string label = "5012345678900";
+    LOG_INFO("Logging {} records", count);     // Creates the thread's buffer outside the timed loop
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        LOG_INFO("Barcode scanner ID:[{}] type {} : {}", (i & 7) + 1, ST_EAN13, label);
+    }
+    return (double)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count() / count;
+}
+
+/*
+* Time a statement below LOG_MIN_SEVERITY
+* return value : Nanoseconds per statement
+*/
+double TimeCompiledOutLog(int count)
+{
+    string label = "5012345678900";
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        LOG_DEBUG("Decode scanner ID:[{}] : {}", i, label);
+    }
+    return (double)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count() / count;
+}
+
+/*
+* Compare flushed ostream logging with the log channel, single thread and from several event threads
+*/
+void RunBenchmark()
+{
+    const int kLines = 100000;
+    const int kThreads = 4;
+
+    double sync_ns = TimeSynchronousLog("sync_log.txt", kLines);
+    cout << "ostream << endl            : " << sync_ns << " ns per line" << endl;
+
+    FILE* log_file = fopen("async_log.txt", "w");
+    if (log_file == NULL)
+    {
+        cout << "Cannot create async_log.txt" << endl;
+        return;
+    }
+    // Buffers hold a whole burst, so every timed record is stored rather than dropped
+    FileSink sink = { log_file };
+    AsyncLog::Instance().Start(sink, 8 * 1024 * 1024);
+    double async_ns = TimeAsyncLog(kLines);
+    cout << "LOG_INFO, 1 thread         : " << async_ns << " ns per record" << endl;
+
+    vector<double> thread_ns(kThreads);
+    vector<thread> threads;
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.push_back(thread([&thread_ns, t, kLines]() { thread_ns[t] = TimeAsyncLog(kLines); }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    double total_ns = 0;
+    for (int t = 0; t < kThreads; t++)
+    {
+        total_ns += thread_ns[t];
+    }
+    cout << "LOG_INFO, " << kThreads << " threads        : " << total_ns / kThreads << " ns per record" << endl;
+    cout << "LOG_DEBUG (compiled out)   : " << TimeCompiledOutLog(kLines) << " ns per statement" << endl;
+
+    AsyncLog::Instance().Stop();
+    fclose(log_file);
+    unsigned long long dropped = AsyncLog::Instance().DroppedCount();
+    long long records = (long long)(kLines + 1) * (kThreads + 1);
+    // Every record is either written or counted as dropped
+    long long written = CountRecordLines("async_log.txt");
+    cout << "Records : " << records << ", written : " << written << ", dropped : " << dropped
+        << (written + (long long)dropped == records ? " - all accounted for" : " - MISMATCH") << endl;
+    cout << "Speedup on the event thread : " << sync_ns / async_ns << "x" << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Async log channel benchmark" << endl;
+    RunBenchmark();
+    cout << " " << endl;
+
+    AsyncLog::Instance().Start();
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        scanner_event_sink->SetScanDataHandler([](short event_type, const string& scan_data_xml)
+        {
+            ScanData scan_data;
+            if (!ParseScanData(scan_data_xml, &scan_data))
+            {
+                LOG_WARNING("Scan data event type {} without a label", event_type);
+                return;
+            }
+            LOG_INFO("Barcode scanner ID:[{}] type {} : {}", scan_data.scanner_id, scan_data.symbology, scan_data.label);
+        });
+
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            WaitForInput("Scan barcodes or attach/detach scanners now, press any key to exit.");
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+        }
+        scanner_event_sink->SetScanDataHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    AsyncLog::Instance().Stop();
+    cout << "Log records dropped : " << AsyncLog::Instance().DroppedCount() << endl;
+    WaitForInput("Press any key to exit.");
+}
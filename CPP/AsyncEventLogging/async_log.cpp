@@ -0,0 +1,396 @@
+/*******************************************************************************************
+* @file async_log.cpp
+* @brief Definition of the asynchronous log channel
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "async_log.h"
+#include <cstdio>
+
+using namespace std;
+
+static const size_t kDrainTextSize = 64 * 1024;   // Sink is called when the formatted text reaches this size
+
+thread_local LogBuffer* AsyncLog::local_buffer_ = NULL;
+
+/**
+* Marks the buffer of a thread abandoned when the thread exits
+**/
+struct LogThreadExit
+{
+    atomic<bool>* abandoned;
+
+    ~LogThreadExit()
+    {
+        if (abandoned != NULL)
+        {
+            abandoned->store(true, memory_order_release);
+        }
+    }
+};
+
+static long long SteadyNanoseconds()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+* Default sink - one write and flush per drain
+**/
+static void WriteStdout(const char* text, size_t length)
+{
+    fwrite(text, 1, length, stdout);
+    fflush(stdout);
+}
+
+LogBuffer::LogBuffer(size_t capacity, int thread_number)
+    : bytes_(new char[capacity]), capacity_(capacity), mask_(capacity - 1), thread_number_(thread_number),
+    reserved_head_(0), cached_tail_(0), head_(0), dropped_(0), tail_(0), reported_dropped_(0), abandoned_(false)
+{
+    // Touch the pages now, so the first records of an event burst do not take page faults
+    memset(bytes_.get(), 0, capacity);
+}
+
+AsyncLog& AsyncLog::Instance()
+{
+    static AsyncLog instance;
+    return instance;
+}
+
+AsyncLog::AsyncLog()
+    : running_(false), buffer_bytes_(0), flush_interval_ms_(0), start_time_(0), next_thread_number_(1), freed_dropped_(0),
+    stop_requested_(false), flush_requested_(0), flush_done_(0)
+{
+}
+
+AsyncLog::~AsyncLog()
+{
+    Stop();
+    for (size_t i = 0; i < buffers_.size(); i++)
+    {
+        delete buffers_[i];
+    }
+}
+
+void AsyncLog::Start(const Sink& sink, size_t buffer_bytes, int flush_interval_ms)
+{
+    if (running_.load())
+    {
+        return;
+    }
+    size_t capacity = 4096;
+    while (capacity < buffer_bytes)
+    {
+        capacity *= 2;
+    }
+    sink_ = sink ? sink : Sink(WriteStdout);
+    flush_interval_ms_ = flush_interval_ms;
+    start_time_ = SteadyNanoseconds();
+    {
+        lock_guard<mutex> lock(buffers_mutex_);
+        buffer_bytes_ = capacity;
+    }
+    {
+        lock_guard<mutex> lock(wake_mutex_);
+        stop_requested_ = false;
+    }
+    thread_ = thread(&AsyncLog::Run, this);
+    running_.store(true);
+}
+
+void AsyncLog::Stop()
+{
+    if (!running_.exchange(false))
+    {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(wake_mutex_);
+        stop_requested_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void AsyncLog::Flush()
+{
+    unique_lock<mutex> lock(wake_mutex_);
+    if (!running_.load())
+    {
+        return;
+    }
+    long long target = ++flush_requested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [this, target] { return flush_done_ >= target || stop_requested_; });
+}
+
+unsigned long long AsyncLog::DroppedCount() const
+{
+    lock_guard<mutex> lock(buffers_mutex_);
+    unsigned long long dropped = freed_dropped_;
+    for (size_t i = 0; i < buffers_.size(); i++)
+    {
+        dropped += buffers_[i]->dropped_.load(memory_order_relaxed);
+    }
+    return dropped;
+}
+
+/**
+* Create the buffer of the calling thread
+**/
+LogBuffer* AsyncLog::AttachThread()
+{
+    static thread_local LogThreadExit thread_exit = { NULL };
+    LogBuffer* buffer;
+    {
+        lock_guard<mutex> lock(buffers_mutex_);
+        buffer = new LogBuffer(buffer_bytes_, next_thread_number_++);
+        buffers_.push_back(buffer);
+    }
+    thread_exit.abandoned = &buffer->abandoned_;
+    local_buffer_ = buffer;
+    return buffer;
+}
+
+/**
+* Log thread - drain every flush interval or when a flush is requested, once more when stopping
+**/
+void AsyncLog::Run()
+{
+    unique_lock<mutex> lock(wake_mutex_);
+    while (true)
+    {
+        bool stopping = stop_requested_;
+        long long requested = flush_requested_;
+        lock.unlock();
+        Drain();
+        lock.lock();
+        flush_done_ = requested;
+        flushed_.notify_all();
+        if (stopping)
+        {
+            return;
+        }
+        wake_.wait_for(lock, chrono::milliseconds(flush_interval_ms_),
+            [this, requested] { return stop_requested_ || flush_requested_ != requested; });
+    }
+}
+
+/**
+* Read position of a buffer during a drain
+**/
+struct LogCursor
+{
+    LogBuffer* buffer;
+    size_t tail;
+    size_t head;
+    const char* record;     // Next record, NULL when the buffer is drained
+    long long timestamp;
+};
+
+/**
+* Write the committed records of all buffers, oldest first
+**/
+void AsyncLog::Drain()
+{
+    vector<LogBuffer*> buffers;
+    {
+        lock_guard<mutex> lock(buffers_mutex_);
+        buffers = buffers_;
+    }
+
+    vector<LogCursor> cursors(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        cursors[i].buffer = buffers[i];
+        cursors[i].tail = buffers[i]->tail_.load(memory_order_relaxed);
+        cursors[i].head = buffers[i]->head_.load(memory_order_acquire);
+        cursors[i].record = NULL;
+    }
+
+    // Peek the next record of a cursor, skipping the wrap marker at the end of the buffer
+    auto peek = [](LogCursor* cursor)
+    {
+        cursor->record = NULL;
+        if (cursor->tail == cursor->head)
+        {
+            return;
+        }
+        const char* bytes = cursor->buffer->bytes_.get();
+        size_t offset = cursor->tail & cursor->buffer->mask_;
+        LogRecordHeader header;
+        memcpy(&header.size, bytes + offset, sizeof(header.size));
+        if (header.size == 0)
+        {
+            cursor->tail += cursor->buffer->capacity_ - offset;
+            offset = 0;
+        }
+        memcpy(&header, bytes + offset, sizeof(header));
+        cursor->record = bytes + offset;
+        cursor->timestamp = header.timestamp;
+    };
+    for (size_t i = 0; i < cursors.size(); i++)
+    {
+        peek(&cursors[i]);
+    }
+
+    // Merge the per thread streams - each is already in time order
+    while (true)
+    {
+        LogCursor* oldest = NULL;
+        for (size_t i = 0; i < cursors.size(); i++)
+        {
+            if (cursors[i].record != NULL && (oldest == NULL || cursors[i].timestamp < oldest->timestamp))
+            {
+                oldest = &cursors[i];
+            }
+        }
+        if (oldest == NULL)
+        {
+            break;
+        }
+        Format(*oldest->buffer, oldest->record);
+        uint32_t size;
+        memcpy(&size, oldest->record, sizeof(size));
+        oldest->tail += size;
+        oldest->buffer->tail_.store(oldest->tail, memory_order_release);
+        peek(oldest);
+
+        if (text_.size() >= kDrainTextSize)
+        {
+            sink_(text_.data(), text_.size());
+            text_.clear();
+        }
+    }
+
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        LogBuffer* buffer = buffers[i];
+        unsigned long long dropped = buffer->dropped_.load(memory_order_relaxed);
+        if (dropped != buffer->reported_dropped_)
+        {
+            char line[96];
+            int length = snprintf(line, sizeof(line), "[%12.6f] WARNING T%-3d %llu log records dropped (buffer full)\n",
+                (SteadyNanoseconds() - start_time_) / 1e9, buffer->thread_number_, dropped - buffer->reported_dropped_);
+            text_.append(line, length);
+            buffer->reported_dropped_ = dropped;
+        }
+    }
+    if (!text_.empty())
+    {
+        sink_(text_.data(), text_.size());
+        text_.clear();
+    }
+
+    // Free the buffers of exited threads once written. The exit flag is read before the head so
+    // the head seen is the thread's last one.
+    lock_guard<mutex> lock(buffers_mutex_);
+    for (size_t i = 0; i < buffers_.size();)
+    {
+        LogBuffer* buffer = buffers_[i];
+        if (buffer->abandoned_.load(memory_order_acquire) &&
+            buffer->head_.load(memory_order_acquire) == buffer->tail_.load(memory_order_relaxed))
+        {
+            freed_dropped_ += buffer->dropped_.load(memory_order_relaxed);
+            delete buffer;
+            buffers_.erase(buffers_.begin() + i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+/**
+* Append the text line of a record: "[seconds] SEVERITY Tn message"
+**/
+void AsyncLog::Format(const LogBuffer& buffer, const char* record)
+{
+    static const char* kSeverityNames[] = { "DEBUG", "INFO", "WARNING", "ERROR" };
+
+    LogRecordHeader header;
+    memcpy(&header, record, sizeof(header));
+    const char* arg = record + sizeof(header);
+    uint32_t args_left = header.arg_count;
+
+    char prefix[64];
+    int severity = header.site->severity;
+    int length = snprintf(prefix, sizeof(prefix), "[%12.6f] %-7s T%-3d ", (header.timestamp - start_time_) / 1e9,
+        severity >= 0 && severity <= 3 ? kSeverityNames[severity] : "?", buffer.thread_number_);
+    text_.append(prefix, length);
+
+    // Decode the next argument and append its text
+    auto append_arg = [this, &arg, &args_left]()
+    {
+        char number[32];
+        int number_length = 0;
+        unsigned char type = (unsigned char)*arg++;
+        args_left--;
+        switch (type)
+        {
+        case kLogArgInt:
+        {
+            long long value;
+            memcpy(&value, arg, sizeof(value));
+            arg += sizeof(value);
+            number_length = snprintf(number, sizeof(number), "%lld", value);
+            break;
+        }
+        case kLogArgUnsigned:
+        {
+            unsigned long long value;
+            memcpy(&value, arg, sizeof(value));
+            arg += sizeof(value);
+            number_length = snprintf(number, sizeof(number), "%llu", value);
+            break;
+        }
+        case kLogArgDouble:
+        {
+            double value;
+            memcpy(&value, arg, sizeof(value));
+            arg += sizeof(value);
+            number_length = snprintf(number, sizeof(number), "%g", value);
+            break;
+        }
+        case kLogArgBool:
+            text_ += *arg++ ? "true" : "false";
+            break;
+        case kLogArgChar:
+            text_ += *arg++;
+            break;
+        case kLogArgString:
+        {
+            uint32_t size;
+            memcpy(&size, arg, sizeof(size));
+            arg += sizeof(size);
+            text_.append(arg, size);
+            arg += size;
+            break;
+        }
+        }
+        text_.append(number, number_length);
+    };
+
+    for (const char* format = header.site->format; *format != '\0'; format++)
+    {
+        if (format[0] == '{' && format[1] == '}' && args_left > 0)
+        {
+            append_arg();
+            format++;
+        }
+        else
+        {
+            text_ += *format;
+        }
+    }
+    // Arguments without a placeholder are appended, so nothing logged is lost
+    while (args_left > 0)
+    {
+        text_ += ' ';
+        append_arg();
+    }
+    text_ += '\n';
+}
@@ -0,0 +1,412 @@
+/*******************************************************************************************
+* @file async_log.h
+* @brief Asynchronous log channel - binary records in per thread buffers, formatted and written by a background thread
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define LOG_SEVERITY_DEBUG      0
+#define LOG_SEVERITY_INFO       1
+#define LOG_SEVERITY_WARNING    2
+#define LOG_SEVERITY_ERROR      3
+
+/**
+* Records below this severity are compiled out - the call and the evaluation of its arguments
+* disappear. Define it in the project settings (e.g. LOG_MIN_SEVERITY=0 to keep debug records).
+**/
+#ifndef LOG_MIN_SEVERITY
+#define LOG_MIN_SEVERITY LOG_SEVERITY_INFO
+#endif
+
+/**
+* Log a record. The format is a string literal with a {} placeholder for each argument:
+*   LOG_INFO("Barcode scanner ID:[{}] type {} : {}", scan_data.scanner_id, scan_data.symbology, scan_data.label);
+* Arguments may be integers, floating point numbers, bool, char, const char* and std::string.
+**/
+#define LOG_AT(severity, format, ...) \
+    do \
+    { \
+        static const LogSite log_site_ = { severity, __FILE__, __LINE__, format }; \
+        AsyncLog::Instance().Write(&log_site_, ##__VA_ARGS__); \
+    } while (0)
+
+#if LOG_MIN_SEVERITY <= LOG_SEVERITY_DEBUG
+#define LOG_DEBUG(format, ...) LOG_AT(LOG_SEVERITY_DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) ((void)0)
+#endif
+
+#if LOG_MIN_SEVERITY <= LOG_SEVERITY_INFO
+#define LOG_INFO(format, ...) LOG_AT(LOG_SEVERITY_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) ((void)0)
+#endif
+
+#if LOG_MIN_SEVERITY <= LOG_SEVERITY_WARNING
+#define LOG_WARNING(format, ...) LOG_AT(LOG_SEVERITY_WARNING, format, ##__VA_ARGS__)
+#else
+#define LOG_WARNING(format, ...) ((void)0)
+#endif
+
+#define LOG_ERROR(format, ...) LOG_AT(LOG_SEVERITY_ERROR, format, ##__VA_ARGS__)
+
+/**
+* Static description of a log statement - one per LOG_xxx call site, records refer to it by address
+**/
+struct LogSite
+{
+    int severity;
+    const char* file;
+    int line;
+    const char* format;
+};
+
+/**
+* Argument type tags of the binary record encoding
+**/
+enum LogArgType
+{
+    kLogArgInt = 1,
+    kLogArgUnsigned,
+    kLogArgDouble,
+    kLogArgBool,
+    kLogArgChar,
+    kLogArgString,
+};
+
+/**
+* Binary encoding of one argument: a type tag byte followed by the value
+* (8 bytes for numbers, 1 for bool and char, a 4 byte length and the bytes for strings).
+* Argument types without a specialization do not compile.
+**/
+template <typename T, typename Enable = void>
+struct LogArg;
+
+template <typename T>
+struct LogArg<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value>::type>
+{
+    static size_t Size(T) { return 1 + sizeof(long long); }
+
+    static char* Encode(char* out, T value)
+    {
+        *out = (char)(std::is_signed<T>::value ? kLogArgInt : kLogArgUnsigned);
+        if (std::is_signed<T>::value)
+        {
+            long long number = (long long)value;
+            memcpy(out + 1, &number, sizeof(number));
+        }
+        else
+        {
+            unsigned long long number = (unsigned long long)value;
+            memcpy(out + 1, &number, sizeof(number));
+        }
+        return out + 1 + sizeof(long long);
+    }
+};
+
+template <typename T>
+struct LogArg<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+    static size_t Size(T) { return 1 + sizeof(long long); }
+
+    static char* Encode(char* out, T value) { return LogArg<long long>::Encode(out, (long long)value); }
+};
+
+template <typename T>
+struct LogArg<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static size_t Size(T) { return 1 + sizeof(double); }
+
+    static char* Encode(char* out, T value)
+    {
+        double number = (double)value;
+        *out = (char)kLogArgDouble;
+        memcpy(out + 1, &number, sizeof(number));
+        return out + 1 + sizeof(double);
+    }
+};
+
+template <>
+struct LogArg<bool>
+{
+    static size_t Size(bool) { return 2; }
+
+    static char* Encode(char* out, bool value)
+    {
+        out[0] = (char)kLogArgBool;
+        out[1] = value ? 1 : 0;
+        return out + 2;
+    }
+};
+
+template <>
+struct LogArg<char>
+{
+    static size_t Size(char) { return 2; }
+
+    static char* Encode(char* out, char value)
+    {
+        out[0] = (char)kLogArgChar;
+        out[1] = value;
+        return out + 2;
+    }
+};
+
+/**
+* Strings are copied into the record - the caller's buffer may be gone when the record is formatted
+**/
+inline char* EncodeLogString(char* out, const char* text, size_t length)
+{
+    uint32_t size = (uint32_t)length;
+    *out = (char)kLogArgString;
+    memcpy(out + 1, &size, sizeof(size));
+    memcpy(out + 1 + sizeof(size), text, length);
+    return out + 1 + sizeof(size) + length;
+}
+
+template <>
+struct LogArg<const char*>
+{
+    static size_t Size(const char* value) { return 1 + sizeof(uint32_t) + (value == NULL ? 0 : strlen(value)); }
+
+    static char* Encode(char* out, const char* value) { return EncodeLogString(out, value, value == NULL ? 0 : strlen(value)); }
+};
+
+template <>
+struct LogArg<char*> : LogArg<const char*>
+{
+};
+
+template <>
+struct LogArg<std::string>
+{
+    static size_t Size(const std::string& value) { return 1 + sizeof(uint32_t) + value.size(); }
+
+    static char* Encode(char* out, const std::string& value) { return EncodeLogString(out, value.data(), value.size()); }
+};
+
+inline size_t LogArgsSize()
+{
+    return 0;
+}
+
+template <typename T, typename... Rest>
+size_t LogArgsSize(const T& first, const Rest&... rest)
+{
+    return LogArg<typename std::decay<T>::type>::Size(first) + LogArgsSize(rest...);
+}
+
+inline char* EncodeLogArgs(char* out)
+{
+    return out;
+}
+
+template <typename T, typename... Rest>
+char* EncodeLogArgs(char* out, const T& first, const Rest&... rest)
+{
+    return EncodeLogArgs(LogArg<typename std::decay<T>::type>::Encode(out, first), rest...);
+}
+
+/**
+* Fixed part of a binary record, followed by the encoded arguments. Records are padded to 8 bytes.
+**/
+struct LogRecordHeader
+{
+    uint32_t size;          // Record size with header and padding, 0 marks the unused end of the buffer before a wrap
+    uint32_t arg_count;
+    const LogSite* site;
+    long long timestamp;    // steady_clock nanoseconds
+};
+
+/**
+* Single producer single consumer byte ring of one thread. The owning thread reserves and commits
+* records, the log thread reads and releases them; head and tail are on separate cache lines.
+**/
+class LogBuffer
+{
+public:
+    LogBuffer(size_t capacity, int thread_number);
+
+    /**
+    * Space for a record of size bytes (a multiple of 8), contiguous in the buffer
+    * return value : Record address, NULL if the buffer is full
+    */
+    char* Reserve(size_t size)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t offset = head & mask_;
+        size_t contiguous = capacity_ - offset;
+        size_t needed = size <= contiguous ? size : contiguous + size;
+        if (capacity_ - (head - cached_tail_) < needed)
+        {
+            // Only look at the consumer's cache line when the buffer looks full
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (capacity_ - (head - cached_tail_) < needed)
+            {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return NULL;
+            }
+        }
+        if (size > contiguous)
+        {
+            uint32_t wrap = 0;
+            memcpy(bytes_.get() + offset, &wrap, sizeof(wrap));
+            head += contiguous;
+        }
+        reserved_head_ = head;
+        return bytes_.get() + (head & mask_);
+    }
+
+    /**
+    * Publish the record returned by the last Reserve()
+    */
+    void Commit(size_t size) { head_.store(reserved_head_ + size, std::memory_order_release); }
+
+private:
+    friend class AsyncLog;
+
+    std::unique_ptr<char[]> bytes_;
+    size_t capacity_;               // Power of 2
+    size_t mask_;
+    int thread_number_;             // Shown in the formatted line
+
+    // Producer side
+    size_t reserved_head_;
+    size_t cached_tail_;
+    std::atomic<size_t> head_;
+    std::atomic<unsigned long long> dropped_;
+    char producer_padding_[64];
+
+    // Consumer side
+    std::atomic<size_t> tail_;
+    unsigned long long reported_dropped_;
+    std::atomic<bool> abandoned_;   // Owning thread exited
+    char consumer_padding_[64];
+};
+
+/**
+* Process wide asynchronous log channel.
+*
+* A LOG_xxx call encodes its arguments into a binary record in a buffer owned by the calling
+* thread: no lock, no formatting, no allocation and no I/O on the caller's thread - just a
+* timestamp, a few copies and one release store. A background thread wakes every flush interval,
+* merges the records of all threads in timestamp order, formats them and hands the text to the sink
+* in one write. When a buffer is full the record is dropped and counted (the event thread never
+* waits for the console); the count is reported in the output.
+*
+* Buffers are created on a thread's first record and freed after the thread exits and its records
+* are written. Records written while the channel is stopped are discarded.
+**/
+class AsyncLog
+{
+public:
+    typedef std::function<void(const char* text, size_t length)> Sink;
+
+    /**
+    * The log channel
+    */
+    static AsyncLog& Instance();
+
+    /**
+    * Start the log thread
+    * @param sink - Receives formatted lines, called on the log thread (default: stdout)
+    * @param buffer_bytes - Buffer size of each logging thread (rounded up to a power of 2)
+    * @param flush_interval_ms - Time between two drains of the buffers
+    */
+    void Start(const Sink& sink = Sink(), size_t buffer_bytes = 256 * 1024, int flush_interval_ms = 20);
+
+    /**
+    * Write all records, then stop the log thread
+    */
+    void Stop();
+
+    /**
+    * Wait until every record committed before the call is written
+    */
+    void Flush();
+
+    /**
+    * Records dropped because a buffer was full
+    */
+    unsigned long long DroppedCount() const;
+
+    /**
+    * Encode a record - called through the LOG_xxx macros
+    */
+    template <typename... Args>
+    void Write(const LogSite* site, const Args&... args)
+    {
+        if (!running_.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        LogBuffer* buffer = local_buffer_ != NULL ? local_buffer_ : AttachThread();
+        size_t size = (sizeof(LogRecordHeader) + LogArgsSize(args...) + 7) & ~(size_t)7;
+        if (size > buffer->capacity_ / 2)
+        {
+            buffer->dropped_.store(buffer->dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        char* record = buffer->Reserve(size);
+        if (record == NULL)
+        {
+            return;
+        }
+        LogRecordHeader header;
+        header.size = (uint32_t)size;
+        header.arg_count = (uint32_t)sizeof...(Args);
+        header.site = site;
+        header.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        memcpy(record, &header, sizeof(header));
+        EncodeLogArgs(record + sizeof(header), args...);
+        buffer->Commit(size);
+    }
+
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+private:
+    AsyncLog();
+    ~AsyncLog();
+
+    LogBuffer* AttachThread();
+    void Run();
+    void Drain();
+    void Format(const LogBuffer& buffer, const char* record);
+
+    static thread_local LogBuffer* local_buffer_;
+
+    std::atomic<bool> running_;
+    Sink sink_;
+    size_t buffer_bytes_;
+    int flush_interval_ms_;
+    long long start_time_;
+    std::string text_;              // Formatted lines of the current drain (log thread only)
+    std::thread thread_;
+
+    mutable std::mutex buffers_mutex_;
+    std::vector<LogBuffer*> buffers_;
+    int next_thread_number_;
+    unsigned long long freed_dropped_;  // Dropped records of freed buffers
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    bool stop_requested_;
+    long long flush_requested_;
+    long long flush_done_;
+};
@@ -0,0 +1,379 @@
+/*******************************************************************************************
+* @file command_policy.h
+* @brief Retry with budgeted exponential backoff and per scanner circuit breakers around ExecCommand
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cwchar>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "common_defs.h"
+#include "opcode_traits.h"
+
+//---- CoreScanner command status codes used by the policy (STATUS_SUCCESS/STATUS_LOCKED in common_defs.h) ------//
+static const LONG kStatusDeviceUnavailable = 112;
+static const LONG kStatusOperationFailed = 117;
+static const LONG kStatusRequestFailed = 118;
+static const LONG kStatusDeviceBusy = 120;
+
+/**
+* How a command outcome is handled
+**/
+enum StatusClass
+{
+    kStatusClassSuccess,
+    kStatusClassRejected,   // Not executed, scanner alive (STATUS_LOCKED, busy) - retried for every opcode
+    kStatusClassFailed,     // Failed in flight (no answer, unavailable, COM error) - retried only for retry safe
+                            // opcodes, counts against the scanner's circuit breaker
+    kStatusClassPermanent   // Bad arguments, unsupported opcode ... - never retried
+};
+
+/**
+* Classify a command outcome
+* @param hr - ExecCommand HRESULT
+* @param status - Command status
+*/
+inline StatusClass ClassifyStatus(HRESULT hr, LONG status)
+{
+    if (hr != S_OK)
+    {
+        return kStatusClassFailed;
+    }
+    switch (status)
+    {
+    case STATUS_SUCCESS:
+        return kStatusClassSuccess;
+    case STATUS_LOCKED:
+    case kStatusDeviceBusy:
+        return kStatusClassRejected;
+    case kStatusDeviceUnavailable:
+    case kStatusOperationFailed:
+    case kStatusRequestFailed:
+        return kStatusClassFailed;
+    default:
+        return kStatusClassPermanent;
+    }
+}
+
+/**
+* Retry and circuit breaker settings
+**/
+struct CommandPolicySettings
+{
+    int max_attempts;           // Attempts per command, first one included
+    int initial_backoff_ms;     // Delay before the first retry, doubled per retry ...
+    int max_backoff_ms;         // ... up to this; each delay is randomized between half and all of it
+    double retry_budget_ratio;  // Retry tokens earned per command sent
+    double retry_budget_max;    // Tokens kept at most (and at start): retries are a fraction of the traffic, never a storm
+    int breaker_failures;       // Consecutive failed commands that open a scanner's circuit
+    int breaker_open_ms;        // Time an open circuit fails commands at once before one probe command is let through
+
+    CommandPolicySettings()
+        : max_attempts(4), initial_backoff_ms(20), max_backoff_ms(400), retry_budget_ratio(0.2), retry_budget_max(20),
+        breaker_failures(3), breaker_open_ms(2000)
+    {
+    }
+};
+
+/**
+* Policy counters
+**/
+struct CommandPolicyMetrics
+{
+    long long commands;             // Commands executed through the policy
+    long long attempts;             // Commands sent to CoreScanner (retries included)
+    long long retries;
+    long long retry_successes;      // Commands that succeeded after a retry
+    long long retries_not_safe;     // Failed commands not retried because the opcode is not retry safe
+    long long retries_throttled;    // Retries refused by the retry budget
+    long long fast_failures;        // Commands failed at once by an open circuit
+    long long circuits_opened;
+    int open_circuits;              // Scanners with an open circuit now
+};
+
+/**
+* Retry and circuit breaker policy in front of a CoreScanner interface.
+*
+* ResilientScanner has the ExecCommand/ExecCommandAsync signatures of ICoreScanner, so it can be
+* passed to Exec<Op>() or used by any code written against the interface:
+*
+*   ResilientScanner<ICoreScanner> resilient(scanner_interface);
+*   CommandResult<AttributeResponse> result = Exec<RSM_ATTR_GET>(&resilient, scanner_id, attribute_ids);
+*
+* Outcomes are classified by status (ClassifyStatus()) and opcode (IsRetrySafeOpcode()): a rejected
+* command was not executed and is retried whatever the opcode; a command that failed in flight may
+* have run, so only retry safe opcodes are retried (a second UPDATE_DECODE_TONE or REBOOT_SCANNER
+* is not sent on a guess). Retries wait with randomized exponential backoff and spend tokens of a
+* retry budget shared by all scanners, earned as a fraction of the commands sent, so a bad minute
+* cannot multiply the command traffic.
+*
+* Each scanner has a circuit breaker. Consecutive failed commands (after their retries) open it;
+* while open, commands to that scanner fail at once with the status that opened it, so a dead
+* scanner does not hold command slots for timeouts. After breaker_open_ms one probe command is sent:
+* success closes the circuit, failure keeps it open for another period.
+* Commands without a scanner id are retried but not circuit broken.
+*
+* Thread safe. Backoff sleeps on the calling thread.
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommand signature
+**/
+template <typename Scanner>
+class ResilientScanner
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+    * Resilient scanner constructor
+    * @param scanner - CoreScanner interface commands are sent to
+    */
+    explicit ResilientScanner(Scanner* scanner, const CommandPolicySettings& settings = CommandPolicySettings())
+        : scanner_(scanner), settings_(settings), retry_tokens_(settings.retry_budget_max), random_(std::random_device()()),
+        metrics_(CommandPolicyMetrics())
+    {
+    }
+
+    /**
+    * ICoreScanner::ExecCommand with retries and circuit breaking
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        // Callers pass an uninitialized BSTR, only answers of earlier attempts are freed
+        *out_xml = NULL;
+        return Execute(opcode, in_xml, [this, opcode, in_xml, out_xml, status]()
+        {
+            if (*out_xml != NULL)
+            {
+                SysFreeString(*out_xml);    // Answer of a failed attempt
+                *out_xml = NULL;
+            }
+            return scanner_->ExecCommand(opcode, in_xml, out_xml, status);
+        }, status);
+    }
+
+    /**
+    * ICoreScanner::ExecCommandAsync with retries and circuit breaking of the submission
+    */
+    HRESULT ExecCommandAsync(LONG opcode, BSTR* in_xml, LONG* status)
+    {
+        return Execute(opcode, in_xml, [this, opcode, in_xml, status]()
+        {
+            return scanner_->ExecCommandAsync(opcode, in_xml, status);
+        }, status);
+    }
+
+    /**
+    * True if commands to a scanner currently fail at once
+    */
+    bool IsCircuitOpen(int scanner_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        typename std::map<int, Breaker>::const_iterator it = breakers_.find(scanner_id);
+        return it != breakers_.end() && it->second.open;
+    }
+
+    /**
+    * Counters since construction
+    */
+    CommandPolicyMetrics Metrics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CommandPolicyMetrics metrics = metrics_;
+        metrics.open_circuits = 0;
+        for (typename std::map<int, Breaker>::const_iterator it = breakers_.begin(); it != breakers_.end(); ++it)
+        {
+            metrics.open_circuits += it->second.open ? 1 : 0;
+        }
+        return metrics;
+    }
+
+private:
+    struct Breaker
+    {
+        int consecutive_failures;
+        bool open;
+        bool probing;               // The one command let through an open circuit is running
+        Clock::time_point retry_at; // When an open circuit lets a probe through
+        LONG open_status;           // Status returned while open
+
+        Breaker() : consecutive_failures(0), open(false), probing(false), open_status(kStatusDeviceUnavailable) {}
+    };
+
+    template <typename Attempt>
+    HRESULT Execute(LONG opcode, BSTR* in_xml, const Attempt& attempt, LONG* status)
+    {
+        int scanner_id = OpcodeNeedsScannerId(opcode) ? ScannerIdOf(*in_xml) : 0;
+        if (!Admit(scanner_id, status))
+        {
+            return S_OK;
+        }
+
+        HRESULT hr = S_OK;
+        StatusClass outcome = kStatusClassPermanent;
+        bool retried = false;
+        for (int attempt_number = 1; ; attempt_number++)
+        {
+            hr = attempt();
+            outcome = ClassifyStatus(hr, *status);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                metrics_.attempts++;
+            }
+            if (outcome == kStatusClassSuccess || outcome == kStatusClassPermanent || attempt_number >= settings_.max_attempts ||
+                !MayRetry(opcode, outcome, scanner_id))
+            {
+                break;
+            }
+            retried = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(Backoff(attempt_number)));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (outcome == kStatusClassSuccess && retried)
+        {
+            metrics_.retry_successes++;
+        }
+        Record(scanner_id, outcome, *status);
+        return hr;
+    }
+
+    /**
+    * Let a command through the scanner's circuit, or fail it at once
+    */
+    bool Admit(int scanner_id, LONG* status)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        metrics_.commands++;
+        retry_tokens_ = std::min(settings_.retry_budget_max, retry_tokens_ + settings_.retry_budget_ratio);
+        if (scanner_id == 0)
+        {
+            return true;
+        }
+        Breaker& breaker = breakers_[scanner_id];
+        if (!breaker.open)
+        {
+            return true;
+        }
+        if (!breaker.probing && Clock::now() >= breaker.retry_at)
+        {
+            breaker.probing = true;
+            return true;
+        }
+        metrics_.fast_failures++;
+        *status = breaker.open_status;
+        return false;
+    }
+
+    /**
+    * Decide on a retry, spending a budget token. A probe of an open circuit is not retried.
+    */
+    bool MayRetry(LONG opcode, StatusClass outcome, int scanner_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (outcome == kStatusClassFailed && !IsRetrySafeOpcode(opcode))
+        {
+            metrics_.retries_not_safe++;
+            return false;
+        }
+        if (scanner_id != 0 && breakers_[scanner_id].probing)
+        {
+            return false;
+        }
+        if (retry_tokens_ < 1)
+        {
+            metrics_.retries_throttled++;
+            return false;
+        }
+        retry_tokens_ -= 1;
+        metrics_.retries++;
+        return true;
+    }
+
+    /**
+    * Randomized exponential backoff before retry number attempt_number
+    */
+    int Backoff(int attempt_number)
+    {
+        long long delay = settings_.initial_backoff_ms;
+        for (int i = 1; i < attempt_number && delay < settings_.max_backoff_ms; i++)
+        {
+            delay *= 2;
+        }
+        delay = std::min<long long>(delay, settings_.max_backoff_ms);
+        std::lock_guard<std::mutex> lock(mutex_);
+        return (int)std::uniform_int_distribution<long long>(delay / 2, delay)(random_);
+    }
+
+    /**
+    * Update the scanner's circuit with the final outcome of a command. Called with mutex_ held.
+    */
+    void Record(int scanner_id, StatusClass outcome, LONG status)
+    {
+        if (scanner_id == 0)
+        {
+            return;
+        }
+        Breaker& breaker = breakers_[scanner_id];
+        bool was_probe = breaker.probing;
+        breaker.probing = false;
+        if (outcome != kStatusClassFailed)
+        {
+            // The scanner answered - rejected and permanent outcomes prove it is alive too
+            breaker.consecutive_failures = 0;
+            breaker.open = false;
+            return;
+        }
+        breaker.consecutive_failures++;
+        if (was_probe || (!breaker.open && breaker.consecutive_failures >= settings_.breaker_failures))
+        {
+            if (!breaker.open)
+            {
+                metrics_.circuits_opened++;
+            }
+            breaker.open = true;
+            breaker.open_status = status;
+            breaker.retry_at = Clock::now() + std::chrono::milliseconds(settings_.breaker_open_ms);
+        }
+    }
+
+    /**
+    * Scanner id of an inXML (<scannerID>n</scannerID>), 0 if absent
+    */
+    static int ScannerIdOf(BSTR in_xml)
+    {
+        static const wchar_t kTag[] = L"<scannerID>";
+        const size_t tag_length = sizeof(kTag) / sizeof(kTag[0]) - 1;
+        if (in_xml == NULL)
+        {
+            return 0;
+        }
+        size_t length = SysStringLen(in_xml);
+        for (size_t i = 0; i + tag_length <= length; i++)
+        {
+            if (wcsncmp(in_xml + i, kTag, tag_length) == 0)
+            {
+                int scanner_id = 0;
+                for (size_t digit = i + tag_length; digit < length && in_xml[digit] >= L'0' && in_xml[digit] <= L'9'; digit++)
+                {
+                    scanner_id = scanner_id * 10 + (in_xml[digit] - L'0');
+                }
+                return scanner_id;
+            }
+        }
+        return 0;
+    }
+
+    Scanner* scanner_;
+    CommandPolicySettings settings_;
+    mutable std::mutex mutex_;
+    std::map<int, Breaker> breakers_;
+    double retry_tokens_;
+    std::mt19937 random_;
+    CommandPolicyMetrics metrics_;
+};
@@ -0,0 +1,382 @@
+/*******************************************************************************************
+* @file command_retry_policy.cpp
+* @brief This file contains code snippet to send commands through a retry and circuit breaker policy
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "command_policy.h"
+#include "mock_flaky_host.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Get the ids of the connected scanners
+* @param scanner_ids - Receives scanner ids
+* return value : GetScanners success/fail status
+*/
+bool GetScannerIds(vector<int>* scanner_ids)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+    XmlReader reader(get_scanners_output_xml);
+    XmlSlice text;
+    while (reader.FindElement("scannerID") && reader.ReadElementText(&text))
+    {
+        scanner_ids->push_back((int)text.ToLong());
+    }
+    cout << "CoreScanner GetScanners() - Success, " << scanner_ids->size() << " scanners" << endl;
+    return true;
+}
+
+void PrintMetrics(const CommandPolicyMetrics& metrics)
+{
+    cout << " Commands : " << metrics.commands << ", sent : " << metrics.attempts << ", retries : " << metrics.retries
+         << " (" << metrics.retry_successes << " succeeded after a retry)" << endl;
+    cout << " Not retried - unsafe opcode : " << metrics.retries_not_safe << ", retry budget : " << metrics.retries_throttled << endl;
+    cout << " Circuits opened : " << metrics.circuits_opened << ", open now : " << metrics.open_circuits
+         << ", commands failed fast : " << metrics.fast_failures << endl;
+}
+
+/*
+* Run the command mix of several lanes: attribute reads to every scanner and a beep every fourth command
+* @param send - Sends one command, send(scanner_id, beep) returns the command success/fail status
+* return value : Commands that succeeded
+*/
+template <typename Send>
+long RunLanes(int lanes, int commands_per_lane, int scanner_count, const Send& send)
+{
+    atomic<long> succeeded(0);
+    vector<thread> threads;
+    for (int lane = 0; lane < lanes; lane++)
+    {
+        threads.push_back(thread([&succeeded, &send, lane, commands_per_lane, scanner_count]()
+        {
+            for (int i = 0; i < commands_per_lane; i++)
+            {
+                if (send(1 + (lane + i) % scanner_count, i % 4 == 3))
+                {
+                    succeeded++;
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+    return succeeded;
+}
+
+/*
+* Send one benchmark command
+*/
+template <typename Scanner>
+bool SendBenchmarkCommand(Scanner* scanner, int scanner_id, bool beep)
+{
+    if (beep)
+    {
+        return Exec<SET_ACTION>(scanner, scanner_id, ONESHORTHIGH).Succeeded();
+    }
+    vector<int> attribute_ids(1, 533);
+    return Exec<RSM_ATTR_GET>(scanner, scanner_id, attribute_ids).Succeeded();
+}
+
+/*
+* Same lanes with one attempt per command, with retrying every failure, and through the policy.
+* Scanner 1 is healthy, scanner 2 is busy (STATUS_LOCKED, lost answers) and scanner 3 is dead.
+*/
+void RunPolicyBenchmark()
+{
+    const int kLanes = 3;
+    const int kCommandsPerLane = 60;
+    const int kScanners = 3;
+    const int kHealthy = 1;
+    const int kBusy = 2;
+    const int kDead = 3;
+    const char* names[] = { "One attempt (snippets today)", "Retry every failure 4x", "ResilientScanner" };
+
+    // Beeps the lanes ask of the busy scanner
+    long beeps_requested = 0;
+    for (int lane = 0; lane < kLanes; lane++)
+    {
+        for (int i = 0; i < kCommandsPerLane; i++)
+        {
+            beeps_requested += (i % 4 == 3 && 1 + (lane + i) % kScanners == kBusy) ? 1 : 0;
+        }
+    }
+
+    for (int strategy = 0; strategy < 3; strategy++)
+    {
+        MockFlakyHost host(5, 100, 0.3, 0.05);
+        host.SetHealth(kHealthy, MockFlakyHost::kHealthy);
+        host.SetHealth(kBusy, MockFlakyHost::kBusy);
+        host.SetHealth(kDead, MockFlakyHost::kDead);
+        ResilientScanner<MockFlakyHost> resilient(&host);
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        long succeeded = 0;
+        if (strategy == 0)
+        {
+            succeeded = RunLanes(kLanes, kCommandsPerLane, kScanners, [&host](int scanner_id, bool beep)
+            {
+                return SendBenchmarkCommand(&host, scanner_id, beep);
+            });
+        }
+        else if (strategy == 1)
+        {
+            succeeded = RunLanes(kLanes, kCommandsPerLane, kScanners, [&host](int scanner_id, bool beep)
+            {
+                for (int attempt = 0; attempt < 4; attempt++)
+                {
+                    if (SendBenchmarkCommand(&host, scanner_id, beep))
+                    {
+                        return true;
+                    }
+                    this_thread::sleep_for(chrono::milliseconds(20));
+                }
+                return false;
+            });
+        }
+        else
+        {
+            succeeded = RunLanes(kLanes, kCommandsPerLane, kScanners, [&resilient](int scanner_id, bool beep)
+            {
+                return SendBenchmarkCommand(&resilient, scanner_id, beep);
+            });
+        }
+        double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << names[strategy] << endl;
+        cout << " Succeeded : " << succeeded << "/" << kLanes * kCommandsPerLane << " in " << elapsed_ms << " ms" << endl;
+        cout << " Commands sent to the dead scanner : " << host.Received(kDead) << endl;
+        cout << " Beeps on the busy scanner : " << host.Executed(kBusy, SET_ACTION) << " for " << beeps_requested << " requested" << endl;
+        if (strategy == 2)
+        {
+            PrintMetrics(resilient.Metrics());
+        }
+    }
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    const int kAttributeModelNumber = 533;
+    const int kAttributeSerialNumber = 534;
+
+    cout << "Retry policy benchmark (simulated host)" << endl;
+    RunPolicyBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    vector<int> scanner_ids;
+    if (Open() && GetScannerIds(&scanner_ids))
+    {
+        ResilientScanner<ICoreScanner> resilient(scanner_interface);
+        vector<int> attribute_ids;
+        attribute_ids.push_back(kAttributeModelNumber);
+        attribute_ids.push_back(kAttributeSerialNumber);
+        for (size_t i = 0; i < scanner_ids.size(); i++)
+        {
+            CommandResult<AttributeResponse> result = Exec<RSM_ATTR_GET>(&resilient, scanner_ids[i], attribute_ids);
+            if (!result.Succeeded())
+            {
+                cout << "CoreScanner RSM_ATTR_GET scanner ID:[" << scanner_ids[i] << "] - Failed. Error Code : " << result.status
+                     << (resilient.IsCircuitOpen(scanner_ids[i]) ? " (circuit open)" : "") << endl;
+                continue;
+            }
+            cout << "CoreScanner RSM_ATTR_GET scanner ID:[" << scanner_ids[i] << "] - Success" << endl;
+            for (size_t a = 0; a < result.response.attributes.size(); a++)
+            {
+                cout << " Attribute " << result.response.attributes[a].id << " : " << result.response.attributes[a].value << endl;
+            }
+            Exec<SET_ACTION>(&resilient, scanner_ids[i], ONESHORTHIGH);
+        }
+        cout << "Retry policy" << endl;
+        PrintMetrics(resilient.Metrics());
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,143 @@
+/*******************************************************************************************
+* @file mock_flaky_host.h
+* @brief Simulated CoreScanner host with healthy, busy and dead scanners
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include "common_defs.h"
+#include "command_policy.h"
+#include "xml_reader.h"
+
+/**
+* Simulated CoreScanner host with the ICoreScanner::ExecCommand signature.
+* A healthy scanner answers every command after command_latency_ms. A busy scanner answers
+* STATUS_LOCKED to a share of the commands, and a share of its commands time out after they ran
+* (kStatusRequestFailed although the scanner executed the command). A dead scanner answers
+* nothing: every command fails with kStatusRequestFailed after timeout_ms.
+**/
+class MockFlakyHost
+{
+public:
+    enum Health
+    {
+        kHealthy,
+        kBusy,
+        kDead
+    };
+
+    /**
+    * Mock host constructor
+    */
+    MockFlakyHost(int command_latency_ms, int timeout_ms, double locked_ratio, double lost_answer_ratio)
+        : command_latency_ms_(command_latency_ms), timeout_ms_(timeout_ms), locked_ratio_(locked_ratio),
+        lost_answer_ratio_(lost_answer_ratio), random_(7)
+    {
+    }
+
+    void SetHealth(int scanner_id, Health health)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        scanners_[scanner_id].health = health;
+    }
+
+    /**
+    * Commands received by a scanner (answered or not)
+    */
+    long Received(int scanner_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<int, Device>::const_iterator it = scanners_.find(scanner_id);
+        return it == scanners_.end() ? 0 : it->second.received;
+    }
+
+    /**
+    * Times a scanner executed an opcode (SET_ACTION executed twice beeps twice)
+    */
+    long Executed(int scanner_id, LONG opcode) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<int, Device>::const_iterator it = scanners_.find(scanner_id);
+        if (it == scanners_.end())
+        {
+            return 0;
+        }
+        std::map<LONG, long>::const_iterator executed = it->second.executed.find(opcode);
+        return executed == it->second.executed.end() ? 0 : executed->second;
+    }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        *out_xml = NULL;
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        std::string value;
+        int scanner_id = XmlFindText(in, "scannerID", &value) ? atoi(value.c_str()) : 0;
+
+        Health health;
+        double roll;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Device& device = scanners_[scanner_id];
+            device.received++;
+            health = device.health;
+            roll = std::uniform_real_distribution<double>(0, 1)(random_);
+        }
+
+        if (health == kDead)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms_));
+            *status = kStatusRequestFailed;
+            return S_OK;
+        }
+        if (health == kBusy && roll < locked_ratio_)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(command_latency_ms_));
+            *status = STATUS_LOCKED;
+            return S_OK;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(command_latency_ms_));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            scanners_[scanner_id].executed[opcode]++;
+        }
+        if (health == kBusy && roll < locked_ratio_ + lost_answer_ratio_)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms_ - command_latency_ms_));
+            *status = kStatusRequestFailed;
+            return S_OK;
+        }
+        *status = STATUS_SUCCESS;
+        return S_OK;
+    }
+
+private:
+    struct Device
+    {
+        Health health;
+        long received;
+        std::map<LONG, long> executed;
+
+        Device() : health(kHealthy), received(0) {}
+    };
+
+    int command_latency_ms_;
+    int timeout_ms_;
+    double locked_ratio_;
+    double lost_answer_ratio_;
+    mutable std::mutex mutex_;
+    std::mt19937 random_;
+    std::map<int, Device> scanners_;
+};
@@ -0,0 +1,522 @@
+/*******************************************************************************************
+* @file decode_tone_deployment.cpp
+* @brief This file contains code snippet to validate a decode tone and deploy it to many scanners
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "mapped_file.h"
+#include "wav_tone.h"
+#include "tone_journal.h"
+#include "tone_deployer.h"
+#include "mock_tone_host.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+IGlobalInterfaceTable* global_interface_table = NULL;  // Hands the interface to deployment workers
+DWORD scanner_interface_cookie = 0;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Validate a tone file through a mapped view and write its normalized form
+* @param path - Source WAV file
+* @param normalized_path - Receives the normalized WAV file
+* @param tone_hash - Receives the content hash of the normalized tone
+* return value : true if the tone is valid and the normalized file was written
+*/
+bool PrepareTone(const string& path, const string& normalized_path, unsigned long long* tone_hash)
+{
+    MappedFile file;
+    if (!file.Open(path))
+    {
+        cout << "Decode tone " << path << " - Failed : cannot open the file" << endl;
+        return false;
+    }
+    WavInfo info;
+    string error;
+    if (!ParseWav(file.Data(), file.Size(), ToneRequirements(), &info, &error))
+    {
+        cout << "Decode tone " << path << " - Failed : " << error << endl;
+        return false;
+    }
+
+    vector<unsigned char> wav;
+    NormalizeTone(file.Data(), info, &wav);
+    ofstream normalized(normalized_path.c_str(), ios::binary | ios::trunc);
+    normalized.write((const char*)wav.data(), wav.size());
+    if (!normalized)
+    {
+        cout << "Decode tone " << normalized_path << " - Failed : cannot write the normalized tone" << endl;
+        return false;
+    }
+    *tone_hash = ToneContentHash(wav);
+    cout << "Decode tone " << path << " - " << info.channels << " channels, " << info.bits_per_sample << " bits, "
+         << info.sample_rate << " Hz, " << info.DurationMs() << " ms -> " << normalized_path << endl;
+    return true;
+}
+
+/*
+* Write a stereo 16 bit WAV file with a metadata chunk (album art, as exported by audio tools) before the samples
+*/
+void WriteSyntheticTone(const string& path, int duration_ms, size_t metadata_size)
+{
+    const int kSampleRate = 44100;
+    const int kChannels = 2;
+    vector<unsigned char> samples((size_t)kSampleRate * duration_ms / 1000 * kChannels * 2);
+    for (size_t i = 0; i + 3 < samples.size(); i += 4)
+    {
+        short value = (short)(8000 * sin(2 * 3.14159265 * 2700 * (i / 4) / kSampleRate));   // 2.7 kHz beep
+        samples[i] = samples[i + 2] = (unsigned char)(value & 0xff);
+        samples[i + 1] = samples[i + 3] = (unsigned char)((value >> 8) & 0xff);
+    }
+    unsigned int fmt[4] = { 0x00020001, kSampleRate, kSampleRate * kChannels * 2, 0x00100004 };
+    unsigned int riff_size = (unsigned int)(4 + 8 + sizeof(fmt) + 8 + metadata_size + 8 + samples.size());
+    unsigned int fmt_size = sizeof(fmt);
+    unsigned int metadata_chunk_size = (unsigned int)metadata_size;
+    unsigned int data_size = (unsigned int)samples.size();
+
+    ofstream file(path.c_str(), ios::binary | ios::trunc);
+    file.write("RIFF", 4).write((const char*)&riff_size, 4).write("WAVEfmt ", 8);
+    file.write((const char*)&fmt_size, 4).write((const char*)fmt, sizeof(fmt));
+    file.write("LIST", 4).write((const char*)&metadata_chunk_size, 4);
+    file.write(string(metadata_size, 'M').data(), metadata_size);
+    file.write("data", 4).write((const char*)&data_size, 4).write((const char*)samples.data(), samples.size());
+}
+
+/*
+* Validate and normalize a tone exported with large metadata, loading the whole file as the
+* deployment scripts did and through a mapped view
+*/
+void RunValidationBenchmark()
+{
+    const int kRuns = 20;
+    const string path = "synthetic_tone.wav";
+    WriteSyntheticTone(path, 250, 16 * 1024 * 1024);
+
+    double loaded_ms = 0;
+    double mapped_ms = 0;
+    unsigned long long loaded_hash = 0;
+    unsigned long long mapped_hash = 0;
+    for (int run = 0; run < kRuns; run++)
+    {
+        WavInfo info;
+        string error;
+        vector<unsigned char> wav;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        ifstream file(path.c_str(), ios::binary);
+        vector<unsigned char> content((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+        if (ParseWav(content.data(), content.size(), ToneRequirements(), &info, &error))
+        {
+            NormalizeTone(content.data(), info, &wav);
+            loaded_hash = ToneContentHash(wav);
+        }
+        loaded_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        MappedFile mapped;
+        if (mapped.Open(path) && ParseWav(mapped.Data(), mapped.Size(), ToneRequirements(), &info, &error))
+        {
+            NormalizeTone(mapped.Data(), info, &wav);
+            mapped_hash = ToneContentHash(wav);
+        }
+        mapped_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    remove(path.c_str());
+
+    cout << "Validation of a 250 ms tone with 16 MB of metadata" << endl;
+    cout << " Whole file loaded : " << loaded_ms / kRuns << " ms per file" << endl;
+    cout << " Mapped view       : " << mapped_ms / kRuns << " ms per file" << endl;
+    cout << " Same normalized tone : " << (loaded_hash == mapped_hash && mapped_hash != 0 ? "yes" : "no") << endl;
+}
+
+/*
+* Deploy a tone to a fleet of mock scanners, most of which got it in an earlier run, uploading to
+* every scanner one after the other as the deployment scripts did and with the tone deployer
+*/
+void RunDeploymentBenchmark()
+{
+    const int kScannerCount = 128;
+    const int kWorkerCount = 16;
+    const int kFailureInterval = 40;
+    const string tone_path = "C:\\tones\\lane_normalized.wav";
+    const unsigned long long tone_hash = 0x746f6e652e776176ULL;
+
+    vector<ToneTarget> targets;
+    ToneJournal journal;
+    int deployed_before = 0;
+    for (int i = 0; i < kScannerCount; i++)
+    {
+        ToneTarget target = { i + 1, "MOCK" + to_string(100000 + i) };
+        targets.push_back(target);
+        if (i % 3 != 0)
+        {
+            journal.Record(target.serial_number, tone_hash);    // Deployed by an earlier run
+            deployed_before++;
+        }
+    }
+
+    MockToneHost scripted_host(kScannerCount, 20, kFailureInterval);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int scripted_failures = 0;
+    for (size_t i = 0; i < targets.size(); i++)
+    {
+        scripted_failures += Exec<UPDATE_DECODE_TONE>(&scripted_host, targets[i].scanner_id, tone_path).Succeeded() ? 0 : 1;
+    }
+    double scripted_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    MockToneHost deployer_host(kScannerCount, 20, kFailureInterval);
+    ToneDeployer<MockToneHost> deployer(&journal, kWorkerCount, [&deployer_host](int worker) { return &deployer_host; });
+    size_t last_reported = 0;
+    deployer.SetProgressHandler([&last_reported](const ToneProgress& progress, const ToneResult& result)
+    {
+        if (result.outcome == kToneFailed)
+        {
+            cout << " Scanner " << result.target.scanner_id << " (" << result.target.serial_number << ") - Failed. Error Code : " << result.status << endl;
+        }
+        if (progress.done == progress.total || progress.done - last_reported >= progress.total / 4)
+        {
+            cout << " Progress " << progress.done << "/" << progress.total << " : " << progress.deployed << " deployed, "
+                 << progress.skipped << " skipped, " << progress.failed << " failed" << endl;
+            last_reported = progress.done;
+        }
+    });
+    start = chrono::steady_clock::now();
+    vector<ToneResult> results = deployer.Deploy(targets, tone_path, tone_hash);
+    double deployer_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "Decode tone deployment to " << kScannerCount << " mock scanners (" << deployed_before << " deployed before)" << endl;
+    cout << " Upload to every scanner in turn : " << scripted_ms << " ms, " << scripted_host.CommandCount() << " uploads, "
+         << scripted_failures << " failed" << endl;
+    cout << " Tone deployer                   : " << deployer_ms << " ms, " << deployer_host.CommandCount() << " uploads" << endl;
+}
+
+/*
+* Get connected scanners with their serial numbers
+* @param targets - Receives the scanners
+* return value : GetScanners success/fail status
+*/
+bool GetToneTargets(vector<ToneTarget>* targets)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+
+    XmlReader reader(get_scanners_output_xml);
+    while (reader.FindElement("scanner"))
+    {
+        int depth = reader.Depth();
+        XmlSlice text;
+        ToneTarget target = { 0, string() };
+        if (reader.FindChild("scannerID", depth) && reader.ReadElementText(&text))
+        {
+            target.scanner_id = (int)text.ToLong();
+        }
+        if (reader.FindChild("serialnumber", depth) && reader.ReadElementText(&text))
+        {
+            target.serial_number = text.ToString();
+        }
+        if (target.scanner_id != 0 && !target.serial_number.empty())
+        {
+            targets->push_back(target);
+        }
+    }
+    cout << "CoreScanner GetScanners() - Success, " << targets->size() << " scanners" << endl;
+    return true;
+}
+
+/*
+* Give a deployment worker thread its own CoreScanner interface from the global interface table
+*/
+ICoreScanner* AttachWorkerScanner(int worker)
+{
+    CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    ICoreScanner* worker_scanner = NULL;
+    HRESULT hr = global_interface_table->GetInterfaceFromGlobal(scanner_interface_cookie, IID_ICoreScanner, (void**)&worker_scanner);
+    if FAILED(hr)
+    {
+        cout << "CoreScanner interface unmarshaling for deployment worker " << worker << " - Failed" << endl;
+        CoUninitialize();
+        return NULL;
+    }
+    return worker_scanner;
+}
+
+/*
+* Release the CoreScanner interface of a deployment worker thread
+*/
+void DetachWorkerScanner(int worker, ICoreScanner* worker_scanner)
+{
+    if (worker_scanner != NULL)
+    {
+        worker_scanner->Release();
+        CoUninitialize();
+    }
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+* Usage : decode_tone_deployment <full path of the tone WAV file>
+*         decode_tone_deployment --erase
+*/
+int main(int argc, char* argv[])
+{
+    RunValidationBenchmark();
+    cout << " " << endl;
+    RunDeploymentBenchmark();
+    cout << " " << endl;
+
+    const int kWorkerCount = 8;
+    const string journal_path = "decode_tone_journal.txt";
+    if (argc < 2)
+    {
+        cout << "Usage : decode_tone_deployment <full path of the tone WAV file> | --erase" << endl;
+        WaitForInput("Press any key to exit.");
+        return false;
+    }
+
+    // Validate and normalize the tone once, before any scanner is touched
+    bool erase = (string(argv[1]) == "--erase");
+    string tone_path = argv[1];
+    string normalized_path;
+    unsigned long long tone_hash = 0;
+    if (!erase)
+    {
+        size_t extension = tone_path.rfind('.');
+        normalized_path = tone_path.substr(0, extension) + "_normalized.wav";
+        if (!PrepareTone(tone_path, normalized_path, &tone_hash))
+        {
+            WaitForInput("Press any key to exit.");
+            return false;
+        }
+    }
+
+    if (!InitializeCOM())
+        return false;
+
+    vector<ToneTarget> targets;
+    if (Open() && GetToneTargets(&targets))
+    {
+        CoCreateInstance(CLSID_StdGlobalInterfaceTable, NULL, CLSCTX_INPROC_SERVER, IID_IGlobalInterfaceTable, (void**)&global_interface_table);
+        if (global_interface_table != NULL &&
+            SUCCEEDED(global_interface_table->RegisterInterfaceInGlobal(scanner_interface, IID_ICoreScanner, &scanner_interface_cookie)))
+        {
+            ToneJournal journal;
+            journal.Load(journal_path);
+            ToneDeployer<ICoreScanner> deployer(&journal, kWorkerCount, AttachWorkerScanner, DetachWorkerScanner);
+            deployer.SetProgressHandler([](const ToneProgress& progress, const ToneResult& result)
+            {
+                cout << " [" << progress.done << "/" << progress.total << "] Scanner " << result.target.scanner_id
+                     << " (" << result.target.serial_number << ") - ";
+                if (result.outcome == kToneFailed)
+                {
+                    cout << "Failed. Error Code : " << result.status << endl;
+                }
+                else
+                {
+                    cout << (result.outcome == kToneSkipped ? "already has the tone" : "Success") << endl;
+                }
+            });
+
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            vector<ToneResult> results = erase ? deployer.Erase(targets) : deployer.Deploy(targets, normalized_path, tone_hash);
+            journal.Save();
+            int failed = 0;
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                failed += (results[i].outcome == kToneFailed) ? 1 : 0;
+            }
+            cout << (erase ? "Decode tone erase" : "Decode tone deployment") << " - " << results.size() - failed << "/" << results.size()
+                 << " scanners (" << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms)" << endl;
+
+            global_interface_table->RevokeInterfaceFromGlobal(scanner_interface_cookie);
+        }
+        else
+        {
+            cout << "CoreScanner interface registration in the global interface table - Failed" << endl;
+        }
+        if (global_interface_table != NULL)
+        {
+            global_interface_table->Release();
+        }
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
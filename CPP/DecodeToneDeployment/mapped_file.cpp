@@ -0,0 +1,73 @@
+/*******************************************************************************************
+* @file mapped_file.cpp
+* @brief Definition of read only memory mapped file
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include <windows.h>
+#include "mapped_file.h"
+
+using namespace std;
+
+MappedFile::MappedFile()
+    : file_(INVALID_HANDLE_VALUE), mapping_(NULL), data_(NULL), size_(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const string& path)
+{
+    Close();
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_ == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_, &file_size) || file_size.QuadPart == 0 || (unsigned long long)file_size.QuadPart > (size_t)-1)
+    {
+        Close();
+        return false;
+    }
+
+    mapping_ = CreateFileMappingA(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping_ == NULL)
+    {
+        Close();
+        return false;
+    }
+    data_ = (const unsigned char*)MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (data_ == NULL)
+    {
+        Close();
+        return false;
+    }
+    size_ = (size_t)file_size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data_ != NULL)
+    {
+        UnmapViewOfFile(data_);
+        data_ = NULL;
+    }
+    if (mapping_ != NULL)
+    {
+        CloseHandle(mapping_);
+        mapping_ = NULL;
+    }
+    if (file_ != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+    }
+    size_ = 0;
+}
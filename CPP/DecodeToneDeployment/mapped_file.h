@@ -0,0 +1,45 @@
+/*******************************************************************************************
+* @file mapped_file.h
+* @brief Read only memory mapped file
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+* Read only view of a whole file. Pages are read from disk when they are first touched, so only
+* the parts of the file that are used are loaded.
+**/
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /**
+    * Map a file, closing the file mapped before
+    * @param path - File to map
+    * return value : true if the file is mapped (an empty file cannot be mapped)
+    */
+    bool Open(const std::string& path);
+
+    /**
+    * Unmap the file
+    */
+    void Close();
+
+    const unsigned char* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    void* file_;        // File HANDLE
+    void* mapping_;     // File mapping HANDLE
+    const unsigned char* data_;
+    size_t size_;
+};
@@ -0,0 +1,103 @@
+/*******************************************************************************************
+* @file mock_tone_host.h
+* @brief Simulated CoreScanner host with many scanners answering the decode tone commands
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common_defs.h"
+#include "xml_reader.h"
+
+/**
+* Simulated CoreScanner host with the ICoreScanner::ExecCommand signature, used to benchmark tone
+* deployment without hardware. A tone upload takes upload_latency_ms of real time and uploads to
+* different scanners overlap. Every failure_interval-th scanner rejects uploads.
+**/
+class MockToneHost
+{
+public:
+    static const LONG kStatusFailed = 1;
+
+    /**
+    * Mock host constructor
+    * @param scanner_count - Scanners with ids 1 .. scanner_count
+    * @param upload_latency_ms - Time a tone upload takes
+    * @param failure_interval - Every failure_interval-th scanner fails (0 for none)
+    */
+    MockToneHost(int scanner_count, int upload_latency_ms = 20, int failure_interval = 0)
+        : tones_(scanner_count), upload_latency_ms_(upload_latency_ms), failure_interval_(failure_interval), command_count_(0)
+    {
+    }
+
+    /**
+    * Tone file of a scanner, empty for the default tone
+    */
+    std::string Tone(int scanner_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tones_[scanner_id - 1];
+    }
+
+    long CommandCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return command_count_;
+    }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        *out_xml = NULL;
+        *status = kStatusFailed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(opcode == UPDATE_DECODE_TONE ? upload_latency_ms_ : 1));
+
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        std::string value;
+        if (!XmlFindText(in, "scannerID", &value))
+        {
+            return S_OK;
+        }
+        int scanner_id = atoi(value.c_str());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        command_count_++;
+        if (scanner_id < 1 || scanner_id > (int)tones_.size() ||
+            (failure_interval_ != 0 && scanner_id % failure_interval_ == 0))
+        {
+            return S_OK;
+        }
+        switch (opcode)
+        {
+        case UPDATE_DECODE_TONE:
+            if (!XmlFindText(in, "arg-string", &tones_[scanner_id - 1]))
+            {
+                return S_OK;
+            }
+            break;
+        case ERASE_DECODE_TONE:
+            tones_[scanner_id - 1].clear();
+            break;
+        default:
+            return S_OK;
+        }
+        *status = STATUS_SUCCESS;
+        return S_OK;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::string> tones_;
+    int upload_latency_ms_;
+    int failure_interval_;
+    long command_count_;
+};
@@ -0,0 +1,597 @@
+/*******************************************************************************************
+* @file opcode_traits.h
+* @brief Compile time CoreScanner opcode traits and type safe ExecCommand front end
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "common_defs.h"
+#include "xml_reader.h"
+
+//----------------- Command argument kinds (serializers) -----------------//
+
+/**
+* <arg-int> command argument
+**/
+struct ArgInt
+{
+    typedef int ValueType;
+    static void Append(std::string* xml, int value)
+    {
+        xml->append("<arg-int>");
+        xml->append(std::to_string(value));
+        xml->append("</arg-int>");
+    }
+};
+
+/**
+* <arg-bool> command argument
+**/
+struct ArgBool
+{
+    typedef bool ValueType;
+    static void Append(std::string* xml, bool value)
+    {
+        xml->append(value ? "<arg-bool>TRUE</arg-bool>" : "<arg-bool>FALSE</arg-bool>");
+    }
+};
+
+/**
+* <arg-string> command argument
+**/
+struct ArgString
+{
+    typedef std::string ValueType;
+    static void Append(std::string* xml, const std::string& value)
+    {
+        xml->append("<arg-string>");
+        XmlAppendEscaped(xml, value);
+        xml->append("</arg-string>");
+    }
+};
+
+/**
+* Count and comma separated list pair, as taken by REGISTER_FOR_EVENTS
+* (<arg-int>count</arg-int><arg-int>1,2,3</arg-int>)
+**/
+struct ArgIntList
+{
+    typedef std::vector<int> ValueType;
+    static void Append(std::string* xml, const std::vector<int>& values)
+    {
+        xml->append("<arg-int>");
+        xml->append(std::to_string(values.size()));
+        xml->append("</arg-int><arg-int>");
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            if (i != 0) xml->append(",");
+            xml->append(std::to_string(values[i]));
+        }
+        xml->append("</arg-int>");
+    }
+};
+
+/**
+* Attribute id list, as taken by RSM_ATTR_GET/RSM_ATTR_GETNEXT
+**/
+struct ArgAttribIds
+{
+    typedef std::vector<int> ValueType;
+    static void Append(std::string* xml, const std::vector<int>& ids)
+    {
+        xml->append("<arg-xml><attrib_list>");
+        for (size_t i = 0; i < ids.size(); i++)
+        {
+            if (i != 0) xml->append(",");
+            xml->append(std::to_string(ids[i]));
+        }
+        xml->append("</attrib_list></arg-xml>");
+    }
+};
+
+/**
+* Scanner attribute (RSM attribute/parameter) value
+**/
+struct Attribute
+{
+    int id;
+    char datatype;      // B, C, F, W, D, I, S, L, A, X ...
+    std::string value;
+};
+
+/**
+* Attribute value list, as taken by RSM_ATTR_SET/RSM_ATTR_STORE/DEVICE_SET_PARAMETERS
+**/
+struct ArgAttribValues
+{
+    typedef std::vector<Attribute> ValueType;
+    static void Append(std::string* xml, const std::vector<Attribute>& attributes)
+    {
+        xml->append("<arg-xml><attrib_list>");
+        for (size_t i = 0; i < attributes.size(); i++)
+        {
+            xml->append("<attribute><id>");
+            xml->append(std::to_string(attributes[i].id));
+            xml->append("</id><datatype>");
+            xml->push_back(attributes[i].datatype);
+            xml->append("</datatype><value>");
+            XmlAppendEscaped(xml, attributes[i].value);
+            xml->append("</value></attribute>");
+        }
+        xml->append("</attrib_list></arg-xml>");
+    }
+};
+
+/**
+* Ordered list of command argument kinds of an opcode
+**/
+template <typename... Kinds>
+struct CmdArgs
+{
+    static const int kCount = sizeof...(Kinds);
+
+    static void Write(std::string* xml, const typename Kinds::ValueType&... values)
+    {
+        xml->append("<cmdArgs>");
+        int expand[] = { 0, (Kinds::Append(xml, values), 0)... };
+        (void)expand;
+        xml->append("</cmdArgs>");
+    }
+};
+
+template <>
+struct CmdArgs<>
+{
+    static const int kCount = 0;
+
+    static void Write(std::string* /*xml*/)
+    {
+    }
+};
+
+//----------------- Command responses (outXML parsers) -----------------//
+
+/**
+* Opcode without meaningful outXML
+**/
+struct NoResponse
+{
+    static const bool kHasOutXml = false;
+    static bool Parse(const std::string& /*out_xml*/, NoResponse* /*response*/) { return true; }
+};
+
+/**
+* Single <arg-string> response (GET_VERSION)
+**/
+struct StringResponse
+{
+    static const bool kHasOutXml = true;
+    std::string value;
+
+    static bool Parse(const std::string& out_xml, StringResponse* response)
+    {
+        return XmlFindText(out_xml, "arg-string", &response->value);
+    }
+};
+
+/**
+* Raw <arg-xml> response (GET_DEVICE_TOPOLOGY, GET_PAIRING_BARCODE ...), left for a dedicated parser
+**/
+struct XmlResponse
+{
+    static const bool kHasOutXml = true;
+    std::string xml;
+
+    static bool Parse(const std::string& out_xml, XmlResponse* response)
+    {
+        response->xml = out_xml;
+        return true;
+    }
+};
+
+/**
+* Attribute values response (RSM_ATTR_GET/RSM_ATTR_GETNEXT)
+**/
+struct AttributeResponse
+{
+    static const bool kHasOutXml = true;
+    std::vector<Attribute> attributes;
+
+    static bool Parse(const std::string& out_xml, AttributeResponse* response)
+    {
+        XmlReader reader(out_xml);
+        if (!reader.FindElement("attrib_list"))
+        {
+            return false;
+        }
+
+        int list_depth = reader.Depth();
+        while (reader.FindChild("attribute", list_depth))
+        {
+            int attribute_depth = reader.Depth();
+            Attribute attribute = { 0, 'S', std::string() };
+            XmlReader::Token token;
+            while ((token = reader.Next()) != XmlReader::kEndOfDocument)
+            {
+                if (token == XmlReader::kEndElement && reader.Depth() < attribute_depth)
+                {
+                    break;
+                }
+                if (token != XmlReader::kStartElement)
+                {
+                    continue;
+                }
+                XmlSlice name = reader.Name();
+                XmlSlice text;
+                reader.ReadElementText(&text);
+                if (name.Equals("id"))              attribute.id = (int)text.ToLong();
+                else if (name.Equals("datatype"))   attribute.datatype = text.length > 0 ? text.data[0] : 'S';
+                else if (name.Equals("value"))      attribute.value = text.ToString();
+            }
+            response->attributes.push_back(attribute);
+        }
+        return true;
+    }
+};
+
+/**
+* Attribute id list response (RSM_ATTR_GETALL)
+**/
+struct AttributeIdResponse
+{
+    static const bool kHasOutXml = true;
+    std::vector<int> ids;
+
+    static bool Parse(const std::string& out_xml, AttributeIdResponse* response)
+    {
+        XmlReader reader(out_xml);
+        if (!reader.FindElement("attrib_list"))
+        {
+            return false;
+        }
+
+        int list_depth = reader.Depth();
+        while (reader.FindChild("attribute", list_depth))
+        {
+            XmlSlice text;
+            if (reader.ReadElementText(&text))
+            {
+                response->ids.push_back((int)text.ToLong());
+            }
+        }
+        return true;
+    }
+};
+
+/**
+* Scale weight response (SCALE_READ_WEIGHT)
+**/
+struct WeightResponse
+{
+    static const bool kHasOutXml = true;
+    double weight;
+    std::string weight_mode;    // English/Metric
+    int scale_status;           // 0 - not enabled ... 6 - stable non zero weight
+
+    static bool Parse(const std::string& out_xml, WeightResponse* response)
+    {
+        response->weight = 0;
+        response->scale_status = 0;
+        XmlReader reader(out_xml);
+        XmlReader::Token token;
+        bool found = false;
+        while ((token = reader.Next()) != XmlReader::kEndOfDocument)
+        {
+            if (token != XmlReader::kStartElement)
+            {
+                continue;
+            }
+            XmlSlice name = reader.Name();
+            if (!name.Equals("weight") && !name.Equals("weight_mode") && !name.Equals("status"))
+            {
+                continue;
+            }
+            XmlSlice text;
+            reader.ReadElementText(&text);
+            if (name.Equals("weight"))
+            {
+                response->weight = text.ToDouble();
+                found = true;
+            }
+            else if (name.Equals("weight_mode"))
+            {
+                response->weight_mode = text.ToString();
+            }
+            else
+            {
+                response->scale_status = (int)text.ToLong();
+            }
+        }
+        return found;
+    }
+};
+
+/**
+* HID keyboard emulator configuration response (KEYBOARD_EMULATOR_GET_CONFIG)
+**/
+struct KeyboardEmulatorConfig
+{
+    static const bool kHasOutXml = true;
+    bool enabled;
+    int locale;     // LANGUAGE_CODES
+
+    static bool Parse(const std::string& out_xml, KeyboardEmulatorConfig* response)
+    {
+        std::string enabled;
+        std::string locale;
+        if (!XmlFindText(out_xml, "KeyEnumState", &enabled) || !XmlFindText(out_xml, "KeyEnumLocale", &locale))
+        {
+            return false;
+        }
+        XmlSlice enabled_slice = { enabled.data(), enabled.size() };
+        XmlSlice locale_slice = { locale.data(), locale.size() };
+        response->enabled = enabled_slice.ToBool();
+        response->locale = (int)locale_slice.ToLong();
+        return true;
+    }
+};
+
+//----------------- Opcode traits table -----------------//
+
+// Argument lists with more than one kind (macro arguments cannot contain commas)
+typedef CmdArgs<ArgInt, ArgInt, ArgInt, ArgInt, ArgString> PairingBarcodeArgs;    // barcode type, protocol, default option, image size, image file
+typedef CmdArgs<ArgString, ArgInt> FirmwareUpdateArgs;                            // firmware/plug-in file, bulk mode
+typedef CmdArgs<ArgInt, ArgInt, ArgInt, ArgInt, ArgInt> SerialPortArgs;           // baud rate, data bits, parity, stop bits, flow control
+typedef CmdArgs<ArgString, ArgBool, ArgBool> SwitchHostModeArgs;                  // host mode, silent switch, permanent change
+
+/*
+* X(opcode, needs <scannerID>, safe to retry, command arguments, response)
+*
+* "Safe to retry" marks commands that can be re-sent after a transient failure without
+* side effects (queries and idempotent state changes). Beeps, reboots, firmware and
+* tone updates are not.
+*/
+#define CORESCANNER_OPCODE_TRAITS(X)                                                                 \
+    X(GET_VERSION,                        false, true,  CmdArgs<>,                     StringResponse)        \
+    X(REGISTER_FOR_EVENTS,                false, true,  CmdArgs<ArgIntList>,           NoResponse)            \
+    X(UNREGISTER_FOR_EVENTS,              false, true,  CmdArgs<ArgIntList>,           NoResponse)            \
+    X(GET_PAIRING_BARCODE,                false, true,  PairingBarcodeArgs,            XmlResponse)           \
+    X(CLAIM_DEVICE,                       true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(RELEASE_DEVICE,                     true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_ABORT_MACROPDF,              true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_ABORT_UPDATE_FIRMWARE,       true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_AIM_OFF,                     true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_AIM_ON,                      true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_FLUSH_MACROPDF,              true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_PULL_TRIGGER,                true,  false, CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_RELEASE_TRIGGER,             true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_SCAN_DISABLE,                true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_SCAN_ENABLE,                 true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_SET_PARAMETER_DEFAULTS,      true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_SET_PARAMETERS,              true,  true,  CmdArgs<ArgAttribValues>,      NoResponse)            \
+    X(DEVICE_SET_PARAMETER_PERSISTANCE,   true,  true,  CmdArgs<ArgAttribValues>,      NoResponse)            \
+    X(REBOOT_SCANNER,                     true,  false, CmdArgs<>,                     NoResponse)            \
+    X(DISCONNECT_BT_SCANNER,              true,  false, CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_CAPTURE_IMAGE,               true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_CAPTURE_BARCODE,             true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_CAPTURE_VIDEO,               true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(RSM_ATTR_GETALL,                    true,  true,  CmdArgs<>,                     AttributeIdResponse)   \
+    X(RSM_ATTR_GET,                       true,  true,  CmdArgs<ArgAttribIds>,         AttributeResponse)     \
+    X(RSM_ATTR_GETNEXT,                   true,  true,  CmdArgs<ArgAttribIds>,         AttributeResponse)     \
+    X(RSM_ATTR_SET,                       true,  true,  CmdArgs<ArgAttribValues>,      NoResponse)            \
+    X(RSM_ATTR_STORE,                     true,  true,  CmdArgs<ArgAttribValues>,      NoResponse)            \
+    X(GET_DEVICE_TOPOLOGY,                false, true,  CmdArgs<>,                     XmlResponse)           \
+    X(UNINSTALL_SYMBOL_DEVICES,           false, false, CmdArgs<>,                     NoResponse)            \
+    X(START_NEW_FIRMWARE,                 true,  false, CmdArgs<>,                     NoResponse)            \
+    X(DEVICE_UPDATE_FIRMWARE,             true,  false, FirmwareUpdateArgs,            NoResponse)            \
+    X(DEVICE_UPDATE_FIRMWARE_FROM_PLUGIN, true,  false, FirmwareUpdateArgs,            NoResponse)            \
+    X(UPDATE_DECODE_TONE,                 true,  false, CmdArgs<ArgString>,            NoResponse)            \
+    X(ERASE_DECODE_TONE,                  true,  false, CmdArgs<>,                     NoResponse)            \
+    X(SET_ACTION,                         true,  false, CmdArgs<ArgInt>,               NoResponse)            \
+    X(DEVICE_SET_SERIAL_PORT_SETTINGS,    true,  true,  SerialPortArgs,                NoResponse)            \
+    X(DEVICE_SWITCH_HOST_MODE,            true,  false, SwitchHostModeArgs,            NoResponse)            \
+    X(SWITCH_CDC_DEVICES,                 false, false, CmdArgs<>,                     NoResponse)            \
+    X(KEYBOARD_EMULATOR_ENABLE,           false, true,  CmdArgs<ArgBool>,              NoResponse)            \
+    X(KEYBOARD_EMULATOR_SET_LOCALE,       false, true,  CmdArgs<ArgInt>,               NoResponse)            \
+    X(KEYBOARD_EMULATOR_GET_CONFIG,       false, true,  CmdArgs<>,                     KeyboardEmulatorConfig) \
+    X(CONFIGURE_DADF,                     false, true,  CmdArgs<ArgString>,            NoResponse)            \
+    X(RESET_DADF,                         false, true,  CmdArgs<>,                     NoResponse)            \
+    X(SCALE_READ_WEIGHT,                  true,  true,  CmdArgs<>,                     WeightResponse)        \
+    X(SCALE_ZERO_SCALE,                   true,  true,  CmdArgs<>,                     NoResponse)            \
+    X(SCALE_SYSTEM_RESET,                 true,  false, CmdArgs<>,                     NoResponse)
+
+/**
+* Opcode traits - only opcodes listed in CORESCANNER_OPCODE_TRAITS are specialized,
+* using any other opcode with Exec() is a compile error
+**/
+template <OPCODE Op>
+struct OpcodeTraits;
+
+#define CORESCANNER_DEFINE_OPCODE_TRAITS(opcode, needs_scanner_id, retry_safe, args, response)   \
+    template <>                                                                                   \
+    struct OpcodeTraits<opcode>                                                                   \
+    {                                                                                             \
+        static const bool kNeedsScannerId = needs_scanner_id;                                    \
+        static const bool kRetrySafe = retry_safe;                                                \
+        typedef args Args;                                                                        \
+        typedef response Response;                                                                \
+        static const int kArgCount = Args::kCount + (needs_scanner_id ? 1 : 0);                  \
+    };
+
+CORESCANNER_OPCODE_TRAITS(CORESCANNER_DEFINE_OPCODE_TRAITS)
+#undef CORESCANNER_DEFINE_OPCODE_TRAITS
+
+/**
+* Runtime view of the traits table, for code that only has the opcode value (retry policies, logging)
+* return value : true if opcode is listed and safe to retry
+*/
+inline bool IsRetrySafeOpcode(LONG opcode)
+{
+    switch (opcode)
+    {
+#define CORESCANNER_RETRY_SAFE_CASE(op, needs_scanner_id, retry_safe, args, response) case op: return retry_safe;
+        CORESCANNER_OPCODE_TRAITS(CORESCANNER_RETRY_SAFE_CASE)
+#undef CORESCANNER_RETRY_SAFE_CASE
+    default:
+        return false;
+    }
+}
+
+/**
+* Runtime view of the traits table
+* return value : true if opcode takes a <scannerID>
+*/
+inline bool OpcodeNeedsScannerId(LONG opcode)
+{
+    switch (opcode)
+    {
+#define CORESCANNER_NEEDS_ID_CASE(op, needs_scanner_id, retry_safe, args, response) case op: return needs_scanner_id;
+        CORESCANNER_OPCODE_TRAITS(CORESCANNER_NEEDS_ID_CASE)
+#undef CORESCANNER_NEEDS_ID_CASE
+    default:
+        return false;
+    }
+}
+
+//----------------- inXML builder -----------------//
+
+template <bool... Values>
+struct BoolPack;
+
+/**
+* True if every value is true (compile time)
+**/
+template <bool... Values>
+struct AllOf : std::is_same<BoolPack<true, Values...>, BoolPack<Values..., true> >
+{
+};
+
+template <bool NeedsScannerId, typename Args>
+struct InXmlBuilder;
+
+template <typename... Kinds>
+struct InXmlBuilder<false, CmdArgs<Kinds...> >
+{
+    template <typename... Values>
+    static void Build(std::string* xml, Values&&... values)
+    {
+        static_assert(AllOf<std::is_same<typename std::decay<Values>::type, typename Kinds::ValueType>::value...>::value,
+            "Wrong argument type for opcode - arguments are not converted, see CORESCANNER_OPCODE_TRAITS");
+        xml->append("<inArgs>");
+        CmdArgs<Kinds...>::Write(xml, values...);
+        xml->append("</inArgs>");
+    }
+};
+
+template <typename... Kinds>
+struct InXmlBuilder<true, CmdArgs<Kinds...> >
+{
+    template <typename... Values>
+    static void Build(std::string* xml, int scanner_id, Values&&... values)
+    {
+        static_assert(AllOf<std::is_same<typename std::decay<Values>::type, typename Kinds::ValueType>::value...>::value,
+            "Wrong argument type for opcode - arguments are not converted, see CORESCANNER_OPCODE_TRAITS");
+        xml->append("<inArgs><scannerID>");
+        xml->append(std::to_string(scanner_id));
+        xml->append("</scannerID>");
+        CmdArgs<Kinds...>::Write(xml, values...);
+        xml->append("</inArgs>");
+    }
+};
+
+/**
+* Build inXML for an opcode. Argument count and types are checked at compile time: each command
+* argument must have the exact type of its kind (int, bool, std::string, ...), without conversions.
+* @param values - scanner id (if the opcode needs one) followed by command arguments
+* return value : inXML string
+*/
+template <OPCODE Op, typename... Values>
+std::string BuildInXml(const Values&... values)
+{
+    typedef OpcodeTraits<Op> Traits;
+    static_assert(sizeof...(Values) == Traits::kArgCount,
+        "Wrong number of arguments for opcode - see CORESCANNER_OPCODE_TRAITS");
+
+    std::string xml;
+    xml.reserve(128);
+    InXmlBuilder<Traits::kNeedsScannerId, typename Traits::Args>::Build(&xml, values...);
+    return xml;
+}
+
+//----------------- Type safe ExecCommand -----------------//
+
+/**
+* Result of a command executed through Exec()
+**/
+template <typename Response>
+struct CommandResult
+{
+    HRESULT hr;
+    LONG status;
+    bool parsed;          // outXML was parsed into response
+    Response response;
+
+    bool Succeeded() const { return (hr == S_OK) && (status == STATUS_SUCCESS); }
+};
+
+/**
+* Execute a CoreScanner command synchronously.
+* Serializer and outXML parser are selected at compile time from OpcodeTraits.
+* @param scanner - ICoreScanner (or any object with the same ExecCommand signature)
+* @param values - scanner id (if the opcode needs one) followed by command arguments
+* return value : Command result with parsed response
+*/
+template <OPCODE Op, typename Scanner, typename... Values>
+CommandResult<typename OpcodeTraits<Op>::Response> Exec(Scanner* scanner, const Values&... values)
+{
+    typedef typename OpcodeTraits<Op>::Response Response;
+
+    CommandResult<Response> result = CommandResult<Response>();
+    result.status = -1;
+
+    std::string in_xml = BuildInXml<Op>(values...);
+    CComBSTR input = in_xml.c_str();
+    BSTR out_xml = NULL;
+
+    result.hr = scanner->ExecCommand(Op,    // Opcode
+        &input,                             // Input xml
+        &out_xml,                           // Output xml
+        &result.status);                    // Command execution success/failure return status
+
+    if (Response::kHasOutXml && result.Succeeded() && out_xml != NULL)
+    {
+        std::wstring out_str(out_xml, SysStringLen(out_xml));
+        std::string output_xml(out_str.begin(), out_str.end());
+        result.parsed = Response::Parse(output_xml, &result.response);
+    }
+    if (out_xml != NULL)
+    {
+        SysFreeString(out_xml);
+    }
+    return result;
+}
+
+/**
+* Execute a CoreScanner command asynchronously (response arrives as ScanCmdResponseEvent)
+* @param scanner - ICoreScanner (or any object with the same ExecCommandAsync signature)
+* @param values - scanner id (if the opcode needs one) followed by command arguments
+* return value : Command result (response is never parsed)
+*/
+template <OPCODE Op, typename Scanner, typename... Values>
+CommandResult<NoResponse> ExecAsync(Scanner* scanner, const Values&... values)
+{
+    CommandResult<NoResponse> result = CommandResult<NoResponse>();
+    result.status = -1;
+
+    std::string in_xml = BuildInXml<Op>(values...);
+    CComBSTR input = in_xml.c_str();
+
+    result.hr = scanner->ExecCommandAsync(Op,   // Opcode
+        &input,                                 // Input xml
+        &result.status);                        // Command execution success/failure return status
+    return result;
+}
@@ -0,0 +1,196 @@
+/*******************************************************************************************
+* @file tone_deployer.h
+* @brief Pushes a decode tone to many scanners concurrently, skipping scanners that already have it
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "opcode_traits.h"
+#include "tone_journal.h"
+
+/**
+* Scanner to deploy to
+**/
+struct ToneTarget
+{
+    int scanner_id;
+    std::string serial_number;
+};
+
+/**
+* Outcome of a deployment to one scanner
+**/
+enum ToneOutcome
+{
+    kToneSkipped,       // Journal shows the same tone
+    kToneDeployed,
+    kToneFailed
+};
+
+/**
+* Deployment result of one scanner
+**/
+struct ToneResult
+{
+    ToneTarget target;
+    ToneOutcome outcome;
+    LONG status;        // Status of the command, -1 if the worker had no scanner interface
+};
+
+/**
+* Deployment progress, reported after each scanner
+**/
+struct ToneProgress
+{
+    size_t total;
+    size_t done;
+    size_t deployed;
+    size_t skipped;
+    size_t failed;
+};
+
+/**
+* Deploys a decode tone with UPDATE_DECODE_TONE (or removes it with ERASE_DECODE_TONE) on a set of
+* scanners, several scanners at a time.
+*
+* Scanners whose journal entry already has the content hash of the tone are skipped without a
+* command. The journal is updated and saved after each successful command, so a deployment that
+* is stopped or fails half way resumes where it left off. UPDATE_DECODE_TONE is not retry safe
+* (see CORESCANNER_OPCODE_TRAITS), so a failed scanner is reported and left to the next run.
+*
+* Each worker thread gets its own scanner interface from attach() (for COM, an interface from the
+* global interface table) and hands it back through detach(). The progress handler is called
+* after each scanner, from the worker threads, one call at a time.
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommand signature (e.g. MockToneHost)
+**/
+template <typename Scanner>
+class ToneDeployer
+{
+public:
+    typedef std::function<Scanner*(int worker)> AttachFunction;
+    typedef std::function<void(int worker, Scanner* scanner)> DetachFunction;
+    typedef std::function<void(const ToneProgress& progress, const ToneResult& result)> ProgressHandler;
+
+    /**
+    * Tone deployer constructor
+    * @param journal - Tone deployed to each scanner, updated as scanners are deployed
+    * @param worker_count - Scanners deployed at the same time
+    * @param attach - Called on each worker thread to get its scanner interface
+    * @param detach - Called on each worker thread when it is done (optional)
+    */
+    ToneDeployer(ToneJournal* journal, int worker_count, const AttachFunction& attach, const DetachFunction& detach = DetachFunction())
+        : journal_(journal), worker_count_(worker_count < 1 ? 1 : worker_count), attach_(attach), detach_(detach)
+    {
+    }
+
+    /**
+    * Set the handler called after each scanner
+    */
+    void SetProgressHandler(const ProgressHandler& handler) { progress_handler_ = handler; }
+
+    /**
+    * Deploy a tone
+    * @param targets - Scanners to deploy to
+    * @param tone_path - Normalized tone file, readable by the CoreScanner service
+    * @param tone_hash - ToneContentHash() of the tone file
+    * return value : One result per target
+    */
+    std::vector<ToneResult> Deploy(const std::vector<ToneTarget>& targets, const std::string& tone_path, unsigned long long tone_hash)
+    {
+        return Run(targets, tone_path, tone_hash);
+    }
+
+    /**
+    * Erase the decode tone, going back to the default tone. Erasing is always sent: a scanner
+    * missing from the journal may have a tone deployed by other means.
+    */
+    std::vector<ToneResult> Erase(const std::vector<ToneTarget>& targets)
+    {
+        return Run(targets, std::string(), 0);
+    }
+
+private:
+    std::vector<ToneResult> Run(const std::vector<ToneTarget>& targets, const std::string& tone_path, unsigned long long tone_hash)
+    {
+        std::vector<ToneResult> results(targets.size());
+        ToneProgress progress = { targets.size(), 0, 0, 0, 0 };
+        std::atomic<size_t> next_index(0);
+        std::vector<std::thread> workers;
+        int thread_count = (int)std::min<size_t>(worker_count_, targets.size());
+        for (int worker = 0; worker < thread_count; worker++)
+        {
+            workers.push_back(std::thread([&, worker]()
+            {
+                Scanner* scanner = attach_(worker);
+                size_t index;
+                while ((index = next_index++) < targets.size())
+                {
+                    ToneResult& result = results[index];
+                    result.target = targets[index];
+                    result.status = STATUS_SUCCESS;
+                    if (scanner == NULL)
+                    {
+                        result.outcome = kToneFailed;
+                        result.status = -1;
+                    }
+                    else if (tone_hash != 0 && journal_->ToneOf(result.target.serial_number) == tone_hash)
+                    {
+                        result.outcome = kToneSkipped;
+                    }
+                    else
+                    {
+                        CommandResult<NoResponse> command = (tone_hash != 0) ?
+                            Exec<UPDATE_DECODE_TONE>(scanner, result.target.scanner_id, tone_path) :
+                            Exec<ERASE_DECODE_TONE>(scanner, result.target.scanner_id);
+                        result.status = command.status;
+                        result.outcome = command.Succeeded() ? kToneDeployed : kToneFailed;
+                        if (command.Succeeded())
+                        {
+                            journal_->Record(result.target.serial_number, tone_hash);
+                            journal_->Save();
+                        }
+                    }
+                    Report(&progress, result);
+                }
+                if (detach_)
+                {
+                    detach_(worker, scanner);
+                }
+            }));
+        }
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            workers[i].join();
+        }
+        return results;
+    }
+
+    void Report(ToneProgress* progress, const ToneResult& result)
+    {
+        std::lock_guard<std::mutex> lock(progress_mutex_);
+        progress->done++;
+        progress->deployed += (result.outcome == kToneDeployed) ? 1 : 0;
+        progress->skipped += (result.outcome == kToneSkipped) ? 1 : 0;
+        progress->failed += (result.outcome == kToneFailed) ? 1 : 0;
+        if (progress_handler_)
+        {
+            progress_handler_(*progress, result);
+        }
+    }
+
+    ToneJournal* journal_;
+    int worker_count_;
+    AttachFunction attach_;
+    DetachFunction detach_;
+    ProgressHandler progress_handler_;
+    std::mutex progress_mutex_;
+};
@@ -0,0 +1,73 @@
+/*******************************************************************************************
+* @file tone_journal.cpp
+* @brief Definition of decode tone journal
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "tone_journal.h"
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+
+bool ToneJournal::Load(const string& path)
+{
+    lock_guard<mutex> lock(mutex_);
+    path_ = path;
+    tones_.clear();
+    ifstream file(path.c_str());
+    if (!file)
+    {
+        return true;
+    }
+    string serial_number;
+    unsigned long long tone_hash;
+    while (file >> serial_number >> hex >> tone_hash)
+    {
+        tones_[serial_number] = tone_hash;
+    }
+    return true;
+}
+
+bool ToneJournal::Save() const
+{
+    lock_guard<mutex> lock(mutex_);
+    if (path_.empty())
+    {
+        return false;
+    }
+    string temp_path = path_ + ".tmp";
+    {
+        ofstream file(temp_path.c_str(), ios::trunc);
+        for (map<string, unsigned long long>::const_iterator it = tones_.begin(); it != tones_.end(); ++it)
+        {
+            file << it->first << " " << hex << it->second << "\n";
+        }
+        if (!file)
+        {
+            return false;
+        }
+    }
+    remove(path_.c_str());
+    return rename(temp_path.c_str(), path_.c_str()) == 0;
+}
+
+unsigned long long ToneJournal::ToneOf(const string& serial_number) const
+{
+    lock_guard<mutex> lock(mutex_);
+    map<string, unsigned long long>::const_iterator it = tones_.find(serial_number);
+    return it == tones_.end() ? 0 : it->second;
+}
+
+void ToneJournal::Record(const string& serial_number, unsigned long long tone_hash)
+{
+    lock_guard<mutex> lock(mutex_);
+    if (tone_hash == 0)
+    {
+        tones_.erase(serial_number);
+        return;
+    }
+    tones_[serial_number] = tone_hash;
+}
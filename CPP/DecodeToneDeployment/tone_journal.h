@@ -0,0 +1,44 @@
+/*******************************************************************************************
+* @file tone_journal.h
+* @brief Journal of the decode tone deployed to each scanner
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+* Decode tone deployed to each scanner, by serial number. Decode tones cannot be read back from a
+* scanner, so the journal is what lets a deployment skip scanners that already have a tone. Thread safe.
+**/
+class ToneJournal
+{
+public:
+    /**
+    * Load the journal ("<serial number> <tone hash>" lines); a missing file is an empty journal
+    */
+    bool Load(const std::string& path);
+
+    /**
+    * Save the journal to the file it was loaded from
+    */
+    bool Save() const;
+
+    /**
+    * Hash of the tone last deployed to a scanner, 0 if none
+    */
+    unsigned long long ToneOf(const std::string& serial_number) const;
+
+    /**
+    * Record a deployed tone, tone hash 0 for an erased tone
+    */
+    void Record(const std::string& serial_number, unsigned long long tone_hash);
+
+private:
+    std::string path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, unsigned long long> tones_;
+};
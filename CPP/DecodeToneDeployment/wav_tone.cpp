@@ -0,0 +1,230 @@
+/*******************************************************************************************
+* @file wav_tone.cpp
+* @brief Definition of decode tone WAV validation and normalization
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "wav_tone.h"
+#include <cstring>
+
+using namespace std;
+
+static const size_t kChunkHeaderSize = 8;
+static const size_t kFmtChunkMinSize = 16;
+static const size_t kFmtExtensibleSize = 40;
+static const size_t kCanonicalHeaderSize = 44;
+
+static unsigned int ReadU16(const unsigned char* data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+static unsigned int ReadU32(const unsigned char* data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24);
+}
+
+static void AppendU16(vector<unsigned char>* wav, unsigned int value)
+{
+    wav->push_back((unsigned char)(value & 0xff));
+    wav->push_back((unsigned char)((value >> 8) & 0xff));
+}
+
+static void AppendU32(vector<unsigned char>* wav, unsigned int value)
+{
+    AppendU16(wav, value & 0xffff);
+    AppendU16(wav, value >> 16);
+}
+
+/**
+* Check the fmt chunk and fill the format part of info
+**/
+static bool ParseFmtChunk(const unsigned char* chunk, size_t chunk_size, const ToneRequirements& requirements, WavInfo* info, string* error)
+{
+    if (chunk_size < kFmtChunkMinSize)
+    {
+        *error = "fmt chunk too short";
+        return false;
+    }
+    info->format_tag = ReadU16(chunk);
+    info->channels = ReadU16(chunk + 2);
+    info->sample_rate = ReadU32(chunk + 4);
+    info->block_align = ReadU16(chunk + 12);
+    info->bits_per_sample = ReadU16(chunk + 14);
+    if (info->format_tag == WAV_FORMAT_EXTENSIBLE)
+    {
+        if (chunk_size < kFmtExtensibleSize)
+        {
+            *error = "extensible fmt chunk too short";
+            return false;
+        }
+        info->format_tag = ReadU16(chunk + 24);     // First two bytes of the sub format GUID
+    }
+
+    bool pcm = info->format_tag == WAV_FORMAT_PCM &&
+        (info->bits_per_sample == 8 || info->bits_per_sample == 16 || info->bits_per_sample == 24 || info->bits_per_sample == 32);
+    bool ieee_float = info->format_tag == WAV_FORMAT_IEEE_FLOAT && info->bits_per_sample == 32;
+    if (!pcm && !ieee_float)
+    {
+        *error = "unsupported format " + to_string(info->format_tag) + " with " + to_string(info->bits_per_sample) + " bits per sample";
+        return false;
+    }
+    if (info->channels < 1 || info->channels > requirements.max_channels)
+    {
+        *error = to_string(info->channels) + " channels, at most " + to_string(requirements.max_channels) + " supported";
+        return false;
+    }
+    if (info->sample_rate < requirements.min_sample_rate || info->sample_rate > requirements.max_sample_rate)
+    {
+        *error = "sample rate " + to_string(info->sample_rate) + " Hz outside " + to_string(requirements.min_sample_rate) +
+            " - " + to_string(requirements.max_sample_rate) + " Hz";
+        return false;
+    }
+    if (info->block_align != info->channels * info->bits_per_sample / 8)
+    {
+        *error = "block align " + to_string(info->block_align) + " does not match the format";
+        return false;
+    }
+    return true;
+}
+
+bool ParseWav(const unsigned char* data, size_t size, const ToneRequirements& requirements, WavInfo* info, string* error)
+{
+    memset(info, 0, sizeof(*info));
+    if (size < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0)
+    {
+        *error = "not a RIFF WAVE file";
+        return false;
+    }
+    size_t riff_end = (size_t)ReadU32(data + 4) + kChunkHeaderSize;
+    if (riff_end > size)
+    {
+        *error = "file truncated (RIFF size " + to_string(riff_end) + ", file size " + to_string(size) + ")";
+        return false;
+    }
+
+    bool fmt_found = false;
+    size_t data_size = 0;
+    size_t offset = 12;
+    while (offset + kChunkHeaderSize <= riff_end)
+    {
+        const unsigned char* chunk = data + offset;
+        size_t chunk_size = ReadU32(chunk + 4);
+        if (chunk_size > riff_end - offset - kChunkHeaderSize)
+        {
+            *error = "chunk " + string((const char*)chunk, 4) + " runs past the end of the file";
+            return false;
+        }
+        if (memcmp(chunk, "fmt ", 4) == 0)
+        {
+            if (!ParseFmtChunk(chunk + kChunkHeaderSize, chunk_size, requirements, info, error))
+            {
+                return false;
+            }
+            fmt_found = true;
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            if (!fmt_found)
+            {
+                *error = "data chunk before fmt chunk";
+                return false;
+            }
+            info->data_offset = offset + kChunkHeaderSize;
+            data_size = chunk_size;
+            break;
+        }
+        offset += kChunkHeaderSize + chunk_size + (chunk_size & 1);     // Chunks are word aligned
+    }
+
+    if (info->data_offset == 0)
+    {
+        *error = fmt_found ? "no data chunk" : "no fmt chunk";
+        return false;
+    }
+    info->frame_count = data_size / info->block_align;
+    if (info->frame_count == 0)
+    {
+        *error = "no samples";
+        return false;
+    }
+    if (info->DurationMs() > requirements.max_duration_ms)
+    {
+        *error = "tone lasts " + to_string(info->DurationMs()) + " ms, at most " + to_string(requirements.max_duration_ms) + " ms supported";
+        return false;
+    }
+    return true;
+}
+
+/**
+* One sample scaled to 16 bits
+**/
+static int Sample16(const unsigned char* sample, const WavInfo& info)
+{
+    if (info.format_tag == WAV_FORMAT_IEEE_FLOAT)
+    {
+        float value;
+        memcpy(&value, sample, sizeof(value));
+        if (!(value > -1.0f))
+        {
+            return -32768;      // Also NaN
+        }
+        return value >= 1.0f ? 32767 : (int)(value * 32767.0f);
+    }
+    switch (info.bits_per_sample)
+    {
+    case 8:
+        return ((int)sample[0] - 128) * 256;
+    case 16:
+        return (short)ReadU16(sample);
+    case 24:
+        return (short)ReadU16(sample + 1);
+    default:
+        return (short)ReadU16(sample + 2);
+    }
+}
+
+void NormalizeTone(const unsigned char* data, const WavInfo& info, vector<unsigned char>* wav)
+{
+    const unsigned int kBytesPerSample = 2;
+    unsigned int data_size = (unsigned int)info.frame_count * kBytesPerSample;
+    wav->clear();
+    wav->reserve(kCanonicalHeaderSize + data_size);
+
+    wav->insert(wav->end(), (const unsigned char*)"RIFF", (const unsigned char*)"RIFF" + 4);
+    AppendU32(wav, (unsigned int)(kCanonicalHeaderSize - kChunkHeaderSize) + data_size);
+    wav->insert(wav->end(), (const unsigned char*)"WAVEfmt ", (const unsigned char*)"WAVEfmt " + 8);
+    AppendU32(wav, (unsigned int)kFmtChunkMinSize);
+    AppendU16(wav, WAV_FORMAT_PCM);
+    AppendU16(wav, 1);
+    AppendU32(wav, info.sample_rate);
+    AppendU32(wav, info.sample_rate * kBytesPerSample);
+    AppendU16(wav, kBytesPerSample);
+    AppendU16(wav, 16);
+    wav->insert(wav->end(), (const unsigned char*)"data", (const unsigned char*)"data" + 4);
+    AppendU32(wav, data_size);
+
+    int bytes_per_sample = info.bits_per_sample / 8;
+    const unsigned char* frame = data + info.data_offset;
+    for (size_t i = 0; i < info.frame_count; i++, frame += info.block_align)
+    {
+        int sum = 0;
+        for (int channel = 0; channel < info.channels; channel++)
+        {
+            sum += Sample16(frame + channel * bytes_per_sample, info);
+        }
+        AppendU16(wav, (unsigned int)(sum / info.channels) & 0xffff);
+    }
+}
+
+unsigned long long ToneContentHash(const vector<unsigned char>& wav)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < wav.size(); i++)
+    {
+        hash = (hash ^ wav[i]) * 1099511628211ULL;
+    }
+    return hash == 0 ? 1 : hash;
+}
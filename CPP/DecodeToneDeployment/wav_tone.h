@@ -0,0 +1,74 @@
+/*******************************************************************************************
+* @file wav_tone.h
+* @brief Validation and normalization of decode tone WAV files
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//---- WAV format tags ------//
+#define WAV_FORMAT_PCM          0x0001
+#define WAV_FORMAT_IEEE_FLOAT   0x0003
+#define WAV_FORMAT_EXTENSIBLE   0xFFFE
+
+/**
+* Limits a decode tone must meet before it is deployed
+**/
+struct ToneRequirements
+{
+    int min_sample_rate;
+    int max_sample_rate;
+    int max_channels;       // Channels are mixed down to mono
+    int max_duration_ms;    // A good decode tone is short - long files are usually the wrong file
+
+    ToneRequirements() : min_sample_rate(8000), max_sample_rate(48000), max_channels(2), max_duration_ms(3000) {}
+};
+
+/**
+* Format and sample data location of a WAV file
+**/
+struct WavInfo
+{
+    int format_tag;         // WAV_FORMAT_PCM or WAV_FORMAT_IEEE_FLOAT (extensible files report their sub format)
+    int channels;
+    int sample_rate;
+    int bits_per_sample;
+    int block_align;        // Bytes per frame
+    size_t data_offset;     // Offset of the first sample in the file
+    size_t frame_count;
+
+    int DurationMs() const { return sample_rate == 0 ? 0 : (int)((uint64_t)frame_count * 1000 / sample_rate); }
+};
+
+/**
+* Validate a WAV file in place. Only the RIFF chunk headers and the fmt chunk are read; other
+* chunks (LIST, cover art ...) are skipped without touching their content and the samples are
+* not read, so a mapped file is validated without loading it.
+* @param data - WAV file content
+* @param size - WAV file size
+* @param requirements - Limits of a decode tone
+* @param info - Receives the format and sample data location
+* @param error - Receives a description of the first problem
+* return value : true if the file is a WAV file the tone can be made from
+*/
+bool ParseWav(const unsigned char* data, size_t size, const ToneRequirements& requirements, WavInfo* info, std::string* error);
+
+/**
+* Write the samples of a validated WAV file as a canonical 16 bit mono PCM WAV file with only
+* the fmt and data chunks. The same sound always gives the same bytes, whatever the
+* metadata, channel count or sample size of the source file.
+* @param data - WAV file content validated by ParseWav()
+* @param info - Format from ParseWav()
+* @param wav - Receives the normalized WAV file
+*/
+void NormalizeTone(const unsigned char* data, const WavInfo& info, std::vector<unsigned char>* wav);
+
+/**
+* Content hash of a normalized tone (FNV-1a), never 0
+*/
+unsigned long long ToneContentHash(const std::vector<unsigned char>& wav);
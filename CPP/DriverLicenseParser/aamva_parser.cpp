@@ -0,0 +1,291 @@
+/*******************************************************************************************
+* @file aamva_parser.cpp
+* @brief Definition of AAMVA driver license / ID card data parsing
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "aamva_parser.h"
+#include <cstring>
+
+using namespace std;
+
+static const char kLineFeed = 0x0A;
+static const char kRecordSeparator = 0x1E;
+static const char kCarriageReturn = 0x0D;
+static const size_t kDesignatorSize = 10;       // Type (2), offset (4), length (4)
+
+static inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static inline bool IsUpperAlnum(char c)
+{
+    return (c >= 'A' && c <= 'Z') || IsDigit(c);
+}
+
+/**
+* Value of count decimal digits, -1 if any is not a digit
+**/
+static int ReadNumber(const char* data, size_t count)
+{
+    int value = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!IsDigit(data[i]))
+        {
+            return -1;
+        }
+        value = value * 10 + (data[i] - '0');
+    }
+    return value;
+}
+
+/**
+* Find a 2 character subfile type that starts a subfile (type followed by an element id)
+* return value : Offset of the type, length if not found
+**/
+static size_t FindSubfile(const char* data, size_t length, size_t from, const char* type)
+{
+    for (size_t i = from; i + 5 <= length; i++)
+    {
+        if (data[i] == type[0] && data[i + 1] == type[1] && IsUpperAlnum(data[i + 2]) && IsUpperAlnum(data[i + 3]) && IsUpperAlnum(data[i + 4]))
+        {
+            return i;
+        }
+    }
+    return length;
+}
+
+/**
+* Stop parsing with an error
+**/
+static bool Fail(AamvaDocument* document, AamvaError error, size_t offset)
+{
+    document->error = error;
+    document->error_offset = offset;
+    return false;
+}
+
+/**
+* Split a subfile into elements - lines of "<id><value>" ended by LF, CR or CR LF
+**/
+static bool ParseElements(const char* data, size_t length, int subfile, AamvaDocument* document, size_t base_offset)
+{
+    size_t position = 0;
+    while (position < length)
+    {
+        size_t end = position;
+        while (end < length && data[end] != kLineFeed && data[end] != kCarriageReturn)
+        {
+            end++;
+        }
+        if (end - position >= 3 && IsUpperAlnum(data[position]) && IsUpperAlnum(data[position + 1]) && IsUpperAlnum(data[position + 2]))
+        {
+            if (document->element_count == AamvaDocument::kMaxElements)
+            {
+                return Fail(document, kAamvaTooManyElements, base_offset + position);
+            }
+            AamvaElement& element = document->elements[document->element_count++];
+            element.id.data = data + position;
+            element.id.length = 3;
+            element.value.data = data + position + 3;
+            element.value.length = end - position - 3;
+            while (element.value.length > 0 && element.value.data[element.value.length - 1] == ' ')
+            {
+                element.value.length--;
+            }
+            element.subfile = subfile;
+        }
+        position = end;
+        while (position < length && (data[position] == kLineFeed || data[position] == kCarriageReturn))
+        {
+            position++;
+        }
+    }
+    return true;
+}
+
+bool ParseAamva(const char* data, size_t length, AamvaDocument* document)
+{
+    document->file_type.data = data;
+    document->file_type.length = 0;
+    document->issuer_id = 0;
+    document->version = 0;
+    document->jurisdiction_version = 0;
+    document->subfile_count = 0;
+    document->element_count = 0;
+    document->error = kAamvaOk;
+    document->error_offset = 0;
+
+    // "@" LF RS CR, the LF is missing on some cards
+    size_t position = 0;
+    if (length < 4 || data[0] != '@')
+    {
+        return Fail(document, kAamvaNoHeader, 0);
+    }
+    position = 1;
+    if (data[position] == kLineFeed)
+    {
+        position++;
+    }
+    if (data[position] != kRecordSeparator || data[position + 1] != kCarriageReturn)
+    {
+        return Fail(document, kAamvaNoHeader, position);
+    }
+    position += 2;
+
+    // File type (5), IIN (6), version (2), [jurisdiction version (2) from version 2], entries (2)
+    if (length < position + 15)
+    {
+        return Fail(document, kAamvaBadHeader, position);
+    }
+    document->file_type.data = data + position;
+    document->file_type.length = 5;
+    document->issuer_id = ReadNumber(data + position + 5, 6);
+    document->version = ReadNumber(data + position + 11, 2);
+    position += 13;
+    if (document->issuer_id < 0 || document->version < 0)
+    {
+        return Fail(document, kAamvaBadHeader, position);
+    }
+    if (document->version >= 2)
+    {
+        document->jurisdiction_version = ReadNumber(data + position, 2);
+        position += 2;
+        if (length < position + 2 || document->jurisdiction_version < 0)
+        {
+            return Fail(document, kAamvaBadHeader, position);
+        }
+    }
+    int entries = ReadNumber(data + position, 2);
+    position += 2;
+    if (entries <= 0)
+    {
+        return Fail(document, kAamvaBadHeader, position);
+    }
+    if (entries > AamvaDocument::kMaxSubfiles)
+    {
+        entries = AamvaDocument::kMaxSubfiles;
+    }
+
+    size_t designators_end = position + entries * kDesignatorSize;
+    if (designators_end > length)
+    {
+        return Fail(document, kAamvaBadDesignator, position);
+    }
+    for (int entry = 0; entry < entries; entry++, position += kDesignatorSize)
+    {
+        const char* designator = data + position;
+        int offset = ReadNumber(designator + 2, 4);
+        int subfile_length = ReadNumber(designator + 6, 4);
+        if (!IsUpperAlnum(designator[0]) || !IsUpperAlnum(designator[1]) || offset < 0 || subfile_length < 0)
+        {
+            return Fail(document, kAamvaBadDesignator, position);
+        }
+
+        AamvaSubfile& subfile = document->subfiles[document->subfile_count];
+        subfile.type.data = designator;
+        subfile.type.length = 2;
+        subfile.offset_corrected = false;
+        size_t start = (size_t)offset;
+        if (start < designators_end || start + 2 > length || data[start] != designator[0] || data[start + 1] != designator[1])
+        {
+            start = FindSubfile(data, length, designators_end, designator);
+            if (start == length)
+            {
+                return Fail(document, kAamvaSubfileNotFound, position);
+            }
+            subfile.offset_corrected = true;
+        }
+
+        // The length counts the type and the closing CR; clamp it to the data
+        size_t end = start + (size_t)subfile_length;
+        if (end > length || subfile_length < 2)
+        {
+            end = length;
+        }
+        subfile.data.data = data + start + 2;
+        subfile.data.length = end - start - 2;
+        if (!ParseElements(subfile.data.data, subfile.data.length, document->subfile_count, document, start + 2))
+        {
+            document->subfile_count++;
+            return false;
+        }
+        document->subfile_count++;
+    }
+    return true;
+}
+
+bool AamvaSlice::Equals(const char* text) const
+{
+    return strlen(text) == length && memcmp(text, data, length) == 0;
+}
+
+string AamvaSlice::ToString() const
+{
+    return string(data, length);
+}
+
+const AamvaElement* AamvaDocument::Find(const char* id) const
+{
+    for (int i = 0; i < element_count; i++)
+    {
+        if (memcmp(elements[i].id.data, id, 3) == 0)
+        {
+            return &elements[i];
+        }
+    }
+    return NULL;
+}
+
+bool AamvaDocument::Date(const char* id, AamvaDate* date) const
+{
+    const AamvaElement* element = Find(id);
+    if (element == NULL || element->value.length < 8)
+    {
+        return false;
+    }
+    const AamvaElement* country = Find("DCG");
+    bool year_first = version == 1 || (country != NULL && country->value.Equals("CAN"));
+    const char* digits = element->value.data;
+    if (year_first)
+    {
+        date->year = ReadNumber(digits, 4);
+        date->month = ReadNumber(digits + 4, 2);
+        date->day = ReadNumber(digits + 6, 2);
+    }
+    else
+    {
+        date->month = ReadNumber(digits, 2);
+        date->day = ReadNumber(digits + 2, 2);
+        date->year = ReadNumber(digits + 4, 4);
+    }
+    return date->year > 0 && date->month >= 1 && date->month <= 12 && date->day >= 1 && date->day <= 31;
+}
+
+int AgeOn(const AamvaDate& birth, const AamvaDate& today)
+{
+    int age = today.year - birth.year;
+    if (today.month < birth.month || (today.month == birth.month && today.day < birth.day))
+    {
+        age--;
+    }
+    return age;
+}
+
+const char* AamvaErrorText(AamvaError error)
+{
+    switch (error)
+    {
+    case kAamvaOk:              return "valid";
+    case kAamvaNoHeader:        return "not AAMVA card data";
+    case kAamvaBadHeader:       return "invalid header";
+    case kAamvaBadDesignator:   return "invalid subfile designator";
+    case kAamvaSubfileNotFound: return "subfile not found";
+    case kAamvaTooManyElements: return "too many elements";
+    default:                    return "unknown error";
+    }
+}
@@ -0,0 +1,128 @@
+/*******************************************************************************************
+* @file aamva_parser.h
+* @brief Parsing of AAMVA driver license / ID card data (PDF417 on the back of the card)
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+* View of part of a label buffer (not null terminated, valid while the label is)
+**/
+struct AamvaSlice
+{
+    const char* data;
+    size_t length;
+
+    /**
+    * Compare slice content with a null terminated string
+    */
+    bool Equals(const char* text) const;
+
+    /**
+    * Copy slice content to a string
+    */
+    std::string ToString() const;
+};
+
+/**
+* Subfile (DL, ID or a jurisdiction specific Zx subfile)
+**/
+struct AamvaSubfile
+{
+    AamvaSlice type;
+    AamvaSlice data;            // Subfile content after the type
+    bool offset_corrected;      // Designator offset was wrong, the subfile was found by its type
+};
+
+/**
+* Data element (DAQ customer id, DBB date of birth ...)
+**/
+struct AamvaElement
+{
+    AamvaSlice id;
+    AamvaSlice value;           // Trailing spaces removed
+    int subfile;                // Index in AamvaDocument::subfiles
+};
+
+/**
+* Parse outcome
+**/
+enum AamvaError
+{
+    kAamvaOk,
+    kAamvaNoHeader,             // Not AAMVA data (also scanner side parsed output)
+    kAamvaBadHeader,
+    kAamvaBadDesignator,
+    kAamvaSubfileNotFound,
+    kAamvaTooManyElements
+};
+
+/**
+* Calendar date
+**/
+struct AamvaDate
+{
+    int year;
+    int month;
+    int day;
+};
+
+/**
+* Parsed card. Slices point into the label buffer - nothing is copied or allocated.
+**/
+struct AamvaDocument
+{
+    static const int kMaxSubfiles = 8;
+    static const int kMaxElements = 128;
+
+    AamvaSlice file_type;       // "ANSI " (or "AAMVA" on early cards)
+    int issuer_id;              // IIN of the issuing jurisdiction
+    int version;                // AAMVA version (1 - 2000 ... 10 - 2020)
+    int jurisdiction_version;
+    AamvaSubfile subfiles[kMaxSubfiles];
+    int subfile_count;
+    AamvaElement elements[kMaxElements];
+    int element_count;
+    AamvaError error;
+    size_t error_offset;
+
+    /**
+    * First element with an id, NULL if none
+    */
+    const AamvaElement* Find(const char* id) const;
+
+    /**
+    * Date element (DBB date of birth, DBA expiry, DBD issue), in the order of the card's
+    * version and country: CCYYMMDD for version 1 and Canadian cards, MMDDCCYY otherwise
+    * return value : false if the element is missing or not a valid date
+    */
+    bool Date(const char* id, AamvaDate* date) const;
+};
+
+/**
+* Parse AAMVA card data.
+*
+* Designator offsets are checked against the subfile type found there; when they are off (a
+* common card defect) the subfile is searched for by its type instead. Lengths are clamped to
+* the data, unknown bytes are skipped and element lines that are not "<3 character id><value>"
+* are ignored, so any input is parsed without reading outside it.
+* @param data - Label bytes
+* @param length - Label length
+* @param document - Receives the card, with the subfiles and elements parsed up to an error
+* return value : true if the header and all subfiles were parsed
+*/
+bool ParseAamva(const char* data, size_t length, AamvaDocument* document);
+
+/**
+* Age in whole years on a date
+*/
+int AgeOn(const AamvaDate& birth, const AamvaDate& today);
+
+/**
+* Text description of a parse error
+*/
+const char* AamvaErrorText(AamvaError error);
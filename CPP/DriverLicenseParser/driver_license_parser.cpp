@@ -0,0 +1,488 @@
+/*******************************************************************************************
+* @file driver_license_parser.cpp
+* @brief This file contains code snippet to parse driver licenses and verify age in process
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "scan_data.h"
+#include "aamva_parser.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for barcode events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_BARCODE);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Build AAMVA card data (version 9) with a DL subfile and a jurisdiction subfile
+* @param elements - DL subfile element lines ("DAQ...", "DBB...")
+* @param offset_error - Added to the DL subfile offset in its designator (simulates a card defect)
+*/
+string MakeCardData(const vector<string>& elements, int offset_error)
+{
+    string dl = "DL";
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+        dl += elements[i] + "\n";
+    }
+    dl += "\r";
+    string zv = "ZVZVA01\r";
+
+    const size_t kHeaderSize = 21;
+    const size_t kDesignatorSize = 10;
+    size_t dl_offset = kHeaderSize + 2 * kDesignatorSize;
+    char designators[64];
+    snprintf(designators, sizeof(designators), "DL%04d%04dZV%04d%04d", (int)dl_offset + offset_error, (int)dl.size(),
+        (int)(dl_offset + dl.size()), (int)zv.size());
+    return string("@\n\x1e\rANSI 636000090002") + designators + dl + zv;
+}
+
+/*
+* Card elements of a sample license holder born on a date (MMDDCCYY)
+*/
+vector<string> SampleElements(const string& date_of_birth)
+{
+    const char* elements[] = {
+        "DCAC", "DCBNONE", "DCDNONE", "DBA10192030", "DCSSAMPLE", "DACALEX", "DADJORDAN", "DBD10192022",
+        "DBB", "DBC3", "DAYBRO", "DAU070 IN", "DAG123 MAIN STREET", "DAIANYTOWN", "DAJVA", "DAK123450000  ",
+        "DAQT64235789", "DCF2424244747474786102204", "DCGUSA", "DDEN", "DDFN", "DDGN"
+    };
+    vector<string> lines(elements, elements + sizeof(elements) / sizeof(elements[0]));
+    lines[8] += date_of_birth;
+    return lines;
+}
+
+/*
+* Today's date
+*/
+AamvaDate Today()
+{
+    SYSTEMTIME now;
+    GetLocalTime(&now);
+    AamvaDate today = { now.wYear, now.wMonth, now.wDay };
+    return today;
+}
+
+/*
+* Print the fields an age verification lane uses
+*/
+void PrintCard(const AamvaDocument& document)
+{
+    if (document.error != kAamvaOk)
+    {
+        cout << "   Error at offset " << document.error_offset << " : " << AamvaErrorText(document.error) << endl;
+    }
+    cout << "   AAMVA version " << document.version << ", issuer " << document.issuer_id << ", " << document.subfile_count
+         << " subfiles" << (document.subfile_count > 0 && document.subfiles[0].offset_corrected ? " (offset corrected)" : "")
+         << ", " << document.element_count << " elements" << endl;
+    const AamvaElement* name = document.Find("DCS");
+    const AamvaElement* first_name = document.Find("DAC");
+    if (name != NULL && first_name != NULL)
+    {
+        cout << "   Name : " << first_name->value.ToString() << " " << name->value.ToString() << endl;
+    }
+    AamvaDate birth;
+    AamvaDate expiry;
+    AamvaDate today = Today();
+    if (document.Date("DBB", &birth))
+    {
+        cout << "   Age : " << AgeOn(birth, today) << (AgeOn(birth, today) >= 21 ? " (21 or over)" : " (UNDER 21)") << endl;
+    }
+    if (document.Date("DBA", &expiry))
+    {
+        bool expired = expiry.year < today.year || (expiry.year == today.year &&
+            (expiry.month < today.month || (expiry.month == today.month && expiry.day < today.day)));
+        cout << "   Expires : " << expiry.year << "-" << expiry.month << "-" << expiry.day << (expired ? " (EXPIRED)" : "") << endl;
+    }
+}
+
+/*
+* Parse sample cards, good and defective
+*/
+void RunSampleCards()
+{
+    struct Sample
+    {
+        const char* description;
+        string data;
+    };
+    Sample samples[] = {
+        { "Valid card", MakeCardData(SampleElements("04151990"), 0) },
+        { "Card under 21", MakeCardData(SampleElements("12312008"), 0) },
+        { "Wrong DL subfile offset", MakeCardData(SampleElements("04151990"), 3) },
+        { "Truncated card", MakeCardData(SampleElements("04151990"), 0).substr(0, 120) },
+        { "Not AAMVA data", "DL123456789" },
+    };
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++)
+    {
+        AamvaDocument document;
+        bool valid = ParseAamva(samples[i].data.data(), samples[i].data.size(), &document);
+        cout << " " << samples[i].description << " : " << (valid ? "valid" : "INVALID") << endl;
+        PrintCard(document);
+    }
+}
+
+/*
+* Check that every view of a parsed document lies inside the parsed buffer
+*/
+bool ViewsInside(const AamvaDocument& document, const char* data, size_t length)
+{
+    const char* end = data + length;
+    if (document.subfile_count < 0 || document.subfile_count > AamvaDocument::kMaxSubfiles ||
+        document.element_count < 0 || document.element_count > AamvaDocument::kMaxElements)
+    {
+        return false;
+    }
+    for (int i = 0; i < document.subfile_count; i++)
+    {
+        const AamvaSubfile& subfile = document.subfiles[i];
+        if (subfile.type.data < data || subfile.type.data + 2 > end || subfile.data.data < data || subfile.data.data + subfile.data.length > end)
+        {
+            return false;
+        }
+    }
+    for (int i = 0; i < document.element_count; i++)
+    {
+        const AamvaElement& element = document.elements[i];
+        if (element.id.data < data || element.value.data + element.value.length > end || element.subfile >= document.subfile_count)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+* Feed mutated card data (flipped, replaced, inserted and removed bytes, truncation) to the parser.
+* Each input is copied to a buffer of its exact size so reads past the end land outside it.
+*/
+void RunFuzz()
+{
+    const int kIterations = 200000;
+    const string card = MakeCardData(SampleElements("04151990"), 0);
+    const char kInteresting[] = { '@', '\n', '\x1e', '\r', '0', '9', 'D', 'L', 'Z', ' ', '\0', '\xff' };
+    mt19937 random(42);
+    int parsed = 0;
+    int rejected = 0;
+    int violations = 0;
+    for (int iteration = 0; iteration < kIterations; iteration++)
+    {
+        string input = card;
+        int mutations = 1 + (int)(random() % 8);
+        for (int m = 0; m < mutations && !input.empty(); m++)
+        {
+            size_t at = random() % input.size();
+            switch (random() % 5)
+            {
+            case 0: input[at] ^= (char)(1 << (random() % 8)); break;
+            case 1: input[at] = kInteresting[random() % sizeof(kInteresting)]; break;
+            case 2: input.insert(input.begin() + at, kInteresting[random() % sizeof(kInteresting)]); break;
+            case 3: input.erase(at, 1 + random() % 8); break;
+            default: input.resize(at); break;
+            }
+        }
+
+        vector<char> buffer(input.begin(), input.end());
+        AamvaDocument document;
+        bool valid = ParseAamva(buffer.empty() ? NULL : &buffer[0], buffer.size(), &document);
+        valid ? parsed++ : rejected++;
+        AamvaDate date;
+        document.Date("DBB", &date);
+        if (!ViewsInside(document, buffer.empty() ? NULL : &buffer[0], buffer.size()))
+        {
+            violations++;
+        }
+    }
+    cout << " " << kIterations << " mutated cards : " << parsed << " parsed, " << rejected << " rejected, "
+         << violations << " views outside the input" << endl;
+}
+
+/*
+* Measure parse and age computation time of one card
+*/
+void RunBenchmark()
+{
+    const int kRuns = 1000000;
+    const string card = MakeCardData(SampleElements("04151990"), 0);
+    AamvaDate today = Today();
+    long adults = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int run = 0; run < kRuns; run++)
+    {
+        AamvaDocument document;
+        AamvaDate birth;
+        if (ParseAamva(card.data(), card.size(), &document) && document.Date("DBB", &birth) && AgeOn(birth, today) >= 21)
+        {
+            adults++;
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << " " << card.size() << " byte card : " << seconds * 1e6 / kRuns << " us per card (parse and age), "
+         << adults << "/" << kRuns << " 21 or over" << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "AAMVA sample cards" << endl;
+    RunSampleCards();
+    cout << "AAMVA parser fuzzing" << endl;
+    RunFuzz();
+    cout << "AAMVA parser benchmark" << endl;
+    RunBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        scanner_event_sink->SetScanDataHandler([](short event_type, const string& scan_data_xml)
+        {
+            ScanData scan_data;
+            if (!ParseScanData(scan_data_xml, &scan_data))
+            {
+                return;
+            }
+            if (scan_data.symbology != ST_PDF417 && scan_data.symbology != ST_PARSED_DRIVER_LICENSE)
+            {
+                cout << "Barcode scanner ID:[" << scan_data.scanner_id << "] type " << scan_data.symbology << " : " << scan_data.label << endl;
+                return;
+            }
+            AamvaDocument document;
+            bool valid = ParseAamva(scan_data.label.data(), scan_data.label.size(), &document);
+            if (document.error == kAamvaNoHeader)
+            {
+                // Plain PDF417, or driver license parsing rules active on the scanner (output already formatted)
+                cout << "PDF417 scanner ID:[" << scan_data.scanner_id << "] (not AAMVA card data) : " << scan_data.label << endl;
+                return;
+            }
+            cout << "Driver license scanner ID:[" << scan_data.scanner_id << "] - " << (valid ? "valid" : "INVALID") << endl;
+            PrintCard(document);
+        });
+
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            WaitForInput("Scan the back of a driver license now, press any key to exit.");
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+        }
+        scanner_event_sink->SetScanDataHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,89 @@
+/*******************************************************************************************
+* @file scan_data.cpp
+* @brief Definition of CoreScanner ScanData event xml decoding
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "scan_data.h"
+#include "xml_reader.h"
+
+using namespace std;
+
+/**
+* Value of a hex digit, -1 if not a hex digit
+**/
+static int HexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void HexListToBytes(const char* hex_list, size_t length, string* bytes)
+{
+    bytes->reserve(bytes->size() + length / 5 + 1);
+    size_t i = 0;
+    while (i < length)
+    {
+        // Skip separators and the 0x prefix of each byte
+        if (hex_list[i] == '0' && i + 1 < length && (hex_list[i + 1] == 'x' || hex_list[i + 1] == 'X'))
+        {
+            i += 2;
+        }
+        int value = -1;
+        while (i < length && HexDigit(hex_list[i]) >= 0)
+        {
+            value = (value < 0 ? 0 : value * 16) + HexDigit(hex_list[i]);
+            i++;
+        }
+        if (value >= 0)
+        {
+            bytes->push_back((char)value);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+bool ParseScanData(const string& scan_data_xml, ScanData* scan_data)
+{
+    scan_data->scanner_id = 0;
+    scan_data->symbology = 0;
+    scan_data->label.clear();
+
+    bool has_label = false;
+    XmlReader reader(scan_data_xml);
+    XmlReader::Token token;
+    while ((token = reader.Next()) != XmlReader::kEndOfDocument)
+    {
+        if (token != XmlReader::kStartElement)
+        {
+            continue;
+        }
+
+        XmlSlice name = reader.Name();
+        XmlSlice text;
+        if (name.Equals("scannerID"))
+        {
+            reader.ReadElementText(&text);
+            scan_data->scanner_id = (int)text.ToLong();
+        }
+        else if (name.Equals("datatype"))
+        {
+            reader.ReadElementText(&text);
+            scan_data->symbology = (int)text.ToLong();
+        }
+        else if (name.Equals("datalabel"))
+        {
+            reader.ReadElementText(&text);
+            HexListToBytes(text.data, text.length, &scan_data->label);
+            has_label = true;
+        }
+    }
+    return has_label;
+}
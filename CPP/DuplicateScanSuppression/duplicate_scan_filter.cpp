@@ -0,0 +1,211 @@
+/*******************************************************************************************
+* @file duplicate_scan_filter.cpp
+* @brief Definition of duplicate decode suppression
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "duplicate_scan_filter.h"
+
+using namespace std;
+
+static const size_t kNotFound = (size_t)-1;
+
+DuplicateScanFilter::DuplicateScanFilter(const DuplicateFilterSettings& settings, Clock::time_point start)
+    : settings_(settings), start_(start), accepted_count_(0), suppressed_count_(0)
+{
+    if (settings_.tick_ms < 1)
+    {
+        settings_.tick_ms = 1;
+    }
+    size_t capacity = 16;
+    while (capacity < settings_.initial_capacity * 2)   // Tables are kept at most half full
+    {
+        capacity *= 2;
+    }
+    settings_.initial_capacity = capacity;
+    window_ticks_ = (settings_.window_ms + settings_.tick_ms - 1) / settings_.tick_ms;
+    for (int i = 0; i <= MAX_NUM_DEVICES; i++)
+    {
+        tables_[i] = NULL;
+    }
+}
+
+DuplicateScanFilter::~DuplicateScanFilter()
+{
+    for (int i = 0; i <= MAX_NUM_DEVICES; i++)
+    {
+        delete tables_[i];
+    }
+}
+
+bool DuplicateScanFilter::Accept(int scanner_id, int symbology, const char* label, size_t length, Clock::time_point now)
+{
+    if (scanner_id < 0 || scanner_id > MAX_NUM_DEVICES || window_ticks_ == 0)
+    {
+        accepted_count_++;
+        return true;
+    }
+    ScannerTable* table = tables_[scanner_id];
+    if (table == NULL)
+    {
+        table = tables_[scanner_id] = new ScannerTable();
+        table->slots.assign(settings_.initial_capacity, Slot());
+        table->used = 0;
+        table->wheel.resize((size_t)window_ticks_ + 1);
+        table->expired_tick = -1;
+    }
+
+    long long tick = chrono::duration_cast<chrono::milliseconds>(now - start_).count() / settings_.tick_ms;
+    Advance(table, tick);
+
+    unsigned long long key = Key(symbology, label, length);
+    if (Find(*table, key) != kNotFound)
+    {
+        suppressed_count_++;
+        return false;
+    }
+
+    long long expiry_tick = tick + window_ticks_;
+    Insert(table, key, expiry_tick);
+    table->wheel[(size_t)(expiry_tick % (long long)table->wheel.size())].push_back(key);
+    accepted_count_++;
+    return true;
+}
+
+void DuplicateScanFilter::Forget(int scanner_id)
+{
+    if (scanner_id >= 0 && scanner_id <= MAX_NUM_DEVICES)
+    {
+        delete tables_[scanner_id];
+        tables_[scanner_id] = NULL;
+    }
+}
+
+size_t DuplicateScanFilter::TrackedLabels() const
+{
+    size_t count = 0;
+    for (int i = 0; i <= MAX_NUM_DEVICES; i++)
+    {
+        count += tables_[i] ? tables_[i]->used : 0;
+    }
+    return count;
+}
+
+/**
+* 64 bit hash of symbology and label (FNV-1a with a final mix), never 0. The symbology's four
+* bytes are hashed ahead of the label, so they never share a step with a label byte.
+**/
+unsigned long long DuplicateScanFilter::Key(int symbology, const char* label, size_t length)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        hash = (hash ^ (((unsigned int)symbology >> shift) & 0xFF)) * 1099511628211ULL;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ (unsigned char)label[i]) * 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash == 0 ? 1 : hash;
+}
+
+/**
+* Remove the labels that expired up to a tick, emptying one wheel bucket per tick passed
+**/
+void DuplicateScanFilter::Advance(ScannerTable* table, long long tick)
+{
+    long long wheel_size = (long long)table->wheel.size();
+    long long first = table->expired_tick + 1;
+    if (tick - first >= wheel_size)
+    {
+        first = tick - wheel_size + 1;      // Idle for a whole turn - every bucket is visited once
+    }
+    for (long long t = first; t <= tick; t++)
+    {
+        vector<unsigned long long>& bucket = table->wheel[(size_t)(t % wheel_size)];
+        for (size_t i = 0; i < bucket.size(); i++)
+        {
+            size_t index = Find(*table, bucket[i]);
+            if (index != kNotFound && table->slots[index].expiry_tick <= tick)
+            {
+                Erase(table, index);
+            }
+        }
+        bucket.clear();
+    }
+    if (tick > table->expired_tick)
+    {
+        table->expired_tick = tick;
+    }
+}
+
+size_t DuplicateScanFilter::Find(const ScannerTable& table, unsigned long long key) const
+{
+    size_t mask = table.slots.size() - 1;
+    for (size_t index = (size_t)key & mask; table.slots[index].key != 0; index = (index + 1) & mask)
+    {
+        if (table.slots[index].key == key)
+        {
+            return index;
+        }
+    }
+    return kNotFound;
+}
+
+void DuplicateScanFilter::Insert(ScannerTable* table, unsigned long long key, long long expiry_tick)
+{
+    if ((table->used + 1) * 2 > table->slots.size())
+    {
+        Grow(table);
+    }
+    size_t mask = table->slots.size() - 1;
+    size_t index = (size_t)key & mask;
+    while (table->slots[index].key != 0)
+    {
+        index = (index + 1) & mask;
+    }
+    table->slots[index].key = key;
+    table->slots[index].expiry_tick = expiry_tick;
+    table->used++;
+}
+
+/**
+* Backward shift deletion - move later entries of the probe run into the hole so lookups
+* never need tombstones
+**/
+void DuplicateScanFilter::Erase(ScannerTable* table, size_t index)
+{
+    size_t mask = table->slots.size() - 1;
+    size_t hole = index;
+    for (size_t next = (hole + 1) & mask; table->slots[next].key != 0; next = (next + 1) & mask)
+    {
+        size_t home = (size_t)table->slots[next].key & mask;
+        // Move the entry unless its home lies cyclically in (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            table->slots[hole] = table->slots[next];
+            hole = next;
+        }
+    }
+    table->slots[hole].key = 0;
+    table->used--;
+}
+
+void DuplicateScanFilter::Grow(ScannerTable* table)
+{
+    vector<Slot> old_slots(table->slots.size() * 2, Slot());
+    old_slots.swap(table->slots);
+    table->used = 0;
+    for (size_t i = 0; i < old_slots.size(); i++)
+    {
+        if (old_slots[i].key != 0)
+        {
+            Insert(table, old_slots[i].key, old_slots[i].expiry_tick);
+        }
+    }
+}
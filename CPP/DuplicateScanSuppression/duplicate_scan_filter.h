@@ -0,0 +1,120 @@
+/*******************************************************************************************
+* @file duplicate_scan_filter.h
+* @brief Suppression of the same label decoded again by a scanner within a time window
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "common_defs.h"
+#include "scan_data.h"
+
+/**
+* Duplicate filter settings
+**/
+struct DuplicateFilterSettings
+{
+    int window_ms;              // A label decoded again within this time of its first decode is a duplicate
+    int tick_ms;                // Expiry granularity - a window ends up to one tick late
+    size_t initial_capacity;    // Labels tracked per scanner before its table grows
+
+    DuplicateFilterSettings()
+        : window_ms(500), tick_ms(10), initial_capacity(64)
+    {
+    }
+};
+
+/**
+* Drops decodes of a (symbology, label) pair that the same scanner already decoded within the
+* last window_ms, so consumers behind it see a re-presented item once.
+*
+* Each scanner has an open addressing table (linear probing) of 16 byte slots holding a 64 bit
+* hash of the symbology and label and the tick the entry expires; labels themselves are not
+* stored. Expiry is driven by a timing wheel of window_ms / tick_ms + 1 buckets: an accepted label
+* is queued in the bucket of its expiry tick, and advancing the clock empties only the buckets
+* of the ticks that passed, so the cost of expiry does not depend on how many labels are tracked.
+* Removal uses backward shift deletion, leaving no tombstones behind.
+*
+* The window is fixed from the accepted decode: holding an item under the scanner for longer than
+* the window counts it again. All calls are expected on the event (message loop) thread.
+**/
+class DuplicateScanFilter
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+    * Duplicate filter constructor
+    * @param settings - Window and table settings
+    * @param start - Time the ticks count from
+    */
+    explicit DuplicateScanFilter(const DuplicateFilterSettings& settings, Clock::time_point start = Clock::now());
+    ~DuplicateScanFilter();
+
+    /**
+    * Check a decode
+    * @param scanner_id - Scanner that decoded the label
+    * @param symbology - ST_xxx data type
+    * @param label - Label bytes
+    * @param length - Label length
+    * @param now - Time of the decode (not earlier than the previous call)
+    * return value : true to deliver the decode, false for a duplicate
+    */
+    bool Accept(int scanner_id, int symbology, const char* label, size_t length, Clock::time_point now);
+
+    /**
+    * Check a decoded ScanData event
+    */
+    bool Accept(const ScanData& scan_data, Clock::time_point now)
+    {
+        return Accept(scan_data.scanner_id, scan_data.symbology, scan_data.label.data(), scan_data.label.size(), now);
+    }
+
+    /**
+    * Forget the labels of a scanner (detached or reset)
+    */
+    void Forget(int scanner_id);
+
+    /**
+    * Labels currently tracked across all scanners
+    */
+    size_t TrackedLabels() const;
+
+    long AcceptedCount() const { return accepted_count_; }
+    long SuppressedCount() const { return suppressed_count_; }
+
+private:
+    DuplicateScanFilter(const DuplicateScanFilter&);
+    DuplicateScanFilter& operator=(const DuplicateScanFilter&);
+
+    struct Slot
+    {
+        unsigned long long key;     // 0 - empty
+        long long expiry_tick;
+    };
+
+    struct ScannerTable
+    {
+        std::vector<Slot> slots;                            // Power of two size
+        size_t used;
+        std::vector<std::vector<unsigned long long> > wheel;   // Keys by expiry tick % wheel size
+        long long expired_tick;                             // Buckets up to this tick are empty
+    };
+
+    static unsigned long long Key(int symbology, const char* label, size_t length);
+    void Advance(ScannerTable* table, long long tick);
+    size_t Find(const ScannerTable& table, unsigned long long key) const;
+    void Insert(ScannerTable* table, unsigned long long key, long long expiry_tick);
+    void Erase(ScannerTable* table, size_t index);
+    void Grow(ScannerTable* table);
+
+    DuplicateFilterSettings settings_;
+    Clock::time_point start_;
+    long long window_ticks_;
+    ScannerTable* tables_[MAX_NUM_DEVICES + 1];     // By scanner id, created on first decode
+    long accepted_count_;
+    long suppressed_count_;
+};
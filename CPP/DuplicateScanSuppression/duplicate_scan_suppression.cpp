@@ -0,0 +1,422 @@
+/*******************************************************************************************
+* @file duplicate_scan_suppression.cpp
+* @brief This file contains code snippet to suppress duplicate decodes before they reach consumers
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "scan_data.h"
+#include "duplicate_scan_filter.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for barcode events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_BARCODE);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* EAN-13 label with a valid check digit
+*/
+string MakeEan13(long long item)
+{
+    string label = to_string(400000000000LL + item % 100000000000LL);
+    int sum = 0;
+    for (int i = 0; i < 12; i++)
+    {
+        sum += (label[i] - '0') * ((i % 2) ? 3 : 1);
+    }
+    label.push_back((char)('0' + (10 - sum % 10) % 10));
+    return label;
+}
+
+/*
+* Show which decodes reach the consumers in a few lane situations
+*/
+void RunSyntheticScans()
+{
+    DuplicateFilterSettings settings;
+    DuplicateScanFilter::Clock::time_point start = DuplicateScanFilter::Clock::now();
+    DuplicateScanFilter filter(settings, start);
+    struct Decode
+    {
+        const char* description;
+        int scanner_id;
+        int symbology;
+        int at_ms;
+    };
+    const Decode decodes[] = {
+        { "Item scanned", 1, ST_EAN13, 0 },
+        { "Same item decoded again 40 ms later", 1, ST_EAN13, 40 },
+        { "Same item re-presented 300 ms later", 1, ST_EAN13, 300 },
+        { "Same label on the next lane", 2, ST_EAN13, 320 },
+        { "Same digits as another symbology", 1, ST_CODE_128, 350 },
+        { "Second item of the same kind 900 ms later", 1, ST_EAN13, 900 },
+    };
+    string label = MakeEan13(12345);
+    for (size_t i = 0; i < sizeof(decodes) / sizeof(decodes[0]); i++)
+    {
+        bool accepted = filter.Accept(decodes[i].scanner_id, decodes[i].symbology, label.data(), label.size(),
+            start + chrono::milliseconds(decodes[i].at_ms));
+        cout << " " << decodes[i].description << " : " << (accepted ? "delivered" : "suppressed") << endl;
+    }
+}
+
+/*
+* Reference filter for the benchmark - a map of every label with the tick it expires
+*/
+class MapDuplicateFilter
+{
+public:
+    MapDuplicateFilter(const DuplicateFilterSettings& settings, DuplicateScanFilter::Clock::time_point start)
+        : start_(start), tick_ms_(settings.tick_ms), window_ticks_((settings.window_ms + settings.tick_ms - 1) / settings.tick_ms)
+    {
+    }
+
+    bool Accept(const ScanData& scan_data, DuplicateScanFilter::Clock::time_point now)
+    {
+        long long tick = chrono::duration_cast<chrono::milliseconds>(now - start_).count() / tick_ms_;
+        long long& expiry_tick = expiry_ticks_[make_pair(make_pair(scan_data.scanner_id, scan_data.symbology), scan_data.label)];
+        if (expiry_tick > tick)
+        {
+            return false;
+        }
+        expiry_tick = tick + window_ticks_;
+        return true;
+    }
+
+private:
+    DuplicateScanFilter::Clock::time_point start_;
+    long long tick_ms_;
+    long long window_ticks_;
+    map<pair<pair<int, int>, string>, long long> expiry_ticks_;
+};
+
+/*
+* Filter a decode stream of 100000 decodes per second from 16 lanes, one in ten decodes repeating
+* a label its lane decoded shortly before
+*/
+void RunBenchmark()
+{
+    const int kDecodes = 1000000;
+    const int kDecodesPerSecond = 100000;
+    const int kScanners = 16;
+
+    DuplicateFilterSettings settings;
+    DuplicateScanFilter::Clock::time_point start = DuplicateScanFilter::Clock::now();
+    mt19937 random(2026);
+    vector<ScanData> decodes(kDecodes);
+    vector<DuplicateScanFilter::Clock::time_point> times(kDecodes);
+    vector<vector<string> > recent(kScanners + 1);
+    for (int i = 0; i < kDecodes; i++)
+    {
+        ScanData& scan_data = decodes[i];
+        scan_data.scanner_id = 1 + (int)(random() % kScanners);
+        scan_data.symbology = (random() % 8 == 0) ? ST_CODE_128 : ST_EAN13;
+        vector<string>& lane_recent = recent[scan_data.scanner_id];
+        if (!lane_recent.empty() && random() % 10 == 0)
+        {
+            scan_data.label = lane_recent[random() % lane_recent.size()];
+        }
+        else
+        {
+            scan_data.label = MakeEan13(random());
+            lane_recent.push_back(scan_data.label);
+            if (lane_recent.size() > 64)
+            {
+                lane_recent.erase(lane_recent.begin());
+            }
+        }
+        times[i] = start + chrono::microseconds((long long)i * 1000000 / kDecodesPerSecond);
+    }
+
+    DuplicateScanFilter filter(settings, start);
+    long delivered = 0;
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    for (int i = 0; i < kDecodes; i++)
+    {
+        delivered += filter.Accept(decodes[i], times[i]) ? 1 : 0;
+    }
+    double filter_seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    MapDuplicateFilter reference(settings, start);
+    long reference_delivered = 0;
+    begin = chrono::steady_clock::now();
+    for (int i = 0; i < kDecodes; i++)
+    {
+        reference_delivered += reference.Accept(decodes[i], times[i]) ? 1 : 0;
+    }
+    double reference_seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    cout << " " << kDecodes << " decodes (" << kDecodes / kDecodesPerSecond << " s at " << kDecodesPerSecond << "/s), "
+         << kDecodes - delivered << " duplicates suppressed, " << filter.TrackedLabels() << " labels tracked at the end" << endl;
+    cout << " Duplicate filter : " << filter_seconds * 1e9 / kDecodes << " ns per decode, "
+         << filter_seconds * kDecodesPerSecond * 100 / kDecodes << "% of one core at " << kDecodesPerSecond << " decodes/s" << endl;
+    cout << " Map of every label : " << reference_seconds * 1e9 / kDecodes << " ns per decode" << endl;
+    cout << " Same decodes delivered : " << (delivered == reference_delivered ? "yes" : "NO") << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+* Usage : duplicate_scan_suppression [window in ms]
+*/
+int main(int argc, char* argv[])
+{
+    cout << "Duplicate suppression with synthetic decodes" << endl;
+    RunSyntheticScans();
+    cout << "Duplicate suppression benchmark" << endl;
+    RunBenchmark();
+    cout << " " << endl;
+
+    DuplicateFilterSettings settings;
+    if (argc > 1)
+    {
+        settings.window_ms = atoi(argv[1]);
+    }
+
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        DuplicateScanFilter filter(settings);
+        scanner_event_sink->SetScanDataHandler([&filter](short event_type, const string& scan_data_xml)
+        {
+            ScanData scan_data;
+            if (!ParseScanData(scan_data_xml, &scan_data))
+            {
+                return;
+            }
+            if (!filter.Accept(scan_data, DuplicateScanFilter::Clock::now()))
+            {
+                cout << "Duplicate suppressed scanner ID:[" << scan_data.scanner_id << "] : " << scan_data.label << endl;
+                return;
+            }
+            // Consumers (POS) only see decodes that passed the filter
+            cout << "Barcode scanner ID:[" << scan_data.scanner_id << "] type " << scan_data.symbology << " : " << scan_data.label << endl;
+        });
+
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            WaitForInput("Scan barcodes now (duplicates within " + to_string(settings.window_ms) + " ms are suppressed), press any key to exit.");
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+            cout << "Decodes delivered : " << filter.AcceptedCount() << ", duplicates suppressed : " << filter.SuppressedCount() << endl;
+        }
+        scanner_event_sink->SetScanDataHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
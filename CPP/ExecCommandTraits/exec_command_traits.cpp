@@ -0,0 +1,330 @@
+/*******************************************************************************************
+* @file exec_command_traits.cpp
+* @brief This file contains code snippet to execute CoreScanner commands through the compile time opcode traits
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+SHORT num_scanners = 0;
+SAFEARRAY* get_scanners_array = NULL;
+SHORT* scanner_id_array;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Get connected scanners
+* return value : GetScanners success/fail status
+*/
+bool GetScanners()
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    HRESULT hr = S_FALSE;
+    LONG status = -1;
+    BSTR out_xml;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    // Get connected scanners
+    hr = scanner_interface->GetScanners(
+        &num_scanners,         // Returns number of scanners discovered 
+        get_scanners_array,    // Returns array of connected scanner ids 
+        &out_xml,              // Output xml containing discovered scanners information 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        cout << "CoreScanner GetScanners()- Success" << endl;
+        cout << " Total Scanners : " << num_scanners << endl;
+        string scanner_id_list = "";
+        HRESULT hr = SafeArrayAccessData(get_scanners_array, (void**)&scanner_id_array);
+        for (int n = 0; n < num_scanners; n++)
+        {
+            scanner_id_list = " " + to_string(scanner_id_array[n]);
+            if (n != num_scanners - 1)
+            {
+                scanner_id_list += ",";
+            }
+        }
+        cout << " Scanner IDs :" << scanner_id_list << endl;
+        wstring out_str(out_xml, SysStringLen(out_xml));
+        string  get_scanners_output_xml(out_str.begin(), out_str.end());
+        cout << " Out xml : " << endl;
+        cout << get_scanners_output_xml << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner GetScanner() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Get CoreScanner version using the opcode traits front end
+* return value : GetVersion success/fail status
+*/
+bool GetVersion()
+{
+    // GET_VERSION takes no scanner id and no cmdArgs
+    CommandResult<StringResponse> result = Exec<GET_VERSION>(scanner_interface);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner GetVersion() - Success. Version : " << result.response.value << endl;
+        return true;
+    }
+    cout << "CoreScanner GetVersion() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Get scanner attribute values using the opcode traits front end
+* @param scanner_id Scanner id of specific scanner to send command
+* @param attribute_ids Attribute ids to query
+* return value : RSM_ATTR_GET success/fail status
+*/
+bool GetAttributes(int scanner_id, const vector<int>& attribute_ids)
+{
+    // RSM_ATTR_GET takes a scanner id and an attribute id list, response is parsed to Attribute values
+    CommandResult<AttributeResponse> result = Exec<RSM_ATTR_GET>(scanner_interface, scanner_id, attribute_ids);
+    if (!result.Succeeded())
+    {
+        cout << "CoreScanner RSM_ATTR_GET scanner ID:[" << scanner_id << "] - Failed. Error Code : " << result.status << endl;
+        return false;
+    }
+
+    cout << "CoreScanner RSM_ATTR_GET scanner ID:[" << scanner_id << "] - Success" << endl;
+    for (size_t i = 0; i < result.response.attributes.size(); i++)
+    {
+        const Attribute& attribute = result.response.attributes[i];
+        cout << " Attribute " << attribute.id << " (" << attribute.datatype << ") : " << attribute.value << endl;
+    }
+    return true;
+}
+
+/*
+* Trigger scanner SetAction (beep/led) using the opcode traits front end
+* @param scanner_id Scanner id of specific scanner to send command
+* @param action_code SetAction (beeper/led pattern) code
+* return value : SetAction success/fail status
+*/
+bool SetAction(int scanner_id, int action_code)
+{
+    // SET_ACTION takes a scanner id and one <arg-int>. A wrong argument shape, e.g.
+    // Exec<SET_ACTION>(scanner_interface, scanner_id) or Exec<SET_ACTION>(scanner_interface, scanner_id, string("1")),
+    // does not compile.
+    CommandResult<NoResponse> result = Exec<SET_ACTION>(scanner_interface, scanner_id, action_code);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner Scanner SetAction(" << action_code << ") scanner ID:[" << scanner_id << "] - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner Scanner SetAction(" << action_code << ") scanner ID:[" << scanner_id << "] - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    const int kAttributeModelNumber = 533;
+    const int kAttributeSerialNumber = 534;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (Open())
+    {
+        GetVersion();
+        cout << " " << endl;
+
+        if (GetScanners())
+        {
+            if (num_scanners > 0)
+            {
+                // Select first scanner found
+                int scanner_id = scanner_id_array[0];
+
+                // Query model and serial number
+                vector<int> attribute_ids;
+                attribute_ids.push_back(kAttributeModelNumber);
+                attribute_ids.push_back(kAttributeSerialNumber);
+                GetAttributes(scanner_id, attribute_ids);
+                cout << " " << endl;
+
+                // Beep scanner (one short high)
+                SetAction(scanner_id, ONESHORTHIGH);
+            }
+            else
+            {
+                cout << "No scanners found." << endl;
+            }
+        }
+
+        if (get_scanners_array != NULL)
+        {
+            SafeArrayUnaccessData(get_scanners_array);
+            SafeArrayDestroy(get_scanners_array);
+        }
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
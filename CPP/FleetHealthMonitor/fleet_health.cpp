@@ -0,0 +1,228 @@
+/*******************************************************************************************
+* @file fleet_health.cpp
+* @brief Definition of fleet health table
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "fleet_health.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+static_assert(sizeof(ScannerHealth) == 64, "ScannerHealth should fill one cache line");
+
+/**
+* FNV-1a hash of a slice
+**/
+static unsigned long long HashSlice(const XmlSlice& slice)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < slice.length; i++)
+    {
+        hash = (hash ^ (unsigned char)slice.data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+* Store a value in a row field
+* return value : true if the value changed
+**/
+template <typename T>
+static bool Store(T* field, long long value)
+{
+    if (*field == (T)value)
+    {
+        return false;
+    }
+    *field = (T)value;
+    return true;
+}
+
+FleetHealth::FleetHealth()
+    : rows_(MAX_NUM_DEVICES + 1), serial_numbers_(MAX_NUM_DEVICES + 1), scanner_count_(0)
+{
+    memset(&rows_[0], 0, rows_.size() * sizeof(ScannerHealth));
+    config_names_.push_back(string());
+    config_ids_[string()] = 0;
+}
+
+int FleetHealth::Apply(const RmdEvent& event, long long now_ms)
+{
+    ScannerHealth* row = Row(event.scanner_id, event.serial_number);
+    if (row == NULL)
+    {
+        return 0;
+    }
+
+    int changed = 0;
+    for (size_t i = 0; i < event.deltas.size(); i++)
+    {
+        const RmdDelta& delta = event.deltas[i];
+        unsigned int field_bit = 1u << delta.field;
+        bool first_report = (row->reported_fields & field_bit) == 0;
+        row->reported_fields |= field_bit;
+
+        bool value_changed = false;
+        switch (delta.field)
+        {
+        case kRmdBatteryLevel:
+            value_changed = Store(&row->battery_level, delta.value);
+            break;
+        case kRmdBatteryHealth:
+            value_changed = Store(&row->battery_health, delta.value);
+            break;
+        case kRmdChargeStatus:
+            value_changed = Store(&row->charge_status, delta.value);
+            break;
+        case kRmdBatteryTemperature:
+            value_changed = Store(&row->battery_temperature, delta.value);
+            break;
+        case kRmdHealthStatus:
+            value_changed = Store(&row->health_status, delta.value);
+            break;
+        case kRmdFaultCode:
+            value_changed = Store(&row->fault_code, delta.value);
+            break;
+        case kRmdConfigName:
+            value_changed = Store(&row->config_id, InternConfig(delta.text));
+            if (value_changed)
+            {
+                row->attribute_changes = 0;
+            }
+            break;
+        case kRmdAttributeChanged:
+            row->attribute_changes++;
+            value_changed = true;
+            break;
+        case kRmdFirmwareStage:
+            value_changed = Store(&row->firmware_stage, delta.value);
+            if (delta.value == kFirmwareSessionStarted)
+            {
+                row->firmware_percent = 0;
+                row->firmware_status = 0;
+            }
+            break;
+        case kRmdFirmwareTotal:
+            value_changed = Store(&row->firmware_total, delta.value);
+            break;
+        case kRmdFirmwareProgress:
+            if (row->firmware_total != 0 && delta.value >= 0)
+            {
+                value_changed = Store(&row->firmware_percent, min<long long>(100, (long long)delta.value * 100 / row->firmware_total));
+            }
+            break;
+        case kRmdFirmwareStatus:
+            value_changed = Store(&row->firmware_status, delta.value);
+            break;
+        default:
+            break;
+        }
+        if (value_changed || first_report)
+        {
+            changed++;
+        }
+    }
+
+    row->event_count++;
+    if (changed > 0)
+    {
+        row->change_count++;
+    }
+    row->last_event_ms = now_ms;
+    return changed;
+}
+
+void FleetHealth::Forget(int scanner_id)
+{
+    if (scanner_id < 1 || scanner_id > MAX_NUM_DEVICES || rows_[scanner_id].scanner_id == 0)
+    {
+        return;
+    }
+    memset(&rows_[scanner_id], 0, sizeof(ScannerHealth));
+    serial_numbers_[scanner_id].clear();
+    scanner_count_--;
+}
+
+const ScannerHealth* FleetHealth::Find(int scanner_id) const
+{
+    if (scanner_id < 1 || scanner_id > MAX_NUM_DEVICES || rows_[scanner_id].scanner_id == 0)
+    {
+        return NULL;
+    }
+    return &rows_[scanner_id];
+}
+
+void FleetHealth::LowBattery(int threshold_percent, vector<int>* scanner_ids) const
+{
+    scanner_ids->clear();
+    for (size_t i = 1; i < rows_.size(); i++)
+    {
+        const ScannerHealth& row = rows_[i];
+        if (row.scanner_id != 0 && (row.reported_fields & (1u << kRmdBatteryLevel)) && row.battery_level < threshold_percent)
+        {
+            scanner_ids->push_back(row.scanner_id);
+        }
+    }
+}
+
+void FleetHealth::Unhealthy(vector<int>* scanner_ids) const
+{
+    scanner_ids->clear();
+    for (size_t i = 1; i < rows_.size(); i++)
+    {
+        const ScannerHealth& row = rows_[i];
+        if (row.scanner_id != 0 && (row.health_status == kHealthWarning || row.health_status == kHealthFault || row.firmware_status != 0))
+        {
+            scanner_ids->push_back(row.scanner_id);
+        }
+    }
+}
+
+/**
+* Row of a scanner, reset when a different scanner (serial number) shows up under the same id
+**/
+ScannerHealth* FleetHealth::Row(int scanner_id, const XmlSlice& serial_number)
+{
+    if (scanner_id < 1 || scanner_id > MAX_NUM_DEVICES)
+    {
+        return NULL;
+    }
+
+    ScannerHealth* row = &rows_[scanner_id];
+    unsigned long long serial_hash = serial_number.length > 0 ? HashSlice(serial_number) : row->serial_hash;
+    if (row->scanner_id != 0 && row->serial_hash == serial_hash)
+    {
+        return row;
+    }
+
+    if (row->scanner_id == 0)
+    {
+        scanner_count_++;
+    }
+    memset(row, 0, sizeof(ScannerHealth));
+    row->scanner_id = scanner_id;
+    row->serial_hash = serial_hash;
+    serial_numbers_[scanner_id] = serial_number.ToString();
+    return row;
+}
+
+/**
+* Id of a configuration name, added on first use
+**/
+unsigned int FleetHealth::InternConfig(const XmlSlice& name)
+{
+    string config_name = name.ToString();
+    unordered_map<string, unsigned int>::const_iterator it = config_ids_.find(config_name);
+    if (it != config_ids_.end())
+    {
+        return it->second;
+    }
+    unsigned int config_id = (unsigned int)config_names_.size();
+    config_names_.push_back(config_name);
+    config_ids_[config_name] = config_id;
+    return config_id;
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************************
+* @file fleet_health.h
+* @brief Latest battery, health and configuration state of every scanner, fed by RMD events
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "common_defs.h"
+#include "rmd_event.h"
+
+/**
+* Health row of one scanner - fixed size, no pointers, 64 bytes (one cache line)
+**/
+struct ScannerHealth
+{
+    int scanner_id;                 // 0 for a free row
+    unsigned int reported_fields;   // Bit per RmdField seen for this scanner
+    unsigned char battery_level;
+    unsigned char battery_health;
+    unsigned char charge_status;    // RmdChargeStatus
+    unsigned char health_status;    // RmdHealthStatus
+    short battery_temperature;
+    unsigned char firmware_stage;   // RmdFirmwareStage
+    unsigned char firmware_percent; // Download progress of the firmware update
+    long long fault_code;
+    unsigned int config_id;         // Index for FleetHealth::ConfigName()
+    unsigned int attribute_changes; // Attributes changed since the configuration was loaded
+    unsigned int event_count;
+    unsigned int change_count;      // Events that changed a value
+    long long last_event_ms;
+    unsigned long long serial_hash; // Detects a different scanner reusing the scanner id
+    unsigned int firmware_total;    // Records to download in the firmware update session
+    int firmware_status;            // Last SCANNER_UF_STATUS status, 0 - success
+};
+
+/**
+* Fleet health table.
+*
+* RMD events are decoded into RmdDelta records and applied to a flat array of ScannerHealth
+* rows indexed by scanner id, so the hot state of the whole fleet is MAX_NUM_DEVICES
+* cache lines and fleet wide queries (low battery, faulted scanners) are linear scans
+* without pointer chasing. Strings are kept out of the rows: configuration names are
+* interned once and serial numbers live in a separate cold array.
+*
+* The table is not thread safe; feed it from the thread that receives CoreScanner events.
+**/
+class FleetHealth
+{
+public:
+    /**
+    * Fleet health constructor
+    */
+    FleetHealth();
+
+    /**
+    * Apply a decoded RMD event
+    * @param event - Decoded event
+    * @param now_ms - Event time in milliseconds
+    * return value : Number of values the event changed
+    */
+    int Apply(const RmdEvent& event, long long now_ms);
+
+    /**
+    * Drop a scanner (detached)
+    */
+    void Forget(int scanner_id);
+
+    /**
+    * Health row of a scanner
+    * return value : NULL if no event was received from the scanner
+    */
+    const ScannerHealth* Find(int scanner_id) const;
+
+    /**
+    * Scanners that reported a battery level below a threshold
+    */
+    void LowBattery(int threshold_percent, std::vector<int>* scanner_ids) const;
+
+    /**
+    * Scanners whose last health status is warning or fault, or whose last firmware update status
+    * is an error
+    */
+    void Unhealthy(std::vector<int>* scanner_ids) const;
+
+    /**
+    * Configuration name for ScannerHealth::config_id
+    */
+    const std::string& ConfigName(unsigned int config_id) const { return config_names_[config_id]; }
+
+    /**
+    * Serial number of a scanner as last reported
+    */
+    const std::string& SerialNumber(int scanner_id) const { return serial_numbers_[scanner_id]; }
+
+    int ScannerCount() const { return scanner_count_; }
+
+private:
+    ScannerHealth* Row(int scanner_id, const XmlSlice& serial_number);
+    unsigned int InternConfig(const XmlSlice& name);
+
+    std::vector<ScannerHealth> rows_;           // Indexed by scanner id
+    std::vector<std::string> serial_numbers_;   // Cold data, indexed by scanner id
+    std::vector<std::string> config_names_;     // Index 0 is "no configuration"
+    std::unordered_map<std::string, unsigned int> config_ids_;
+    int scanner_count_;
+};
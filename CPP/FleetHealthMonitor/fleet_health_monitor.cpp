@@ -0,0 +1,447 @@
+/*******************************************************************************************
+* @file fleet_health_monitor.cpp
+* @brief This file contains code snippet to track battery, health, configuration and firmware updates of scanners from RMD events
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include <chrono>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "rmd_event.h"
+#include "fleet_health.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for RMD events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_RMD);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Print the health table
+*/
+void PrintFleet(const FleetHealth& fleet)
+{
+    static const char* const kChargeStatus[] = { "unknown", "discharging", "charging", "full" };
+    static const char* const kHealthStatus[] = { "unknown", "ok", "warning", "fault" };
+    static const char* const kFirmwareStage[] = { "", "session started", "downloading", "component done", "session ended" };
+    for (int scanner_id = 1; scanner_id <= MAX_NUM_DEVICES; scanner_id++)
+    {
+        const ScannerHealth* row = fleet.Find(scanner_id);
+        if (row == NULL)
+        {
+            continue;
+        }
+        cout << " Scanner ID:[" << scanner_id << "] S/N:[" << fleet.SerialNumber(scanner_id) << "]";
+        if (row->reported_fields & (1u << kRmdBatteryLevel))
+        {
+            cout << " battery " << (int)row->battery_level << "% " << kChargeStatus[row->charge_status & 3];
+        }
+        if (row->reported_fields & (1u << kRmdBatteryHealth))
+        {
+            cout << " health " << (int)row->battery_health << "%";
+        }
+        if (row->reported_fields & (1u << kRmdHealthStatus))
+        {
+            cout << " status " << kHealthStatus[row->health_status & 3];
+        }
+        if (row->fault_code != 0)
+        {
+            cout << " fault " << row->fault_code;
+        }
+        if (row->config_id != 0)
+        {
+            cout << " config " << fleet.ConfigName(row->config_id) << " (+" << row->attribute_changes << " changes)";
+        }
+        if (row->firmware_stage != kFirmwareNone)
+        {
+            cout << " firmware " << kFirmwareStage[row->firmware_stage % 5] << " " << (int)row->firmware_percent << "%";
+        }
+        if (row->firmware_status != 0)
+        {
+            cout << " firmware status " << row->firmware_status;
+        }
+        cout << " events " << row->event_count << endl;
+    }
+}
+
+/*
+* Build RMD event xml for a scanner with given payload
+*/
+string MakeRmdXml(int scanner_id, const string& payload)
+{
+    return "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><scannerID>" + to_string(scanner_id) +
+        "</scannerID><arg-xml><modelnumber>MC9300</modelnumber><serialnumber>S" + to_string(100000 + scanner_id) +
+        "</serialnumber><GUID>0</GUID><rmd>" + payload + "</rmd></arg-xml></outArgs>";
+}
+
+/*
+* Feed a synthetic fleet through the decoder and the health table, and compare a fleet wide
+* query with keeping the latest raw event xml of every scanner. Battery, health and configuration
+* events use the assumed site schema (event type 0); every 50th event is a step of a firmware update.
+*/
+void RunSyntheticFleet()
+{
+    const int kScannerCount = 250;
+    const int kEventCount = 200000;
+
+    // Pre-build the events so only decoding and applying is timed
+    vector<string> events;
+    vector<short> event_types;
+    vector<int> event_scanners;
+    unsigned int seed = 12345;
+    for (int i = 0; i < 4000; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int scanner_id = 1 + (int)((seed >> 8) % kScannerCount);
+        int level = (int)((seed >> 16) % 100);
+        if (i % 50 == 0)
+        {
+            // Session start, component start, progress, component end, session end, status
+            int step = (i / 50) % 6;
+            short event_type = (short)(SCANNER_UF_SESS_START + step);
+            string firmware_payload = step == 0 ? "<maxcount>4000</maxcount>" :
+                (step == 2 ? "<progress>" + to_string(level * 40) + "</progress>" :
+                (step == 5 ? "<status>" + to_string(level < 10 ? 1 : 0) + "</status>" : ""));
+            events.push_back(MakeRmdXml(scanner_id, firmware_payload));
+            event_types.push_back(event_type);
+            event_scanners.push_back(scanner_id);
+            continue;
+        }
+        string payload = "<battery><battery_level>" + to_string(level) + "</battery_level><charge_status>" +
+            (level % 3 == 0 ? "charging" : "discharging") + "</charge_status><battery_health>9" + to_string(level % 10) +
+            "</battery_health><battery_temperature>3" + to_string(level % 10) + "</battery_temperature></battery>";
+        if (i % 25 == 0)
+        {
+            payload += "<health><health_status>" + string(level < 10 ? "warning" : "ok") + "</health_status><fault_code>0</fault_code></health>";
+        }
+        if (i % 100 == 0)
+        {
+            payload += "<config><config_name>site_" + to_string(level % 4) + ".scncfg</config_name><attribute><id>" +
+                to_string(level) + "</id></attribute></config>";
+        }
+        events.push_back(MakeRmdXml(scanner_id, payload));
+        event_types.push_back(0);
+        event_scanners.push_back(scanner_id);
+    }
+
+    FleetHealth fleet;
+    RmdEvent event;
+    long changes = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < kEventCount; i++)
+    {
+        if (DecodeRmdEvent(event_types[i % events.size()], events[i % events.size()], &event))
+        {
+            changes += fleet.Apply(event, i);
+        }
+    }
+    double apply_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kEventCount;
+
+    // Baseline: keep the latest raw battery xml and parse it again for every query
+    map<int, string> raw_events;
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        if (event_types[i] == 0)
+        {
+            raw_events[event_scanners[i]] = events[i];
+        }
+    }
+
+    const int kQueryCount = 1000;
+    vector<int> low_battery;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < kQueryCount; i++)
+    {
+        fleet.LowBattery(20, &low_battery);
+    }
+    double table_query_us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / kQueryCount;
+
+    size_t raw_low_battery = 0;
+    size_t raw_bytes = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < kQueryCount; i++)
+    {
+        raw_low_battery = 0;
+        raw_bytes = 0;
+        for (map<int, string>::const_iterator it = raw_events.begin(); it != raw_events.end(); ++it)
+        {
+            string level;
+            raw_bytes += it->second.size();
+            if (XmlFindText(it->second, "battery_level", &level) && atoi(level.c_str()) < 20)
+            {
+                raw_low_battery++;
+            }
+        }
+    }
+    double raw_query_us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / kQueryCount;
+
+    vector<int> unhealthy;
+    fleet.Unhealthy(&unhealthy);
+    cout << "Synthetic fleet of " << fleet.ScannerCount() << " scanners, " << kEventCount << " RMD events" << endl;
+    cout << " Decode and apply : " << apply_ns << " ns/event, " << changes << " value changes" << endl;
+    cout << " Low battery query, health table : " << table_query_us << " us (" << low_battery.size() << " scanners, "
+         << (MAX_NUM_DEVICES + 1) * sizeof(ScannerHealth) << " bytes)" << endl;
+    cout << " Low battery query, raw xml per scanner : " << raw_query_us << " us (" << raw_low_battery << " scanners, "
+         << raw_bytes << " bytes)" << endl;
+    cout << " Scanners with health warnings or failed firmware updates : " << unhealthy.size() << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Fleet health table with synthetic RMD events" << endl;
+    RunSyntheticFleet();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        FleetHealth fleet;
+        RmdEvent event;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        scanner_event_sink->SetRmdHandler([&](short event_type, const string& event_data)
+        {
+            if (!DecodeRmdEvent(event_type, event_data, &event))
+            {
+                return;
+            }
+            long long now_ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+            if (fleet.Apply(event, now_ms) > 0)
+            {
+                cout << "RMD event from scanner " << event.scanner_id << " :";
+                for (size_t i = 0; i < event.deltas.size(); i++)
+                {
+                    const RmdDelta& delta = event.deltas[i];
+                    cout << " " << RmdFieldName(delta.field) << "=" << (delta.field == kRmdConfigName ? delta.text.ToString() : to_string(delta.value));
+                }
+                cout << endl;
+            }
+        });
+
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            WaitForInput("Waiting for RMD events, press any key to print the fleet health and exit.");
+            PrintFleet(fleet);
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+        }
+        scanner_event_sink->SetRmdHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
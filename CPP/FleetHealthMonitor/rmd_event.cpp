@@ -0,0 +1,160 @@
+/*******************************************************************************************
+* @file rmd_event.cpp
+* @brief Definition of CoreScanner RMD event decoding
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "rmd_event.h"
+#include "common_defs.h"
+
+using namespace std;
+
+/**
+* Element name of each leaf value, indexed by RmdField (attribute ids are read from <attribute>)
+**/
+static const char* const kRmdElementNames[kRmdFieldCount] =
+{
+    "battery_level",
+    "battery_health",
+    "charge_status",
+    "battery_temperature",
+    "health_status",
+    "fault_code",
+    "config_name",
+    "attribute",
+    "firmware_stage",
+    "maxcount",
+    "progress",
+    "status"
+};
+
+static const char* const kChargeStatusNames[] = { "unknown", "discharging", "charging", "full" };
+static const char* const kHealthStatusNames[] = { "unknown", "ok", "warning", "fault" };
+
+/**
+* Enum value of a status text - a name from the table or a number
+**/
+static long StatusValue(const XmlSlice& text, const char* const* names, int name_count)
+{
+    for (int i = 0; i < name_count; i++)
+    {
+        if (text.Equals(names[i]))
+        {
+            return i;
+        }
+    }
+    return text.ToLong();
+}
+
+/**
+* Firmware update stage of a SCANNER_UF_* event type, kFirmwareNone for other event types
+**/
+static RmdFirmwareStage FirmwareStage(short event_type)
+{
+    switch (event_type)
+    {
+    case SCANNER_UF_SESS_START:
+        return kFirmwareSessionStarted;
+    case SCANNER_UF_DL_START:
+    case SCANNER_UF_DL_PROGRESS:
+        return kFirmwareDownloading;
+    case SCANNER_UF_DL_END:
+        return kFirmwareComponentDone;
+    case SCANNER_UF_SESS_END:
+        return kFirmwareSessionEnded;
+    default:
+        return kFirmwareNone;
+    }
+}
+
+bool DecodeRmdEvent(short event_type, const string& event_xml, RmdEvent* event)
+{
+    event->event_type = event_type;
+    event->scanner_id = 0;
+    event->serial_number = XmlSlice();
+    event->deltas.clear();
+
+    // SCANNER_UF_STATUS reports on the stage in progress and does not change it
+    bool firmware_event = event_type >= SCANNER_UF_SESS_START && event_type <= SCANNER_UF_STATUS;
+    RmdFirmwareStage stage = FirmwareStage(event_type);
+    if (stage != kFirmwareNone)
+    {
+        RmdDelta delta = { kRmdFirmwareStage, stage, XmlSlice() };
+        event->deltas.push_back(delta);
+    }
+    int first_field = firmware_event ? kRmdFirmwareTotal : 0;
+    int last_field = firmware_event ? kRmdFirmwareStatus : kRmdConfigName;
+
+    XmlReader reader(event_xml);
+    XmlReader::Token token;
+    while ((token = reader.Next()) != XmlReader::kEndOfDocument)
+    {
+        if (token != XmlReader::kStartElement)
+        {
+            continue;
+        }
+
+        XmlSlice name = reader.Name();
+        XmlSlice text;
+        if (name.Equals("scannerID"))
+        {
+            reader.ReadElementText(&text);
+            if (event->scanner_id == 0)
+            {
+                event->scanner_id = (int)text.ToLong();
+            }
+            continue;
+        }
+        if (name.Equals("serialnumber"))
+        {
+            reader.ReadElementText(&event->serial_number);
+            continue;
+        }
+        if (!firmware_event && name.Equals("attribute"))
+        {
+            int depth = reader.Depth();
+            if (reader.FindChild("id", depth) && reader.ReadElementText(&text))
+            {
+                RmdDelta delta = { kRmdAttributeChanged, text.ToLong(), text };
+                event->deltas.push_back(delta);
+            }
+            continue;
+        }
+
+        for (int field = first_field; field <= last_field; field++)
+        {
+            if (!name.Equals(kRmdElementNames[field]))
+            {
+                continue;
+            }
+            if (reader.ReadElementText(&text))
+            {
+                RmdDelta delta = { (RmdField)field, 0, text };
+                switch (field)
+                {
+                case kRmdChargeStatus:
+                    delta.value = StatusValue(text, kChargeStatusNames, 4);
+                    break;
+                case kRmdHealthStatus:
+                    delta.value = StatusValue(text, kHealthStatusNames, 4);
+                    break;
+                case kRmdConfigName:
+                    break;
+                default:
+                    delta.value = text.ToLong();
+                    break;
+                }
+                event->deltas.push_back(delta);
+            }
+            break;
+        }
+    }
+    return event->scanner_id != 0;
+}
+
+const char* RmdFieldName(RmdField field)
+{
+    return field >= 0 && field < kRmdFieldCount ? kRmdElementNames[field] : "unknown";
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************************
+* @file rmd_event.h
+* @brief Typed decoding of CoreScanner RMD (remote management) event xml
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <string>
+#include <vector>
+#include "xml_reader.h"
+
+/**
+* Scanner state reported by RMD events. The firmware fields come from the SCANNER_UF_* events
+* CoreScanner sends during a firmware update; the others come from the assumed site schema
+* described at DecodeRmdEvent().
+**/
+enum RmdField
+{
+    kRmdBatteryLevel,       // Charge in percent
+    kRmdBatteryHealth,      // Battery state of health in percent
+    kRmdChargeStatus,       // RmdChargeStatus
+    kRmdBatteryTemperature, // Degrees Celsius
+    kRmdHealthStatus,       // RmdHealthStatus
+    kRmdFaultCode,
+    kRmdConfigName,         // Text - name of the configuration loaded on the scanner
+    kRmdAttributeChanged,   // Id of an attribute changed on the scanner
+    kRmdFirmwareStage,      // RmdFirmwareStage, from the event type
+    kRmdFirmwareTotal,      // Records to download in the session
+    kRmdFirmwareProgress,   // Records downloaded
+    kRmdFirmwareStatus,     // Status of a SCANNER_UF_STATUS event, 0 - success
+    kRmdFieldCount
+};
+
+enum RmdChargeStatus
+{
+    kChargeUnknown,
+    kChargeDischarging,
+    kChargeCharging,
+    kChargeFull
+};
+
+enum RmdHealthStatus
+{
+    kHealthUnknown,
+    kHealthOk,
+    kHealthWarning,
+    kHealthFault
+};
+
+enum RmdFirmwareStage
+{
+    kFirmwareNone,
+    kFirmwareSessionStarted,    // SCANNER_UF_SESS_START
+    kFirmwareDownloading,       // SCANNER_UF_DL_START, SCANNER_UF_DL_PROGRESS
+    kFirmwareComponentDone,     // SCANNER_UF_DL_END
+    kFirmwareSessionEnded       // SCANNER_UF_SESS_END
+};
+
+/**
+* One value carried by an RMD event
+**/
+struct RmdDelta
+{
+    RmdField field;
+    long value;         // Numeric or enum value (0 for text fields)
+    XmlSlice text;      // Raw text, points into the event xml
+};
+
+/**
+* Decoded RMD event. The slices point into the event xml, which must outlive the event.
+**/
+struct RmdEvent
+{
+    short event_type;               // event_type argument of ScanRmdEvent
+    int scanner_id;
+    XmlSlice serial_number;
+    std::vector<RmdDelta> deltas;   // Values in the event, in document order
+
+    RmdEvent() : event_type(0), scanner_id(0), serial_number() {}
+};
+
+/**
+* Decode an RMD event with the pull parser, without building a document or copying strings.
+*
+* The RMD events CoreScanner sends are the firmware update events SCANNER_UF_SESS_START to
+* SCANNER_UF_STATUS. Their stage is taken from the event type, and the maxcount (session start),
+* progress (download progress) and status (update status) elements are read when present.
+*
+* Other event types are decoded with an assumed schema, which the CoreScanner SDK does not define
+* - it stands for a site's own agent forwarding scanner state, and must be adapted to the xml that
+* agent actually sends. Battery and health state of a stock CoreScanner installation are read with
+* RSM_ATTR_GET instead. Values are recognized by element name anywhere below <outArgs>, so the
+* grouping elements around them (<rmd>, <battery>, <health>, <config>) do not matter:
+*   battery_level, battery_health, charge_status (discharging/charging/full or number),
+*   battery_temperature, health_status (ok/warning/fault or number), fault_code,
+*   config_name and <attribute><id> of changed attributes.
+* Unknown elements are skipped.
+*
+* @param event_type - event_type argument of ScanRmdEvent
+* @param event_xml - Event xml
+* @param event - Receives the decoded event, deltas vector is reused
+* return value : true if the event names a scanner
+*/
+bool DecodeRmdEvent(short event_type, const std::string& event_xml, RmdEvent* event);
+
+/**
+* Field name for display
+*/
+const char* RmdFieldName(RmdField field);
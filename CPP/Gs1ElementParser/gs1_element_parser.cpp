@@ -0,0 +1,436 @@
+/*******************************************************************************************
+* @file gs1_element_parser.cpp
+* @brief This file contains code snippet to parse GS1 application identifiers in decoded labels
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "scan_data.h"
+#include "gs1_parser.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for barcode events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_BARCODE);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Print the elements of a GS1 label
+*/
+void PrintElements(const Gs1ElementString& elements)
+{
+    for (int i = 0; i < elements.count; i++)
+    {
+        const Gs1Element& element = elements.elements[i];
+        cout << "   (" << element.ai.ToString() << ") " << element.spec->title << " : " << element.value.ToString();
+        if (element.decimals >= 0)
+        {
+            cout << " (" << element.decimals << " decimals)";
+        }
+        if (!element.verified)
+        {
+            cout << " (not checked)";
+        }
+        cout << endl;
+    }
+    if (elements.error != kGs1Ok)
+    {
+        cout << "   Error at offset " << elements.error_offset << " : " << Gs1ErrorText(elements.error) << endl;
+    }
+}
+
+/*
+* Sample labels as transmitted by the scanner (FNC1 separators as GS)
+*/
+const char* kSampleLabels[] = {
+    "]C1010950600013435217261231" "10ABC123\x1d" "21XYZ0042",
+    "01095060001343523103001250152612313712",
+    "00106141411234567897" "420" "10001",
+    "]d2010950600013435210LOT7\x1d" "3922499\x1d" "8005000395",
+    "0109506000134353",
+    "0109506000134352" "17261331",
+    "0109506000134352" "99" "INTERNAL\x1d" "4X",
+    "]C1" "0109506000134352" "3402000150" "8004" "ABC-1234\x1d" "4300" "ACME",
+    "0109506000134352" "17260230",
+    "0109506000134352" "7999" "NEW-AI",
+};
+
+/*
+* Parse sample labels
+*/
+void RunSampleLabels()
+{
+    for (size_t i = 0; i < sizeof(kSampleLabels) / sizeof(kSampleLabels[0]); i++)
+    {
+        string label = kSampleLabels[i];
+        Gs1ElementString elements;
+        bool valid = ParseGs1(label.data(), label.size(), &elements);
+        string printable = label;
+        replace(printable.begin(), printable.end(), (char)GS1_GROUP_SEPARATOR, '|');
+        cout << " " << printable << " : " << (valid ? "valid" : "INVALID") << endl;
+        PrintElements(elements);
+    }
+}
+
+/*
+* String based parser, the way the ERP scripts parse labels: dictionary in a map of strings,
+* every element copied out
+*/
+bool ParseGs1Strings(const string& label, const map<string, const Gs1AiSpec*>& dictionary, vector<pair<string, string> >* elements)
+{
+    elements->clear();
+    size_t position = 0;
+    while (position < label.size())
+    {
+        const Gs1AiSpec* spec = NULL;
+        string ai;
+        for (size_t ai_length = 2; ai_length <= 4 && spec == NULL; ai_length++)
+        {
+            ai = label.substr(position, ai_length);
+            map<string, const Gs1AiSpec*>::const_iterator it = dictionary.find(ai);
+            if (it == dictionary.end() && ai_length == 4)
+            {
+                it = dictionary.find(ai.substr(0, 3));      // Family with decimal point digit
+            }
+            if (it != dictionary.end())
+            {
+                spec = it->second;
+            }
+        }
+        if (spec == NULL)
+        {
+            return false;
+        }
+        ai = label.substr(position, spec->ai_length);
+        position += spec->ai_length;
+        size_t end = (spec->min_length == spec->max_length && string("00 01 02 03 04 11 12 13 15 16 17 20 31 41").find(ai.substr(0, 2)) != string::npos) ?
+            position + spec->max_length : label.find((char)GS1_GROUP_SEPARATOR, position);
+        string value = label.substr(position, end == string::npos ? string::npos : end - position);
+        elements->push_back(make_pair(ai, value));
+        position = (end == string::npos) ? label.size() : end + (end < label.size() && label[end] == GS1_GROUP_SEPARATOR ? 1 : 0);
+    }
+    return true;
+}
+
+/*
+* Measure labels/s for a mix of valid labels
+*/
+void RunBenchmark()
+{
+    const int kRuns = 1000000;
+    vector<string> labels;
+    for (size_t i = 0; i < 4; i++)
+    {
+        labels.push_back(kSampleLabels[i]);
+    }
+
+    // String parser dictionary, built from the one-pass parser's lookups
+    map<string, const Gs1AiSpec*> dictionary;
+    for (int ai = 0; ai < 10000; ai++)
+    {
+        char digits[5];
+        snprintf(digits, sizeof(digits), "%04d", ai);
+        for (int length = 2; length <= 4; length++)
+        {
+            const Gs1AiSpec* spec = FindGs1Ai(digits, length);
+            if (spec != NULL && strlen(spec->prefix) == (size_t)length)
+            {
+                dictionary[string(digits, length)] = spec;
+            }
+        }
+    }
+    vector<string> stripped(labels);
+    for (size_t i = 0; i < stripped.size(); i++)
+    {
+        if (stripped[i].compare(0, 1, "]") == 0)
+        {
+            stripped[i].erase(0, 3);
+        }
+    }
+
+    long elements_found = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int run = 0; run < kRuns; run++)
+    {
+        const string& label = labels[run % labels.size()];
+        Gs1ElementString elements;
+        ParseGs1(label.data(), label.size(), &elements);
+        elements_found += elements.count;
+    }
+    double one_pass_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long string_elements_found = 0;
+    start = chrono::steady_clock::now();
+    vector<pair<string, string> > string_elements;
+    for (int run = 0; run < kRuns; run++)
+    {
+        ParseGs1Strings(stripped[run % stripped.size()], dictionary, &string_elements);
+        string_elements_found += (long)string_elements.size();
+    }
+    double string_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << " One pass parser with check digits : " << (long)(kRuns / one_pass_seconds) << " labels/s ("
+         << one_pass_seconds * 1e9 / kRuns << " ns per label), " << elements_found << " elements" << endl;
+    cout << " String parser without validation  : " << (long)(kRuns / string_seconds) << " labels/s ("
+         << string_seconds * 1e9 / kRuns << " ns per label), " << string_elements_found << " elements" << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "GS1 sample labels" << endl;
+    RunSampleLabels();
+    cout << "GS1 parser benchmark" << endl;
+    RunBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        scanner_event_sink->SetScanDataHandler([](short event_type, const string& scan_data_xml)
+        {
+            ScanData scan_data;
+            if (!ParseScanData(scan_data_xml, &scan_data))
+            {
+                return;
+            }
+            if (!IsGs1Symbology(scan_data.symbology))
+            {
+                cout << "Barcode scanner ID:[" << scan_data.scanner_id << "] type " << scan_data.symbology << " : " << scan_data.label << endl;
+                return;
+            }
+            Gs1ElementString elements;
+            bool valid = ParseGs1(scan_data.label.data(), scan_data.label.size(), &elements);
+            cout << "GS1 barcode scanner ID:[" << scan_data.scanner_id << "] type " << scan_data.symbology << " - "
+                 << (valid ? "valid" : "INVALID") << endl;
+            PrintElements(elements);
+        });
+
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            WaitForInput("Scan GS1 barcodes now, press any key to exit.");
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+        }
+        scanner_event_sink->SetScanDataHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
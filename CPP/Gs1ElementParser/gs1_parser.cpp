@@ -0,0 +1,647 @@
+/*******************************************************************************************
+* @file gs1_parser.cpp
+* @brief Definition of GS1 element string parsing
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "gs1_parser.h"
+#include <cstring>
+#include "common_defs.h"
+
+using namespace std;
+
+/**
+* AI dictionary (GS1 General Specifications, section 3.2), sorted by prefix. Families with an
+* implied decimal point (310n ...) are listed once with ai_length one more than the prefix length;
+* families whose last digit is a sequence number (703s, 723s) are listed per AI.
+**/
+static constexpr Gs1AiSpec kGs1Dictionary[] = {
+    //  prefix  ai  min max   numeric check date   title
+    { "00",    2, 18, 18, true,  18, false, "SSCC" },
+    { "01",    2, 14, 14, true,  14, false, "GTIN" },
+    { "02",    2, 14, 14, true,  14, false, "CONTENT" },
+    { "03",    2, 14, 14, true,  14, false, "MTO GTIN" },
+    { "10",    2,  1, 20, false,  0, false, "BATCH/LOT" },
+    { "11",    2,  6,  6, true,   0, true,  "PROD DATE" },
+    { "12",    2,  6,  6, true,   0, true,  "DUE DATE" },
+    { "13",    2,  6,  6, true,   0, true,  "PACK DATE" },
+    { "15",    2,  6,  6, true,   0, true,  "BEST BEFORE" },
+    { "16",    2,  6,  6, true,   0, true,  "SELL BY" },
+    { "17",    2,  6,  6, true,   0, true,  "USE BY" },
+    { "20",    2,  2,  2, true,   0, false, "VARIANT" },
+    { "21",    2,  1, 20, false,  0, false, "SERIAL" },
+    { "22",    2,  1, 20, false,  0, false, "CPV" },
+    { "235",   3,  1, 28, false,  0, false, "TPX" },
+    { "240",   3,  1, 30, false,  0, false, "ADDITIONAL ID" },
+    { "241",   3,  1, 30, false,  0, false, "CUST. PART No." },
+    { "242",   3,  1,  6, true,   0, false, "MTO VARIANT" },
+    { "243",   3,  1, 20, false,  0, false, "PCN" },
+    { "250",   3,  1, 30, false,  0, false, "SECONDARY SERIAL" },
+    { "251",   3,  1, 30, false,  0, false, "REF. TO SOURCE" },
+    { "253",   3, 13, 30, false, 13, false, "GDTI" },
+    { "254",   3,  1, 20, false,  0, false, "GLN EXTENSION COMPONENT" },
+    { "255",   3, 13, 25, true,  13, false, "GCN" },
+    { "30",    2,  1,  8, true,   0, false, "VAR. COUNT" },
+    { "310",   4,  6,  6, true,   0, false, "NET WEIGHT (kg)" },
+    { "311",   4,  6,  6, true,   0, false, "LENGTH (m)" },
+    { "312",   4,  6,  6, true,   0, false, "WIDTH (m)" },
+    { "313",   4,  6,  6, true,   0, false, "HEIGHT (m)" },
+    { "314",   4,  6,  6, true,   0, false, "AREA (m2)" },
+    { "315",   4,  6,  6, true,   0, false, "NET VOLUME (l)" },
+    { "316",   4,  6,  6, true,   0, false, "NET VOLUME (m3)" },
+    { "320",   4,  6,  6, true,   0, false, "NET WEIGHT (lb)" },
+    { "321",   4,  6,  6, true,   0, false, "LENGTH (in)" },
+    { "322",   4,  6,  6, true,   0, false, "LENGTH (ft)" },
+    { "323",   4,  6,  6, true,   0, false, "LENGTH (yd)" },
+    { "324",   4,  6,  6, true,   0, false, "WIDTH (in)" },
+    { "325",   4,  6,  6, true,   0, false, "WIDTH (ft)" },
+    { "326",   4,  6,  6, true,   0, false, "WIDTH (yd)" },
+    { "327",   4,  6,  6, true,   0, false, "HEIGHT (in)" },
+    { "328",   4,  6,  6, true,   0, false, "HEIGHT (ft)" },
+    { "329",   4,  6,  6, true,   0, false, "HEIGHT (yd)" },
+    { "330",   4,  6,  6, true,   0, false, "GROSS WEIGHT (kg)" },
+    { "331",   4,  6,  6, true,   0, false, "LENGTH (m), log" },
+    { "332",   4,  6,  6, true,   0, false, "WIDTH (m), log" },
+    { "333",   4,  6,  6, true,   0, false, "HEIGHT (m), log" },
+    { "334",   4,  6,  6, true,   0, false, "AREA (m2), log" },
+    { "335",   4,  6,  6, true,   0, false, "VOLUME (l), log" },
+    { "336",   4,  6,  6, true,   0, false, "VOLUME (m3), log" },
+    { "337",   4,  6,  6, true,   0, false, "KG PER m2" },
+    { "340",   4,  6,  6, true,   0, false, "GROSS WEIGHT (lb)" },
+    { "341",   4,  6,  6, true,   0, false, "LENGTH (in), log" },
+    { "342",   4,  6,  6, true,   0, false, "LENGTH (ft), log" },
+    { "343",   4,  6,  6, true,   0, false, "LENGTH (yd), log" },
+    { "344",   4,  6,  6, true,   0, false, "WIDTH (in), log" },
+    { "345",   4,  6,  6, true,   0, false, "WIDTH (ft), log" },
+    { "346",   4,  6,  6, true,   0, false, "WIDTH (yd), log" },
+    { "347",   4,  6,  6, true,   0, false, "HEIGHT (in), log" },
+    { "348",   4,  6,  6, true,   0, false, "HEIGHT (ft), log" },
+    { "349",   4,  6,  6, true,   0, false, "HEIGHT (yd), log" },
+    { "350",   4,  6,  6, true,   0, false, "AREA (in2)" },
+    { "351",   4,  6,  6, true,   0, false, "AREA (ft2)" },
+    { "352",   4,  6,  6, true,   0, false, "AREA (yd2)" },
+    { "353",   4,  6,  6, true,   0, false, "AREA (in2), log" },
+    { "354",   4,  6,  6, true,   0, false, "AREA (ft2), log" },
+    { "355",   4,  6,  6, true,   0, false, "AREA (yd2), log" },
+    { "356",   4,  6,  6, true,   0, false, "NET WEIGHT (t oz)" },
+    { "357",   4,  6,  6, true,   0, false, "NET VOLUME (oz)" },
+    { "360",   4,  6,  6, true,   0, false, "NET VOLUME (qt)" },
+    { "361",   4,  6,  6, true,   0, false, "NET VOLUME (gal.)" },
+    { "362",   4,  6,  6, true,   0, false, "VOLUME (qt), log" },
+    { "363",   4,  6,  6, true,   0, false, "VOLUME (gal.), log" },
+    { "364",   4,  6,  6, true,   0, false, "VOLUME (in3)" },
+    { "365",   4,  6,  6, true,   0, false, "VOLUME (ft3)" },
+    { "366",   4,  6,  6, true,   0, false, "VOLUME (yd3)" },
+    { "367",   4,  6,  6, true,   0, false, "VOLUME (in3), log" },
+    { "368",   4,  6,  6, true,   0, false, "VOLUME (ft3), log" },
+    { "369",   4,  6,  6, true,   0, false, "VOLUME (yd3), log" },
+    { "37",    2,  1,  8, true,   0, false, "COUNT" },
+    { "390",   4,  1, 15, true,   0, false, "AMOUNT" },
+    { "391",   4,  4, 18, true,   0, false, "AMOUNT (ISO currency)" },
+    { "392",   4,  1, 15, true,   0, false, "PRICE" },
+    { "393",   4,  4, 18, true,   0, false, "PRICE (ISO currency)" },
+    { "394",   4,  4,  4, true,   0, false, "PRCNT OFF" },
+    { "395",   4,  6,  6, true,   0, false, "PRICE/UoM" },
+    { "400",   3,  1, 30, false,  0, false, "ORDER NUMBER" },
+    { "401",   3,  1, 30, false,  0, false, "GINC" },
+    { "402",   3, 17, 17, true,  17, false, "GSIN" },
+    { "403",   3,  1, 30, false,  0, false, "ROUTE" },
+    { "410",   3, 13, 13, true,  13, false, "SHIP TO LOC" },
+    { "411",   3, 13, 13, true,  13, false, "BILL TO" },
+    { "412",   3, 13, 13, true,  13, false, "PURCHASE FROM" },
+    { "413",   3, 13, 13, true,  13, false, "SHIP FOR LOC" },
+    { "414",   3, 13, 13, true,  13, false, "LOC No." },
+    { "415",   3, 13, 13, true,  13, false, "PAY TO" },
+    { "416",   3, 13, 13, true,  13, false, "PROD/SERV LOC" },
+    { "417",   3, 13, 13, true,  13, false, "PARTY" },
+    { "420",   3,  1, 20, false,  0, false, "SHIP TO POST" },
+    { "421",   3,  4, 12, false,  0, false, "SHIP TO POST (ISO country)" },
+    { "422",   3,  3,  3, true,   0, false, "ORIGIN" },
+    { "423",   3,  3, 15, true,   0, false, "COUNTRY - INITIAL PROCESS." },
+    { "424",   3,  3,  3, true,   0, false, "COUNTRY - PROCESS." },
+    { "425",   3,  3, 15, true,   0, false, "COUNTRY - DISASSEMBLY" },
+    { "426",   3,  3,  3, true,   0, false, "COUNTRY - FULL PROCESS" },
+    { "427",   3,  1,  3, false,  0, false, "ORIGIN SUBDIVISION" },
+    { "4300",  4,  1, 35, false,  0, false, "SHIP TO COMP" },
+    { "4301",  4,  1, 35, false,  0, false, "SHIP TO NAME" },
+    { "4302",  4,  1, 70, false,  0, false, "SHIP TO ADD1" },
+    { "4303",  4,  1, 70, false,  0, false, "SHIP TO ADD2" },
+    { "4304",  4,  1, 70, false,  0, false, "SHIP TO SUB" },
+    { "4305",  4,  1, 70, false,  0, false, "SHIP TO LOC" },
+    { "4306",  4,  1, 70, false,  0, false, "SHIP TO REG" },
+    { "4307",  4,  2,  2, false,  0, false, "SHIP TO COUNTRY" },
+    { "4308",  4,  1, 30, false,  0, false, "SHIP TO PHONE" },
+    { "4309",  4, 20, 20, true,   0, false, "SHIP TO GEO" },
+    { "4310",  4,  1, 35, false,  0, false, "RTN TO COMP" },
+    { "4311",  4,  1, 35, false,  0, false, "RTN TO NAME" },
+    { "4312",  4,  1, 70, false,  0, false, "RTN TO ADD1" },
+    { "4313",  4,  1, 70, false,  0, false, "RTN TO ADD2" },
+    { "4314",  4,  1, 70, false,  0, false, "RTN TO SUB" },
+    { "4315",  4,  1, 70, false,  0, false, "RTN TO LOC" },
+    { "4316",  4,  1, 70, false,  0, false, "RTN TO REG" },
+    { "4317",  4,  2,  2, false,  0, false, "RTN TO COUNTRY" },
+    { "4318",  4,  1, 20, false,  0, false, "RTN TO POST" },
+    { "4319",  4,  1, 30, false,  0, false, "RTN TO PHONE" },
+    { "4320",  4,  1, 35, false,  0, false, "SRV DESCRIPTION" },
+    { "4321",  4,  1,  1, true,   0, false, "DANGEROUS GOODS" },
+    { "4322",  4,  1,  1, true,   0, false, "AUTH LEAVE" },
+    { "4323",  4,  1,  1, true,   0, false, "SIG REQUIRED" },
+    { "4324",  4, 10, 10, true,   0, true,  "NBEF DEL DT" },
+    { "4325",  4, 10, 10, true,   0, true,  "NAFT DEL DT" },
+    { "4326",  4,  6,  6, true,   0, true,  "REL DATE" },
+    { "4330",  4,  6,  7, false,  0, false, "MAX TEMP F." },
+    { "4331",  4,  6,  7, false,  0, false, "MAX TEMP C." },
+    { "4332",  4,  6,  7, false,  0, false, "MIN TEMP F." },
+    { "4333",  4,  6,  7, false,  0, false, "MIN TEMP C." },
+    { "7001",  4, 13, 13, true,   0, false, "NSN" },
+    { "7002",  4,  1, 30, false,  0, false, "MEAT CUT" },
+    { "7003",  4, 10, 10, true,   0, true,  "EXPIRY TIME" },
+    { "7004",  4,  1,  4, true,   0, false, "ACTIVE POTENCY" },
+    { "7005",  4,  1, 12, false,  0, false, "CATCH AREA" },
+    { "7006",  4,  6,  6, true,   0, true,  "FIRST FREEZE DATE" },
+    { "7007",  4,  6, 12, true,   0, true,  "HARVEST DATE" },
+    { "7008",  4,  1,  3, false,  0, false, "AQUATIC SPECIES" },
+    { "7009",  4,  1, 10, false,  0, false, "FISHING GEAR TYPE" },
+    { "7010",  4,  1,  2, false,  0, false, "PROD METHOD" },
+    { "7011",  4,  6, 10, true,   0, true,  "TEST BY DATE" },
+    { "7020",  4,  1, 20, false,  0, false, "REFURB LOT" },
+    { "7021",  4,  1, 20, false,  0, false, "FUNC STAT" },
+    { "7022",  4,  1, 20, false,  0, false, "REV STAT" },
+    { "7023",  4,  1, 30, false,  0, false, "GIAI - ASSEMBLY" },
+    { "7030",  4,  4, 30, false,  0, false, "PROCESSOR # 0" },
+    { "7031",  4,  4, 30, false,  0, false, "PROCESSOR # 1" },
+    { "7032",  4,  4, 30, false,  0, false, "PROCESSOR # 2" },
+    { "7033",  4,  4, 30, false,  0, false, "PROCESSOR # 3" },
+    { "7034",  4,  4, 30, false,  0, false, "PROCESSOR # 4" },
+    { "7035",  4,  4, 30, false,  0, false, "PROCESSOR # 5" },
+    { "7036",  4,  4, 30, false,  0, false, "PROCESSOR # 6" },
+    { "7037",  4,  4, 30, false,  0, false, "PROCESSOR # 7" },
+    { "7038",  4,  4, 30, false,  0, false, "PROCESSOR # 8" },
+    { "7039",  4,  4, 30, false,  0, false, "PROCESSOR # 9" },
+    { "7040",  4,  4,  4, false,  0, false, "UIC+EXT" },
+    { "7041",  4,  1,  4, false,  0, false, "UFRGT UNIT TYPE" },
+    { "710",   3,  1, 20, false,  0, false, "NHRN PZN" },
+    { "711",   3,  1, 20, false,  0, false, "NHRN CIP" },
+    { "712",   3,  1, 20, false,  0, false, "NHRN CN" },
+    { "713",   3,  1, 20, false,  0, false, "NHRN DRN" },
+    { "714",   3,  1, 20, false,  0, false, "NHRN AIM" },
+    { "715",   3,  1, 20, false,  0, false, "NHRN NDC" },
+    { "716",   3,  1, 20, false,  0, false, "NHRN AIC" },
+    { "7230",  4,  3, 30, false,  0, false, "CERT # 0" },
+    { "7231",  4,  3, 30, false,  0, false, "CERT # 1" },
+    { "7232",  4,  3, 30, false,  0, false, "CERT # 2" },
+    { "7233",  4,  3, 30, false,  0, false, "CERT # 3" },
+    { "7234",  4,  3, 30, false,  0, false, "CERT # 4" },
+    { "7235",  4,  3, 30, false,  0, false, "CERT # 5" },
+    { "7236",  4,  3, 30, false,  0, false, "CERT # 6" },
+    { "7237",  4,  3, 30, false,  0, false, "CERT # 7" },
+    { "7238",  4,  3, 30, false,  0, false, "CERT # 8" },
+    { "7239",  4,  3, 30, false,  0, false, "CERT # 9" },
+    { "7240",  4,  1, 20, false,  0, false, "PROTOCOL" },
+    { "7241",  4,  2,  2, true,   0, false, "AIDC MEDIA TYPE" },
+    { "7242",  4,  1, 25, false,  0, false, "VCN" },
+    { "7250",  4,  8,  8, true,   0, false, "DOB" },
+    { "7251",  4, 12, 12, true,   0, false, "DOB TIME" },
+    { "7252",  4,  1,  1, true,   0, false, "BIO SEX" },
+    { "7253",  4,  1, 40, false,  0, false, "FAMILY NAME" },
+    { "7254",  4,  1, 40, false,  0, false, "GIVEN NAME" },
+    { "7255",  4,  1, 10, false,  0, false, "SUFFIX" },
+    { "7256",  4,  1, 90, false,  0, false, "FULL NAME" },
+    { "7257",  4,  1, 70, false,  0, false, "PERSON ADDR" },
+    { "7258",  4,  3,  3, false,  0, false, "BIRTH SEQUENCE" },
+    { "7259",  4,  1, 40, false,  0, false, "BABY" },
+    { "8001",  4, 14, 14, true,   0, false, "DIMENSIONS" },
+    { "8002",  4,  1, 20, false,  0, false, "CMT No." },
+    { "8003",  4, 14, 30, false, 14, false, "GRAI" },
+    { "8004",  4,  1, 30, false,  0, false, "GIAI" },
+    { "8005",  4,  6,  6, true,   0, false, "PRICE PER UNIT" },
+    { "8006",  4, 18, 18, true,  14, false, "ITIP" },
+    { "8007",  4,  1, 34, false,  0, false, "IBAN" },
+    { "8008",  4,  8, 12, true,   0, true,  "PROD TIME" },
+    { "8009",  4,  1, 50, false,  0, false, "OPTSEN" },
+    { "8010",  4,  1, 30, false,  0, false, "CPID" },
+    { "8011",  4,  1, 12, true,   0, false, "CPID SERIAL" },
+    { "8012",  4,  1, 20, false,  0, false, "VERSION" },
+    { "8013",  4,  1, 25, false,  0, false, "GMN" },
+    { "8017",  4, 18, 18, true,  18, false, "GSRN - PROVIDER" },
+    { "8018",  4, 18, 18, true,  18, false, "GSRN - RECIPIENT" },
+    { "8019",  4,  1, 10, true,   0, false, "SRIN" },
+    { "8020",  4,  1, 25, false,  0, false, "REF No." },
+    { "8026",  4, 18, 18, true,  14, false, "ITIP CONTENT" },
+    { "8030",  4,  1, 90, false,  0, false, "DIGSIG" },
+    { "8110",  4,  1, 70, false,  0, false, "COUPON" },
+    { "8111",  4,  4,  4, true,   0, false, "POINTS" },
+    { "8112",  4,  1, 70, false,  0, false, "PAPERLESS COUPON" },
+    { "8200",  4,  1, 70, false,  0, false, "PRODUCT URL" },
+    { "90",    2,  1, 30, false,  0, false, "INTERNAL" },
+    { "91",    2,  1, 90, false,  0, false, "INTERNAL" },
+    { "92",    2,  1, 90, false,  0, false, "INTERNAL" },
+    { "93",    2,  1, 90, false,  0, false, "INTERNAL" },
+    { "94",    2,  1, 90, false,  0, false, "INTERNAL" },
+    { "95",    2,  1, 90, false,  0, false, "INTERNAL" },
+    { "96",    2,  1, 90, false,  0, false, "INTERNAL" },
+    { "97",    2,  1, 90, false,  0, false, "INTERNAL" },
+    { "98",    2,  1, 90, false,  0, false, "INTERNAL" },
+    { "99",    2,  1, 90, false,  0, false, "INTERNAL" },
+};
+
+static constexpr int kGs1DictionarySize = (int)(sizeof(kGs1Dictionary) / sizeof(kGs1Dictionary[0]));
+static_assert(kGs1DictionarySize <= 255, "GS1 dictionary index holds entry numbers in bytes");
+
+/**
+* Entry of elements whose AI is missing from the dictionary
+**/
+static const Gs1AiSpec kGs1UnverifiedAi = { "", 0, 1, 90, false, 0, false, "UNVERIFIED AI" };
+
+/**
+* Value of the first two digits of a prefix
+**/
+static constexpr int PrefixBucket(const char* prefix)
+{
+    return (prefix[0] - '0') * 10 + (prefix[1] - '0');
+}
+
+/**
+* Compare prefixes as strings
+**/
+static constexpr bool PrefixLess(const char* a, const char* b)
+{
+    while (*a != '\0' && *a == *b)
+    {
+        a++;
+        b++;
+    }
+    return (unsigned char)*a < (unsigned char)*b;
+}
+
+/**
+* Check the dictionary is sorted and prefix free (no AI is the start of another), which the
+* lookup relies on
+**/
+static constexpr bool DictionaryIsValid()
+{
+    for (int i = 0; i < kGs1DictionarySize; i++)
+    {
+        const char* prefix = kGs1Dictionary[i].prefix;
+        int length = 0;
+        while (prefix[length] != '\0')
+        {
+            if (prefix[length] < '0' || prefix[length] > '9')
+            {
+                return false;
+            }
+            length++;
+        }
+        if (length < 2 || kGs1Dictionary[i].ai_length < length || kGs1Dictionary[i].ai_length > length + 1)
+        {
+            return false;
+        }
+        if (i > 0)
+        {
+            const char* previous = kGs1Dictionary[i - 1].prefix;
+            if (!PrefixLess(previous, prefix))
+            {
+                return false;
+            }
+            int common = 0;
+            while (previous[common] != '\0' && previous[common] == prefix[common])
+            {
+                common++;
+            }
+            if (previous[common] == '\0')
+            {
+                return false;   // Previous prefix starts this one
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(DictionaryIsValid(), "GS1 AI dictionary must be sorted and prefix free");
+
+/**
+* Range of dictionary entries by the first two AI digits, built at compile time
+**/
+struct Gs1DictionaryIndex
+{
+    unsigned char first[101];   // Entries of bucket b are first[b] .. first[b + 1] - 1
+
+    constexpr Gs1DictionaryIndex() : first()
+    {
+        int entry = 0;
+        for (int bucket = 0; bucket <= 100; bucket++)
+        {
+            while (entry < kGs1DictionarySize && PrefixBucket(kGs1Dictionary[entry].prefix) < bucket)
+            {
+                entry++;
+            }
+            first[bucket] = (unsigned char)entry;
+        }
+    }
+};
+
+static constexpr Gs1DictionaryIndex kGs1Index;
+
+static inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+* Data length of AIs with a predefined length, by their first two digits - no FNC1 follows them
+* (GS1 General Specifications, figure 7.8.5-2)
+* return value : Data length, 0 if elements of the AI end with FNC1
+**/
+static int PredefinedLength(const char* ai)
+{
+    int bucket = (ai[0] - '0') * 10 + (ai[1] - '0');
+    if (bucket == 0)
+    {
+        return 18;
+    }
+    if (bucket <= 3)
+    {
+        return 14;
+    }
+    if (bucket == 4)
+    {
+        return 16;
+    }
+    if ((bucket >= 11 && bucket <= 19) || (bucket >= 31 && bucket <= 36))
+    {
+        return 6;
+    }
+    if (bucket == 20)
+    {
+        return 2;
+    }
+    return bucket == 41 ? 13 : 0;
+}
+
+/**
+* Digits of an AI missing from the dictionary, by its first two digits (the AI length of the
+* GS1 ranges; 4 for unassigned ranges)
+**/
+static size_t UnverifiedAiLength(const char* ai)
+{
+    int bucket = (ai[0] - '0') * 10 + (ai[1] - '0');
+    if (bucket <= 22 || bucket == 30 || bucket == 37 || bucket >= 90)
+    {
+        return 2;
+    }
+    if ((bucket >= 23 && bucket <= 25) || (bucket >= 40 && bucket <= 42) || bucket == 71)
+    {
+        return 3;
+    }
+    return 4;
+}
+
+/**
+* GS1 mod 10 check digit over digits[0 .. count - 1], the last being the check digit
+**/
+static bool CheckDigitValid(const char* digits, int count)
+{
+    int sum = 0;
+    int weight = 3;
+    for (int i = count - 2; i >= 0; i--)
+    {
+        sum += (digits[i] - '0') * weight;
+        weight = 4 - weight;
+    }
+    return (10 - sum % 10) % 10 == digits[count - 1] - '0';
+}
+
+/**
+* YYMMDD date, day 00 meaning the last day of the month. YY falls in a 100 year window around
+* the current year, in which every year divisible by 4 is a leap year.
+**/
+static bool DateValid(const char* digits)
+{
+    static const int kDaysInMonth[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int year = (digits[0] - '0') * 10 + (digits[1] - '0');
+    int month = (digits[2] - '0') * 10 + (digits[3] - '0');
+    int day = (digits[4] - '0') * 10 + (digits[5] - '0');
+    if (month < 1 || month > 12)
+    {
+        return false;
+    }
+    int days = kDaysInMonth[month - 1] + ((month == 2 && year % 4 == 0) ? 1 : 0);
+    return day <= days;
+}
+
+/**
+* Characters allowed in alphanumeric GS1 data (GS1 AI encodable character set 82)
+**/
+static bool IsCset82(char c)
+{
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || IsDigit(c) || (c >= '!' && c <= '/' && c != '#' && c != '$' && c != '@') ||
+        c == ':' || c == ';' || c == '<' || c == '=' || c == '>' || c == '?' || c == '_';
+}
+
+bool Gs1Slice::Equals(const char* text) const
+{
+    return strlen(text) == length && memcmp(text, data, length) == 0;
+}
+
+string Gs1Slice::ToString() const
+{
+    return string(data, length);
+}
+
+const Gs1Element* Gs1ElementString::Find(const char* ai) const
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (elements[i].ai.Equals(ai))
+        {
+            return &elements[i];
+        }
+    }
+    return NULL;
+}
+
+bool IsGs1Symbology(int symbology)
+{
+    return symbology == ST_EAN128 || symbology == ST_GS1_DATAMATRIX || symbology == ST_GS1_QR ||
+        symbology == ST_RSS_EXPANDED || symbology == ST_DATABAR_COUPON;
+}
+
+const Gs1AiSpec* FindGs1Ai(const char* data, size_t length)
+{
+    if (length < 2 || !IsDigit(data[0]) || !IsDigit(data[1]))
+    {
+        return NULL;
+    }
+    int bucket = (data[0] - '0') * 10 + (data[1] - '0');
+    for (int i = kGs1Index.first[bucket]; i < kGs1Index.first[bucket + 1]; i++)
+    {
+        const char* prefix = kGs1Dictionary[i].prefix;
+        size_t matched = 2;
+        while (prefix[matched] != '\0' && matched < length && prefix[matched] == data[matched])
+        {
+            matched++;
+        }
+        if (prefix[matched] == '\0')
+        {
+            return &kGs1Dictionary[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+* Stop parsing with an error
+**/
+static bool Fail(Gs1ElementString* elements, Gs1Error error, size_t offset)
+{
+    elements->error = error;
+    elements->error_offset = offset;
+    return false;
+}
+
+bool ParseGs1(const char* label, size_t length, Gs1ElementString* elements)
+{
+    elements->count = 0;
+    elements->error = kGs1Ok;
+    elements->error_offset = 0;
+
+    size_t position = 0;
+    if (length >= 3 && label[0] == ']' &&
+        ((label[1] == 'C' && label[2] == '1') || (label[1] == 'd' && label[2] == '2') ||
+         (label[1] == 'Q' && label[2] == '3') || (label[1] == 'e' && label[2] == '0')))
+    {
+        position = 3;
+    }
+    while (position < length && label[position] == GS1_GROUP_SEPARATOR)
+    {
+        position++;
+    }
+    if (position == length)
+    {
+        return Fail(elements, kGs1Empty, position);
+    }
+
+    while (position < length)
+    {
+        size_t element_start = position;
+        const Gs1AiSpec* spec = FindGs1Ai(label + position, length - position);
+        bool verified = spec != NULL;
+        size_t ai_length = 0;
+        if (verified)
+        {
+            ai_length = spec->ai_length;
+        }
+        else if (length - position >= 2 && IsDigit(label[position]) && IsDigit(label[position + 1]))
+        {
+            // Not in the dictionary: split the element off by the GS1 length tables, unchecked
+            spec = &kGs1UnverifiedAi;
+            ai_length = UnverifiedAiLength(label + position);
+            for (size_t i = 2; i < ai_length && position + i < length; i++)
+            {
+                if (!IsDigit(label[position + i]))
+                {
+                    return Fail(elements, kGs1UnknownAi, element_start);
+                }
+            }
+        }
+        if (spec == NULL || length - position < ai_length)
+        {
+            return Fail(elements, kGs1UnknownAi, element_start);
+        }
+        if (elements->count == Gs1ElementString::kMaxElements)
+        {
+            return Fail(elements, kGs1TooManyElements, element_start);
+        }
+
+        Gs1Element& element = elements->elements[elements->count];
+        element.ai.data = label + position;
+        element.ai.length = ai_length;
+        element.spec = spec;
+        element.verified = verified;
+        element.decimals = -1;
+        if (verified && spec->ai_length > strlen(spec->prefix))
+        {
+            char decimals = label[position + spec->ai_length - 1];
+            if (!IsDigit(decimals))
+            {
+                return Fail(elements, kGs1UnknownAi, element_start);
+            }
+            element.decimals = decimals - '0';
+        }
+        position += ai_length;
+
+        // Data runs to FNC1 or the end of the label; predefined lengths end without a separator
+        int predefined_length = PredefinedLength(element.ai.data);
+        size_t min_length = spec->min_length;
+        size_t max_length = spec->max_length;
+        bool numeric = spec->numeric;
+        if (!verified && predefined_length != 0)
+        {
+            min_length = max_length = predefined_length;
+            numeric = true;
+        }
+        size_t value_end = position;
+        size_t limit = (min_length == max_length && predefined_length != 0) ? position + max_length : length;
+        if (limit > length)
+        {
+            return Fail(elements, kGs1TooShort, element_start);
+        }
+        const char* separator = (const char*)memchr(label + position, GS1_GROUP_SEPARATOR, limit - position);
+        value_end = separator ? (size_t)(separator - label) : limit;
+
+        element.value.data = label + position;
+        element.value.length = value_end - position;
+        if (element.value.length < min_length)
+        {
+            return Fail(elements, kGs1TooShort, element_start);
+        }
+        if (element.value.length > max_length)
+        {
+            return Fail(elements, kGs1TooLong, element_start);
+        }
+        for (size_t i = 0; i < element.value.length; i++)
+        {
+            char c = element.value.data[i];
+            if ((numeric || i < spec->check_digits) ? !IsDigit(c) : !IsCset82(c))
+            {
+                return Fail(elements, (numeric || i < spec->check_digits) ? kGs1NotNumeric : kGs1InvalidCharacter, element_start);
+            }
+        }
+        if (spec->check_digits != 0 && !CheckDigitValid(element.value.data, spec->check_digits))
+        {
+            return Fail(elements, kGs1BadCheckDigit, element_start);
+        }
+        if (spec->date && !DateValid(element.value.data))
+        {
+            return Fail(elements, kGs1BadDate, element_start);
+        }
+        elements->count++;
+
+        position = value_end;
+        if (position < length && label[position] == GS1_GROUP_SEPARATOR)
+        {
+            position++;
+        }
+    }
+    return true;
+}
+
+const char* Gs1ErrorText(Gs1Error error)
+{
+    switch (error)
+    {
+    case kGs1Ok:                return "valid";
+    case kGs1Empty:             return "empty element string";
+    case kGs1UnknownAi:         return "unknown application identifier";
+    case kGs1TooShort:          return "data too short";
+    case kGs1TooLong:           return "data too long";
+    case kGs1NotNumeric:        return "digit expected";
+    case kGs1InvalidCharacter:  return "character not allowed in GS1 data";
+    case kGs1BadCheckDigit:     return "wrong check digit";
+    case kGs1BadDate:           return "invalid date";
+    case kGs1TooManyElements:   return "too many elements";
+    default:                    return "unknown error";
+    }
+}
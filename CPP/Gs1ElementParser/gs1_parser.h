@@ -0,0 +1,128 @@
+/*******************************************************************************************
+* @file gs1_parser.h
+* @brief Parsing of GS1 element strings (application identifiers) in decoded labels
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <string>
+
+//---- GS1 separator ------//
+#define GS1_GROUP_SEPARATOR 0x1D    // FNC1 as transmitted in a decoded label
+
+/**
+* View of part of a label buffer (not null terminated, valid while the label is)
+**/
+struct Gs1Slice
+{
+    const char* data;
+    size_t length;
+
+    /**
+    * Compare slice content with a null terminated string
+    */
+    bool Equals(const char* text) const;
+
+    /**
+    * Copy slice content to a string
+    */
+    std::string ToString() const;
+};
+
+/**
+* Dictionary entry of an application identifier (or a family of them, e.g. 310n)
+**/
+struct Gs1AiSpec
+{
+    const char* prefix;         // Digits identifying the AI; for a family, the AI without its last digit
+    unsigned char ai_length;    // Digits of the AI (prefix length + 1 for a family whose last digit is the decimal point position)
+    unsigned char min_length;   // Data length limits
+    unsigned char max_length;
+    bool numeric;               // Data is digits only
+    unsigned char check_digits; // Leading data digits ending with a GS1 mod 10 check digit (0 - none)
+    bool date;                  // Data starts with a YYMMDD date
+    const char* title;          // GS1 data title
+};
+
+/**
+* One element of a GS1 element string
+**/
+struct Gs1Element
+{
+    Gs1Slice ai;
+    Gs1Slice value;
+    const Gs1AiSpec* spec;
+    bool verified;              // false - AI missing from the dictionary: only the generic checks (Cset82, 1 to 90 characters, or digits of the predefined length) were applied
+    int decimals;               // Implied decimal point position (310n ...), -1 for other AIs
+};
+
+/**
+* Parse outcome
+**/
+enum Gs1Error
+{
+    kGs1Ok,
+    kGs1Empty,
+    kGs1UnknownAi,
+    kGs1TooShort,
+    kGs1TooLong,
+    kGs1NotNumeric,
+    kGs1InvalidCharacter,
+    kGs1BadCheckDigit,
+    kGs1BadDate,
+    kGs1TooManyElements
+};
+
+/**
+* Elements of one label. Values point into the label buffer - nothing is copied or allocated.
+**/
+struct Gs1ElementString
+{
+    static const int kMaxElements = 32;
+
+    Gs1Element elements[kMaxElements];
+    int count;
+    Gs1Error error;
+    size_t error_offset;        // Offset of the element in error in the label
+
+    /**
+    * First element with an AI, NULL if none
+    */
+    const Gs1Element* Find(const char* ai) const;
+};
+
+/**
+* Returns true for symbologies whose labels carry GS1 element strings
+*/
+bool IsGs1Symbology(int symbology);
+
+/**
+* Look up the AI at the start of a buffer
+* @param data - Element string position
+* @param length - Bytes left
+* return value : Dictionary entry, NULL for an unknown AI
+*/
+const Gs1AiSpec* FindGs1Ai(const char* data, size_t length);
+
+/**
+* Parse a GS1 element string in one pass.
+* A leading symbology identifier (]C1, ]d2, ]Q3, ]e0) or FNC1 is skipped. Elements with a
+* predefined length (AIs 00-04, 11-20, 31-36, 41) need no separator; other elements end with
+* FNC1 (GS) or at the end of the label. Check digits and dates are validated.
+* An AI missing from the dictionary does not fail the label: its length comes from its first two
+* digits, its data from the predefined length table or up to FNC1, and the element is flagged
+* unverified. Its data is still checked - digits for a predefined length, otherwise 1 to 90
+* Cset82 characters - but not against AI specific rules such as check digits.
+* @param label - Label bytes
+* @param length - Label length
+* @param elements - Receives the elements parsed up to the first error
+* return value : true if the whole label is a valid element string
+*/
+bool ParseGs1(const char* label, size_t length, Gs1ElementString* elements);
+
+/**
+* Text description of a parse error
+*/
+const char* Gs1ErrorText(Gs1Error error);
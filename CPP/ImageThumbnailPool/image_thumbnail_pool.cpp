@@ -0,0 +1,557 @@
+/*******************************************************************************************
+* @file image_thumbnail_pool.cpp
+* @brief This file contains code snippet to make thumbnails of image event images on a worker pool
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "image_codec.h"
+#include "transcode_pool.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for image events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_IMAGE);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Get the ids of the connected scanners
+* @param scanner_ids - Receives scanner ids
+* return value : GetScanners success/fail status
+*/
+bool GetScannerIds(vector<int>* scanner_ids)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+    XmlReader reader(get_scanners_output_xml);
+    XmlSlice text;
+    while (reader.FindElement("scannerID") && reader.ReadElementText(&text))
+    {
+        scanner_ids->push_back((int)text.ToLong());
+    }
+    cout << "CoreScanner GetScanners() - Success, " << scanner_ids->size() << " scanners" << endl;
+    return true;
+}
+
+/*
+* Switch a scanner to image or barcode mode
+* @tparam Op DEVICE_CAPTURE_IMAGE or DEVICE_CAPTURE_BARCODE
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecModeSwitch(int scanner_id, const char* name)
+{
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, scanner_id);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() scanner ID:[" << scanner_id << "] - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() scanner ID:[" << scanner_id << "] - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+const char* ImageFormatName(ImageFileFormat format)
+{
+    switch (format)
+    {
+    case kImageJpeg:
+        return "JPEG";
+    case kImageBmp:
+        return "BMP";
+    case kImageTiff:
+        return "TIFF";
+    default:
+        return "unknown";
+    }
+}
+
+/*
+* Synthetic scanner image: a label with bars over a shaded background, with sensor noise
+*/
+Image MakeTestImage(int width, int height, int channels, unsigned seed)
+{
+    Image image;
+    image.Resize(width, height, channels);
+    mt19937 random(seed);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            bool label = x > width / 4 && x < width * 3 / 4 && y > height / 3 && y < height * 2 / 3;
+            int bar = (x * 7 / 5 + (x / 13) * (x / 29)) % 11 < 5 ? 30 : 220;
+            int base = label ? bar : 90 + (x + y) * 100 / (width + height);
+            for (int c = 0; c < channels; c++)
+            {
+                int tint = label ? 0 : c * 25;
+                image.pixels[((size_t)y * width + x) * channels + c] = (unsigned char)max(0, min(255, base + tint + (int)(random() % 13) - 6));
+            }
+        }
+    }
+    return image;
+}
+
+struct BenchmarkInput
+{
+    string name;
+    ImageFileFormat format;
+    vector<unsigned char> file;
+};
+
+/*
+* Image files as scanners send them: 1280x800 gray from a document imager in each format, a
+* 1280x960 color BMP and a 640x480 color JPEG (too small to decode at 1/8 scale)
+*/
+vector<BenchmarkInput> MakeBenchmarkInputs()
+{
+    Image gray = MakeTestImage(1280, 800, 1, 1);
+    Image color = MakeTestImage(1280, 960, 3, 2);
+    Image small_color = MakeTestImage(640, 480, 3, 3);
+    vector<BenchmarkInput> inputs(6);
+    inputs[0].name = "JPEG 1280x800 gray";
+    inputs[0].format = kImageJpeg;
+    EncodeJpeg(gray, 85, &inputs[0].file);
+    inputs[1].name = "BMP 1280x800 gray";
+    inputs[1].format = kImageBmp;
+    EncodeBmp(gray, &inputs[1].file);
+    inputs[2].name = "TIFF 1280x800 gray";
+    inputs[2].format = kImageTiff;
+    EncodeTiff(gray, false, &inputs[2].file);
+    inputs[3].name = "TIFF PackBits 1280x800 gray";
+    inputs[3].format = kImageTiff;
+    EncodeTiff(gray, true, &inputs[3].file);
+    inputs[4].name = "BMP 1280x960 color";
+    inputs[4].format = kImageBmp;
+    EncodeBmp(color, &inputs[4].file);
+    inputs[5].name = "JPEG 640x480 color";
+    inputs[5].format = kImageJpeg;
+    EncodeJpeg(small_color, 85, &inputs[5].file);
+    return inputs;
+}
+
+/*
+* Stage times of the images made from one benchmark input
+*/
+struct InputTimes
+{
+    long images;
+    double decode_ms;
+    double scale_ms;
+    double encode_ms;
+    size_t output_bytes;
+    int thumbnail_width;
+    int thumbnail_height;
+
+    InputTimes() : images(0), decode_ms(0), scale_ms(0), encode_ms(0), output_bytes(0), thumbnail_width(0), thumbnail_height(0) {}
+};
+
+/*
+* Submit images round robin from the inputs and wait for all of them
+* return value : Elapsed time in milliseconds
+*/
+double RunTranscodePool(const TranscodeSettings& settings, const vector<BenchmarkInput>& inputs, int images,
+    TranscodeMetrics* metrics, vector<InputTimes>* input_times)
+{
+    mutex times_mutex;
+    input_times->assign(inputs.size(), InputTimes());
+    int failed = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    {
+        // The scanner id carries the input index
+        TranscodePool pool(settings, [&](const TranscodeResult& result)
+        {
+            lock_guard<mutex> lock(times_mutex);
+            if (!result.succeeded)
+            {
+                failed++;
+                return;
+            }
+            InputTimes& times = (*input_times)[result.scanner_id];
+            times.images++;
+            times.decode_ms += result.decode_ms;
+            times.scale_ms += result.scale_ms;
+            times.encode_ms += result.encode_ms;
+            times.output_bytes += result.thumbnail_size + (result.original_format != result.source_format ? result.original_size : 0);
+            times.thumbnail_width = result.thumbnail_width;
+            times.thumbnail_height = result.thumbnail_height;
+        });
+        for (int i = 0; i < images; i++)
+        {
+            const BenchmarkInput& input = inputs[i % inputs.size()];
+            pool.Submit((int)(i % inputs.size()), (short)input.format, input.file.data(), input.file.size());
+        }
+        pool.Wait();
+        *metrics = pool.Metrics();
+    }
+    if (failed != 0)
+    {
+        cout << " " << failed << " images failed" << endl;
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/*
+* Thumbnails of simulated image events with 1 worker up to one per core, then with the BMP/TIFF
+* originals re-encoded to JPEG as well
+*/
+void RunTranscodeBenchmark()
+{
+    const int kImages = 200;
+    vector<BenchmarkInput> inputs = MakeBenchmarkInputs();
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        cout << " " << inputs[i].name << " : " << inputs[i].file.size() / 1024 << " KB" << endl;
+    }
+
+    int cores = (int)max(1u, thread::hardware_concurrency());
+    vector<int> worker_counts;
+    for (int workers = 1; workers < cores; workers *= 2)
+    {
+        worker_counts.push_back(workers);
+    }
+    worker_counts.push_back(cores);
+
+    TranscodeSettings settings;
+    settings.queued_images = 8;
+    vector<InputTimes> single_worker_times;
+    for (size_t w = 0; w < worker_counts.size(); w++)
+    {
+        settings.workers = worker_counts[w];
+        TranscodeMetrics metrics;
+        vector<InputTimes> input_times;
+        double elapsed_ms = RunTranscodePool(settings, inputs, kImages, &metrics, &input_times);
+        double images_per_second = kImages * 1000.0 / elapsed_ms;
+        cout << "JPEG thumbnails, " << settings.workers << " workers : " << kImages << " images in " << elapsed_ms << " ms, "
+             << images_per_second << " images/s, " << images_per_second / settings.workers << " images/s per worker, "
+             << metrics.images * 1000.0 / metrics.busy_ms << " images/s per busy core, " << metrics.submit_waits << " submits waited" << endl;
+        if (w == 0)
+        {
+            single_worker_times = input_times;
+        }
+    }
+
+    cout << "Per image, 1 worker (decode / scale / encode ms, thumbnail bytes and size)" << endl;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        const InputTimes& times = single_worker_times[i];
+        if (times.images == 0)
+        {
+            continue;
+        }
+        cout << " " << inputs[i].name << " : " << times.decode_ms / times.images << " / " << times.scale_ms / times.images << " / "
+             << times.encode_ms / times.images << ", " << times.output_bytes / times.images << ", "
+             << times.thumbnail_width << "x" << times.thumbnail_height << endl;
+    }
+
+    settings.workers = cores;
+    settings.transcode_originals = true;
+    TranscodeMetrics metrics;
+    vector<InputTimes> input_times;
+    double elapsed_ms = RunTranscodePool(settings, inputs, kImages, &metrics, &input_times);
+    double images_per_second = kImages * 1000.0 / elapsed_ms;
+    cout << "JPEG thumbnails and originals, " << settings.workers << " workers : " << kImages << " images in " << elapsed_ms << " ms, "
+         << images_per_second << " images/s, " << metrics.images * 1000.0 / metrics.busy_ms << " images/s per busy core" << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Thumbnail worker pool benchmark (simulated image events)" << endl;
+    RunTranscodeBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    vector<int> scanner_ids;
+    if (ConnectEvents() && Open() && GetScannerIds(&scanner_ids))
+    {
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            TranscodeSettings settings;
+            {
+                TranscodePool pool(settings, [](const TranscodeResult& result)
+                {
+                    if (!result.succeeded)
+                    {
+                        cout << "Image " << result.image_id << " scanner ID:[" << result.scanner_id << "] - "
+                             << ImageFormatName(result.source_format) << " image could not be decoded" << endl;
+                        return;
+                    }
+                    cout << "Image " << result.image_id << " scanner ID:[" << result.scanner_id << "] - "
+                         << ImageFormatName(result.source_format) << " " << result.original_size << " bytes, thumbnail "
+                         << result.thumbnail_width << "x" << result.thumbnail_height << " " << ImageFormatName(kImageJpeg) << " "
+                         << result.thumbnail_size << " bytes in " << result.decode_ms + result.scale_ms + result.encode_ms << " ms" << endl;
+                });
+                scanner_event_sink->SetCaptureHandler([&pool](int event_type, short format, const unsigned char* data, long size, const string& scanner_data)
+                {
+                    string value;
+                    if (data != NULL && size > 0)
+                    {
+                        pool.Submit(XmlFindText(scanner_data, "scannerID", &value) ? atoi(value.c_str()) : 0, format, data, (size_t)size);
+                    }
+                });
+
+                for (size_t i = 0; i < scanner_ids.size(); i++)
+                {
+                    ExecModeSwitch<DEVICE_CAPTURE_IMAGE>(scanner_ids[i], "CaptureImage");
+                }
+                WaitForInput("Scanners in image mode on " + to_string(pool.WorkerCount()) + " workers, pull the trigger to take images, press any key to exit.");
+                scanner_event_sink->SetCaptureHandler(nullptr);
+                for (size_t i = 0; i < scanner_ids.size(); i++)
+                {
+                    ExecModeSwitch<DEVICE_CAPTURE_BARCODE>(scanner_ids[i], "CaptureBarcode");
+                }
+                pool.Wait();
+
+                TranscodeMetrics metrics = pool.Metrics();
+                if (metrics.images != 0)
+                {
+                    cout << metrics.images << " images, " << metrics.failed << " failed, per image decode "
+                         << metrics.decode_ms / metrics.images << " ms, scale " << metrics.scale_ms / metrics.images << " ms, encode "
+                         << metrics.encode_ms / metrics.images << " ms" << endl;
+                }
+            }
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+        }
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,200 @@
+/*******************************************************************************************
+* @file transcode_pool.cpp
+* @brief Definition of the image transcoding worker pool
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "transcode_pool.h"
+#include <algorithm>
+
+using namespace std;
+
+static double MillisecondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+TranscodePool::TranscodePool(const TranscodeSettings& settings, const ResultHandler& handler)
+    : settings_(settings), handler_(handler), next_image_id_(1), in_flight_(0), stopping_(false)
+{
+    int worker_count = settings_.workers > 0 ? settings_.workers : (int)max(1u, thread::hardware_concurrency());
+    int input_count = max(1, settings_.queued_images) + worker_count;
+    for (int i = 0; i < input_count; i++)
+    {
+        all_inputs_.push_back(new vector<unsigned char>());
+    }
+    free_inputs_ = all_inputs_;
+    for (int i = 0; i < worker_count; i++)
+    {
+        workers_.push_back(thread(&TranscodePool::Run, this, i));
+    }
+}
+
+TranscodePool::~TranscodePool()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    job_ready_.notify_all();
+    for (size_t i = 0; i < workers_.size(); i++)
+    {
+        workers_[i].join();
+    }
+    for (size_t i = 0; i < all_inputs_.size(); i++)
+    {
+        delete all_inputs_[i];
+    }
+}
+
+long TranscodePool::Submit(int scanner_id, short image_format, const unsigned char* data, size_t size)
+{
+    unique_lock<mutex> lock(mutex_);
+    if (free_inputs_.empty())
+    {
+        metrics_.submit_waits++;
+        buffer_free_.wait(lock, [this] { return !free_inputs_.empty(); });
+    }
+    vector<unsigned char>* input = free_inputs_.back();
+    free_inputs_.pop_back();
+    long image_id = next_image_id_++;
+    in_flight_++;
+
+    // The event buffer is only valid during the event, copy it outside the lock
+    lock.unlock();
+    input->assign(data, data + size);
+    Job job = { image_id, scanner_id, image_format, input, Clock::now() };
+    lock.lock();
+    jobs_.push_back(job);
+    job_ready_.notify_one();
+    return image_id;
+}
+
+void TranscodePool::Wait()
+{
+    unique_lock<mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+TranscodeMetrics TranscodePool::Metrics() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return metrics_;
+}
+
+/**
+* Worker thread - takes the queued images in order until the pool stops and the queue is empty
+**/
+void TranscodePool::Run(int worker)
+{
+    WorkerBuffers buffers;
+    unique_lock<mutex> lock(mutex_);
+    while (true)
+    {
+        job_ready_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty())
+        {
+            break;
+        }
+        Job job = jobs_.front();
+        jobs_.pop_front();
+        lock.unlock();
+
+        Clock::time_point started_at = Clock::now();
+        TranscodeResult result = TranscodeResult();
+        result.queued_ms = chrono::duration<double, milli>(started_at - job.submitted_at).count();
+        Transcode(worker, &buffers, job, &result);
+        if (handler_)
+        {
+            handler_(result);
+        }
+        double busy_ms = MillisecondsSince(started_at);
+
+        lock.lock();
+        metrics_.images++;
+        metrics_.failed += result.succeeded ? 0 : 1;
+        metrics_.decode_ms += result.decode_ms;
+        metrics_.scale_ms += result.scale_ms;
+        metrics_.encode_ms += result.encode_ms;
+        metrics_.busy_ms += busy_ms;
+        free_inputs_.push_back(job.input);
+        buffer_free_.notify_one();
+        if (--in_flight_ == 0)
+        {
+            idle_.notify_all();
+        }
+    }
+}
+
+/**
+* Decode, scale and encode one image into the worker's buffers
+**/
+void TranscodePool::Transcode(int worker, WorkerBuffers* buffers, const Job& job, TranscodeResult* result)
+{
+    const unsigned char* data = job.input->data();
+    size_t size = job.input->size();
+    result->image_id = job.image_id;
+    result->scanner_id = job.scanner_id;
+    result->worker = worker;
+    result->original = data;
+    result->original_size = size;
+    ImageFileFormat detected = DetectImageFormat(data, size);
+    result->source_format = detected != kImageUnknown ? detected : (ImageFileFormat)job.image_format;
+    result->original_format = result->source_format;
+
+    Clock::time_point stage_start = Clock::now();
+    Image& decoded = buffers->decoded;
+    bool decoded_ok = false;
+    switch (result->source_format)
+    {
+    case kImageJpeg:
+        decoded_ok = DecodeJpeg(data, size, settings_.max_pixels, settings_.thumbnail_size, &decoded);
+        break;
+    case kImageBmp:
+        decoded_ok = DecodeBmp(data, size, settings_.max_pixels, &decoded);
+        break;
+    case kImageTiff:
+        decoded_ok = DecodeTiff(data, size, settings_.max_pixels, &decoded);
+        break;
+    default:
+        break;
+    }
+    result->decode_ms = MillisecondsSince(stage_start);
+    if (!decoded_ok)
+    {
+        return;
+    }
+    result->width = decoded.width;
+    result->height = decoded.height;
+
+    stage_start = Clock::now();
+    int longer_side = max(decoded.width, decoded.height);
+    int thumbnail_width = decoded.width;
+    int thumbnail_height = decoded.height;
+    if (longer_side > settings_.thumbnail_size)
+    {
+        thumbnail_width = max(1, (int)((int64_t)decoded.width * settings_.thumbnail_size / longer_side));
+        thumbnail_height = max(1, (int)((int64_t)decoded.height * settings_.thumbnail_size / longer_side));
+    }
+    DownsampleBox(decoded, thumbnail_width, thumbnail_height, &buffers->thumbnail, &buffers->column_sums);
+    result->scale_ms = MillisecondsSince(stage_start);
+
+    stage_start = Clock::now();
+    EncodeImage(buffers->thumbnail, settings_.target_format, settings_.jpeg_quality, &buffers->encoded_thumbnail);
+    if (settings_.transcode_originals && result->source_format != kImageJpeg && result->source_format != settings_.target_format)
+    {
+        EncodeImage(decoded, settings_.target_format, settings_.jpeg_quality, &buffers->encoded_original);
+        result->original = buffers->encoded_original.data();
+        result->original_size = buffers->encoded_original.size();
+        result->original_format = settings_.target_format;
+    }
+    result->encode_ms = MillisecondsSince(stage_start);
+
+    result->thumbnail = buffers->encoded_thumbnail.data();
+    result->thumbnail_size = buffers->encoded_thumbnail.size();
+    result->thumbnail_width = buffers->thumbnail.width;
+    result->thumbnail_height = buffers->thumbnail.height;
+    result->succeeded = true;
+}
@@ -0,0 +1,168 @@
+/*******************************************************************************************
+* @file transcode_pool.h
+* @brief Worker pool decoding scanner images, making thumbnails and re-encoding them, with pooled buffers
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "image_codec.h"
+
+/**
+* Transcode pool settings
+**/
+struct TranscodeSettings
+{
+    int workers;                    // 0 - one per core
+    int queued_images;              // Images waiting for a worker, beyond it Submit() waits
+    int thumbnail_size;             // Longer side of the thumbnails, in pixels, smaller images keep their size. JPEGs
+                                    // are decoded at 1/8 scale when that is at least this size, otherwise at full size
+    ImageFileFormat target_format;  // kImageJpeg, kImageBmp or kImageTiff
+    int jpeg_quality;
+    bool transcode_originals;       // Re-encode BMP/TIFF originals to the target format too (JPEG originals are kept)
+    size_t max_pixels;              // Larger images are rejected before any buffer is sized for them
+
+    TranscodeSettings()
+        : workers(0), queued_images(16), thumbnail_size(160), target_format(kImageJpeg), jpeg_quality(80),
+        transcode_originals(false), max_pixels(16 * 1024 * 1024) {}
+};
+
+/**
+* Outcome of one image. The original and thumbnail bytes are only valid during the result handler
+* call - the buffers go back to the pool after it.
+**/
+struct TranscodeResult
+{
+    long image_id;
+    int scanner_id;
+    bool succeeded;
+    ImageFileFormat source_format;
+    int width;                              // Decoded size - 1/8 of the original for JPEG at least 8 * thumbnail_size
+    int height;
+    const unsigned char* original;          // Submitted bytes, or re-encoded with transcode_originals
+    size_t original_size;
+    ImageFileFormat original_format;
+    const unsigned char* thumbnail;
+    size_t thumbnail_size;
+    int thumbnail_width;
+    int thumbnail_height;
+    int worker;
+    double queued_ms;                       // Submit() to a worker taking the image
+    double decode_ms;
+    double scale_ms;
+    double encode_ms;
+};
+
+/**
+* Transcode pool counters
+**/
+struct TranscodeMetrics
+{
+    long images;
+    long failed;
+    double decode_ms;
+    double scale_ms;
+    double encode_ms;
+    double busy_ms;             // Sum over the workers
+    long submit_waits;          // Submit() calls that waited for a free input buffer
+
+    TranscodeMetrics() : images(0), failed(0), decode_ms(0), scale_ms(0), encode_ms(0), busy_ms(0), submit_waits(0) {}
+};
+
+/**
+* Decodes images from image events on a pool of worker threads, makes a thumbnail of each and
+* encodes it to the target format; BMP and TIFF originals can be re-encoded as well.
+*
+* Memory is bounded: Submit() copies the image into one of queued_images + workers input buffers
+* and waits while all of them are in use, and each worker decodes, scales and encodes into its
+* own buffers. All buffers keep their capacity from image to image, so after the first images of
+* the largest size nothing is allocated. JPEG originals are decoded at 1/8 scale from their DC
+* coefficients, which is as far as a thumbnail needs, unless that is smaller than the thumbnail -
+* then they are decoded at full size like BMP and TIFF.
+*
+* The result handler runs on the worker threads, concurrently.
+**/
+class TranscodePool
+{
+public:
+    typedef std::function<void(const TranscodeResult& result)> ResultHandler;
+
+    /**
+    * Transcode pool constructor - starts the workers
+    */
+    TranscodePool(const TranscodeSettings& settings, const ResultHandler& handler);
+
+    /**
+    * Finish the submitted images and stop the workers
+    */
+    ~TranscodePool();
+
+    TranscodePool(const TranscodePool&) = delete;
+    TranscodePool& operator=(const TranscodePool&) = delete;
+
+    /**
+    * Queue an image (call from the image event handler). Waits while every input buffer is in use.
+    * @param image_format - Format of the image event, the file signature decides if it disagrees
+    * return value : Image id
+    */
+    long Submit(int scanner_id, short image_format, const unsigned char* data, size_t size);
+
+    /**
+    * Wait until every submitted image is handled
+    */
+    void Wait();
+
+    int WorkerCount() const { return (int)workers_.size(); }
+
+    TranscodeMetrics Metrics() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Job
+    {
+        long image_id;
+        int scanner_id;
+        short image_format;
+        std::vector<unsigned char>* input;
+        Clock::time_point submitted_at;
+    };
+
+    /**
+    * Buffers of one worker, reused for every image
+    */
+    struct WorkerBuffers
+    {
+        Image decoded;
+        Image thumbnail;
+        std::vector<uint32_t> column_sums;
+        std::vector<unsigned char> encoded_thumbnail;
+        std::vector<unsigned char> encoded_original;
+    };
+
+    void Run(int worker);
+    void Transcode(int worker, WorkerBuffers* buffers, const Job& job, TranscodeResult* result);
+
+    TranscodeSettings settings_;
+    ResultHandler handler_;
+    std::vector<std::thread> workers_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable job_ready_;
+    std::condition_variable buffer_free_;
+    std::condition_variable idle_;
+    std::deque<Job> jobs_;
+    std::vector<std::vector<unsigned char>*> free_inputs_;
+    std::vector<std::vector<unsigned char>*> all_inputs_;
+    long next_image_id_;
+    long in_flight_;            // Submitted, result handler not returned
+    TranscodeMetrics metrics_;
+    bool stopping_;
+};
@@ -0,0 +1,197 @@
+/*******************************************************************************************
+* @file keyboard_emulator_manager.h
+* @brief HID keyboard emulator provisioning that reads the configuration once and sends only the needed commands
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include "common_defs.h"
+#include "opcode_traits.h"
+
+/**
+* HID keyboard emulator state
+**/
+struct KeyboardEmulatorState
+{
+    bool enabled;
+    int locale;     // LANGUAGE_CODES
+
+    KeyboardEmulatorState(bool emulator_enabled = false, int language = DEFAULT)
+        : enabled(emulator_enabled), locale(language)
+    {
+    }
+
+    bool operator==(const KeyboardEmulatorState& other) const { return enabled == other.enabled && locale == other.locale; }
+    bool operator!=(const KeyboardEmulatorState& other) const { return !(*this == other); }
+};
+
+/**
+* Brings the CoreScanner HID keyboard emulator to a desired state with as few commands as possible.
+*
+* The current configuration is read with KEYBOARD_EMULATOR_GET_CONFIG once and cached; Apply()
+* compares the desired state with the cache and sends KEYBOARD_EMULATOR_SET_LOCALE and/or
+* KEYBOARD_EMULATOR_ENABLE only for the values that differ, so re-provisioning a lane that is
+* already configured costs the single read. The locale is changed while the emulator is off
+* (before enabling, after disabling) so no keystrokes are typed with the wrong layout.
+* The cache follows successful commands and is dropped when a command fails, so the next
+* Apply() reads the configuration again instead of trusting a guess.
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommand signature (e.g. MockKeyboardEmulatorHost)
+**/
+template <typename Scanner>
+class KeyboardEmulatorManager
+{
+public:
+    /**
+    * Keyboard emulator manager constructor
+    * @param scanner - CoreScanner interface
+    */
+    explicit KeyboardEmulatorManager(Scanner* scanner)
+        : scanner_(scanner), cached_(false), last_status_(STATUS_SUCCESS), command_count_(0)
+    {
+    }
+
+    /**
+    * Read the configuration with KEYBOARD_EMULATOR_GET_CONFIG, replacing the cached one
+    * return value : Command success/fail status
+    */
+    bool Refresh()
+    {
+        CommandResult<KeyboardEmulatorConfig> result = Exec<KEYBOARD_EMULATOR_GET_CONFIG>(scanner_);
+        command_count_++;
+        last_status_ = result.status;
+        cached_ = result.Succeeded() && result.parsed;
+        if (cached_)
+        {
+            current_ = KeyboardEmulatorState(result.response.enabled, result.response.locale);
+        }
+        return cached_;
+    }
+
+    /**
+    * Bring the keyboard emulator to a desired state
+    * @param desired - Desired enabled state and locale
+    * return value : true if the emulator is in the desired state
+    */
+    bool Apply(const KeyboardEmulatorState& desired)
+    {
+        if (desired.locale <= STARTCODE || desired.locale >= ENDCODE)
+        {
+            return false;
+        }
+        if (!cached_ && !Refresh())
+        {
+            return false;
+        }
+
+        if (desired.enabled)
+        {
+            return SendLocale(desired.locale) && SendEnabled(true);
+        }
+        return SendEnabled(false) && SendLocale(desired.locale);
+    }
+
+    /**
+    * Enable or disable the keyboard emulator, keeping the locale
+    * return value : true if the emulator is in the requested state
+    */
+    bool Enable(bool enabled)
+    {
+        if (!cached_ && !Refresh())
+        {
+            return false;
+        }
+        return Apply(KeyboardEmulatorState(enabled, current_.locale));
+    }
+
+    /**
+    * Change the locale, keeping the enabled state
+    * return value : true if the emulator uses the requested locale
+    */
+    bool SetLocale(int locale)
+    {
+        if (!cached_ && !Refresh())
+        {
+            return false;
+        }
+        return Apply(KeyboardEmulatorState(current_.enabled, locale));
+    }
+
+    /**
+    * Cached configuration
+    * return value : false if the configuration has not been read (or a command failed since)
+    */
+    bool Current(KeyboardEmulatorState* state) const
+    {
+        if (cached_)
+        {
+            *state = current_;
+        }
+        return cached_;
+    }
+
+    /**
+    * Forget the cached configuration (changed outside this manager)
+    */
+    void Invalidate() { cached_ = false; }
+
+    /**
+    * Status of the last command
+    */
+    LONG LastStatus() const { return last_status_; }
+
+    /**
+    * Commands sent, reads included
+    */
+    long CommandCount() const { return command_count_; }
+
+private:
+    bool SendEnabled(bool enabled)
+    {
+        if (current_.enabled == enabled)
+        {
+            return true;
+        }
+        if (!Sent(Exec<KEYBOARD_EMULATOR_ENABLE>(scanner_, enabled)))
+        {
+            return false;
+        }
+        current_.enabled = enabled;
+        return true;
+    }
+
+    bool SendLocale(int locale)
+    {
+        if (current_.locale == locale)
+        {
+            return true;
+        }
+        if (!Sent(Exec<KEYBOARD_EMULATOR_SET_LOCALE>(scanner_, locale)))
+        {
+            return false;
+        }
+        current_.locale = locale;
+        return true;
+    }
+
+    /**
+    * Account for a command, dropping the cache when it failed
+    */
+    bool Sent(const CommandResult<NoResponse>& result)
+    {
+        command_count_++;
+        last_status_ = result.status;
+        if (!result.Succeeded())
+        {
+            cached_ = false;
+        }
+        return result.Succeeded();
+    }
+
+    Scanner* scanner_;
+    KeyboardEmulatorState current_;
+    bool cached_;
+    LONG last_status_;
+    long command_count_;
+};
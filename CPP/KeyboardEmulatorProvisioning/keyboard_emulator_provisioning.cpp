@@ -0,0 +1,260 @@
+/*******************************************************************************************
+* @file keyboard_emulator_provisioning.cpp
+* @brief This file contains code snippet to provision the HID keyboard emulator with the fewest commands
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "keyboard_emulator_manager.h"
+#include "mock_keyboard_emulator_host.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Print min/median/max of per lane provisioning times
+*/
+void PrintLaneTimes(const char* name, vector<double> times_ms, long commands)
+{
+    sort(times_ms.begin(), times_ms.end());
+    cout << " " << name << " : min " << times_ms.front() << " ms, median " << times_ms[times_ms.size() / 2]
+         << " ms, max " << times_ms.back() << " ms per lane, " << commands << " commands" << endl;
+}
+
+/*
+* Provision a row of mock lanes on boot, the way kiosks did it (set locale and enable every time)
+* and with the keyboard emulator manager. Most lanes are already configured from the previous boot.
+*/
+void RunLaneBenchmark()
+{
+    const int kLaneCount = 24;
+    const KeyboardEmulatorState desired(true, ENGLISH);
+
+    vector<double> blind_ms;
+    vector<double> managed_ms;
+    long blind_commands = 0;
+    long managed_commands = 0;
+    int configured_lanes = 0;
+    for (int lane = 0; lane < kLaneCount; lane++)
+    {
+        // Every 4th lane was reset to defaults, every 6th was left disabled
+        bool enabled = (lane % 6 != 0);
+        int locale = (lane % 4 == 0) ? DEFAULT : ENGLISH;
+
+        MockKeyboardEmulatorHost blind_host(enabled, locale);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        Exec<KEYBOARD_EMULATOR_SET_LOCALE>(&blind_host, desired.locale);
+        Exec<KEYBOARD_EMULATOR_ENABLE>(&blind_host, desired.enabled);
+        blind_ms.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        blind_commands += blind_host.CommandCount();
+
+        MockKeyboardEmulatorHost managed_host(enabled, locale);
+        KeyboardEmulatorManager<MockKeyboardEmulatorHost> manager(&managed_host);
+        start = chrono::steady_clock::now();
+        bool applied = manager.Apply(desired);
+        managed_ms.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        managed_commands += manager.CommandCount();
+        if (applied && managed_host.Enabled() == desired.enabled && managed_host.Locale() == desired.locale)
+        {
+            configured_lanes++;
+        }
+    }
+
+    cout << "Keyboard emulator provisioning of " << kLaneCount << " mock lanes" << endl;
+    PrintLaneTimes("Set locale and enable on every boot", blind_ms, blind_commands);
+    PrintLaneTimes("Read once, send the differences", managed_ms, managed_commands);
+    cout << " Lanes in the desired state : " << configured_lanes << "/" << kLaneCount << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    RunLaneBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (Open())
+    {
+        KeyboardEmulatorManager<ICoreScanner> manager(scanner_interface);
+        KeyboardEmulatorState current;
+        if (manager.Refresh() && manager.Current(&current))
+        {
+            cout << "Keyboard emulator " << (current.enabled ? "enabled" : "disabled") << ", locale " << current.locale << endl;
+        }
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        if (manager.Apply(KeyboardEmulatorState(true, ENGLISH)))
+        {
+            cout << "Keyboard emulator provisioning - Success (" << manager.CommandCount() << " commands, "
+                 << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms)" << endl;
+        }
+        else
+        {
+            cout << "Keyboard emulator provisioning - Failed. Error Code : " << manager.LastStatus() << endl;
+        }
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
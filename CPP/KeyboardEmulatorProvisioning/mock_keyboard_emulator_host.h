@@ -0,0 +1,92 @@
+/*******************************************************************************************
+* @file mock_keyboard_emulator_host.h
+* @brief Simulated CoreScanner host answering the HID keyboard emulator commands
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include "common_defs.h"
+#include "xml_reader.h"
+
+/**
+* Simulated keyboard emulator of one lane with the ICoreScanner::ExecCommand signature, used to
+* benchmark provisioning without hardware. Every command takes command_latency_ms of real time.
+**/
+class MockKeyboardEmulatorHost
+{
+public:
+    static const LONG kStatusFailed = 1;
+
+    /**
+    * Mock host constructor
+    * @param enabled - Initial emulator state
+    * @param locale - Initial locale (LANGUAGE_CODES)
+    * @param command_latency_ms - Time each command takes
+    */
+    MockKeyboardEmulatorHost(bool enabled, int locale, int command_latency_ms = 5)
+        : enabled_(enabled), locale_(locale), command_latency_ms_(command_latency_ms), command_count_(0)
+    {
+    }
+
+    bool Enabled() const { return enabled_; }
+    int Locale() const { return locale_; }
+    long CommandCount() const { return command_count_; }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        command_count_++;
+        *out_xml = NULL;
+        *status = STATUS_SUCCESS;
+        std::this_thread::sleep_for(std::chrono::milliseconds(command_latency_ms_));
+
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        std::string value;
+        switch (opcode)
+        {
+        case KEYBOARD_EMULATOR_ENABLE:
+            if (!XmlFindText(in, "arg-bool", &value))
+            {
+                *status = kStatusFailed;
+                break;
+            }
+            enabled_ = (value == "TRUE");
+            break;
+        case KEYBOARD_EMULATOR_SET_LOCALE:
+            if (!XmlFindText(in, "arg-int", &value))
+            {
+                *status = kStatusFailed;
+                break;
+            }
+            locale_ = atoi(value.c_str());
+            break;
+        case KEYBOARD_EMULATOR_GET_CONFIG:
+        {
+            std::string out = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><arg-xml><KeyEnumState>" +
+                std::string(enabled_ ? "1" : "0") + "</KeyEnumState><KeyEnumLocale>" + std::to_string(locale_) +
+                "</KeyEnumLocale></arg-xml></outArgs>";
+            std::wstring out_str(out.begin(), out.end());
+            *out_xml = SysAllocString(out_str.c_str());
+            break;
+        }
+        default:
+            *status = kStatusFailed;    // Not supported by the mock
+            break;
+        }
+        return S_OK;
+    }
+
+private:
+    bool enabled_;
+    int locale_;
+    int command_latency_ms_;
+    long command_count_;
+};
@@ -0,0 +1,431 @@
+/*******************************************************************************************
+* @file keyed_command_executor.cpp
+* @brief This file contains code snippet to run commands in parallel across scanners and in order per scanner
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "keyed_executor.h"
+#include "mock_command_host.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+IGlobalInterfaceTable* global_interface_table = NULL;  // Hands the interface to executor workers
+DWORD scanner_interface_cookie = 0;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Get the ids of the connected scanners
+* @param scanner_ids - Receives scanner ids
+* return value : GetScanners success/fail status
+*/
+bool GetScannerIds(vector<int>* scanner_ids)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+    XmlReader reader(get_scanners_output_xml);
+    XmlSlice text;
+    while (reader.FindElement("scannerID") && reader.ReadElementText(&text))
+    {
+        scanner_ids->push_back((int)text.ToLong());
+    }
+    cout << "CoreScanner GetScanners() - Success, " << scanner_ids->size() << " scanners" << endl;
+    return true;
+}
+
+/*
+* Give an executor worker thread its own CoreScanner interface from the global interface table
+*/
+ICoreScanner* AttachWorkerScanner(int worker)
+{
+    CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    ICoreScanner* worker_scanner = NULL;
+    HRESULT hr = global_interface_table->GetInterfaceFromGlobal(scanner_interface_cookie, IID_ICoreScanner, (void**)&worker_scanner);
+    if FAILED(hr)
+    {
+        cout << "CoreScanner interface unmarshaling for executor worker " << worker << " - Failed" << endl;
+        CoUninitialize();
+        return NULL;
+    }
+    return worker_scanner;
+}
+
+/*
+* Release the CoreScanner interface of an executor worker thread
+*/
+void DetachWorkerScanner(int worker, ICoreScanner* worker_scanner)
+{
+    if (worker_scanner != NULL)
+    {
+        worker_scanner->Release();
+        CoUninitialize();
+    }
+}
+
+/*
+* Post the beeper volume change of a scanner as three bulk commands on its strand
+*/
+template <typename Scanner>
+void PostReconfigure(KeyedExecutor<Scanner>* executor, int scanner_id, CommandPriority priority, atomic<long>* failures)
+{
+    Attribute beeper_volume = { 140, 'B', "1" };
+    executor->Post(scanner_id, priority, [scanner_id, failures](Scanner* scanner)
+    {
+        if (scanner == NULL || !Exec<DEVICE_SCAN_DISABLE>(scanner, scanner_id).Succeeded())
+        {
+            (*failures)++;
+        }
+    });
+    executor->Post(scanner_id, priority, [scanner_id, beeper_volume, failures](Scanner* scanner)
+    {
+        if (scanner == NULL || !Exec<RSM_ATTR_SET>(scanner, scanner_id, vector<Attribute>(1, beeper_volume)).Succeeded())
+        {
+            (*failures)++;
+        }
+    });
+    executor->Post(scanner_id, priority, [scanner_id, failures](Scanner* scanner)
+    {
+        if (scanner == NULL || !Exec<DEVICE_SCAN_ENABLE>(scanner, scanner_id).Succeeded())
+        {
+            (*failures)++;
+        }
+    });
+}
+
+/*
+* Check a scanner ran its bulk commands as DEVICE_SCAN_DISABLE, RSM_ATTR_SET, DEVICE_SCAN_ENABLE rounds
+*/
+bool BulkOrderKept(const vector<LONG>& history, int rounds)
+{
+    const LONG kRound[] = { DEVICE_SCAN_DISABLE, RSM_ATTR_SET, DEVICE_SCAN_ENABLE };
+    int position = 0;
+    for (size_t i = 0; i < history.size(); i++)
+    {
+        if (history[i] == SET_ACTION)
+        {
+            continue;
+        }
+        if (history[i] != kRound[position % 3])
+        {
+            return false;
+        }
+        position++;
+    }
+    return position == rounds * 3;
+}
+
+double Percentile(vector<double> values, double percentile)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    sort(values.begin(), values.end());
+    return values[(size_t)(percentile * (values.size() - 1))];
+}
+
+/*
+* Reconfigure every scanner while beeps arrive on a timer, one command at a time (snippets today)
+* and through the keyed executor without and with priorities. Measures total throughput and the
+* time from posting a beep to the beep done.
+*/
+void RunExecutorBenchmark()
+{
+    const int kScanners = 8;
+    const int kRounds = 10;
+    const int kBeeps = 40;
+    const int kBeepIntervalMs = 10;
+    const int kWorkers = 4;
+    const char* names[] = { "One at a time (snippets today)", "KeyedExecutor, FIFO", "KeyedExecutor, beeps interactive" };
+
+    for (int strategy = 0; strategy < 3; strategy++)
+    {
+        MockCommandHost host(4, 2);
+        atomic<long> failures(0);
+        vector<double> beep_ms(kBeeps);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        long long steals = 0;
+        {
+            KeyedExecutor<MockCommandHost> executor(strategy == 0 ? 1 : kWorkers, [&host](int) { return &host; });
+            CommandPriority bulk = strategy == 2 ? kPriorityBulk : kPriorityNormal;
+            CommandPriority beep = strategy == 2 ? kPriorityInteractive : kPriorityNormal;
+            for (int round = 0; round < kRounds; round++)
+            {
+                for (int scanner_id = 1; scanner_id <= kScanners; scanner_id++)
+                {
+                    PostReconfigure(&executor, scanner_id, bulk, &failures);
+                }
+            }
+            for (int i = 0; i < kBeeps; i++)
+            {
+                this_thread::sleep_for(chrono::milliseconds(kBeepIntervalMs));
+                int scanner_id = 1 + (i * 3) % kScanners;
+                chrono::steady_clock::time_point posted = chrono::steady_clock::now();
+                double* latency = &beep_ms[i];
+                executor.Post(scanner_id, beep, [scanner_id, posted, latency, &failures](MockCommandHost* scanner)
+                {
+                    if (!Exec<SET_ACTION>(scanner, scanner_id, ONESHORTHIGH).Succeeded())
+                    {
+                        failures++;
+                    }
+                    *latency = chrono::duration<double, milli>(chrono::steady_clock::now() - posted).count();
+                });
+            }
+            executor.Wait();
+            steals = executor.StealCount();
+        }
+        double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        bool ordered = true;
+        for (int scanner_id = 1; scanner_id <= kScanners; scanner_id++)
+        {
+            ordered = ordered && BulkOrderKept(host.History(scanner_id), kRounds);
+        }
+        int commands = kScanners * kRounds * 3 + kBeeps;
+        cout << names[strategy] << endl;
+        cout << " " << commands << " commands in " << elapsed_ms << " ms (" << commands * 1000.0 / elapsed_ms << " commands/s), "
+             << failures << " failed, " << steals << " strands stolen" << endl;
+        cout << " Beep latency p50 : " << Percentile(beep_ms, 0.5) << " ms, p99 : " << Percentile(beep_ms, 0.99)
+             << " ms, max : " << Percentile(beep_ms, 1.0) << " ms" << endl;
+        cout << " Per scanner order kept : " << (ordered ? "yes" : "NO") << ", overlapping commands : " << host.Overlaps() << endl;
+    }
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    const int kWorkerCount = 4;
+
+    cout << "Keyed executor benchmark (simulated host)" << endl;
+    RunExecutorBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    vector<int> scanner_ids;
+    if (Open() && GetScannerIds(&scanner_ids))
+    {
+        CoCreateInstance(CLSID_StdGlobalInterfaceTable, NULL, CLSCTX_INPROC_SERVER, IID_IGlobalInterfaceTable, (void**)&global_interface_table);
+        if (global_interface_table != NULL &&
+            SUCCEEDED(global_interface_table->RegisterInterfaceInGlobal(scanner_interface, IID_ICoreScanner, &scanner_interface_cookie)))
+        {
+            atomic<long> failures(0);
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            {
+                KeyedExecutor<ICoreScanner> executor(kWorkerCount, AttachWorkerScanner, DetachWorkerScanner);
+                for (size_t i = 0; i < scanner_ids.size(); i++)
+                {
+                    PostReconfigure(&executor, scanner_ids[i], kPriorityBulk, &failures);
+                }
+                // Posted last, runs first on each scanner
+                for (size_t i = 0; i < scanner_ids.size(); i++)
+                {
+                    int scanner_id = scanner_ids[i];
+                    executor.Post(scanner_id, kPriorityInteractive, [scanner_id, &failures](ICoreScanner* scanner)
+                    {
+                        if (scanner == NULL || !Exec<SET_ACTION>(scanner, scanner_id, ONESHORTHIGH).Succeeded())
+                        {
+                            failures++;
+                        }
+                    });
+                }
+                executor.Wait();
+            }
+            cout << "Keyed executor - " << scanner_ids.size() * 4 << " commands to " << scanner_ids.size() << " scanners, "
+                 << failures << " failed ("
+                 << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms)" << endl;
+
+            global_interface_table->RevokeInterfaceFromGlobal(scanner_interface_cookie);
+        }
+        else
+        {
+            cout << "CoreScanner interface registration in the global interface table - Failed" << endl;
+        }
+        if (global_interface_table != NULL)
+        {
+            global_interface_table->Release();
+        }
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
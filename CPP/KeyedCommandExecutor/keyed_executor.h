@@ -0,0 +1,344 @@
+/*******************************************************************************************
+* @file keyed_executor.h
+* @brief Work stealing thread pool running commands in one serial strand per scanner, by priority
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+* Command priority - a worker always takes the most urgent ready strand
+**/
+enum CommandPriority
+{
+    kPriorityInteractive,   // Trigger, beep, LED - someone is waiting at the lane
+    kPriorityNormal,
+    kPriorityBulk,          // Configuration, firmware, inventory
+    kPriorityCount
+};
+
+/**
+* Runs scanner commands on a pool of worker threads.
+*
+* Every scanner id owns a strand: its commands never run at the same time and, within a priority,
+* run in the order they were posted (DEVICE_SCAN_DISABLE, RSM_ATTR_SET, DEVICE_SCAN_ENABLE stay in
+* that order), while strands of different scanners run in parallel. A higher priority command
+* posted to a strand runs before its queued lower priority commands, so a beep does not wait for
+* a scanner's bulk configuration; commands that must not be separated are posted as one task.
+*
+* Ready strands are queued per worker and per priority. A worker takes the most urgent strand of
+* its own queues, else steals the most urgent strand of another worker, and runs one command of it
+* before queueing the strand again - a busy scanner cannot starve the others.
+*
+* Each worker gets its own scanner interface from attach() on the worker thread (for COM, a
+* marshalled ICoreScanner), and hands it back through detach() when the executor is destroyed.
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommand signature
+**/
+template <typename Scanner>
+class KeyedExecutor
+{
+public:
+    typedef std::function<Scanner*(int worker)> AttachFunction;
+    typedef std::function<void(int worker, Scanner* scanner)> DetachFunction;
+    typedef std::function<void(Scanner* scanner)> Task;
+
+    /**
+    * Keyed executor constructor - starts the workers
+    * @param worker_count - Commands run at the same time (on different scanners)
+    * @param attach - Called on each worker thread to get its scanner interface
+    * @param detach - Called on each worker thread when it stops (optional)
+    */
+    KeyedExecutor(int worker_count, const AttachFunction& attach, const DetachFunction& detach = DetachFunction())
+        : attach_(attach), detach_(detach), ready_count_(0), pending_(0), next_worker_(0), steal_count_(0), stopping_(false)
+    {
+        int count = worker_count < 1 ? 1 : worker_count;
+        for (int i = 0; i < count; i++)
+        {
+            workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+        }
+        for (int i = 0; i < count; i++)
+        {
+            workers_[i]->thread = std::thread(&KeyedExecutor::Run, this, i);
+        }
+    }
+
+    /**
+    * Run the posted commands, then stop the workers
+    */
+    ~KeyedExecutor()
+    {
+        Wait();
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            stopping_ = true;
+        }
+        idle_.notify_all();
+        for (size_t i = 0; i < workers_.size(); i++)
+        {
+            workers_[i]->thread.join();
+        }
+        for (typename std::unordered_map<int, Strand*>::iterator it = strands_.begin(); it != strands_.end(); ++it)
+        {
+            delete it->second;
+        }
+    }
+
+    KeyedExecutor(const KeyedExecutor&) = delete;
+    KeyedExecutor& operator=(const KeyedExecutor&) = delete;
+
+    /**
+    * Queue a command on a scanner's strand
+    * @param scanner_id - Strand key
+    * @param priority - Command priority
+    * @param task - Sends the command(s) through the worker's scanner interface
+    */
+    void Post(int scanner_id, CommandPriority priority, const Task& task)
+    {
+        Strand* strand = StrandOf(scanner_id);
+        pending_++;
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(strand->mutex);
+            strand->tasks[priority].push_back(task);
+            unsigned int bit = 1u << priority;
+            if (!strand->running && (strand->queued & bit) == 0)
+            {
+                strand->queued |= bit;
+                schedule = true;
+            }
+        }
+        if (schedule)
+        {
+            Schedule(strand, priority);
+        }
+    }
+
+    /**
+    * Wait until every posted command has run
+    */
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(done_mutex_);
+        done_.wait(lock, [this] { return pending_.load() == 0; });
+    }
+
+    /**
+    * Commands posted and not yet run
+    */
+    long Pending() const { return pending_.load(); }
+
+    /**
+    * Strands a worker took from another worker's queues
+    */
+    long long StealCount() const { return steal_count_.load(); }
+
+private:
+    struct Strand
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks[kPriorityCount];
+        bool running;           // A worker runs a command of this strand
+        unsigned int queued;    // Priorities the strand is queued at (bit per priority)
+
+        Strand() : running(false), queued(0) {}
+
+        int TopPriority() const
+        {
+            for (int priority = 0; priority < kPriorityCount; priority++)
+            {
+                if (!tasks[priority].empty())
+                {
+                    return priority;
+                }
+            }
+            return kPriorityCount;
+        }
+    };
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Strand*> ready[kPriorityCount];
+        std::thread thread;
+    };
+
+    Strand* StrandOf(int scanner_id)
+    {
+        std::lock_guard<std::mutex> lock(strands_mutex_);
+        Strand*& strand = strands_[scanner_id];
+        if (strand == NULL)
+        {
+            strand = new Strand();
+        }
+        return strand;
+    }
+
+    /**
+    * Queue a strand at a priority - on the calling worker's own queue, else spread over the workers
+    */
+    void Schedule(Strand* strand, int priority)
+    {
+        int worker = current_worker_ >= 0 && current_executor_ == this ? current_worker_ : (int)(next_worker_++ % workers_.size());
+        {
+            std::lock_guard<std::mutex> lock(workers_[worker]->mutex);
+            workers_[worker]->ready[priority].push_back(strand);
+        }
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            ready_count_++;
+        }
+        idle_.notify_one();
+    }
+
+    /**
+    * Take the most urgent ready strand: own queues first, then the other workers' at the same priority
+    */
+    bool Take(int worker, Strand** strand, int* priority)
+    {
+        for (int level = 0; level < kPriorityCount; level++)
+        {
+            for (size_t offset = 0; offset < workers_.size(); offset++)
+            {
+                Worker& victim = *workers_[(worker + offset) % workers_.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                std::deque<Strand*>& ready = victim.ready[level];
+                if (ready.empty())
+                {
+                    continue;
+                }
+                // The owner takes the oldest strand, a thief the newest
+                if (offset == 0)
+                {
+                    *strand = ready.front();
+                    ready.pop_front();
+                }
+                else
+                {
+                    *strand = ready.back();
+                    ready.pop_back();
+                    steal_count_++;
+                }
+                *priority = level;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Run(int worker)
+    {
+        current_executor_ = this;
+        current_worker_ = worker;
+        Scanner* scanner = attach_(worker);
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(idle_mutex_);
+                idle_.wait(lock, [this] { return ready_count_ > 0 || stopping_; });
+                if (ready_count_ == 0)
+                {
+                    break;
+                }
+                ready_count_--;
+            }
+
+            Strand* strand = NULL;
+            int priority = 0;
+            while (!Take(worker, &strand, &priority))
+            {
+                // Counted but not visible yet - the scheduling thread is between its two locks
+                std::this_thread::yield();
+            }
+            RunOne(scanner, strand, priority);
+        }
+        if (detach_)
+        {
+            detach_(worker, scanner);
+        }
+        current_worker_ = -1;
+        current_executor_ = NULL;
+    }
+
+    /**
+    * Run the most urgent command of a strand taken from the queue at a priority
+    */
+    void RunOne(Scanner* scanner, Strand* strand, int priority)
+    {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(strand->mutex);
+            strand->queued &= ~(1u << priority);
+            int top = strand->TopPriority();
+            if (strand->running || top == kPriorityCount)
+            {
+                // Stale entry - the strand runs on another worker, or ran its commands from another entry
+                return;
+            }
+            strand->running = true;
+            task.swap(strand->tasks[top].front());
+            strand->tasks[top].pop_front();
+        }
+
+        task(scanner);
+
+        int requeue = kPriorityCount;
+        {
+            std::lock_guard<std::mutex> lock(strand->mutex);
+            strand->running = false;
+            int top = strand->TopPriority();
+            if (top != kPriorityCount && (strand->queued & (1u << top)) == 0)
+            {
+                strand->queued |= 1u << top;
+                requeue = top;
+            }
+        }
+        if (requeue != kPriorityCount)
+        {
+            Schedule(strand, requeue);
+        }
+        if (--pending_ == 0)
+        {
+            std::lock_guard<std::mutex> lock(done_mutex_);
+            done_.notify_all();
+        }
+    }
+
+    static thread_local int current_worker_;
+    static thread_local KeyedExecutor* current_executor_;
+
+    AttachFunction attach_;
+    DetachFunction detach_;
+    std::vector<std::unique_ptr<Worker> > workers_;
+
+    std::mutex strands_mutex_;
+    std::unordered_map<int, Strand*> strands_;
+
+    std::mutex idle_mutex_;
+    std::condition_variable idle_;
+    long ready_count_;          // Entries in the ready queues not yet claimed by a worker
+
+    std::atomic<long> pending_;
+    std::mutex done_mutex_;
+    std::condition_variable done_;
+
+    std::atomic<unsigned int> next_worker_;
+    std::atomic<long long> steal_count_;
+    bool stopping_;
+};
+
+template <typename Scanner>
+thread_local int KeyedExecutor<Scanner>::current_worker_ = -1;
+
+template <typename Scanner>
+thread_local KeyedExecutor<Scanner>* KeyedExecutor<Scanner>::current_executor_ = NULL;
@@ -0,0 +1,101 @@
+/*******************************************************************************************
+* @file mock_command_host.h
+* @brief Simulated CoreScanner host recording the commands each scanner executed
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+
+/**
+* Simulated CoreScanner host with the ICoreScanner::ExecCommand signature. SET_ACTION takes
+* action_latency_ms and every other command command_latency_ms; the host is called from any
+* number of threads. It records the opcodes each scanner executed, in order, and counts the
+* commands sent to a scanner while it still executed another one.
+**/
+class MockCommandHost
+{
+public:
+    /**
+    * Mock host constructor
+    */
+    MockCommandHost(int command_latency_ms, int action_latency_ms)
+        : command_latency_ms_(command_latency_ms), action_latency_ms_(action_latency_ms), overlaps_(0)
+    {
+    }
+
+    /**
+    * Commands a scanner received while it executed another command
+    */
+    long Overlaps() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return overlaps_;
+    }
+
+    /**
+    * Opcodes a scanner executed, in order
+    */
+    std::vector<LONG> History(int scanner_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<int, Device>::const_iterator it = scanners_.find(scanner_id);
+        return it == scanners_.end() ? std::vector<LONG>() : it->second.history;
+    }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        *out_xml = NULL;
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        std::string value;
+        int scanner_id = XmlFindText(in, "scannerID", &value) ? atoi(value.c_str()) : 0;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Device& device = scanners_[scanner_id];
+            if (device.busy)
+            {
+                overlaps_++;
+            }
+            device.busy = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(opcode == SET_ACTION ? action_latency_ms_ : command_latency_ms_));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Device& device = scanners_[scanner_id];
+            device.busy = false;
+            device.history.push_back(opcode);
+        }
+        *status = STATUS_SUCCESS;
+        return S_OK;
+    }
+
+private:
+    struct Device
+    {
+        bool busy;
+        std::vector<LONG> history;
+
+        Device() : busy(false) {}
+    };
+
+    int command_latency_ms_;
+    int action_latency_ms_;
+    mutable std::mutex mutex_;
+    long overlaps_;
+    std::map<int, Device> scanners_;
+};
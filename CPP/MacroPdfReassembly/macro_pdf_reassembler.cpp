@@ -0,0 +1,303 @@
+/*******************************************************************************************
+* @file macro_pdf_reassembler.cpp
+* @brief Definition of Macro PDF segment reassembly
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "macro_pdf_reassembler.h"
+#include <cstring>
+
+using namespace std;
+
+static const char kControlBlock[] = "\\928";
+static const char kOptionalField[] = "\\923";
+static const char kLastSegment[] = "\\922";
+static const int kSegmentIndexDigits = 5;
+static const char kFieldSegmentCount = '1';
+
+bool IsMacroSymbology(int symbology)
+{
+    return symbology == ST_MACRO_PDF || symbology == ST_MACRO_MICRO_PDF || symbology == ST_MACRO_QR_CODE ||
+           symbology == ST_PDF417 || symbology == ST_MICRO_PDF;
+}
+
+/**
+* Parse a run of decimal digits
+**/
+static int ParseDigits(const char* text, size_t count)
+{
+    int value = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (text[i] < '0' || text[i] > '9')
+        {
+            return -1;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    return value;
+}
+
+bool ParseMacroPdfSegment(const string& label, MacroPdfSegment* segment)
+{
+    size_t control = label.rfind(kControlBlock);
+    if (control == string::npos)
+    {
+        return false;
+    }
+
+    const char* p = label.data() + control + strlen(kControlBlock);
+    const char* end = label.data() + label.size();
+    if (end - p < kSegmentIndexDigits)
+    {
+        return false;
+    }
+
+    segment->segment_index = ParseDigits(p, kSegmentIndexDigits);
+    if (segment->segment_index < 0)
+    {
+        return false;
+    }
+    p += kSegmentIndexDigits;
+
+    const char* file_id_end = p;
+    while (file_id_end < end && *file_id_end != '\\') file_id_end++;
+    segment->file_id.assign(p, file_id_end);
+    segment->segment_count = -1;
+    segment->is_last = false;
+    segment->data_length = control;
+
+    // Optional fields and terminator
+    p = file_id_end;
+    while (p < end)
+    {
+        const char* next = p + 1;
+        while (next < end && *next != '\\') next++;
+
+        if ((size_t)(next - p) >= strlen(kLastSegment) && memcmp(p, kLastSegment, strlen(kLastSegment)) == 0)
+        {
+            segment->is_last = true;
+        }
+        else if ((size_t)(next - p) > strlen(kOptionalField) && memcmp(p, kOptionalField, strlen(kOptionalField)) == 0 &&
+                 p[strlen(kOptionalField)] == kFieldSegmentCount)
+        {
+            const char* count = p + strlen(kOptionalField) + 1;
+            segment->segment_count = ParseDigits(count, next - count);
+        }
+        p = next;
+    }
+    return true;
+}
+
+MacroPdfReassembler::MacroPdfReassembler(const MacroPdfSettings& settings, const DocumentHandler& on_document, const TimeoutHandler& on_timeout)
+    : settings_(settings), on_document_(on_document), on_timeout_(on_timeout),
+      segment_count_(0), duplicate_count_(0), document_count_(0), timeout_count_(0)
+{
+}
+
+bool MacroPdfReassembler::AddSegment(int scanner_id, const string& label, Clock::time_point now)
+{
+    MacroPdfSegment segment;
+    if (!ParseMacroPdfSegment(label, &segment))
+    {
+        return false;
+    }
+    segment_count_++;
+
+    Arena& arena = arenas_[scanner_id];
+    chrono::milliseconds duplicate_window(settings_.duplicate_window_ms);
+    while (!arena.recent_documents.empty() && arena.recent_documents.front().completed_at + duplicate_window <= now)
+    {
+        arena.recent_documents.pop_front();
+    }
+    for (size_t i = 0; i < arena.recent_documents.size(); i++)
+    {
+        if (arena.recent_documents[i].file_id == segment.file_id)
+        {
+            duplicate_count_++;
+            return true;
+        }
+    }
+
+    size_t document_index = 0;
+    while (document_index < arena.documents.size() && arena.documents[document_index].file_id != segment.file_id)
+    {
+        document_index++;
+    }
+
+    if (document_index == arena.documents.size())
+    {
+        if (arena.documents.empty())
+        {
+            arena.bytes.clear();    // Keeps capacity - the arena is reused for the next document
+            arena.live_bytes = 0;
+        }
+        else if (arena.documents.size() >= settings_.max_documents_per_scanner)
+        {
+            GiveUp(scanner_id, &arena, 0);
+            document_index--;
+        }
+
+        Document document;
+        document.file_id = segment.file_id;
+        document.received = 0;
+        document.last_index = -1;
+        arena.documents.push_back(document);
+    }
+
+    Document& document = arena.documents[document_index];
+    document.last_seen = now;
+    if (segment.segment_count > 0)
+    {
+        document.last_index = segment.segment_count - 1;
+    }
+    if (segment.is_last)
+    {
+        document.last_index = segment.segment_index;
+    }
+
+    if ((size_t)segment.segment_index >= document.segments.size())
+    {
+        SegmentRef missing = { kMissing, 0 };
+        document.segments.resize(segment.segment_index + 1, missing);
+    }
+
+    SegmentRef& ref = document.segments[segment.segment_index];
+    if (ref.offset != kMissing)
+    {
+        duplicate_count_++;
+    }
+    else
+    {
+        ref.offset = (unsigned int)arena.bytes.size();
+        ref.length = (unsigned int)segment.data_length;
+        arena.bytes.append(label.data(), segment.data_length);
+        arena.live_bytes += segment.data_length;
+        document.received++;
+    }
+
+    if (document.last_index >= 0 && document.received == document.last_index + 1 &&
+        (int)document.segments.size() == document.last_index + 1)
+    {
+        Complete(scanner_id, &arena, document_index, now);
+    }
+    return true;
+}
+
+int MacroPdfReassembler::Expire(Clock::time_point now)
+{
+    int expired = 0;
+    chrono::milliseconds timeout(settings_.timeout_ms);
+    for (map<int, Arena>::iterator it = arenas_.begin(); it != arenas_.end(); ++it)
+    {
+        for (size_t i = it->second.documents.size(); i-- > 0;)
+        {
+            if (it->second.documents[i].last_seen + timeout <= now)
+            {
+                GiveUp(it->first, &it->second, i);
+                expired++;
+            }
+        }
+    }
+    return expired;
+}
+
+size_t MacroPdfReassembler::PendingDocuments() const
+{
+    size_t count = 0;
+    for (map<int, Arena>::const_iterator it = arenas_.begin(); it != arenas_.end(); ++it)
+    {
+        count += it->second.documents.size();
+    }
+    return count;
+}
+
+/**
+* Emit a complete document and release its arena space
+**/
+void MacroPdfReassembler::Complete(int scanner_id, Arena* arena, size_t document_index, Clock::time_point now)
+{
+    const Document& document = arena->documents[document_index];
+    size_t total = 0;
+    for (size_t i = 0; i < document.segments.size(); i++)
+    {
+        total += document.segments[i].length;
+    }
+
+    assembled_.clear();
+    assembled_.reserve(total);
+    for (size_t i = 0; i < document.segments.size(); i++)
+    {
+        assembled_.append(arena->bytes, document.segments[i].offset, document.segments[i].length);
+    }
+
+    document_count_++;
+    string file_id = document.file_id;
+    RecentDocument recent = { file_id, now };
+    arena->recent_documents.push_back(recent);
+    if (arena->recent_documents.size() > kRecentDocuments)
+    {
+        arena->recent_documents.pop_front();
+    }
+    Release(arena, document_index);
+    if (on_document_)
+    {
+        on_document_(scanner_id, file_id, assembled_);
+    }
+}
+
+/**
+* Drop an incomplete document and ask the scanner to flush/abort its Macro PDF buffer
+**/
+void MacroPdfReassembler::GiveUp(int scanner_id, Arena* arena, size_t document_index)
+{
+    timeout_count_++;
+    Release(arena, document_index);
+    if (on_timeout_)
+    {
+        on_timeout_(scanner_id, settings_.flush_on_timeout ? DEVICE_FLUSH_MACROPDF : DEVICE_ABORT_MACROPDF);
+    }
+}
+
+/**
+* Remove a document from the arena, compacting the arena once most of it is dead
+**/
+void MacroPdfReassembler::Release(Arena* arena, size_t document_index)
+{
+    Document& document = arena->documents[document_index];
+    for (size_t i = 0; i < document.segments.size(); i++)
+    {
+        if (document.segments[i].offset != kMissing)
+        {
+            arena->live_bytes -= document.segments[i].length;
+        }
+    }
+    arena->documents.erase(arena->documents.begin() + document_index);
+
+    if (arena->documents.empty())
+    {
+        arena->bytes.clear();
+        arena->live_bytes = 0;
+    }
+    else if (arena->live_bytes * 2 < arena->bytes.size())
+    {
+        string compacted;
+        compacted.reserve(arena->live_bytes);
+        for (size_t d = 0; d < arena->documents.size(); d++)
+        {
+            vector<SegmentRef>& segments = arena->documents[d].segments;
+            for (size_t i = 0; i < segments.size(); i++)
+            {
+                if (segments[i].offset != kMissing)
+                {
+                    unsigned int offset = (unsigned int)compacted.size();
+                    compacted.append(arena->bytes, segments[i].offset, segments[i].length);
+                    segments[i].offset = offset;
+                }
+            }
+        }
+        arena->bytes.swap(compacted);
+    }
+}
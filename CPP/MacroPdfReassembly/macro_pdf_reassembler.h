@@ -0,0 +1,160 @@
+/*******************************************************************************************
+* @file macro_pdf_reassembler.h
+* @brief Reassembly of multi segment Macro PDF/Macro QR symbols from decoded ScanData
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "common_defs.h"
+
+/**
+* Macro PDF control block of one decoded segment
+**/
+struct MacroPdfSegment
+{
+    int segment_index;      // 0 based position of the segment in the document
+    int segment_count;      // Total segments if the optional count field was sent, -1 otherwise
+    bool is_last;           // Segment carries the last segment terminator
+    std::string file_id;
+    size_t data_length;     // Length of the segment data (label bytes before the control block)
+};
+
+/**
+* Parse the Macro PDF control block appended to a segment label.
+* The scanner must transmit the control header ("Transmit Macro PDF Control Header" enabled), in
+* escaped codeword form: <data>\928<5 digit segment index><file id>[\923<field><value>...][\922]
+* @param label - Decoded label bytes
+* @param segment - Receives control block fields
+* return value : true if the label carries a Macro PDF control block
+*/
+bool ParseMacroPdfSegment(const std::string& label, MacroPdfSegment* segment);
+
+/**
+* Returns true for symbologies that can carry a Macro PDF/Macro QR control block
+*/
+bool IsMacroSymbology(int symbology);
+
+/**
+* Reassembler settings
+**/
+struct MacroPdfSettings
+{
+    int timeout_ms;                     // Incomplete document is given up after this much silence
+    int duplicate_window_ms;            // Segments of a completed document are ignored for this long
+    bool flush_on_timeout;              // true - DEVICE_FLUSH_MACROPDF, false - DEVICE_ABORT_MACROPDF
+    size_t max_documents_per_scanner;   // Oldest incomplete document is given up beyond this
+
+    MacroPdfSettings()
+        : timeout_ms(5000), duplicate_window_ms(2000), flush_on_timeout(true), max_documents_per_scanner(4)
+    {
+    }
+};
+
+/**
+* Collects Macro PDF segments per scanner and emits each document once all segments arrived.
+*
+* Segment data is appended to a per scanner arena (one growing buffer) and documents only keep
+* offsets into it, so segments arriving in any order cost one copy in and one copy out.
+* Duplicate segments (re-presented symbols), also those arriving within duplicate_window_ms after
+* their document completed, are ignored; a later segment with the same file id starts a new
+* document. An incomplete document that sees no new segment for timeout_ms is dropped and the timeout handler is asked to flush or abort the
+* scanner's Macro PDF buffer. All calls are expected on the event (message loop) thread.
+**/
+class MacroPdfReassembler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<void(int scanner_id, const std::string& file_id, const std::string& document)> DocumentHandler;
+    typedef std::function<void(int scanner_id, OPCODE opcode)> TimeoutHandler;
+
+    /**
+    * Reassembler constructor
+    * @param settings - Timeout and limits
+    * @param on_document - Called with each complete document
+    * @param on_timeout - Called with DEVICE_FLUSH_MACROPDF/DEVICE_ABORT_MACROPDF for a timed out document
+    */
+    MacroPdfReassembler(const MacroPdfSettings& settings, const DocumentHandler& on_document, const TimeoutHandler& on_timeout);
+
+    /**
+    * Add a decoded segment
+    * @param scanner_id - Scanner that decoded the segment
+    * @param label - Decoded label bytes including the control block
+    * @param now - Current time
+    * return value : true if the label was a Macro PDF segment (consumed), false for ordinary labels
+    */
+    bool AddSegment(int scanner_id, const std::string& label, Clock::time_point now);
+
+    /**
+    * Give up documents that timed out
+    * @param now - Current time
+    * return value : Number of documents given up
+    */
+    int Expire(Clock::time_point now);
+
+    /**
+    * Number of incomplete documents across all scanners
+    */
+    size_t PendingDocuments() const;
+
+    long SegmentCount() const { return segment_count_; }
+    long DuplicateCount() const { return duplicate_count_; }
+    long DocumentCount() const { return document_count_; }
+    long TimeoutCount() const { return timeout_count_; }
+
+private:
+    static const unsigned int kMissing = 0xFFFFFFFF;
+    static const size_t kRecentDocuments = 8;
+
+    struct SegmentRef
+    {
+        unsigned int offset;    // Offset in scanner arena, kMissing until received
+        unsigned int length;
+    };
+
+    struct Document
+    {
+        std::string file_id;
+        std::vector<SegmentRef> segments;
+        int received;
+        int last_index;         // -1 until the last segment or segment count is known
+        Clock::time_point last_seen;
+    };
+
+    struct RecentDocument
+    {
+        std::string file_id;
+        Clock::time_point completed_at;
+    };
+
+    struct Arena
+    {
+        std::string bytes;                  // Segment data of all pending documents
+        size_t live_bytes;                  // Bytes still referenced by pending documents
+        std::vector<Document> documents;
+        std::deque<RecentDocument> recent_documents;    // Completed within the duplicate window, oldest first
+
+        Arena() : live_bytes(0) {}
+    };
+
+    void Complete(int scanner_id, Arena* arena, size_t document_index, Clock::time_point now);
+    void GiveUp(int scanner_id, Arena* arena, size_t document_index);
+    void Release(Arena* arena, size_t document_index);
+
+    MacroPdfSettings settings_;
+    DocumentHandler on_document_;
+    TimeoutHandler on_timeout_;
+    std::map<int, Arena> arenas_;
+    std::string assembled_;     // Reused output buffer
+
+    long segment_count_;
+    long duplicate_count_;
+    long document_count_;
+    long timeout_count_;
+};
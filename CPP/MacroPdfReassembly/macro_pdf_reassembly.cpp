@@ -0,0 +1,437 @@
+/*******************************************************************************************
+* @file macro_pdf_reassembly.cpp
+* @brief This file contains code snippet to reassemble multi segment Macro PDF symbols from barcode events
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "scan_data.h"
+#include "macro_pdf_reassembler.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for barcode events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_BARCODE);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Build a segment label with a Macro PDF control block, as the scanner transmits it
+*/
+string MakeSegmentLabel(const string& data, int segment_index, int segment_count, const string& file_id)
+{
+    char index[8];
+    snprintf(index, sizeof(index), "%05d", segment_index);
+    string label = data + "\\928" + index + file_id;
+    if (segment_index == 0)
+    {
+        char count[8];
+        snprintf(count, sizeof(count), "%05d", segment_count);
+        label += string("\\9231") + count;
+    }
+    if (segment_index == segment_count - 1)
+    {
+        label += "\\922";
+    }
+    return label;
+}
+
+/*
+* Split a document into segment labels
+*/
+vector<string> MakeSegments(const string& document, int segment_count, const string& file_id)
+{
+    vector<string> labels;
+    size_t segment_size = (document.size() + segment_count - 1) / segment_count;
+    for (int i = 0; i < segment_count; i++)
+    {
+        size_t offset = i * segment_size;
+        string data = offset < document.size() ? document.substr(offset, segment_size) : string();
+        labels.push_back(MakeSegmentLabel(data, i, segment_count, file_id));
+    }
+    return labels;
+}
+
+/*
+* Feed synthetic segments in order, shuffled, duplicated, with a missing segment, and the first
+* document scanned again once its duplicate window is over
+*/
+void RunSyntheticSegments()
+{
+    string original;
+    for (int i = 0; i < 2000; i++)
+    {
+        original.push_back((char)('A' + i % 26));
+    }
+
+    string received;
+    int timeouts = 0;
+    MacroPdfSettings settings;
+    MacroPdfReassembler reassembler(settings,
+        [&received](int scanner_id, const string& file_id, const string& document) { received = document; },
+        [&timeouts](int scanner_id, OPCODE opcode) { timeouts++; });
+
+    MacroPdfReassembler::Clock::time_point now = MacroPdfReassembler::Clock::now();
+    mt19937 random(2026);
+    const char* scenarios[] = { "In order", "Shuffled", "Shuffled with duplicates", "Missing segment", "Same file ID scanned again" };
+    for (int scenario = 0; scenario < 5; scenario++)
+    {
+        vector<string> labels = MakeSegments(original, 7, "001" + to_string(scenario % 4));
+        if (scenario >= 1)
+        {
+            shuffle(labels.begin(), labels.end(), random);
+        }
+        if (scenario == 2)
+        {
+            labels.insert(labels.begin() + 3, labels[0]);
+            labels.push_back(labels[1]);
+        }
+        if (scenario == 3)
+        {
+            labels.erase(labels.begin() + 2);
+        }
+
+        if (scenario == 4)
+        {
+            now += chrono::minutes(10);
+        }
+
+        received.clear();
+        timeouts = 0;
+        for (size_t i = 0; i < labels.size(); i++)
+        {
+            reassembler.AddSegment(1, labels[i], now);
+        }
+        reassembler.Expire(now + chrono::milliseconds(settings.timeout_ms));
+
+        cout << " " << scenarios[scenario] << " : "
+             << (received == original ? "document reassembled" : received.empty() ? "no document" : "document CORRUPT")
+             << (timeouts ? ", timed out (flush sent)" : "") << endl;
+    }
+    cout << " Segments : " << reassembler.SegmentCount() << ", duplicates : " << reassembler.DuplicateCount()
+         << ", documents : " << reassembler.DocumentCount() << ", timeouts : " << reassembler.TimeoutCount() << endl;
+}
+
+/*
+* Measure reassembly throughput with interleaved, shuffled documents from several scanners
+*/
+void RunBenchmark()
+{
+    const int kDocuments = 20000;
+    const int kSegments = 8;
+    const int kScanners = 4;
+    const int kSegmentBytes = 256;
+
+    vector<pair<int, string> > labels;
+    mt19937 random(7);
+    for (int d = 0; d < kDocuments; d++)
+    {
+        vector<string> segments = MakeSegments(string(kSegments * kSegmentBytes, (char)('a' + d % 26)), kSegments, to_string(100000 + d));
+        shuffle(segments.begin(), segments.end(), random);
+        for (size_t i = 0; i < segments.size(); i++)
+        {
+            labels.push_back(make_pair(d % kScanners, segments[i]));
+        }
+    }
+
+    long completed_bytes = 0;
+    MacroPdfReassembler reassembler(MacroPdfSettings(),
+        [&completed_bytes](int scanner_id, const string& file_id, const string& document) { completed_bytes += (long)document.size(); },
+        MacroPdfReassembler::TimeoutHandler());
+
+    MacroPdfReassembler::Clock::time_point now = MacroPdfReassembler::Clock::now();
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (size_t i = 0; i < labels.size(); i++)
+    {
+        reassembler.AddSegment(labels[i].first, labels[i].second, now);
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << " " << labels.size() << " segments, " << reassembler.DocumentCount() << " documents in " << seconds * 1000 << " ms : "
+         << (long)(labels.size() / seconds) << " segments/s, " << completed_bytes / seconds / (1024 * 1024) << " MB/s" << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Macro PDF reassembly with synthetic segments" << endl;
+    RunSyntheticSegments();
+    cout << "Macro PDF reassembly benchmark" << endl;
+    RunBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        MacroPdfSettings settings;
+        MacroPdfReassembler reassembler(settings,
+            [](int scanner_id, const string& file_id, const string& document)
+            {
+                cout << "Macro PDF document scanner ID:[" << scanner_id << "] file ID:[" << file_id << "] (" << document.size() << " bytes) : " << endl;
+                cout << document << endl;
+            },
+            [](int scanner_id, OPCODE opcode)
+            {
+                // Incomplete document - flush (or abort) the scanner's Macro PDF buffer
+                CommandResult<NoResponse> result = opcode == DEVICE_FLUSH_MACROPDF ?
+                    Exec<DEVICE_FLUSH_MACROPDF>(scanner_interface, scanner_id) : Exec<DEVICE_ABORT_MACROPDF>(scanner_interface, scanner_id);
+                cout << "Macro PDF timed out, " << (opcode == DEVICE_FLUSH_MACROPDF ? "flush" : "abort") << " scanner ID:[" << scanner_id << "] - "
+                     << (result.Succeeded() ? "Success" : "Failed") << endl;
+            });
+
+        scanner_event_sink->SetScanDataHandler([&reassembler](short event_type, const string& scan_data_xml)
+        {
+            ScanData scan_data;
+            if (!ParseScanData(scan_data_xml, &scan_data))
+            {
+                return;
+            }
+            if (IsMacroSymbology(scan_data.symbology) &&
+                reassembler.AddSegment(scan_data.scanner_id, scan_data.label, MacroPdfReassembler::Clock::now()))
+            {
+                cout << "Macro PDF segment scanner ID:[" << scan_data.scanner_id << "], documents pending : " << reassembler.PendingDocuments() << endl;
+                return;
+            }
+            cout << "Barcode scanner ID:[" << scan_data.scanner_id << "] type " << scan_data.symbology << " : " << scan_data.label << endl;
+        });
+
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            cout << "Scan Macro PDF segments now, press any key to exit." << endl;
+            MSG msg = { 0 };
+            while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+            {
+                PeekMessage(&msg, NULL, 0, 0, 0);
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+                if (_kbhit())
+                {
+                    break;
+                }
+                reassembler.Expire(MacroPdfReassembler::Clock::now());
+                Sleep(1);
+            }
+            getchar();
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+        }
+        scanner_event_sink->SetScanDataHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
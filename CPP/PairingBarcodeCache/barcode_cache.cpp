@@ -0,0 +1,302 @@
+/*******************************************************************************************
+* @file barcode_cache.cpp
+* @brief Definition of pairing barcode image cache
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "barcode_cache.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+static const char kSpillMagic[4] = { 'P', 'B', 'C', '1' };
+
+string PairingBarcodeRequest::Key() const
+{
+    return host + "|" + to_string(barcode_type) + "|" + to_string(protocol) + "|" +
+        to_string(default_option) + "|" + to_string(image_size);
+}
+
+PairingBarcodeCache::PairingBarcodeCache(const PairingBarcodeCacheSettings& settings, const Fetcher& fetcher)
+    : settings_(settings), fetcher_(fetcher), generation_(0), memory_bytes_(0),
+      memory_hit_count_(0), disk_hit_count_(0), shared_count_(0), miss_count_(0), failed_count_(0)
+{
+}
+
+bool PairingBarcodeCache::Get(const PairingBarcodeRequest& request, ImagePtr* image)
+{
+    string key = request.Key();
+    uint64_t hash = HashKey(key);
+
+    unique_lock<mutex> lock(mutex_);
+    unordered_map<uint64_t, Entry>::iterator entry = entries_.find(hash);
+    if (entry != entries_.end() && entry->second.key == key)
+    {
+        memory_hit_count_++;
+        lru_.splice(lru_.begin(), lru_, entry->second.lru_position);
+        *image = entry->second.image;
+        return true;
+    }
+
+    unordered_map<string, shared_ptr<Flight> >::iterator in_flight = flights_.find(key);
+    if (in_flight != flights_.end())
+    {
+        // Same image is being fetched - wait for that result
+        shared_ptr<Flight> flight = in_flight->second;
+        shared_count_++;
+        while (!flight->done)
+        {
+            flight->finished.wait(lock);
+        }
+        *image = flight->image;
+        return flight->success;
+    }
+
+    shared_ptr<Flight> flight = make_shared<Flight>();
+    flight->generation = generation_;
+    flights_[key] = flight;
+    lock.unlock();
+
+    Image data;
+    bool from_disk = false;
+    {
+        lock_guard<mutex> spill_lock(spill_mutex_);
+        from_disk = ReadSpill(hash, key, &data);
+    }
+    bool success = from_disk;
+    if (!from_disk)
+    {
+        success = fetcher_(request, &data) && !data.empty();
+        if (success)
+        {
+            // Invalidate() removes the spill file under spill_mutex_, so a stale image is never written after it
+            lock_guard<mutex> spill_lock(spill_mutex_);
+            lock.lock();
+            bool current = flight->generation == generation_;
+            lock.unlock();
+            if (current)
+            {
+                WriteSpill(hash, key, data);
+            }
+        }
+    }
+    ImagePtr result = success ? make_shared<const Image>(std::move(data)) : ImagePtr();
+
+    lock.lock();
+    if (from_disk)
+    {
+        disk_hit_count_++;
+    }
+    else
+    {
+        miss_count_++;
+        if (!success)
+        {
+            failed_count_++;
+        }
+    }
+    if (success && flight->generation == generation_)
+    {
+        Insert(hash, key, result);
+    }
+    flight->done = true;
+    flight->success = success;
+    flight->image = result;
+    in_flight = flights_.find(key);
+    if (in_flight != flights_.end() && in_flight->second == flight)
+    {
+        flights_.erase(in_flight);
+    }
+    lock.unlock();
+    flight->finished.notify_all();
+
+    *image = result;
+    return success;
+}
+
+void PairingBarcodeCache::Invalidate(const PairingBarcodeRequest& request)
+{
+    string key = request.Key();
+    uint64_t hash = HashKey(key);
+    lock_guard<mutex> spill_lock(spill_mutex_);
+    {
+        // A fetch in flight is left to finish for its callers; later callers start a new one
+        lock_guard<mutex> lock(mutex_);
+        generation_++;
+        flights_.erase(key);
+        unordered_map<uint64_t, Entry>::iterator entry = entries_.find(hash);
+        if (entry != entries_.end() && entry->second.key == key)
+        {
+            memory_bytes_ -= entry->second.image->size();
+            lru_.erase(entry->second.lru_position);
+            entries_.erase(entry);
+        }
+    }
+    if (!settings_.spill_directory.empty())
+    {
+        remove(SpillPath(hash).c_str());
+    }
+}
+
+long PairingBarcodeCache::MemoryHitCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return memory_hit_count_;
+}
+
+long PairingBarcodeCache::DiskHitCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return disk_hit_count_;
+}
+
+long PairingBarcodeCache::SharedCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return shared_count_;
+}
+
+long PairingBarcodeCache::MissCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return miss_count_;
+}
+
+long PairingBarcodeCache::FailedCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return failed_count_;
+}
+
+size_t PairingBarcodeCache::MemoryBytes() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return memory_bytes_;
+}
+
+/**
+* 64 bit FNV-1a hash of a request key
+**/
+uint64_t PairingBarcodeCache::HashKey(const string& key)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < key.size(); i++)
+    {
+        hash ^= (unsigned char)key[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+string PairingBarcodeCache::SpillPath(uint64_t hash) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.pbc", (unsigned long long)hash);
+    return settings_.spill_directory + "\\" + name;
+}
+
+/**
+* Read a spilled image. Layout: magic, key length, key, image length, image.
+**/
+bool PairingBarcodeCache::ReadSpill(uint64_t hash, const string& key, Image* image) const
+{
+    if (settings_.spill_directory.empty())
+    {
+        return false;
+    }
+    ifstream file(SpillPath(hash).c_str(), ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    char magic[sizeof(kSpillMagic)];
+    uint32_t key_length = 0;
+    file.read(magic, sizeof(magic));
+    file.read((char*)&key_length, sizeof(key_length));
+    if (!file || memcmp(magic, kSpillMagic, sizeof(magic)) != 0 || key_length != key.size())
+    {
+        return false;
+    }
+    string stored_key(key_length, '\0');
+    file.read(&stored_key[0], key_length);
+    if (!file || stored_key != key)
+    {
+        return false;   // Hash collision with another request
+    }
+
+    uint32_t image_length = 0;
+    file.read((char*)&image_length, sizeof(image_length));
+    if (!file || image_length == 0)
+    {
+        return false;
+    }
+    image->resize(image_length);
+    file.read((char*)&(*image)[0], image_length);
+    return (bool)file;
+}
+
+/**
+* Spill an image. It is written to a temporary file first so a concurrent reader never sees a partial image.
+**/
+void PairingBarcodeCache::WriteSpill(uint64_t hash, const string& key, const Image& image) const
+{
+    if (settings_.spill_directory.empty())
+    {
+        return;
+    }
+    string path = SpillPath(hash);
+    string temporary_path = path + ".tmp";
+    {
+        ofstream file(temporary_path.c_str(), ios::binary | ios::trunc);
+        uint32_t key_length = (uint32_t)key.size();
+        uint32_t image_length = (uint32_t)image.size();
+        file.write(kSpillMagic, sizeof(kSpillMagic));
+        file.write((const char*)&key_length, sizeof(key_length));
+        file.write(key.data(), key.size());
+        file.write((const char*)&image_length, sizeof(image_length));
+        file.write((const char*)&image[0], image.size());
+        if (!file)
+        {
+            file.close();
+            remove(temporary_path.c_str());
+            return;
+        }
+    }
+    remove(path.c_str());
+    rename(temporary_path.c_str(), path.c_str());
+}
+
+/**
+* Add an image to memory, dropping least recently used images beyond the memory limit.
+* Called with mutex_ held.
+**/
+void PairingBarcodeCache::Insert(uint64_t hash, const string& key, const ImagePtr& image)
+{
+    unordered_map<uint64_t, Entry>::iterator entry = entries_.find(hash);
+    if (entry != entries_.end())
+    {
+        memory_bytes_ -= entry->second.image->size();
+        lru_.erase(entry->second.lru_position);
+        entries_.erase(entry);
+    }
+
+    lru_.push_front(hash);
+    Entry& inserted = entries_[hash];
+    inserted.key = key;
+    inserted.image = image;
+    inserted.lru_position = lru_.begin();
+    memory_bytes_ += image->size();
+
+    while (memory_bytes_ > settings_.memory_limit_bytes && lru_.size() > 1)
+    {
+        unordered_map<uint64_t, Entry>::iterator victim = entries_.find(lru_.back());
+        memory_bytes_ -= victim->second.image->size();
+        entries_.erase(victim);
+        lru_.pop_back();
+    }
+}
@@ -0,0 +1,163 @@
+/*******************************************************************************************
+* @file barcode_cache.h
+* @brief Content addressed cache for GET_PAIRING_BARCODE images with disk spill and single flight fetch
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+* Parameters of a pairing barcode. A pairing barcode only depends on the host it pairs with and
+* the GET_PAIRING_BARCODE arguments, so together they address the image.
+**/
+struct PairingBarcodeRequest
+{
+    std::string host;       // Host identity (computer name / Bluetooth radio address)
+    int barcode_type;
+    int protocol;
+    int default_option;
+    int image_size;
+
+    /**
+    * Canonical key string of the request
+    */
+    std::string Key() const;
+};
+
+/**
+* Pairing barcode cache settings
+**/
+struct PairingBarcodeCacheSettings
+{
+    size_t memory_limit_bytes;      // Least recently used images beyond this are dropped from memory
+    std::string spill_directory;    // Existing directory for spilled images, empty to keep images in memory only
+
+    PairingBarcodeCacheSettings()
+        : memory_limit_bytes(4 * 1024 * 1024)
+    {
+    }
+};
+
+/**
+* Caches pairing barcode images so repeated prints do not go back to the driver.
+*
+* Images are addressed by a 64 bit FNV-1a hash of the request key. A lookup is served from
+* memory, then from the spill directory (<hash>.pbc, which also stores the key so a hash
+* collision reads as a miss), and only then fetched. Every fetched image is written to the
+* spill directory, so images dropped from memory or cached by an earlier run are still hits.
+*
+* Fetches are single flight: while one caller fetches an image, other callers asking for the
+* same key wait for that result instead of sending their own GET_PAIRING_BARCODE. The fetch
+* function runs on the calling thread without the cache lock held, so fetches of different keys
+* run concurrently. A fetch that was in flight when its key was invalidated still answers its
+* callers, but its image is neither kept in memory nor spilled.
+**/
+class PairingBarcodeCache
+{
+public:
+    typedef std::vector<unsigned char> Image;
+    typedef std::shared_ptr<const Image> ImagePtr;
+    typedef std::function<bool(const PairingBarcodeRequest& request, Image* image)> Fetcher;
+
+    /**
+    * Pairing barcode cache constructor
+    * @param settings - Memory limit and spill directory
+    * @param fetcher - Function that gets the image from the driver (GET_PAIRING_BARCODE)
+    */
+    PairingBarcodeCache(const PairingBarcodeCacheSettings& settings, const Fetcher& fetcher);
+
+    /**
+    * Get a pairing barcode image
+    * @param request - Pairing barcode parameters
+    * @param image - Receives the image (shared, read only)
+    * return value : true if the image was found or fetched
+    */
+    bool Get(const PairingBarcodeRequest& request, ImagePtr* image);
+
+    /**
+    * Forget a pairing barcode (e.g. after the host Bluetooth radio changed)
+    */
+    void Invalidate(const PairingBarcodeRequest& request);
+
+    /**
+    * Number of requests served from memory
+    */
+    long MemoryHitCount() const;
+
+    /**
+    * Number of requests served from the spill directory
+    */
+    long DiskHitCount() const;
+
+    /**
+    * Number of requests that waited for another caller's fetch of the same image
+    */
+    long SharedCount() const;
+
+    /**
+    * Number of requests that went to the driver
+    */
+    long MissCount() const;
+
+    /**
+    * Number of failed fetches
+    */
+    long FailedCount() const;
+
+    /**
+    * Bytes of images held in memory
+    */
+    size_t MemoryBytes() const;
+
+private:
+    struct Entry
+    {
+        std::string key;
+        ImagePtr image;
+        std::list<uint64_t>::iterator lru_position;
+    };
+
+    struct Flight
+    {
+        bool done;
+        bool success;
+        ImagePtr image;
+        unsigned long generation;   // generation_ when the fetch started
+        std::condition_variable finished;
+
+        Flight() : done(false), success(false), generation(0) {}
+    };
+
+    static uint64_t HashKey(const std::string& key);
+    std::string SpillPath(uint64_t hash) const;
+    bool ReadSpill(uint64_t hash, const std::string& key, Image* image) const;
+    void WriteSpill(uint64_t hash, const std::string& key, const Image& image) const;
+    void Insert(uint64_t hash, const std::string& key, const ImagePtr& image);
+
+    PairingBarcodeCacheSettings settings_;
+    Fetcher fetcher_;
+
+    std::mutex spill_mutex_;        // Orders spill reads/writes with Invalidate(), taken before mutex_
+    mutable std::mutex mutex_;
+    unsigned long generation_;      // Incremented by every Invalidate()
+    std::unordered_map<uint64_t, Entry> entries_;
+    std::list<uint64_t> lru_;       // Most recently used first
+    size_t memory_bytes_;
+    std::unordered_map<std::string, std::shared_ptr<Flight> > flights_;   // Fetches in progress by key
+
+    long memory_hit_count_;
+    long disk_hit_count_;
+    long shared_count_;
+    long miss_count_;
+    long failed_count_;
+};
@@ -0,0 +1,331 @@
+/*******************************************************************************************
+* @file pairing_barcode_cache.cpp
+* @brief This file contains code snippet to cache Bluetooth pairing barcode images (GET_PAIRING_BARCODE)
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "barcode_cache.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+
+//---- GET_PAIRING_BARCODE arguments ------//
+#define PAIRING_BARCODE_TYPE_STC        0   // Scan-To-Connect barcode
+#define PAIRING_PROTOCOL_SSI_BT_CRADLE  1   // Bluetooth SSI / cradle host
+#define PAIRING_DEFAULT_OPTION_NONE     0   // Keep scanner defaults
+#define PAIRING_IMAGE_SIZE_MEDIUM       1
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Get a pairing barcode image from the driver. The driver writes the image to a file, which is read back.
+* Each fetch uses its own file, so concurrent fetches of different barcodes do not overwrite each other.
+* @param request - Pairing barcode parameters
+* @param image - Receives the image file content
+* return value : Command success/fail status
+*/
+bool FetchPairingBarcode(const PairingBarcodeRequest& request, PairingBarcodeCache::Image* image)
+{
+    static atomic<unsigned long> fetch_count(0);
+    char file_name[64];
+    snprintf(file_name, sizeof(file_name), "pairing_barcode_fetch_%016llx_%lu.bmp",
+        (unsigned long long)hash<string>()(request.Key()), (unsigned long)++fetch_count);
+    const string file_path = file_name;
+    CommandResult<XmlResponse> result = Exec<GET_PAIRING_BARCODE>(scanner_interface,
+        request.barcode_type, request.protocol, request.default_option, request.image_size, file_path);
+    if (!result.Succeeded())
+    {
+        cout << "CoreScanner GetPairingBarcode() - Failed. Error Code : " << result.status << endl;
+        remove(file_path.c_str());
+        return false;
+    }
+
+    {
+        ifstream file(file_path.c_str(), ios::binary);
+        image->assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+    remove(file_path.c_str());
+    return !image->empty();
+}
+
+/*
+* Request the same pairing barcode from many threads at once with a simulated slow driver,
+* then again from a new cache instance that finds the images in the spill directory
+*/
+void RunRequestStorm(const string& spill_directory)
+{
+    const int kThreads = 32;
+    const int kRequestsPerThread = 50;
+    const int kDriverLatencyMs = 200;
+
+    atomic<int> driver_calls(0);
+    PairingBarcodeCache::Fetcher slow_driver = [&driver_calls, kDriverLatencyMs](const PairingBarcodeRequest& request, PairingBarcodeCache::Image* image)
+    {
+        driver_calls++;
+        this_thread::sleep_for(chrono::milliseconds(kDriverLatencyMs));
+        image->assign(64 * 1024, (unsigned char)request.image_size);
+        return true;
+    };
+
+    PairingBarcodeCacheSettings settings;
+    settings.spill_directory = spill_directory;
+    for (int image_size = 0; image_size < 2; image_size++)
+    {
+        // Start cold - drop images spilled by an earlier run
+        PairingBarcodeRequest request = { "STORM-HOST", PAIRING_BARCODE_TYPE_STC, PAIRING_PROTOCOL_SSI_BT_CRADLE,
+                                          PAIRING_DEFAULT_OPTION_NONE, image_size };
+        PairingBarcodeCache(settings, slow_driver).Invalidate(request);
+    }
+
+    for (int run = 0; run < 2; run++)
+    {
+        PairingBarcodeCache cache(settings, slow_driver);
+        driver_calls = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        vector<thread> threads;
+        for (int t = 0; t < kThreads; t++)
+        {
+            threads.push_back(thread([&cache, t]()
+            {
+                for (int i = 0; i < kRequestsPerThread; i++)
+                {
+                    PairingBarcodeRequest request = { "STORM-HOST", PAIRING_BARCODE_TYPE_STC, PAIRING_PROTOCOL_SSI_BT_CRADLE,
+                                                      PAIRING_DEFAULT_OPTION_NONE, (t + i) % 2 };
+                    PairingBarcodeCache::ImagePtr image;
+                    cache.Get(request, &image);
+                }
+            }));
+        }
+        for (size_t t = 0; t < threads.size(); t++)
+        {
+            threads[t].join();
+        }
+        double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << " " << (run == 0 ? "Cold cache" : "Restarted cache") << ", " << kThreads * kRequestsPerThread << " requests in "
+             << milliseconds << " ms : driver calls " << driver_calls << ", misses " << cache.MissCount()
+             << ", shared " << cache.SharedCount() << ", memory hits " << cache.MemoryHitCount()
+             << ", disk hits " << cache.DiskHitCount() << endl;
+    }
+}
+
+/*
+* Get the pairing barcode through the cache and save it for printing
+* return value : Pairing barcode success/fail status
+*/
+bool GetPairingBarcode(PairingBarcodeCache* cache, const string& host, const string& output_path)
+{
+    PairingBarcodeRequest request = { host, PAIRING_BARCODE_TYPE_STC, PAIRING_PROTOCOL_SSI_BT_CRADLE,
+                                      PAIRING_DEFAULT_OPTION_NONE, PAIRING_IMAGE_SIZE_MEDIUM };
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    PairingBarcodeCache::ImagePtr image;
+    if (!cache->Get(request, &image))
+    {
+        return false;
+    }
+    double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    ofstream file(output_path.c_str(), ios::binary | ios::trunc);
+    file.write((const char*)&(*image)[0], image->size());
+    cout << "Pairing barcode (" << image->size() << " bytes) saved to " << output_path << " in " << milliseconds << " ms" << endl;
+    return true;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    const string spill_directory = "pairing_barcode_cache";
+    CreateDirectoryA(spill_directory.c_str(), NULL);
+
+    cout << "Pairing barcode request storm with simulated driver" << endl;
+    RunRequestStorm(spill_directory);
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (Open())
+    {
+        char computer_name[MAX_COMPUTERNAME_LENGTH + 1] = { 0 };
+        DWORD length = sizeof(computer_name);
+        GetComputerNameA(computer_name, &length);
+
+        PairingBarcodeCacheSettings settings;
+        settings.spill_directory = spill_directory;
+        PairingBarcodeCache cache(settings, FetchPairingBarcode);
+        for (int i = 0; i < 3; i++)
+        {
+            if (!GetPairingBarcode(&cache, computer_name, "pairing_barcode.bmp"))
+            {
+                break;
+            }
+        }
+        cout << "Pairing barcode cache - memory hits : " << cache.MemoryHitCount() << ", disk hits : " << cache.DiskHitCount()
+             << ", misses : " << cache.MissCount() << ", failed : " << cache.FailedCount() << endl;
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,423 @@
+/*******************************************************************************************
+* @file connection_supervisor.h
+* @brief Restores event registration, enabled state and attributes of scanners that drop and rejoin
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "opcode_traits.h"
+#include "xml_reader.h"
+
+//---- PNP event types ------//
+#define PNP_EVENT_ATTACHED  0
+#define PNP_EVENT_DETACHED  1
+
+/**
+* Connection supervisor settings
+**/
+struct SupervisorSettings
+{
+    int initial_backoff_ms;     // Delay before the second restore attempt, doubled per failure
+    int max_backoff_ms;         // Backoff ceiling
+    std::vector<int> event_ids; // Events (re)registered with REGISTER_FOR_EVENTS
+    unsigned int jitter_seed;
+
+    SupervisorSettings()
+        : initial_backoff_ms(10), max_backoff_ms(5000), jitter_seed(std::random_device()())
+    {
+        event_ids.push_back(EVENT_TYPE_BARCODE);
+        event_ids.push_back(EVENT_TYPE_PNP);
+    }
+};
+
+/**
+* State of a supervised scanner
+**/
+enum SupervisedState
+{
+    kScannerDetached,
+    kScannerRestoring,  // Attached, enabled state/attributes not restored yet
+    kScannerReady
+};
+
+/**
+* Keeps Bluetooth (and other hot pluggable) scanners usable across disconnects.
+*
+* Scanners are tracked by serial number because a rejoining scanner may get a new scanner id;
+* scanners attaching for the first time are tracked from then on. The supervisor remembers the
+* enabled state and the attributes set through it; when a PNP attach event brings a scanner back
+* it registers for events again and restores them. The first
+* restore attempt runs on the next Poll(); failed attempts are retried with exponential backoff
+* and jitter so a rejoining fleet does not retry in lock step.
+*
+* Decodes from a scanner that is still being restored are held and delivered in order once it is
+* ready (or dropped if it is meant to be disabled), so a scan taken right after reattach is not
+* lost. The time from attach to the first delivered decode is recorded per reattach.
+*
+* Like ScaleReader, the supervisor is driven from the thread that owns the CoreScanner interface:
+* feed it PNP and decode events and call Poll() from the message loop.
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommand signature (e.g. MockBluetoothScanner)
+**/
+template <typename Scanner>
+class ConnectionSupervisor
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<void(const std::string& serial_number, int scanner_id, const std::string& scan_data)> DecodeHandler;
+
+    /**
+    * Connection supervisor constructor
+    * @param scanner - CoreScanner interface
+    * @param settings - Backoff and event settings
+    * @param decode_handler - Receives decodes of ready scanners
+    */
+    ConnectionSupervisor(Scanner* scanner, const SupervisorSettings& settings, const DecodeHandler& decode_handler)
+        : scanner_(scanner), settings_(settings), decode_handler_(decode_handler), random_(settings.jitter_seed),
+          events_registered_(false), restore_attempt_count_(0), restore_failure_count_(0), reattach_count_(0)
+    {
+    }
+
+    /**
+    * Register for events
+    * return value : Command success/fail status (on failure registration is retried with the next restore)
+    */
+    bool Start()
+    {
+        events_registered_ = Exec<REGISTER_FOR_EVENTS>(scanner_, settings_.event_ids).Succeeded();
+        return events_registered_;
+    }
+
+    /**
+    * Supervise an attached scanner
+    * @param scanner_id - Current scanner id
+    * @param serial_number - Scanner serial number
+    * @param enabled - Current enabled state
+    */
+    void Track(int scanner_id, const std::string& serial_number, bool enabled = true)
+    {
+        Record& record = RecordFor(serial_number);
+        record.scanner_id = scanner_id;
+        record.state = kScannerReady;
+        record.enabled = enabled;
+        record.was_attached = true;
+    }
+
+    /**
+    * Enable/disable scanning and remember the state for reattach
+    * return value : Command success/fail status (true if the scanner is detached and the state was recorded)
+    */
+    bool SetEnabled(const std::string& serial_number, bool enabled)
+    {
+        Record& record = RecordFor(serial_number);
+        record.enabled = enabled;
+        if (record.state != kScannerReady)
+        {
+            return true;
+        }
+        return SendEnabled(record);
+    }
+
+    /**
+    * Set attributes and remember them for reattach (later values of an attribute replace earlier ones)
+    * return value : Command success/fail status (true if the scanner is detached and the attributes were recorded)
+    */
+    bool SetAttributes(const std::string& serial_number, const std::vector<Attribute>& attributes)
+    {
+        Record& record = RecordFor(serial_number);
+        for (size_t i = 0; i < attributes.size(); i++)
+        {
+            record.attributes[attributes[i].id] = attributes[i];
+        }
+        if (record.state != kScannerReady)
+        {
+            return true;
+        }
+        return Exec<RSM_ATTR_SET>(scanner_, record.scanner_id, attributes).Succeeded();
+    }
+
+    /**
+    * Disconnect a Bluetooth scanner (DISCONNECT_BT_SCANNER). It is restored when it rejoins.
+    * return value : Command success/fail status
+    */
+    bool Disconnect(const std::string& serial_number)
+    {
+        typename std::map<std::string, Record>::iterator it = records_.find(serial_number);
+        if (it == records_.end() || it->second.state == kScannerDetached)
+        {
+            return false;
+        }
+        bool success = Exec<DISCONNECT_BT_SCANNER>(scanner_, it->second.scanner_id).Succeeded();
+        if (success)
+        {
+            it->second.state = kScannerDetached;
+            it->second.held_decodes.clear();
+            events_registered_ = false;
+        }
+        return success;
+    }
+
+    /**
+    * Handle a PNP event
+    * @param event_type - PNP_EVENT_ATTACHED/PNP_EVENT_DETACHED
+    * @param pnp_data - PNP event xml
+    * @param now - Event time
+    */
+    void OnPnpEvent(short event_type, const std::string& pnp_data, Clock::time_point now)
+    {
+        XmlReader reader(pnp_data);
+        while (reader.FindElement("scanner"))
+        {
+            int scanner_depth = reader.Depth();
+            int scanner_id = 0;
+            std::string serial_number;
+            while (true)
+            {
+                XmlReader::Token token = reader.Next();
+                if (token == XmlReader::kEndOfDocument || (token == XmlReader::kEndElement && reader.Depth() < scanner_depth))
+                {
+                    break;
+                }
+                XmlSlice text;
+                if (token != XmlReader::kStartElement || reader.Depth() != scanner_depth + 1)
+                {
+                    continue;
+                }
+                if (reader.Name().Equals("scannerID") && reader.ReadElementText(&text))
+                {
+                    scanner_id = (int)text.ToLong();
+                }
+                else if (reader.Name().Equals("serialnumber") && reader.ReadElementText(&text))
+                {
+                    serial_number = text.ToString();
+                }
+            }
+            if (serial_number.empty())
+            {
+                continue;
+            }
+
+            if (event_type == PNP_EVENT_DETACHED)
+            {
+                typename std::map<std::string, Record>::iterator it = records_.find(serial_number);
+                if (it != records_.end())
+                {
+                    it->second.state = kScannerDetached;
+                    it->second.held_decodes.clear();
+                    events_registered_ = false;     // Registered again by the restore after reattach
+                }
+                continue;
+            }
+
+            Record& record = RecordFor(serial_number);
+            bool reattach = record.was_attached;
+
+            record.scanner_id = scanner_id;
+            record.state = kScannerRestoring;
+            record.attached_at = now;
+            record.next_attempt = now;
+            record.backoff_ms = settings_.initial_backoff_ms;
+            record.awaiting_first_decode = reattach;
+            record.was_attached = true;
+            if (reattach)
+            {
+                reattach_count_++;
+            }
+        }
+    }
+
+    /**
+    * Handle a decode event
+    * @param scanner_id - Scanner id reported with the decode
+    * @param scan_data - Decode data
+    * @param now - Event time
+    */
+    void OnDecode(int scanner_id, const std::string& scan_data, Clock::time_point now)
+    {
+        Record* record = FindByScannerId(scanner_id);
+        if (record == NULL)
+        {
+            decode_handler_(std::string(), scanner_id, scan_data);
+            return;
+        }
+        if (record->state == kScannerRestoring)
+        {
+            record->held_decodes.push_back(scan_data);
+            return;
+        }
+        Deliver(record, scan_data, now);
+    }
+
+    /**
+    * Run restore attempts that are due
+    * @param now - Current time
+    */
+    void Poll(Clock::time_point now)
+    {
+        for (typename std::map<std::string, Record>::iterator it = records_.begin(); it != records_.end(); ++it)
+        {
+            Record& record = it->second;
+            if (record.state != kScannerRestoring || now < record.next_attempt)
+            {
+                continue;
+            }
+
+            restore_attempt_count_++;
+            if (Restore(record))
+            {
+                // Held decodes are delivered now, after the restore round trips
+                record.state = kScannerReady;
+                Clock::time_point ready = Clock::now();
+                std::vector<std::string> held;
+                held.swap(record.held_decodes);
+                for (size_t i = 0; i < held.size(); i++)
+                {
+                    Deliver(&record, held[i], ready);
+                }
+                continue;
+            }
+
+            // Equal jitter: half the backoff plus a random part of the other half
+            restore_failure_count_++;
+            int half = record.backoff_ms / 2;
+            int delay_ms = half + std::uniform_int_distribution<int>(0, record.backoff_ms - half)(random_);
+            record.next_attempt = now + std::chrono::milliseconds(delay_ms);
+            record.backoff_ms = record.backoff_ms * 2 > settings_.max_backoff_ms ? settings_.max_backoff_ms : record.backoff_ms * 2;
+        }
+    }
+
+    /**
+    * State of a supervised scanner (kScannerDetached if unknown)
+    */
+    SupervisedState StateOf(const std::string& serial_number) const
+    {
+        typename std::map<std::string, Record>::const_iterator it = records_.find(serial_number);
+        return it == records_.end() ? kScannerDetached : it->second.state;
+    }
+
+    /**
+    * Attach to first delivered decode latency of each completed reattach, in milliseconds
+    */
+    const std::vector<double>& ReattachLatencies() const { return reattach_latencies_ms_; }
+
+    /**
+    * Number of supervised reattach events (first attaches of a scanner are not counted)
+    */
+    long ReattachCount() const { return reattach_count_; }
+
+    /**
+    * Number of restore attempts
+    */
+    long RestoreAttemptCount() const { return restore_attempt_count_; }
+
+    /**
+    * Number of failed restore attempts
+    */
+    long RestoreFailureCount() const { return restore_failure_count_; }
+
+private:
+    struct Record
+    {
+        std::string serial_number;
+        int scanner_id;
+        SupervisedState state;
+        bool enabled;
+        std::map<int, Attribute> attributes;    // Attributes to restore, by id
+        Clock::time_point attached_at;
+        Clock::time_point next_attempt;
+        int backoff_ms;
+        bool awaiting_first_decode;
+        bool was_attached;      // Tracked or attached before, so the next attach is a reattach
+        std::vector<std::string> held_decodes;
+
+        Record()
+            : scanner_id(0), state(kScannerDetached), enabled(true), backoff_ms(0), awaiting_first_decode(false),
+              was_attached(false)
+        {
+        }
+    };
+
+    Record& RecordFor(const std::string& serial_number)
+    {
+        Record& record = records_[serial_number];
+        record.serial_number = serial_number;
+        return record;
+    }
+
+    Record* FindByScannerId(int scanner_id)
+    {
+        for (typename std::map<std::string, Record>::iterator it = records_.begin(); it != records_.end(); ++it)
+        {
+            if (it->second.scanner_id == scanner_id && it->second.state != kScannerDetached)
+            {
+                return &it->second;
+            }
+        }
+        return NULL;
+    }
+
+    bool SendEnabled(const Record& record)
+    {
+        return record.enabled ?
+            Exec<DEVICE_SCAN_ENABLE>(scanner_, record.scanner_id).Succeeded() :
+            Exec<DEVICE_SCAN_DISABLE>(scanner_, record.scanner_id).Succeeded();
+    }
+
+    /**
+    * One restore attempt: event registration (lost on detach), enabled state, then all cached attributes in one RSM_ATTR_SET
+    */
+    bool Restore(const Record& record)
+    {
+        if (!events_registered_ && !Start())
+        {
+            return false;
+        }
+        if (!SendEnabled(record))
+        {
+            return false;
+        }
+        if (record.attributes.empty())
+        {
+            return true;
+        }
+        std::vector<Attribute> attributes;
+        for (typename std::map<int, Attribute>::const_iterator it = record.attributes.begin(); it != record.attributes.end(); ++it)
+        {
+            attributes.push_back(it->second);
+        }
+        return Exec<RSM_ATTR_SET>(scanner_, record.scanner_id, attributes).Succeeded();
+    }
+
+    void Deliver(Record* record, const std::string& scan_data, Clock::time_point now)
+    {
+        if (!record->enabled)
+        {
+            return;     // Scanned before the disable was restored
+        }
+        if (record->awaiting_first_decode)
+        {
+            record->awaiting_first_decode = false;
+            reattach_latencies_ms_.push_back(std::chrono::duration<double, std::milli>(now - record->attached_at).count());
+        }
+        decode_handler_(record->serial_number, record->scanner_id, scan_data);
+    }
+
+    Scanner* scanner_;
+    SupervisorSettings settings_;
+    DecodeHandler decode_handler_;
+    std::mt19937 random_;
+    bool events_registered_;
+    std::map<std::string, Record> records_;    // By serial number
+    std::vector<double> reattach_latencies_ms_;
+
+    long restore_attempt_count_;
+    long restore_failure_count_;
+    long reattach_count_;
+};
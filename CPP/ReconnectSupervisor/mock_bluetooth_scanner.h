@@ -0,0 +1,130 @@
+/*******************************************************************************************
+* @file mock_bluetooth_scanner.h
+* @brief Simulated Bluetooth scanner answering the commands used to restore a rejoining scanner
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+
+/**
+* Simulated Bluetooth scanner with the ICoreScanner::ExecCommand signature, used to exercise
+* ConnectionSupervisor without hardware. Every command takes command_latency_ms of real time
+* (a Bluetooth round trip). FailNextCommands() makes the radio reject commands right after a rejoin.
+**/
+class MockBluetoothScanner
+{
+public:
+    static const LONG kStatusFailed = 1;
+
+    /**
+    * Mock scanner constructor
+    * @param command_latency_ms - Time each command takes
+    */
+    explicit MockBluetoothScanner(int command_latency_ms = 3)
+        : command_latency_ms_(command_latency_ms), fail_count_(0), events_registered_(false), enabled_(true), command_count_(0)
+    {
+    }
+
+    /**
+    * Reject the next commands (status kStatusFailed)
+    */
+    void FailNextCommands(int count) { fail_count_ = count; }
+
+    /**
+    * Scanner lost its volatile settings and event registration (power cycle / rejoin)
+    */
+    void ResetVolatileState()
+    {
+        events_registered_ = false;
+        enabled_ = true;
+        attributes_.clear();
+    }
+
+    /**
+    * PNP event xml for this scanner
+    */
+    static std::string PnpXml(int scanner_id, const std::string& serial_number)
+    {
+        return "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><arg-xml><scanners><scanner type=\"SNAPI\"><scannerID>" +
+            std::to_string(scanner_id) + "</scannerID><serialnumber>" + serial_number +
+            "</serialnumber><modelnumber>MOCK-BT</modelnumber></scanner></scanners><status>1</status></arg-xml></outArgs>";
+    }
+
+    bool EventsRegistered() const { return events_registered_; }
+    bool Enabled() const { return enabled_; }
+    const std::map<int, std::string>& Attributes() const { return attributes_; }
+    long CommandCount() const { return command_count_; }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        command_count_++;
+        *out_xml = NULL;
+        std::this_thread::sleep_for(std::chrono::milliseconds(command_latency_ms_));
+        if (fail_count_ > 0)
+        {
+            fail_count_--;
+            *status = kStatusFailed;
+            return S_OK;
+        }
+
+        *status = STATUS_SUCCESS;
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        switch (opcode)
+        {
+        case REGISTER_FOR_EVENTS:
+            events_registered_ = true;
+            break;
+        case DEVICE_SCAN_ENABLE:
+            enabled_ = true;
+            break;
+        case DEVICE_SCAN_DISABLE:
+            enabled_ = false;
+            break;
+        case RSM_ATTR_SET:
+        {
+            XmlReader reader(in);
+            while (reader.FindElement("attribute"))
+            {
+                int depth = reader.Depth();
+                int id = 0;
+                XmlSlice text;
+                if (reader.FindChild("id", depth) && reader.ReadElementText(&text))
+                {
+                    id = (int)text.ToLong();
+                }
+                if (reader.FindChild("value", depth) && reader.ReadElementText(&text))
+                {
+                    attributes_[id] = text.ToString();
+                }
+            }
+            break;
+        }
+        case DISCONNECT_BT_SCANNER:
+            break;
+        default:
+            *status = kStatusFailed;    // Not supported by the mock
+            break;
+        }
+        return S_OK;
+    }
+
+private:
+    int command_latency_ms_;
+    int fail_count_;
+    bool events_registered_;
+    bool enabled_;
+    std::map<int, std::string> attributes_;
+    long command_count_;
+};
@@ -0,0 +1,414 @@
+/*******************************************************************************************
+* @file reconnect_supervisor.cpp
+* @brief This file contains code snippet to restore scanners that disconnect and rejoin (Bluetooth churn)
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "connection_supervisor.h"
+#include "mock_bluetooth_scanner.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Get connected scanners with their serial numbers
+* @param scanners - Receives scanner id and serial number pairs
+* return value : GetScanners success/fail status
+*/
+bool GetScannerSerials(vector<pair<int, string> >* scanners)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+
+    XmlReader reader(get_scanners_output_xml);
+    while (reader.FindElement("scanner"))
+    {
+        int depth = reader.Depth();
+        XmlSlice text;
+        pair<int, string> scanner(0, string());
+        if (reader.FindChild("scannerID", depth) && reader.ReadElementText(&text))
+        {
+            scanner.first = (int)text.ToLong();
+        }
+        if (reader.FindChild("serialnumber", depth) && reader.ReadElementText(&text))
+        {
+            scanner.second = text.ToString();
+        }
+        if (scanner.first != 0 && !scanner.second.empty())
+        {
+            scanners->push_back(scanner);
+        }
+    }
+    cout << "CoreScanner GetScanners() - Success, " << scanners->size() << " scanners" << endl;
+    return true;
+}
+
+/*
+* Drive a mock Bluetooth scanner through detach/rejoin cycles and measure rejoin to first decode latency.
+* Each rejoin comes back with a new scanner id and lost settings; some rejoins reject the first restore attempts.
+*/
+void RunMockChurn()
+{
+    const int kCycles = 40;
+    const double kLatencyBudgetMs = 100;
+    const string serial_number = "MOCK-BT-0001";
+
+    MockBluetoothScanner mock_scanner;
+    long delivered = 0;
+    long delivered_while_disabled = 0;
+    ConnectionSupervisor<MockBluetoothScanner> supervisor(&mock_scanner, SupervisorSettings(),
+        [&](const string& serial, int scanner_id, const string& scan_data)
+        {
+            delivered++;
+            if (!mock_scanner.Enabled())
+            {
+                delivered_while_disabled++;
+            }
+        });
+
+    supervisor.Start();
+    supervisor.Track(1, serial_number);
+    vector<Attribute> attributes;
+    Attribute beeper_volume = { 140, 'B', "1" };
+    Attribute decode_tone = { 145, 'B', "2" };
+    attributes.push_back(beeper_volume);
+    attributes.push_back(decode_tone);
+    supervisor.SetAttributes(serial_number, attributes);
+
+    bool restored = true;
+    for (int cycle = 0; cycle < kCycles; cycle++)
+    {
+        ConnectionSupervisor<MockBluetoothScanner>::Clock::time_point now = ConnectionSupervisor<MockBluetoothScanner>::Clock::now();
+        int scanner_id = 1 + cycle % 4;
+        supervisor.OnPnpEvent(PNP_EVENT_DETACHED, MockBluetoothScanner::PnpXml(scanner_id, serial_number), now);
+        mock_scanner.ResetVolatileState();
+        if (cycle % 5 == 4)
+        {
+            mock_scanner.FailNextCommands(2);   // Radio not ready yet
+        }
+
+        // Rejoin with a new id, the operator scans right away
+        scanner_id = 1 + (cycle + 1) % 4;
+        supervisor.OnPnpEvent(PNP_EVENT_ATTACHED, MockBluetoothScanner::PnpXml(scanner_id, serial_number), ConnectionSupervisor<MockBluetoothScanner>::Clock::now());
+        supervisor.OnDecode(scanner_id, "0123456789", ConnectionSupervisor<MockBluetoothScanner>::Clock::now());
+        while (supervisor.StateOf(serial_number) != kScannerReady)
+        {
+            supervisor.Poll(ConnectionSupervisor<MockBluetoothScanner>::Clock::now());
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        restored = restored && mock_scanner.EventsRegistered() && mock_scanner.Enabled() &&
+            mock_scanner.Attributes().size() == attributes.size();
+    }
+
+    // Disabled while away - the scan taken right after rejoin must not be delivered
+    supervisor.OnPnpEvent(PNP_EVENT_DETACHED, MockBluetoothScanner::PnpXml(1, serial_number), ConnectionSupervisor<MockBluetoothScanner>::Clock::now());
+    supervisor.SetEnabled(serial_number, false);
+    mock_scanner.ResetVolatileState();
+    supervisor.OnPnpEvent(PNP_EVENT_ATTACHED, MockBluetoothScanner::PnpXml(1, serial_number), ConnectionSupervisor<MockBluetoothScanner>::Clock::now());
+    supervisor.OnDecode(1, "0123456789", ConnectionSupervisor<MockBluetoothScanner>::Clock::now());
+    while (supervisor.StateOf(serial_number) != kScannerReady)
+    {
+        supervisor.Poll(ConnectionSupervisor<MockBluetoothScanner>::Clock::now());
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+
+    vector<double> latencies = supervisor.ReattachLatencies();
+    sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (size_t i = 0; i < latencies.size(); i++)
+    {
+        total += latencies[i];
+    }
+    cout << " " << supervisor.ReattachCount() << " rejoins, " << supervisor.RestoreAttemptCount() << " restore attempts ("
+         << supervisor.RestoreFailureCount() << " failed), settings restored : " << (restored ? "yes" : "NO")
+         << ", decodes delivered : " << delivered << " (while disabled : " << delivered_while_disabled << ")" << endl;
+    if (!latencies.empty())
+    {
+        cout << " Rejoin to first decode : median " << latencies[latencies.size() / 2] << " ms, mean " << total / latencies.size()
+             << " ms, max " << latencies.back() << " ms - " << (latencies.back() < kLatencyBudgetMs ? "within" : "OVER")
+             << " " << kLatencyBudgetMs << " ms budget" << endl;
+    }
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Reconnect supervisor with mock Bluetooth scanner" << endl;
+    RunMockChurn();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        ConnectionSupervisor<ICoreScanner> supervisor(scanner_interface, SupervisorSettings(),
+            [](const string& serial_number, int scanner_id, const string& scan_data)
+            {
+                cout << "Barcode scanner ID:[" << scanner_id << "] S/N:[" << serial_number << "]" << endl;
+            });
+
+        vector<pair<int, string> > scanners;
+        GetScannerSerials(&scanners);
+        for (size_t i = 0; i < scanners.size(); i++)
+        {
+            supervisor.Track(scanners[i].first, scanners[i].second);
+        }
+
+        scanner_event_sink->SetPnpHandler([&supervisor](short event_type, const string& pnp_data)
+        {
+            cout << (event_type == PNP_EVENT_ATTACHED ? "Scanner attached" : "Scanner detached") << endl;
+            supervisor.OnPnpEvent(event_type, pnp_data, ConnectionSupervisor<ICoreScanner>::Clock::now());
+        });
+        scanner_event_sink->SetScanDataHandler([&supervisor](short event_type, const string& scan_data)
+        {
+            string scanner_id;
+            XmlFindText(scan_data, "scannerID", &scanner_id);
+            supervisor.OnDecode(atoi(scanner_id.c_str()), scan_data, ConnectionSupervisor<ICoreScanner>::Clock::now());
+        });
+
+        if (supervisor.Start())
+        {
+            cout << "CoreScanner RegisterForEvents() - Success" << endl;
+        }
+        cout << "Disconnect and reconnect Bluetooth scanners, then scan. Press any key to exit." << endl;
+        MSG msg = { 0 };
+        while (true)   // Message loop to dispatch windows messages while waiting for PNP and barcode events
+        {
+            PeekMessage(&msg, NULL, 0, 0, 0);
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+            if (_kbhit())
+            {
+                break;
+            }
+            supervisor.Poll(ConnectionSupervisor<ICoreScanner>::Clock::now());
+            Sleep(1);
+        }
+        getchar();
+
+        const vector<double>& latencies = supervisor.ReattachLatencies();
+        for (size_t i = 0; i < latencies.size(); i++)
+        {
+            cout << " Rejoin to first decode : " << latencies[i] << " ms" << endl;
+        }
+        scanner_event_sink->SetPnpHandler(nullptr);
+        scanner_event_sink->SetScanDataHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,236 @@
+/*******************************************************************************************
+* @file event_router.cpp
+* @brief Definition of CoreScanner event router
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "event_router.h"
+#include <cstring>
+#include <cwchar>
+
+using namespace std;
+
+/**
+* Value of the first <tag>number</tag> element in a wide xml string, 0 if not found
+**/
+static int FindWideNumber(const wchar_t* xml, size_t length, const wchar_t* tag)
+{
+    size_t tag_length = wcslen(tag);
+    for (size_t i = 0; i + tag_length <= length; i++)
+    {
+        if (xml[i] != L'<' || wmemcmp(xml + i, tag, tag_length) != 0)
+        {
+            continue;
+        }
+        int value = 0;
+        for (i += tag_length; i < length && xml[i] >= L'0' && xml[i] <= L'9'; i++)
+        {
+            value = value * 10 + (xml[i] - L'0');
+        }
+        return value;
+    }
+    return 0;
+}
+
+EventRouter::EventRouter()
+    : dropped_count_(0), delivered_count_(0)
+{
+    Compile();
+}
+
+int EventRouter::Subscribe(const EventFilter& filter, const EventHandler& handler)
+{
+    if (!handler || !filter.valid)
+    {
+        return -1;
+    }
+
+    int consumer_id = 0;
+    while (consumer_id < (int)handlers_.size() && handlers_[consumer_id])
+    {
+        consumer_id++;
+    }
+    if (consumer_id >= kMaxConsumers)
+    {
+        return -1;
+    }
+    if (consumer_id == (int)handlers_.size())
+    {
+        filters_.push_back(filter);
+        handlers_.push_back(handler);
+    }
+    else
+    {
+        filters_[consumer_id] = filter;
+        handlers_[consumer_id] = handler;
+    }
+    Compile();
+    return consumer_id;
+}
+
+void EventRouter::Unsubscribe(int consumer_id)
+{
+    if (consumer_id < 0 || consumer_id >= (int)handlers_.size())
+    {
+        return;
+    }
+    handlers_[consumer_id] = EventHandler();
+    filters_[consumer_id] = EventFilter();
+    Compile();
+}
+
+string EventRouter::RegisterXml(int event_mask)
+{
+    int event_count = 0;
+    string event_ids;
+    for (int event_type = EVENT_TYPE_BARCODE; event_type <= EVENT_TYPE_OTHER; event_type <<= 1)
+    {
+        if (event_mask & event_type)
+        {
+            if (event_count > 0)
+            {
+                event_ids += ",";
+            }
+            event_ids += to_string(event_type);
+            event_count++;
+        }
+    }
+
+    string in_xml = "<inArgs>";
+    in_xml.append("<cmdArgs><arg-int>");
+    in_xml.append(to_string(event_count));
+    in_xml.append("</arg-int><arg-int>");
+    in_xml.append(event_ids);
+    in_xml.append("</arg-int></cmdArgs></inArgs>");
+    return in_xml;
+}
+
+int EventRouter::Route(int event_type, short event_subtype, const wchar_t* xml, size_t xml_length, const unsigned char* data, long size)
+{
+    int type_index = EventTypeIndex(event_type);
+    ConsumerMask consumers = type_index < 0 ? 0 : type_consumers_[type_index];
+    if (consumers == 0)
+    {
+        dropped_count_++;
+        return 0;
+    }
+
+    // Look into the xml only if a consumer still in the running filters on the value
+    int scanner_id = 0;
+    if (consumers & scanner_filtered_)
+    {
+        scanner_id = FindWideNumber(xml, xml_length, L"<scannerID>");
+        consumers &= scanner_consumers_[scanner_id <= MAX_NUM_DEVICES ? scanner_id : 0];
+    }
+    int symbology = 0;
+    if (event_type == EVENT_TYPE_BARCODE && (consumers & symbology_filtered_))
+    {
+        symbology = FindWideNumber(xml, xml_length, L"<datatype>");
+        consumers &= symbology_consumers_[symbology < kMaxSymbologyId ? symbology : 0];
+    }
+    if (consumers == 0)
+    {
+        dropped_count_++;
+        return 0;
+    }
+
+    // Values the filters did not need are still reported to the consumers
+    if (scanner_id == 0)
+    {
+        scanner_id = FindWideNumber(xml, xml_length, L"<scannerID>");
+    }
+    if (symbology == 0 && event_type == EVENT_TYPE_BARCODE)
+    {
+        symbology = FindWideNumber(xml, xml_length, L"<datatype>");
+    }
+
+    wstring out_str(xml != NULL ? xml : L"", xml_length);
+    string event_xml(out_str.begin(), out_str.end());
+    RoutedEvent event(event_type, event_subtype, scanner_id, symbology, event_xml, data, size);
+    int delivered = 0;
+    for (int consumer_id = 0; consumers != 0; consumer_id++, consumers >>= 1)
+    {
+        if (consumers & 1)
+        {
+            handlers_[consumer_id](event);
+            delivered++;
+        }
+    }
+    delivered_count_++;
+    return delivered;
+}
+
+/**
+* Rebuild the consumer mask tables from the filters
+**/
+void EventRouter::Compile()
+{
+    event_mask_ = 0;
+    scanner_filtered_ = 0;
+    symbology_filtered_ = 0;
+    memset(type_consumers_, 0, sizeof(type_consumers_));
+    memset(scanner_consumers_, 0, sizeof(scanner_consumers_));
+    memset(symbology_consumers_, 0, sizeof(symbology_consumers_));
+
+    for (int consumer_id = 0; consumer_id < (int)handlers_.size(); consumer_id++)
+    {
+        if (!handlers_[consumer_id])
+        {
+            continue;
+        }
+        const EventFilter& filter = filters_[consumer_id];
+        ConsumerMask bit = 1ULL << consumer_id;
+
+        event_mask_ |= filter.event_types;
+        for (int type_index = 0; type_index < kEventTypeCount; type_index++)
+        {
+            if (filter.event_types & (1 << type_index))
+            {
+                type_consumers_[type_index] |= bit;
+            }
+        }
+
+        bool all_scanners = filter.scanner_ids.none();
+        if (!all_scanners)
+        {
+            scanner_filtered_ |= bit;
+        }
+        for (int scanner_id = 0; scanner_id <= MAX_NUM_DEVICES; scanner_id++)
+        {
+            if (all_scanners || filter.scanner_ids.test(scanner_id))
+            {
+                scanner_consumers_[scanner_id] |= bit;
+            }
+        }
+
+        bool all_symbologies = filter.symbologies.none();
+        if (!all_symbologies)
+        {
+            symbology_filtered_ |= bit;
+        }
+        for (int symbology = 0; symbology < kMaxSymbologyId; symbology++)
+        {
+            if (all_symbologies || filter.symbologies.test(symbology))
+            {
+                symbology_consumers_[symbology] |= bit;
+            }
+        }
+    }
+}
+
+/**
+* Table index of an EVENT_TYPE_* flag, -1 if not a single known flag
+**/
+int EventRouter::EventTypeIndex(int event_type)
+{
+    for (int type_index = 0; type_index < kEventTypeCount; type_index++)
+    {
+        if (event_type == (1 << type_index))
+        {
+            return type_index;
+        }
+    }
+    return -1;
+}
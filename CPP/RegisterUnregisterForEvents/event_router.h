@@ -0,0 +1,161 @@
+/*******************************************************************************************
+* @file event_router.h
+* @brief Per consumer CoreScanner event subscriptions routed through a precompiled bitset filter
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <bitset>
+#include <functional>
+#include <string>
+#include <vector>
+#include "common_defs.h"
+
+const int kMaxSymbologyId = 256;    // Scan data <datatype> values (ST_*) are below 0x100
+
+/**
+* What a consumer wants to receive. Empty symbology/scanner sets mean "all".
+* Symbologies only filter barcode events. A symbology or scanner id out of range makes the
+* filter invalid and EventRouter::Subscribe() rejects it (skipping the id could turn a
+* filter on one scanner into a filter on all scanners).
+**/
+struct EventFilter
+{
+    int event_types;                                // EVENT_TYPE_* flags
+    std::bitset<kMaxSymbologyId> symbologies;       // ST_* values
+    std::bitset<MAX_NUM_DEVICES + 1> scanner_ids;
+    bool valid;                                     // No out of range id was added
+
+    explicit EventFilter(int types = 0) : event_types(types), valid(true) {}
+
+    EventFilter& Symbology(int symbology)
+    {
+        if (symbology < 0 || symbology >= kMaxSymbologyId)
+        {
+            valid = false;
+            return *this;
+        }
+        symbologies.set(symbology);
+        return *this;
+    }
+
+    EventFilter& Scanner(int scanner_id)
+    {
+        if (scanner_id < 0 || scanner_id > MAX_NUM_DEVICES)
+        {
+            valid = false;
+            return *this;
+        }
+        scanner_ids.set(scanner_id);
+        return *this;
+    }
+};
+
+/**
+* Event delivered to a consumer
+**/
+struct RoutedEvent
+{
+    int event_type;             // EVENT_TYPE_* flag
+    short event_subtype;        // event_type argument of the CoreScanner event
+    int scanner_id;             // 0 if not present in the event xml
+    int symbology;              // Barcode events only, 0 otherwise
+    const std::string& xml;     // Event xml (scan data, pnp data, rmd data, scanner data)
+    const unsigned char* data;  // Image/video/binary data buffer, NULL for xml only events
+    long size;
+
+    RoutedEvent(int type, short subtype, int id, int symbology_id, const std::string& event_xml, const unsigned char* buffer, long buffer_size)
+        : event_type(type), event_subtype(subtype), scanner_id(id), symbology(symbology_id), xml(event_xml), data(buffer), size(buffer_size)
+    {
+    }
+};
+
+typedef std::function<void(const RoutedEvent& event)> EventHandler;
+
+/**
+* Routes CoreScanner events to the consumers that subscribed to them.
+*
+* Subscriptions are compiled into lookup tables of consumer bit masks - one mask per event type,
+* per scanner id and per symbology - so an event is matched with three table lookups and an AND.
+* The driver is registered once for the union of all subscribed event types (RegisterXml()).
+* The event BSTR is scanned in place for the scanner id and symbology only when a matching
+* consumer filters on them, and is converted to a string only when some consumer receives the event.
+*
+* Subscribe/Unsubscribe and Route are expected on the same (event dispatching) thread.
+**/
+class EventRouter
+{
+public:
+    static const int kMaxConsumers = 64;
+
+    EventRouter();
+
+    /**
+    * Add a consumer
+    * @param filter - Event types, symbologies and scanners the consumer wants
+    * @param handler - Called for every matching event
+    * return value : Consumer id, -1 if the filter is invalid or kMaxConsumers are subscribed
+    */
+    int Subscribe(const EventFilter& filter, const EventHandler& handler);
+
+    /**
+    * Remove a consumer
+    */
+    void Unsubscribe(int consumer_id);
+
+    /**
+    * Union of the event types of all consumers (EVENT_TYPE_* flags)
+    */
+    int EventMask() const { return event_mask_; }
+
+    /**
+    * Check if any consumer wants an event type - lets the sink skip unwrapping image/video buffers
+    */
+    bool Wants(int event_type) const { return (event_mask_ & event_type) != 0; }
+
+    /**
+    * REGISTER_FOR_EVENTS/UNREGISTER_FOR_EVENTS inXML for an event mask
+    */
+    static std::string RegisterXml(int event_mask);
+
+    /**
+    * Route an event
+    * @param event_type - EVENT_TYPE_* flag
+    * @param event_subtype - event_type argument of the CoreScanner event
+    * @param xml - Event xml as received (BSTR contents, not converted)
+    * @param xml_length - Length of xml in characters
+    * @param data - Image/video/binary buffer (NULL if none)
+    * @param size - Size of data
+    * return value : Number of consumers that received the event
+    */
+    int Route(int event_type, short event_subtype, const wchar_t* xml, size_t xml_length, const unsigned char* data = NULL, long size = 0);
+
+    /**
+    * Events dropped without a string conversion / events delivered
+    */
+    long DroppedCount() const { return dropped_count_; }
+    long DeliveredCount() const { return delivered_count_; }
+
+private:
+    typedef unsigned long long ConsumerMask;
+
+    static const int kEventTypeCount = 6;   // EVENT_TYPE_BARCODE .. EVENT_TYPE_OTHER
+
+    void Compile();
+    static int EventTypeIndex(int event_type);
+
+    std::vector<EventFilter> filters_;
+    std::vector<EventHandler> handlers_;    // Empty handler marks a free consumer id
+
+    // Compiled filter
+    int event_mask_;
+    ConsumerMask type_consumers_[kEventTypeCount];
+    ConsumerMask scanner_consumers_[MAX_NUM_DEVICES + 1];
+    ConsumerMask symbology_consumers_[kMaxSymbologyId];
+    ConsumerMask scanner_filtered_;         // Consumers with a scanner id set
+    ConsumerMask symbology_filtered_;       // Consumers with a symbology set
+
+    long dropped_count_;
+    long delivered_count_;
+};
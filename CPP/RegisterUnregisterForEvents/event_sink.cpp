@@ -20,6 +20,7 @@ IMPLEMENT_DYNAMIC(EventSink, CCmdTarget)
 * Event sink constructor
 **/
 EventSink::EventSink()
+    : router_(NULL)
 {
     EnableAutomation();
 }
@@ -40,6 +41,49 @@ void EventSink::OnFinalRelease()
     CCmdTarget::OnFinalRelease();
 }
 
+/**
+* Set event router
+**/
+void EventSink::SetRouter(EventRouter* router)
+{
+    router_ = router;
+}
+
+/**
+* Pointer to the bytes of a VT_ARRAY|VT_UI1 event buffer, NULL if the variant holds none.
+* Released with SafeArrayUnaccessData.
+**/
+static unsigned char* AccessEventBuffer(VARIANT* buffer)
+{
+    unsigned char* data = NULL;
+    if (buffer != NULL && buffer->vt == (VT_ARRAY | VT_UI1) && buffer->parray != NULL)
+    {
+        if (FAILED(SafeArrayAccessData(buffer->parray, (void**)&data)))
+        {
+            data = NULL;
+        }
+    }
+    return data;
+}
+
+/**
+* Route an image/video/binary data event - the buffer is only touched when a consumer wants the event
+**/
+static void RouteBufferEvent(EventRouter* router, int event_type, SHORT event_subtype, LONG size, VARIANT* buffer, BSTR* scanner_data)
+{
+    if (router == NULL || !router->Wants(event_type))
+    {
+        return;
+    }
+    BSTR xml = scanner_data != NULL ? *scanner_data : NULL;
+    unsigned char* data = AccessEventBuffer(buffer);
+    router->Route(event_type, event_subtype, xml, SysStringLen(xml), data, data != NULL ? size : 0);
+    if (data != NULL)
+    {
+        SafeArrayUnaccessData(buffer->parray);
+    }
+}
+
 BEGIN_MESSAGE_MAP(EventSink, CCmdTarget)
 END_MESSAGE_MAP()
 
@@ -64,6 +108,11 @@ END_INTERFACE_MAP()
 **/
 void EventSink::OnScanDataEvent(short event_type, BSTR scan_data)
 {
+    if (router_)
+    {
+        router_->Route(EVENT_TYPE_BARCODE, event_type, scan_data, SysStringLen(scan_data));
+        return;
+    }
     wstring out_str(scan_data, SysStringLen(scan_data));
     string  output_barcode_data(out_str.begin(), out_str.end());
     cout << "Barcode Event Type : " << event_type << endl;
@@ -92,7 +141,7 @@ void EventSink::OnIoNotificationEvent(short type, unsigned char data)
 **/
 void EventSink::OnImageEvent(SHORT event_type, LONG size, SHORT image_format, VARIANT *image_data, BSTR* scanner_data)
 {
-
+    RouteBufferEvent(router_, EVENT_TYPE_IMAGE, event_type, size, image_data, scanner_data);
 }
 
 /**
@@ -100,7 +149,7 @@ void EventSink::OnImageEvent(SHORT event_type, LONG size, SHORT image_format, VA
 **/
 void EventSink::OnVideoEvent(SHORT event_type, LONG size, VARIANT *video_data, BSTR* scanner_data)
 {
-
+    RouteBufferEvent(router_, EVENT_TYPE_VIDEO, event_type, size, video_data, scanner_data);
 }
 
 /**
@@ -108,7 +157,10 @@ void EventSink::OnVideoEvent(SHORT event_type, LONG size, VARIANT *video_data, B
 **/
 void EventSink::OnPnpEvents(short event_type, BSTR pnp_data)
 {
-
+    if (router_)
+    {
+        router_->Route(EVENT_TYPE_PNP, event_type, pnp_data, SysStringLen(pnp_data));
+    }
 }
 
 /**
@@ -116,7 +168,10 @@ void EventSink::OnPnpEvents(short event_type, BSTR pnp_data)
 **/
 void EventSink::OnScannerNotificationEvent(short notification_type, BSTR scanner_data)
 {
-
+    if (router_)
+    {
+        router_->Route(EVENT_TYPE_OTHER, notification_type, scanner_data, SysStringLen(scanner_data));
+    }
 }
 
 /**
@@ -124,7 +179,10 @@ void EventSink::OnScannerNotificationEvent(short notification_type, BSTR scanner
 **/
 void EventSink::OnScanRmdEvent(short event_type, BSTR event_data)
 {
-
+    if (router_)
+    {
+        router_->Route(EVENT_TYPE_RMD, event_type, event_data, SysStringLen(event_data));
+    }
 }
 
 /**
@@ -132,5 +190,5 @@ void EventSink::OnScanRmdEvent(short event_type, BSTR event_data)
 **/
 void EventSink::OnBinaryDataEvent(SHORT event_type, LONG size, SHORT data_format, VARIANT *binary_bata, BSTR* scanner_data)
 {
-
+    RouteBufferEvent(router_, EVENT_TYPE_OTHER, event_type, size, binary_bata, scanner_data);
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "afxctl.h"
 #include "afxwin.h"
 #include "afxcmn.h"
+#include "event_router.h"
 
 /**
 * Class to handle CoreScanner events
@@ -34,6 +35,12 @@ public:
     */
     virtual void OnFinalRelease();
 
+    /**
+    * Route events to the consumers subscribed in a router.
+    * Without a router barcode event xml is printed.
+    * @param router - Event router (not owned)
+    */
+    void SetRouter(EventRouter* router);
 
     /**
     * Scan decode data event handler function
@@ -106,6 +113,9 @@ public:
     */
     void OnBinaryDataEvent(SHORT event_type, LONG size, SHORT data_format, VARIANT *binary_data, BSTR* scanner_data);
 
+private:
+    EventRouter* router_;
+
 protected:
     DECLARE_MESSAGE_MAP()
     DECLARE_DISPATCH_MAP()
@@ -1,24 +1,116 @@
 /*******************************************************************************************
 * @file register_unregister_for_events.cpp
-* @brief This file contains code snippet to register/unregister for barcode events
+* @brief This file contains code snippet to register/unregister for the events subscribed by several consumers
 * @version 1.0.0.1
 * @date 2020-05-21
 * @copyright  2020 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
 ********************************************************************************************/
 #include <iostream>
 #include <string>
+#include <chrono>
+#include <cstdlib>
 #include <conio.h>
 #include "targetver.h"
 #include "event_sink.h"
+#include "event_router.h"
 #include "_core_scanner_i.c"
 #include "_core_scanner.h"
 #include "common_defs.h"
 
 using namespace std;
 
+/**
+* Wide scan data event xml as received in a ScanDataEvent BSTR
+**/
+static wstring SyntheticScanData(int scanner_id, int symbology, const string& label)
+{
+    string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><scannerID>" + to_string(scanner_id) +
+        "</scannerID><arg-xml><scandata><modelnumber>DS8178-SR0F007ZZWW</modelnumber><serialnumber>19245010502314</serialnumber>"
+        "<GUID>A2D4C4A7C9AA4F45A1C0C9A8A7C8C9F5</GUID><datatype>" + to_string(symbology) + "</datatype><datalabel>";
+    for (size_t i = 0; i < label.size(); i++)
+    {
+        xml += (i == 0 ? "0x" : " 0x");
+        const char* hex = "0123456789abcdef";
+        xml += hex[(label[i] >> 4) & 0xf];
+        xml += hex[label[i] & 0xf];
+    }
+    xml += "</datalabel><rawdata></rawdata></scandata></arg-xml></outArgs>";
+    return wstring(xml.begin(), xml.end());
+}
+
+/**
+* Compare routing through the compiled filter with converting every event and letting
+* each consumer parse and discard it
+**/
+void RunSyntheticRouting()
+{
+    const int kEventCount = 200000;
+    EventRouter router;
+    long received = 0;
+    EventHandler count_event = [&received](const RoutedEvent&) { received++; };
+
+    // Three lanes, each reading only retail symbologies from its own scanner, and a PNP monitor
+    for (int lane = 1; lane <= 3; lane++)
+    {
+        router.Subscribe(EventFilter(EVENT_TYPE_BARCODE).Scanner(lane).Symbology(ST_UPCA).Symbology(ST_EAN13), count_event);
+    }
+    router.Subscribe(EventFilter(EVENT_TYPE_PNP), count_event);
+
+    // Mostly Code 128 labels (discarded), every 10th event an EAN-13 on lane 2
+    wstring discarded = SyntheticScanData(2, ST_CODE_128, "SHIP0123456789");
+    wstring wanted = SyntheticScanData(2, ST_EAN13, "5901234123457");
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < kEventCount; i++)
+    {
+        const wstring& event_xml = (i % 10 == 0) ? wanted : discarded;
+        router.Route(EVENT_TYPE_BARCODE, BARCODE_EVENT_TYPE_GOOD_DECODE, event_xml.c_str(), event_xml.size());
+    }
+    double routed_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kEventCount;
+
+    // Baseline: every consumer receives the converted xml and filters it itself
+    long baseline_received = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < kEventCount; i++)
+    {
+        const wstring& event_xml = (i % 10 == 0) ? wanted : discarded;
+        wstring out_str(event_xml.c_str(), event_xml.size());
+        string xml(out_str.begin(), out_str.end());
+        for (int lane = 1; lane <= 3; lane++)
+        {
+            size_t id_pos = xml.find("<scannerID>");
+            size_t type_pos = xml.find("<datatype>");
+            if (id_pos == string::npos || type_pos == string::npos)
+            {
+                continue;
+            }
+            int scanner_id = atoi(xml.c_str() + id_pos + 11);
+            int symbology = atoi(xml.c_str() + type_pos + 10);
+            if (scanner_id == lane && (symbology == ST_UPCA || symbology == ST_EAN13))
+            {
+                baseline_received++;
+            }
+        }
+    }
+    double baseline_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / kEventCount;
+
+    cout << "Synthetic routing of " << kEventCount << " barcode events (90% discarded)" << endl;
+    cout << " Register mask : 0x" << hex << router.EventMask() << dec << endl;
+    cout << " Compiled filter : " << routed_ns << " ns/event, " << received << " delivered, " << router.DroppedCount() << " dropped before conversion" << endl;
+    cout << " Convert and filter per consumer : " << baseline_ns << " ns/event, " << baseline_received << " delivered" << endl;
+}
+
+/**
+* Print a routed barcode event
+**/
+static void PrintBarcode(const char* consumer, const RoutedEvent& event)
+{
+    cout << consumer << " - scanner " << event.scanner_id << " symbology " << event.symbology << endl;
+    cout << event.xml << endl;
+}
+
 int main()
 {
-    const int kEventIdCount = 1;
 
     ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
     DWORD cookie;
@@ -27,7 +119,17 @@ int main()
 
     HRESULT hr = S_FALSE;
     BSTR out_xml = 0;
-    int event_id_list[kEventIdCount];
+    EventRouter router;
+
+    RunSyntheticRouting();
+
+    // Consumers declare what they want - registration covers the union of their event types
+    router.Subscribe(EventFilter(EVENT_TYPE_BARCODE).Symbology(ST_UPCA).Symbology(ST_EAN13).Symbology(ST_EAN8),
+        [](const RoutedEvent& event) { PrintBarcode("Retail consumer", event); });
+    router.Subscribe(EventFilter(EVENT_TYPE_BARCODE).Symbology(ST_QR_CODE).Symbology(ST_DATAMATRIX).Scanner(1),
+        [](const RoutedEvent& event) { PrintBarcode("2D consumer (scanner 1)", event); });
+    router.Subscribe(EventFilter(EVENT_TYPE_PNP),
+        [](const RoutedEvent& event) { cout << "PNP consumer - " << (event.event_subtype == 0 ? "attached" : "detached") << " scanner " << event.scanner_id << endl; });
 
     // Initialize COM
     CoInitialize(NULL);
@@ -47,6 +149,7 @@ int main()
 
         // Create an instance of a sink object to receive CoreScanner events
         scanner_event_sink = new EventSink();
+        scanner_event_sink->SetRouter(&router);
         scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
         // Advice or make a connection
         BOOL stat = AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie);
@@ -82,26 +185,8 @@ int main()
             {
                 cout << "CoreScanner Open() - Success" << endl;
 
-                // Register for barcode events
-                event_id_list[0] = EVENT_TYPE_BARCODE;
-                string event_id_count;
-                event_id_count += to_string(kEventIdCount);
-                string event_ids;
-                for (int i = 0; i < kEventIdCount; i++)
-                {
-                    event_ids += to_string(event_id_list[i]);
-                    if (i < (kEventIdCount - 1))
-                    {
-                        event_ids += ",";
-                    }
-                }
-
-                string in_xml = "<inArgs>";
-                in_xml.append("<cmdArgs><arg-int>");
-                in_xml.append(event_id_count);
-                in_xml.append("</arg-int><arg-int>");
-                in_xml.append(event_ids);
-                in_xml.append("</arg-int></cmdArgs></inArgs>");
+                // Register once for the events of all consumers
+                string in_xml = EventRouter::RegisterXml(router.EventMask());
                 CComBSTR input = in_xml.c_str();
                 // Register for events
                 hr = scanner_interface->ExecCommand(REGISTER_FOR_EVENTS,  // Opcode: Register for events
@@ -0,0 +1,157 @@
+/*******************************************************************************************
+* @file mock_scale.h
+* @brief Simulated scanner scale answering CoreScanner scale opcodes
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "common_defs.h"
+#include "scale_reader.h"
+
+/**
+* Simulated scale with the ICoreScanner::ExecCommand signature, used to exercise ScaleReader
+* without hardware. Items are placed/removed on a scripted timeline; the platter weight rings
+* around the new value for settle_ms before it becomes stable.
+**/
+class MockScale
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+    * Mock scale constructor
+    * @param start - Start of the simulated timeline
+    * @param settle_ms - Time for the platter to settle after a weight change
+    */
+    MockScale(Clock::time_point start, int settle_ms = 300)
+        : start_(start), now_(start), settle_ms_(settle_ms), zero_offset_(0), command_count_(0)
+    {
+    }
+
+    /**
+    * Schedule platter weight change
+    * @param at_ms - Time offset from start of timeline
+    * @param weight - New platter weight
+    */
+    void ScheduleWeight(int at_ms, double weight)
+    {
+        WeightChange change = { at_ms, weight };
+        timeline_.push_back(change);
+    }
+
+    /**
+    * Set simulated current time
+    */
+    void SetTime(Clock::time_point now) { now_ = now; }
+
+    /**
+    * Number of commands received
+    */
+    long CommandCount() const { return command_count_; }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        command_count_++;
+        *out_xml = NULL;
+        *status = STATUS_SUCCESS;
+
+        switch (opcode)
+        {
+        case SCALE_READ_WEIGHT:
+        {
+            int scale_status = SCALE_STATUS_NON_STABLE_WEIGHT;
+            double weight = CurrentWeight(&scale_status);
+            char weight_text[32];
+            snprintf(weight_text, sizeof(weight_text), "%.3f", weight);
+
+            std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><scannerID>1</scannerID><arg-xml>";
+            xml.append("<modelnumber>MOCK-SCALE</modelnumber><serialnumber>0001</serialnumber><GUID>0</GUID>");
+            xml.append("<weight>").append(weight_text).append("</weight>");
+            xml.append("<weight_mode>English</weight_mode>");
+            xml.append("<status>").append(std::to_string(scale_status)).append("</status>");
+            xml.append("<rawdata>0</rawdata></arg-xml></outArgs>");
+            std::wstring out_str(xml.begin(), xml.end());
+            *out_xml = SysAllocString(out_str.c_str());
+            break;
+        }
+        case SCALE_ZERO_SCALE:
+        {
+            int scale_status = 0;
+            zero_offset_ += CurrentWeight(&scale_status);
+            break;
+        }
+        case SCALE_SYSTEM_RESET:
+            zero_offset_ = 0;
+            break;
+        default:
+            *status = 1;    // Not supported by the mock
+            break;
+        }
+        return S_OK;
+    }
+
+private:
+    struct WeightChange
+    {
+        int at_ms;
+        double weight;
+    };
+
+    double CurrentWeight(int* scale_status) const
+    {
+        long elapsed_ms = (long)std::chrono::duration_cast<std::chrono::milliseconds>(now_ - start_).count();
+        double previous = 0;
+        double target = 0;
+        long changed_at = -settle_ms_;
+        for (size_t i = 0; i < timeline_.size() && timeline_[i].at_ms <= elapsed_ms; i++)
+        {
+            previous = target;
+            target = timeline_[i].weight;
+            changed_at = timeline_[i].at_ms;
+        }
+
+        double weight = target;
+        long since_change = elapsed_ms - changed_at;
+        if (since_change < settle_ms_)
+        {
+            // Decaying oscillation around the new weight
+            double remaining = 1.0 - (double)since_change / settle_ms_;
+            weight = target + (target - previous) * 0.3 * remaining * std::cos(since_change / 15.0);
+        }
+
+        weight -= zero_offset_;
+        if (since_change < settle_ms_)
+        {
+            *scale_status = SCALE_STATUS_NON_STABLE_WEIGHT;
+        }
+        else if (weight < -0.0005)
+        {
+            *scale_status = SCALE_STATUS_STABLE_UNDER_ZERO;
+        }
+        else if (std::fabs(weight) < 0.0005)
+        {
+            *scale_status = SCALE_STATUS_STABLE_ZERO_WEIGHT;
+        }
+        else
+        {
+            *scale_status = SCALE_STATUS_STABLE_NON_ZERO_WEIGHT;
+        }
+        return weight;
+    }
+
+    Clock::time_point start_;
+    Clock::time_point now_;
+    int settle_ms_;
+    double zero_offset_;
+    long command_count_;
+    std::vector<WeightChange> timeline_;
+};
@@ -0,0 +1,285 @@
+/*******************************************************************************************
+* @file scale_reader.h
+* @brief Adaptive SCALE_READ_WEIGHT poller with stable weight detection
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+#include "opcode_traits.h"
+
+//---- Scale status values reported by SCALE_READ_WEIGHT ------//
+#define SCALE_STATUS_NOT_ENABLED             0
+#define SCALE_STATUS_NOT_READY               1
+#define SCALE_STATUS_STABLE_OVER_LIMIT       2
+#define SCALE_STATUS_STABLE_UNDER_ZERO       3
+#define SCALE_STATUS_NON_STABLE_WEIGHT       4
+#define SCALE_STATUS_STABLE_ZERO_WEIGHT      5
+#define SCALE_STATUS_STABLE_NON_ZERO_WEIGHT  6
+
+/**
+* Weight published to subscribers
+**/
+struct WeightReading
+{
+    double weight;
+    std::string weight_mode;    // English/Metric
+    int scale_status;           // SCALE_STATUS_xxx
+    bool stable;                // Weight settled within tolerance over the filter window
+};
+
+/**
+* Scale reader settings
+**/
+struct ScaleReaderSettings
+{
+    int fast_interval_ms;       // Poll interval while weight is changing
+    int slow_interval_ms;       // Poll interval ceiling while weight is stable
+    int stable_samples;         // Filter window (readings within tolerance to call a weight stable)
+    double tolerance;           // Maximum spread of a stable window, in scale units
+
+    ScaleReaderSettings()
+        : fast_interval_ms(50), slow_interval_ms(1000), stable_samples(4), tolerance(0.005)
+    {
+    }
+};
+
+/**
+* Polls a scanner scale with SCALE_READ_WEIGHT at an adaptive rate and publishes weight changes.
+*
+* The reader is driven by Poll() from the thread that owns the CoreScanner interface (the
+* snippet message loop), so it never calls COM from a foreign apartment. Each Poll() issues at
+* most one driver round trip and only when the next read is due: the interval is
+* fast_interval_ms while readings move and doubles up to slow_interval_ms while they hold still.
+* Subscribers are only notified when the stable weight or the scale status changes.
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommand signature (e.g. MockScale)
+**/
+template <typename Scanner>
+class ScaleReader
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<void(const WeightReading&)> Subscriber;
+
+    static const int kMaxStableSamples = 16;
+
+    /**
+    * Scale reader constructor
+    * @param scanner - CoreScanner interface
+    * @param scanner_id - Scanner id of the scanner/scale
+    * @param settings - Poll and filter settings
+    */
+    ScaleReader(Scanner* scanner, int scanner_id, const ScaleReaderSettings& settings = ScaleReaderSettings())
+        : scanner_(scanner), scanner_id_(scanner_id), settings_(settings),
+          interval_ms_(settings.fast_interval_ms), next_read_(), sample_count_(0), sample_index_(0),
+          has_published_(false), read_count_(0), publish_count_(0), error_count_(0)
+    {
+        if (settings_.stable_samples < 1) settings_.stable_samples = 1;
+        if (settings_.stable_samples > kMaxStableSamples) settings_.stable_samples = kMaxStableSamples;
+    }
+
+    /**
+    * Add a weight change subscriber
+    * return value : Subscription id, used with Unsubscribe()
+    */
+    int Subscribe(const Subscriber& subscriber)
+    {
+        subscribers_.push_back(subscriber);
+        return (int)subscribers_.size() - 1;
+    }
+
+    /**
+    * Remove a weight change subscriber
+    */
+    void Unsubscribe(int subscription_id)
+    {
+        if (subscription_id >= 0 && subscription_id < (int)subscribers_.size())
+        {
+            subscribers_[subscription_id] = Subscriber();
+        }
+    }
+
+    /**
+    * Read the scale if a read is due
+    * @param now - Current time
+    * return value : true if a SCALE_READ_WEIGHT command was sent
+    */
+    bool Poll(Clock::time_point now)
+    {
+        if (now < next_read_)
+        {
+            return false;
+        }
+
+        CommandResult<WeightResponse> result = Exec<SCALE_READ_WEIGHT>(scanner_, scanner_id_);
+        read_count_++;
+        if (!result.Succeeded() || !result.parsed)
+        {
+            // Back off on errors the same way as on a stable weight
+            error_count_++;
+            Reschedule(now, true);
+            return true;
+        }
+
+        AddSample(result.response.weight);
+        bool settled = IsSettled() &&
+            (result.response.scale_status == SCALE_STATUS_STABLE_ZERO_WEIGHT ||
+             result.response.scale_status == SCALE_STATUS_STABLE_NON_ZERO_WEIGHT);
+
+        WeightReading reading;
+        reading.weight = result.response.weight;
+        reading.weight_mode = result.response.weight_mode;
+        reading.scale_status = result.response.scale_status;
+        reading.stable = settled;
+
+        bool changed = !has_published_ ||
+            reading.scale_status != last_published_.scale_status ||
+            reading.stable != last_published_.stable ||
+            (settled && std::fabs(reading.weight - last_published_.weight) > settings_.tolerance);
+        if (changed)
+        {
+            Publish(reading);
+        }
+
+        Reschedule(now, settled);
+        return true;
+    }
+
+    /**
+    * Time until next read is due
+    * @param now - Current time
+    * return value : Milliseconds until next Poll() sends a command (0 if due)
+    */
+    int MillisecondsUntilNextRead(Clock::time_point now) const
+    {
+        if (now >= next_read_)
+        {
+            return 0;
+        }
+        return (int)std::chrono::duration_cast<std::chrono::milliseconds>(next_read_ - now).count();
+    }
+
+    /**
+    * Zero the scale (SCALE_ZERO_SCALE) and resume fast polling
+    * return value : Command success/fail status
+    */
+    bool ZeroScale()
+    {
+        bool success = Exec<SCALE_ZERO_SCALE>(scanner_, scanner_id_).Succeeded();
+        ResetFilter();
+        return success;
+    }
+
+    /**
+    * Reset the scale (SCALE_SYSTEM_RESET) and resume fast polling
+    * return value : Command success/fail status
+    */
+    bool ResetScale()
+    {
+        bool success = Exec<SCALE_SYSTEM_RESET>(scanner_, scanner_id_).Succeeded();
+        ResetFilter();
+        has_published_ = false;
+        return success;
+    }
+
+    /**
+    * Number of SCALE_READ_WEIGHT round trips sent
+    */
+    long ReadCount() const { return read_count_; }
+
+    /**
+    * Number of readings published to subscribers
+    */
+    long PublishCount() const { return publish_count_; }
+
+    /**
+    * Number of failed SCALE_READ_WEIGHT commands
+    */
+    long ErrorCount() const { return error_count_; }
+
+private:
+    void AddSample(double weight)
+    {
+        samples_[sample_index_] = weight;
+        sample_index_ = (sample_index_ + 1) % settings_.stable_samples;
+        if (sample_count_ < settings_.stable_samples)
+        {
+            sample_count_++;
+        }
+    }
+
+    bool IsSettled() const
+    {
+        if (sample_count_ < settings_.stable_samples)
+        {
+            return false;
+        }
+        double minimum = samples_[0];
+        double maximum = samples_[0];
+        for (int i = 1; i < sample_count_; i++)
+        {
+            if (samples_[i] < minimum) minimum = samples_[i];
+            if (samples_[i] > maximum) maximum = samples_[i];
+        }
+        return (maximum - minimum) <= settings_.tolerance;
+    }
+
+    void ResetFilter()
+    {
+        sample_count_ = 0;
+        sample_index_ = 0;
+        interval_ms_ = settings_.fast_interval_ms;
+        next_read_ = Clock::time_point();
+    }
+
+    void Reschedule(Clock::time_point now, bool settled)
+    {
+        if (settled)
+        {
+            interval_ms_ = interval_ms_ * 2 > settings_.slow_interval_ms ? settings_.slow_interval_ms : interval_ms_ * 2;
+        }
+        else
+        {
+            interval_ms_ = settings_.fast_interval_ms;
+        }
+        next_read_ = now + std::chrono::milliseconds(interval_ms_);
+    }
+
+    void Publish(const WeightReading& reading)
+    {
+        last_published_ = reading;
+        has_published_ = true;
+        publish_count_++;
+        for (size_t i = 0; i < subscribers_.size(); i++)
+        {
+            if (subscribers_[i])
+            {
+                subscribers_[i](reading);
+            }
+        }
+    }
+
+    Scanner* scanner_;
+    int scanner_id_;
+    ScaleReaderSettings settings_;
+    int interval_ms_;
+    Clock::time_point next_read_;
+
+    double samples_[kMaxStableSamples];     // Ring buffer of last readings
+    int sample_count_;
+    int sample_index_;
+
+    WeightReading last_published_;
+    bool has_published_;
+    std::vector<Subscriber> subscribers_;
+
+    long read_count_;
+    long publish_count_;
+    long error_count_;
+};
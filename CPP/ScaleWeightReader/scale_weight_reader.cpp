@@ -0,0 +1,342 @@
+/*******************************************************************************************
+* @file scale_weight_reader.cpp
+* @brief This file contains code snippet to stream scale weight with adaptive SCALE_READ_WEIGHT polling
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "scale_reader.h"
+#include "mock_scale.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+SHORT num_scanners = 0;
+SAFEARRAY* get_scanners_array = NULL;
+SHORT* scanner_id_array;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Get connected scanners
+* return value : GetScanners success/fail status
+*/
+bool GetScanners()
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    HRESULT hr = S_FALSE;
+    LONG status = -1;
+    BSTR out_xml;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    // Get connected scanners
+    hr = scanner_interface->GetScanners(
+        &num_scanners,         // Returns number of scanners discovered 
+        get_scanners_array,    // Returns array of connected scanner ids 
+        &out_xml,              // Output xml containing discovered scanners information 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        cout << "CoreScanner GetScanners()- Success" << endl;
+        cout << " Total Scanners : " << num_scanners << endl;
+        string scanner_id_list = "";
+        HRESULT hr = SafeArrayAccessData(get_scanners_array, (void**)&scanner_id_array);
+        for (int n = 0; n < num_scanners; n++)
+        {
+            scanner_id_list = " " + to_string(scanner_id_array[n]);
+            if (n != num_scanners - 1)
+            {
+                scanner_id_list += ",";
+            }
+        }
+        cout << " Scanner IDs :" << scanner_id_list << endl;
+        wstring out_str(out_xml, SysStringLen(out_xml));
+        string  get_scanners_output_xml(out_str.begin(), out_str.end());
+        cout << " Out xml : " << endl;
+        cout << get_scanners_output_xml << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner GetScanner() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Print a published weight reading
+*/
+void PrintReading(const WeightReading& reading)
+{
+    cout << " Weight : " << reading.weight << " " << reading.weight_mode
+         << " Status : " << reading.scale_status << (reading.stable ? " (stable)" : "") << endl;
+}
+
+/*
+* Stream weight from a simulated scale and compare driver round trips with fixed rate polling
+*/
+void RunMockScale()
+{
+    const int kSimulatedMs = 60000;
+    const int kStepMs = 10;
+
+    MockScale::Clock::time_point start = MockScale::Clock::now();
+    MockScale mock_scale(start);
+    mock_scale.ScheduleWeight(5000, 1.250);     // Item placed
+    mock_scale.ScheduleWeight(15000, 0);        // Item removed
+    mock_scale.ScheduleWeight(25000, 0.480);
+    mock_scale.ScheduleWeight(26000, 0.960);    // Second item added while first is settling
+    mock_scale.ScheduleWeight(40000, 0);
+
+    ScaleReaderSettings settings;
+    ScaleReader<MockScale> reader(&mock_scale, 1, settings);
+    reader.Subscribe(PrintReading);
+
+    // Simulated time - no sleeping, the mock follows the reader clock
+    for (int elapsed_ms = 0; elapsed_ms <= kSimulatedMs; elapsed_ms += kStepMs)
+    {
+        MockScale::Clock::time_point now = start + chrono::milliseconds(elapsed_ms);
+        mock_scale.SetTime(now);
+        reader.Poll(now);
+    }
+
+    long fixed_rate_reads = kSimulatedMs / settings.fast_interval_ms;
+    cout << "Mock scale " << kSimulatedMs / 1000 << " s : " << reader.ReadCount() << " SCALE_READ_WEIGHT round trips, "
+         << reader.PublishCount() << " readings published" << endl;
+    cout << " Fixed " << settings.fast_interval_ms << " ms polling : " << fixed_rate_reads << " round trips ("
+         << (double)fixed_rate_reads / reader.ReadCount() << "x more)" << endl;
+}
+
+/*
+* Stream weight from a scanner scale until a key is pressed
+* @param scanner_id Scanner id of the scanner/scale
+*/
+void ReadScale(int scanner_id)
+{
+    ScaleReader<ICoreScanner> reader(scanner_interface, scanner_id);
+    reader.Subscribe(PrintReading);
+
+    if (reader.ZeroScale())
+    {
+        cout << "CoreScanner ZeroScale() scanner ID:[" << scanner_id << "] - Success" << endl;
+    }
+    else
+    {
+        cout << "CoreScanner ZeroScale() scanner ID:[" << scanner_id << "] - Failed" << endl;
+    }
+
+    cout << "Place items on the scale, press any key to stop." << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while polling the scale
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+
+        ScaleReader<ICoreScanner>::Clock::time_point now = ScaleReader<ICoreScanner>::Clock::now();
+        reader.Poll(now);
+        int wait_ms = reader.MillisecondsUntilNextRead(now);
+        Sleep(wait_ms < 10 ? wait_ms : 10);
+    }
+    getchar();
+
+    cout << "Scale reads : " << reader.ReadCount() << ", published : " << reader.PublishCount()
+         << ", errors : " << reader.ErrorCount() << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    // Adaptive polling against the simulated scale
+    cout << "Streaming weight from mock scale" << endl;
+    RunMockScale();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (Open())
+    {
+        if (GetScanners())
+        {
+            if (num_scanners > 0)
+            {
+                // Select first scanner found
+                int scanner_id = scanner_id_array[0];
+                ReadScale(scanner_id);
+            }
+            else
+            {
+                cout << "No scanners found." << endl;
+            }
+        }
+
+        if (get_scanners_array != NULL)
+        {
+            SafeArrayUnaccessData(get_scanners_array);
+            SafeArrayDestroy(get_scanners_array);
+        }
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,339 @@
+/*******************************************************************************************
+* @file xml_reader.cpp
+* @brief Definition of lightweight pull parser for CoreScanner xml
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "xml_reader.h"
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+/**
+* Returns true for xml whitespace characters
+**/
+static bool IsXmlSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool XmlSlice::Equals(const char* text) const
+{
+    size_t text_length = strlen(text);
+    return text_length == length && memcmp(data, text, length) == 0;
+}
+
+string XmlSlice::ToString() const
+{
+    string value;
+    value.reserve(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        if (data[i] != '&')
+        {
+            value.push_back(data[i]);
+            continue;
+        }
+
+        const char* entity_end = (const char*)memchr(data + i, ';', length - i);
+        if (entity_end == NULL)
+        {
+            value.push_back(data[i]);
+            continue;
+        }
+
+        XmlSlice entity = { data + i + 1, (size_t)(entity_end - data - i - 1) };
+        if (entity.Equals("lt"))        value.push_back('<');
+        else if (entity.Equals("gt"))   value.push_back('>');
+        else if (entity.Equals("amp"))  value.push_back('&');
+        else if (entity.Equals("quot")) value.push_back('"');
+        else if (entity.Equals("apos")) value.push_back('\'');
+        else if (entity.length > 1 && entity.data[0] == '#')
+        {
+            bool hex = entity.data[1] == 'x';
+            value.push_back((char)strtol(string(entity.data + (hex ? 2 : 1), entity.data + entity.length).c_str(), NULL, hex ? 16 : 10));
+        }
+        else
+        {
+            value.append(data + i, entity.length + 2);
+        }
+        i += entity.length + 1;
+    }
+    return value;
+}
+
+long XmlSlice::ToLong() const
+{
+    size_t i = 0;
+    while (i < length && IsXmlSpace(data[i])) i++;
+
+    bool negative = false;
+    if (i < length && (data[i] == '-' || data[i] == '+'))
+    {
+        negative = data[i] == '-';
+        i++;
+    }
+
+    long value = 0;
+    if (i + 1 < length && data[i] == '0' && (data[i + 1] == 'x' || data[i + 1] == 'X'))
+    {
+        for (i += 2; i < length; i++)
+        {
+            char c = data[i];
+            int digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (digit < 0) break;
+            value = value * 16 + digit;
+        }
+    }
+    else
+    {
+        for (; i < length && data[i] >= '0' && data[i] <= '9'; i++)
+        {
+            value = value * 10 + (data[i] - '0');
+        }
+    }
+    return negative ? -value : value;
+}
+
+double XmlSlice::ToDouble() const
+{
+    char buffer[64];
+    size_t count = length < sizeof(buffer) - 1 ? length : sizeof(buffer) - 1;
+    memcpy(buffer, data, count);
+    buffer[count] = '\0';
+    return strtod(buffer, NULL);
+}
+
+bool XmlSlice::ToBool() const
+{
+    return Equals("TRUE") || Equals("true") || Equals("1");
+}
+
+XmlReader::XmlReader(const char* data, size_t length)
+    : cursor_(data), end_(data + length), depth_(0), pending_end_(false)
+{
+    name_.data = text_.data = attributes_.data = data;
+    name_.length = text_.length = attributes_.length = 0;
+}
+
+XmlReader::XmlReader(const string& xml)
+    : XmlReader(xml.data(), xml.size())
+{
+}
+
+XmlReader::Token XmlReader::Next()
+{
+    if (pending_end_)
+    {
+        pending_end_ = false;
+        depth_--;
+        return kEndElement;
+    }
+
+    while (cursor_ < end_)
+    {
+        if (*cursor_ != '<')
+        {
+            // Text node - report only if it is not whitespace between elements
+            const char* start = cursor_;
+            const char* next_tag = (const char*)memchr(cursor_, '<', end_ - cursor_);
+            cursor_ = next_tag ? next_tag : end_;
+
+            const char* first = start;
+            const char* last = cursor_;
+            while (first < last && IsXmlSpace(*first)) first++;
+            while (last > first && IsXmlSpace(*(last - 1))) last--;
+            if (first == last)
+            {
+                continue;
+            }
+            text_.data = first;
+            text_.length = last - first;
+            return kText;
+        }
+
+        if (cursor_ + 1 < end_ && (cursor_[1] == '?' || cursor_[1] == '!'))
+        {
+            // Declaration, comment or doctype - skip it
+            const char* terminator = ">";
+            size_t terminator_length = 1;
+            if (end_ - cursor_ >= 4 && memcmp(cursor_, "<!--", 4) == 0)
+            {
+                terminator = "-->";
+                terminator_length = 3;
+            }
+            const char* p = cursor_ + 2;
+            while (p + terminator_length <= end_ && memcmp(p, terminator, terminator_length) != 0) p++;
+            cursor_ = p + terminator_length <= end_ ? p + terminator_length : end_;
+            continue;
+        }
+
+        bool is_end_tag = cursor_ + 1 < end_ && cursor_[1] == '/';
+        const char* name_start = cursor_ + (is_end_tag ? 2 : 1);
+        const char* p = name_start;
+        while (p < end_ && !IsXmlSpace(*p) && *p != '>' && *p != '/') p++;
+        name_.data = name_start;
+        name_.length = p - name_start;
+
+        const char* tag_end = (const char*)memchr(p, '>', end_ - p);
+        if (tag_end == NULL)
+        {
+            cursor_ = end_;
+            break;
+        }
+        cursor_ = tag_end + 1;
+        attributes_.data = p;
+        attributes_.length = tag_end - p;
+
+        if (is_end_tag)
+        {
+            depth_--;
+            return kEndElement;
+        }
+
+        depth_++;
+        pending_end_ = *(tag_end - 1) == '/';
+        return kStartElement;
+    }
+    return kEndOfDocument;
+}
+
+bool XmlReader::Attribute(const char* name, XmlSlice* value) const
+{
+    size_t name_length = strlen(name);
+    const char* p = attributes_.data;
+    const char* end = attributes_.data + attributes_.length;
+    while (p < end)
+    {
+        while (p < end && (IsXmlSpace(*p) || *p == '/')) p++;
+        const char* attribute_name = p;
+        while (p < end && *p != '=' && !IsXmlSpace(*p)) p++;
+        size_t attribute_name_length = p - attribute_name;
+        while (p < end && (IsXmlSpace(*p) || *p == '=')) p++;
+        if (p >= end || (*p != '"' && *p != '\''))
+        {
+            return false;
+        }
+
+        char quote = *p++;
+        const char* value_start = p;
+        while (p < end && *p != quote) p++;
+        if (attribute_name_length == name_length && memcmp(attribute_name, name, name_length) == 0)
+        {
+            value->data = value_start;
+            value->length = p - value_start;
+            return true;
+        }
+        p++;
+    }
+    return false;
+}
+
+bool XmlReader::FindElement(const char* name)
+{
+    Token token;
+    while ((token = Next()) != kEndOfDocument)
+    {
+        if (token == kStartElement && name_.Equals(name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool XmlReader::FindChild(const char* name, int parent_depth)
+{
+    Token token;
+    while ((token = Next()) != kEndOfDocument)
+    {
+        if (token == kEndElement && depth_ < parent_depth)
+        {
+            return false;
+        }
+        if (token == kStartElement && name_.Equals(name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool XmlReader::ReadElementText(XmlSlice* text)
+{
+    text->data = cursor_;
+    text->length = 0;
+
+    Token token = Next();
+    if (token == kEndElement)
+    {
+        return true;
+    }
+    if (token != kText)
+    {
+        if (token == kStartElement)
+        {
+            SkipElement();
+            SkipElement();
+        }
+        return false;
+    }
+
+    *text = text_;
+    token = Next();
+    if (token == kEndElement)
+    {
+        return true;
+    }
+    if (token == kStartElement)
+    {
+        SkipElement();
+        SkipElement();
+    }
+    return false;
+}
+
+void XmlReader::SkipElement()
+{
+    int start_depth = depth_;
+    Token token;
+    while ((token = Next()) != kEndOfDocument)
+    {
+        if (token == kEndElement && depth_ < start_depth)
+        {
+            return;
+        }
+    }
+}
+
+bool XmlFindText(const string& xml, const char* name, string* value)
+{
+    XmlReader reader(xml);
+    XmlSlice text;
+    if (reader.FindElement(name))
+    {
+        reader.ReadElementText(&text);
+        *value = text.ToString();
+        return true;
+    }
+    return false;
+}
+
+void XmlAppendEscaped(string* xml, const string& text)
+{
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        switch (text[i])
+        {
+        case '<':  xml->append("&lt;");   break;
+        case '>':  xml->append("&gt;");   break;
+        case '&':  xml->append("&amp;");  break;
+        case '"':  xml->append("&quot;"); break;
+        case '\'': xml->append("&apos;"); break;
+        default:   xml->push_back(text[i]); break;
+        }
+    }
+}
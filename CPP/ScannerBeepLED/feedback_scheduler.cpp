@@ -0,0 +1,230 @@
+/*******************************************************************************************
+* @file feedback_scheduler.cpp
+* @brief Definition of asynchronous beeper/LED (SET_ACTION) scheduler
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "feedback_scheduler.h"
+#include "common_defs.h"
+
+using namespace std;
+
+/**
+* LED number (1 - green, 2 - yellow, 3 - red) of an LED action code, 0 for beeps
+**/
+static int LedOf(int action_code)
+{
+    switch (action_code)
+    {
+    case LED1ON: case LED1OFF: return 1;
+    case LED2ON: case LED2OFF: return 2;
+    case LED3ON: case LED3OFF: return 3;
+    default: return 0;
+    }
+}
+
+FeedbackScheduler::FeedbackScheduler(const FeedbackSchedulerSettings& settings)
+    : settings_(settings), pending_count_(0), sending_(false), stopping_(false),
+      queued_count_(0), collapsed_count_(0), sent_count_(0), failed_count_(0)
+{
+    if (settings_.max_pending_per_scanner == 0)
+    {
+        settings_.max_pending_per_scanner = 1;
+    }
+    thread_ = thread(&FeedbackScheduler::Run, this);
+}
+
+FeedbackScheduler::~FeedbackScheduler()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+}
+
+void FeedbackScheduler::Queue(int scanner_id, int action_code)
+{
+    lock_guard<mutex> lock(mutex_);
+    Enqueue(scanner_id, action_code, Clock::now());
+}
+
+void FeedbackScheduler::QueuePattern(int scanner_id, const vector<FeedbackStep>& steps)
+{
+    lock_guard<mutex> lock(mutex_);
+    Clock::time_point due = Clock::now();
+    for (size_t i = 0; i < steps.size(); i++)
+    {
+        Enqueue(scanner_id, steps[i].action_code, due);
+        due += chrono::milliseconds(steps[i].delay_ms);
+    }
+}
+
+void FeedbackScheduler::Flush()
+{
+    unique_lock<mutex> lock(mutex_);
+    while (pending_count_ != 0 || sending_)
+    {
+        idle_.wait(lock);
+    }
+}
+
+long FeedbackScheduler::QueuedCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return queued_count_;
+}
+
+long FeedbackScheduler::CollapsedCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return collapsed_count_;
+}
+
+long FeedbackScheduler::SentCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return sent_count_;
+}
+
+long FeedbackScheduler::FailedCount() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return failed_count_;
+}
+
+/**
+* Insert an action in the scanner queue, merging it with redundant pending actions.
+* Called with mutex_ held.
+**/
+void FeedbackScheduler::Enqueue(int scanner_id, int action_code, Clock::time_point due)
+{
+    queued_count_++;
+    deque<PendingAction>& queue = pending_[scanner_id];
+    chrono::milliseconds window(settings_.collapse_window_ms);
+    int led = LedOf(action_code);
+
+    for (size_t i = queue.size(); i-- > 0;)
+    {
+        if (queue[i].due + window < due)
+        {
+            break;  // Queue is ordered by due time, nothing older can be merged
+        }
+        if (queue[i].due > due + window)
+        {
+            continue;
+        }
+        if (queue[i].action_code == action_code)
+        {
+            // Same beep/LED state already pending
+            collapsed_count_++;
+            return;
+        }
+        if (led != 0 && LedOf(queue[i].action_code) == led)
+        {
+            // Same LED switched again within the window (e.g. on then off) - only the last state is observable
+            queue.erase(queue.begin() + i);
+            pending_count_--;
+            collapsed_count_++;
+        }
+    }
+
+    PendingAction action = { action_code, due };
+    deque<PendingAction>::iterator position = queue.end();
+    while (position != queue.begin() && (position - 1)->due > due)
+    {
+        --position;
+    }
+    queue.insert(position, action);
+    pending_count_++;
+
+    if (queue.size() > settings_.max_pending_per_scanner)
+    {
+        // Drop the oldest beep first, LED actions keep the LED state consistent
+        deque<PendingAction>::iterator victim = queue.begin();
+        for (deque<PendingAction>::iterator it = queue.begin(); it != queue.end(); ++it)
+        {
+            if (LedOf(it->action_code) == 0)
+            {
+                victim = it;
+                break;
+            }
+        }
+        queue.erase(victim);
+        pending_count_--;
+        collapsed_count_++;
+    }
+    wake_.notify_one();
+}
+
+/**
+* Scheduler thread - sends the earliest due action across all scanners
+**/
+void FeedbackScheduler::Run()
+{
+    if (settings_.on_thread_start)
+    {
+        settings_.on_thread_start();
+    }
+
+    unique_lock<mutex> lock(mutex_);
+    while (true)
+    {
+        map<int, deque<PendingAction> >::iterator next = pending_.end();
+        for (map<int, deque<PendingAction> >::iterator it = pending_.begin(); it != pending_.end(); ++it)
+        {
+            if (!it->second.empty() && (next == pending_.end() || it->second.front().due < next->second.front().due))
+            {
+                next = it;
+            }
+        }
+
+        if (next == pending_.end())
+        {
+            idle_.notify_all();
+            if (stopping_)
+            {
+                break;
+            }
+            wake_.wait(lock);
+            continue;
+        }
+
+        // When stopping, remaining pattern steps are sent without their delays so no LED is left on
+        Clock::time_point due = next->second.front().due;
+        if (!stopping_ && due > Clock::now())
+        {
+            wake_.wait_until(lock, due);
+            continue;
+        }
+
+        int scanner_id = next->first;
+        int action_code = next->second.front().action_code;
+        next->second.pop_front();
+        pending_count_--;
+        sending_ = true;
+
+        lock.unlock();
+        bool success = settings_.send_action(scanner_id, action_code);
+        lock.lock();
+
+        sending_ = false;
+        if (success)
+        {
+            sent_count_++;
+        }
+        else
+        {
+            failed_count_++;
+        }
+    }
+    lock.unlock();
+
+    if (settings_.on_thread_stop)
+    {
+        settings_.on_thread_stop();
+    }
+}
@@ -0,0 +1,136 @@
+/*******************************************************************************************
+* @file feedback_scheduler.h
+* @brief Asynchronous, per scanner beeper/LED (SET_ACTION) scheduler
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+* One step of a feedback pattern: send action_code, then wait delay_ms before the next step
+**/
+struct FeedbackStep
+{
+    int action_code;
+    int delay_ms;
+};
+
+/**
+* Feedback scheduler settings
+**/
+struct FeedbackSchedulerSettings
+{
+    int collapse_window_ms;         // Redundant actions queued this close together are merged
+    size_t max_pending_per_scanner; // Oldest pending action is dropped beyond this
+
+    std::function<bool(int scanner_id, int action_code)> send_action;   // Sends SET_ACTION (runs on scheduler thread)
+    std::function<void()> on_thread_start;                              // e.g. join COM apartment, unmarshal interface
+    std::function<void()> on_thread_stop;
+
+    FeedbackSchedulerSettings()
+        : collapse_window_ms(50), max_pending_per_scanner(16)
+    {
+    }
+};
+
+/**
+* Queues SET_ACTION beeper/LED codes per scanner and sends them from a background thread.
+*
+* Queue()/QueuePattern() only take a short lock and never wait on the driver, so they are safe to
+* call from the decode path. Pattern delays are scheduled times rather than sleeps, so a long
+* pattern on one lane does not hold back cues for another lane. Redundant actions queued within
+* the collapse window are merged before they reach the driver:
+*  - the same beep or LED state queued twice is sent once
+*  - an LED switched again within the window (e.g. on then off) only sends its last state
+**/
+class FeedbackScheduler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+    * Feedback scheduler constructor - starts the scheduler thread
+    * @param settings - Scheduler settings, send_action is required
+    */
+    explicit FeedbackScheduler(const FeedbackSchedulerSettings& settings);
+
+    /**
+    * Feedback scheduler destructor - sends every queued action, remaining pattern steps without
+    * their delays so no LED is left on, and stops the scheduler thread
+    */
+    ~FeedbackScheduler();
+
+    /**
+    * Queue a beeper/LED action
+    * @param scanner_id - Scanner id of specific scanner to send command
+    * @param action_code - SetAction (beeper/led pattern) code
+    */
+    void Queue(int scanner_id, int action_code);
+
+    /**
+    * Queue a timed beeper/LED pattern
+    * @param scanner_id - Scanner id of specific scanner to send command
+    * @param steps - Actions and delays between them
+    */
+    void QueuePattern(int scanner_id, const std::vector<FeedbackStep>& steps);
+
+    /**
+    * Block until all queued actions have been sent (for shutdown and demos, not the decode path)
+    */
+    void Flush();
+
+    /**
+    * Number of actions accepted by Queue()/QueuePattern()
+    */
+    long QueuedCount() const;
+
+    /**
+    * Number of actions merged away or dropped before reaching the driver
+    */
+    long CollapsedCount() const;
+
+    /**
+    * Number of SET_ACTION commands sent
+    */
+    long SentCount() const;
+
+    /**
+    * Number of SET_ACTION commands that failed
+    */
+    long FailedCount() const;
+
+private:
+    struct PendingAction
+    {
+        int action_code;
+        Clock::time_point due;
+    };
+
+    void Enqueue(int scanner_id, int action_code, Clock::time_point due);
+    void Run();
+
+    FeedbackSchedulerSettings settings_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::map<int, std::deque<PendingAction> > pending_;     // Per scanner, ordered by due time
+    size_t pending_count_;
+    bool sending_;
+    bool stopping_;
+
+    long queued_count_;
+    long collapsed_count_;
+    long sent_count_;
+    long failed_count_;
+
+    std::thread thread_;
+};
@@ -9,11 +9,14 @@
 #include "afxctl.h"
 #include <iostream>
 #include <string>
+#include <vector>
+#include <chrono>
 #include <conio.h>
 #include "targetver.h"
 #include "_core_scanner_i.c"
 #include "_core_scanner.h"
 #include "common_defs.h"
+#include "feedback_scheduler.h"
 
 using namespace std;
 
@@ -25,6 +28,9 @@ SHORT num_scanners = 0;
 SAFEARRAY* get_scanners_array = NULL;
 SHORT* scanner_id_array;
 
+IStream* feedback_scanner_stream = NULL;        // CoreScanner interface marshaled to the feedback scheduler thread
+ICoreScanner* feedback_scanner_interface = NULL; // CoreScanner interface used on the feedback scheduler thread
+
 /*
 * Initialize COM - Create the CoreScanner COM object
 */
@@ -198,11 +204,12 @@ bool Close()
 
 /*
 * Trigger scanner SetAction (beep/led) using CoreScanner
+* @param scanner CoreScanner interface of the calling thread
 * @param scanner_id Scanner id of specific scanner to send command
 * @param action_code SetAction (beeper/led pattern) code
 * return value : SetAction success/fail status
 */
-bool SetAction(int scanner_id, int action_code)
+bool SetAction(ICoreScanner* scanner, int scanner_id, int action_code)
 {
     LONG status = -1;
     HRESULT hr = S_FALSE;
@@ -222,7 +229,7 @@ bool SetAction(int scanner_id, int action_code)
     CComBSTR input = in_xml.c_str();
 
     // Send scanner action
-    hr = scanner_interface->ExecCommand(SET_ACTION,         // Opcode: for SET_ACTION (beep/Led)
+    hr = scanner->ExecCommand(SET_ACTION,                   // Opcode: for SET_ACTION (beep/Led)
         &input,                                             // Input xml
         &out_xml,                                           // Output xml 
         &status);                                           // Command execution success/failure return status   
@@ -239,6 +246,50 @@ bool SetAction(int scanner_id, int action_code)
     return true;
 }
 
+/*
+* Feedback scheduler thread start - join the multithreaded apartment and unmarshal the CoreScanner interface
+*/
+void OnFeedbackThreadStart()
+{
+    CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    if (feedback_scanner_stream == NULL)
+    {
+        return;     // Marshaling failed, every action is counted as failed
+    }
+    HRESULT hr = CoGetInterfaceAndReleaseStream(feedback_scanner_stream, IID_ICoreScanner, (void**)&feedback_scanner_interface);
+    feedback_scanner_stream = NULL;
+    if FAILED(hr)
+    {
+        cout << "CoreScanner interface unmarshaling for feedback thread - Failed" << endl;
+        feedback_scanner_interface = NULL;
+    }
+}
+
+/*
+* Feedback scheduler thread stop - release the thread's CoreScanner interface
+*/
+void OnFeedbackThreadStop()
+{
+    if (feedback_scanner_interface)
+    {
+        feedback_scanner_interface->Release();
+        feedback_scanner_interface = NULL;
+    }
+    CoUninitialize();
+}
+
+/*
+* Send a scheduled SetAction from the feedback scheduler thread
+*/
+bool SendFeedbackAction(int scanner_id, int action_code)
+{
+    if (feedback_scanner_interface == NULL)
+    {
+        return false;
+    }
+    return SetAction(feedback_scanner_interface, scanner_id, action_code);
+}
+
 /*
 * Wait display message and wait for user input
 */
@@ -276,21 +327,69 @@ int main()
                 // Select first scanner found
                 int scanner_id = scanner_id_array[0];
 
-                // Beep scanner (one short high) using setAction
+                // Marshal the CoreScanner interface to the feedback scheduler thread
+                HRESULT hr = CoMarshalInterThreadInterfaceInStream(IID_ICoreScanner, scanner_interface, &feedback_scanner_stream);
+                if FAILED(hr)
+                {
+                    cout << "CoreScanner interface marshaling for feedback thread - Failed" << endl;
+                    feedback_scanner_stream = NULL;
+                }
+
+                FeedbackSchedulerSettings settings;
+                settings.send_action = SendFeedbackAction;
+                settings.on_thread_start = OnFeedbackThreadStart;
+                settings.on_thread_stop = OnFeedbackThreadStop;
+                FeedbackScheduler feedback(settings);
+
+                // Beep scanner (one short high) using setAction, without waiting for the command
                 cout << "Beep scanner (one short high) using setAction" << endl;
-                SetAction(scanner_id, ONESHORTHIGH);
+                feedback.Queue(scanner_id, ONESHORTHIGH);
+                cout << " " << endl;
+
+                // A burst of good-read cues, as queued by a decode handler. Redundant cues are merged
+                // and queueing never waits on the driver.
+                const int kBurstCount = 20;
+                chrono::steady_clock::time_point burst_start = chrono::steady_clock::now();
+                for (int i = 0; i < kBurstCount; i++)
+                {
+                    feedback.Queue(scanner_id, LED1ON);
+                    feedback.Queue(scanner_id, ONESHORTHIGH);
+                    feedback.Queue(scanner_id, LED1OFF);
+                }
+                chrono::steady_clock::duration burst_time = chrono::steady_clock::now() - burst_start;
+                cout << "Queued " << kBurstCount * 3 << " good-read actions in "
+                     << chrono::duration_cast<chrono::microseconds>(burst_time).count() << " us" << endl;
+                feedback.Flush();
+                cout << " " << endl;
+
+                // Timed pattern (green LED blinks three times) runs on the scheduler thread
+                cout << "Blink scanner LED1 (Green) three times using a feedback pattern" << endl;
+                vector<FeedbackStep> blink;
+                for (int i = 0; i < 3; i++)
+                {
+                    FeedbackStep on = { LED1ON, 200 };
+                    FeedbackStep off = { LED1OFF, 200 };
+                    blink.push_back(on);
+                    blink.push_back(off);
+                }
+                feedback.QueuePattern(scanner_id, blink);
+                feedback.Flush();
                 cout << " " << endl;
 
                 // Trigger scanner LED3 (Red) on using setAction
                 cout << "Trigger scanner LED3 (Red) on using setAction" << endl;
-                SetAction(scanner_id, LED3ON);
+                feedback.Queue(scanner_id, LED3ON);
 
                 WaitForInput("LED3 (red) switched on, press any key to continue");
 
                 // Trigger scanner LED3 (Red) off using setAction
                 cout << "Trigger scanner LED3 (Red) off using setAction" << endl;
-                SetAction(scanner_id, LED3OFF);
+                feedback.Queue(scanner_id, LED3OFF);
+                feedback.Flush();
                 cout << "LED3 (red) switched off" << endl;
+
+                cout << "Feedback actions queued : " << feedback.QueuedCount() << ", merged : " << feedback.CollapsedCount()
+                     << ", sent : " << feedback.SentCount() << ", failed : " << feedback.FailedCount() << endl;
             }
             else
             {
@@ -0,0 +1,311 @@
+/*******************************************************************************************
+* @file claim_manager.cpp
+* @brief Definition of scanner claim manager
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "claim_manager.h"
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+ClaimManager::ClaimManager(const ClaimManagerSettings& settings)
+    : settings_(settings), slots_(MAX_NUM_DEVICES + 1), expired_count_(0), locked_retry_count_(0), stopping_(false)
+{
+    expiry_thread_ = thread(&ClaimManager::RunExpiryCheck, this);
+}
+
+ClaimManager::~ClaimManager()
+{
+    {
+        lock_guard<mutex> lock(expiry_mutex_);
+        stopping_ = true;
+    }
+    expiry_wake_.notify_all();
+    expiry_thread_.join();
+    for (int scanner_id = 1; scanner_id <= MAX_NUM_DEVICES; scanner_id++)
+    {
+        if (slots_[scanner_id].driver_claimed && settings_.release_device)
+        {
+            settings_.release_device(scanner_id);
+        }
+    }
+}
+
+ClaimStatus ClaimManager::Claim(int scanner_id, int client_id, int lease_ms, int timeout_ms)
+{
+    Slot* slot = SlotOf(scanner_id);
+    if (slot == NULL || client_id == kNoOwner)
+    {
+        return kClaimFailed;
+    }
+
+    Clock::time_point now = Clock::now();
+    Clock::time_point deadline = now + chrono::milliseconds(timeout_ms);
+    unique_lock<mutex> lock(slot->mutex);
+    Waiter waiter(client_id);
+
+    if (slot->owner == client_id && slot->driver_claimed && slot->lease_deadline >= Ticks(now))
+    {
+        // Claimed again by the owner - a renewal, not a wait behind itself
+        slot->lease_deadline = Ticks(now + chrono::milliseconds(lease_ms));
+        return kClaimGranted;
+    }
+    if (slot->queue.empty() && (slot->owner == kNoOwner || slot->lease_deadline < Ticks(now)))
+    {
+        if (slot->owner != kNoOwner)
+        {
+            expired_count_++;
+        }
+        slot->owner = client_id;
+    }
+    else
+    {
+        // Wait in line - woken by the hand off, or to take over from an owner whose lease ran out
+        slot->queue.push_back(&waiter);
+        while (!waiter.granted && !waiter.cancelled)
+        {
+            Clock::time_point lease_end = Clock::time_point(Clock::duration(slot->lease_deadline.load()));
+            waiter.wake.wait_until(lock, min(deadline, lease_end));
+            if (waiter.granted || waiter.cancelled)
+            {
+                break;
+            }
+
+            now = Clock::now();
+            if (slot->queue.front() == &waiter && slot->lease_deadline < Ticks(now))
+            {
+                expired_count_++;
+                slot->queue.pop_front();
+                slot->owner = client_id;
+                waiter.granted = true;
+                break;
+            }
+            if (now >= deadline)
+            {
+                slot->queue.erase(find(slot->queue.begin(), slot->queue.end(), &waiter));
+                return kClaimTimedOut;
+            }
+        }
+        if (waiter.cancelled)
+        {
+            return kClaimCancelled;
+        }
+
+        now = Clock::now();
+        if (waiter.released_at != Clock::time_point())
+        {
+            lock_guard<mutex> stats_lock(stats_mutex_);
+            handoff_latencies_us_.push_back(chrono::duration<double, micro>(now - waiter.released_at).count());
+        }
+    }
+
+    if (!slot->driver_claimed)
+    {
+        // Keep waiters from taking over while CLAIM_DEVICE backs off on another application
+        slot->lease_deadline = Ticks(deadline + chrono::milliseconds(lease_ms));
+        lock.unlock();
+        ClaimStatus status = ClaimDriver(scanner_id, deadline);
+        lock.lock();
+        if (status != kClaimGranted)
+        {
+            HandOff(slot, scanner_id);
+            return status;
+        }
+        slot->driver_claimed = true;
+        now = Clock::now();
+    }
+    slot->lease_deadline = Ticks(now + chrono::milliseconds(lease_ms));
+    return kClaimGranted;
+}
+
+bool ClaimManager::Renew(int scanner_id, int client_id, int lease_ms)
+{
+    Slot* slot = SlotOf(scanner_id);
+    if (slot == NULL)
+    {
+        return false;
+    }
+    lock_guard<mutex> lock(slot->mutex);
+    Clock::time_point now = Clock::now();
+    if (slot->owner != client_id)
+    {
+        return false;
+    }
+    if (slot->lease_deadline < Ticks(now))
+    {
+        // Too late - a waiting client takes over, otherwise the device is released
+        ReleaseIfExpired(slot, scanner_id, now);
+        return false;
+    }
+    slot->lease_deadline = Ticks(now + chrono::milliseconds(lease_ms));
+    return true;
+}
+
+bool ClaimManager::Release(int scanner_id, int client_id)
+{
+    Slot* slot = SlotOf(scanner_id);
+    if (slot == NULL)
+    {
+        return false;
+    }
+    lock_guard<mutex> lock(slot->mutex);
+    if (slot->owner != client_id)
+    {
+        return false;
+    }
+    HandOff(slot, scanner_id);
+    return true;
+}
+
+void ClaimManager::ReleaseClient(int client_id)
+{
+    for (int scanner_id = 1; scanner_id <= MAX_NUM_DEVICES; scanner_id++)
+    {
+        Slot* slot = &slots_[scanner_id];
+        lock_guard<mutex> lock(slot->mutex);
+        for (deque<Waiter*>::iterator it = slot->queue.begin(); it != slot->queue.end();)
+        {
+            if ((*it)->client_id == client_id)
+            {
+                (*it)->cancelled = true;
+                (*it)->wake.notify_one();
+                it = slot->queue.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        if (slot->owner == client_id)
+        {
+            HandOff(slot, scanner_id);
+        }
+    }
+}
+
+int ClaimManager::OwnerOf(int scanner_id) const
+{
+    if (scanner_id < 1 || scanner_id > MAX_NUM_DEVICES)
+    {
+        return kNoOwner;
+    }
+    const Slot& slot = slots_[scanner_id];
+    int owner = slot.owner.load();
+    if (owner == kNoOwner || slot.lease_deadline.load() < Ticks(Clock::now()))
+    {
+        return kNoOwner;
+    }
+    return owner;
+}
+
+vector<double> ClaimManager::HandoffLatencies() const
+{
+    lock_guard<mutex> lock(stats_mutex_);
+    return handoff_latencies_us_;
+}
+
+ClaimManager::Slot* ClaimManager::SlotOf(int scanner_id)
+{
+    if (scanner_id < 1 || scanner_id > MAX_NUM_DEVICES)
+    {
+        return NULL;
+    }
+    return &slots_[scanner_id];
+}
+
+/**
+* Send CLAIM_DEVICE, backing off while another application holds the device
+**/
+ClaimStatus ClaimManager::ClaimDriver(int scanner_id, Clock::time_point deadline)
+{
+    int delay_ms = settings_.locked_retry_initial_ms;
+    while (true)
+    {
+        long status = settings_.claim_device ? settings_.claim_device(scanner_id) : STATUS_SUCCESS;
+        if (status == STATUS_SUCCESS)
+        {
+            return kClaimGranted;
+        }
+        if (status != STATUS_LOCKED)
+        {
+            return kClaimFailed;
+        }
+        if (Clock::now() + chrono::milliseconds(delay_ms) > deadline)
+        {
+            return kClaimLocked;
+        }
+        locked_retry_count_++;
+        this_thread::sleep_for(chrono::milliseconds(delay_ms));
+        delay_ms = min(delay_ms * 2, settings_.locked_retry_max_ms);
+    }
+}
+
+/**
+* Pass ownership to the first waiting client, or release the device in the driver if nobody waits.
+* Called with slot mutex held.
+**/
+void ClaimManager::HandOff(Slot* slot, int scanner_id)
+{
+    if (!slot->queue.empty())
+    {
+        Waiter* next = slot->queue.front();
+        slot->queue.pop_front();
+        next->granted = true;
+        next->released_at = Clock::now();
+        slot->owner = next->client_id;
+        slot->lease_deadline = Ticks(Clock::time_point::max());    // Until the new owner sets its lease
+        next->wake.notify_one();
+        return;
+    }
+
+    slot->owner = kNoOwner;
+    if (slot->driver_claimed)
+    {
+        slot->driver_claimed = false;
+        if (settings_.release_device)
+        {
+            settings_.release_device(scanner_id);
+        }
+    }
+}
+
+/**
+* Release the device of an owner whose lease ran out while nobody waits for it - a waiting
+* client takes the scanner over by itself. Called with slot mutex held.
+* return value : true if the lease had run out
+**/
+bool ClaimManager::ReleaseIfExpired(Slot* slot, int scanner_id, Clock::time_point now)
+{
+    if (slot->owner == kNoOwner || slot->lease_deadline >= Ticks(now) || !slot->queue.empty())
+    {
+        return false;
+    }
+    expired_count_++;
+    HandOff(slot, scanner_id);
+    return true;
+}
+
+/**
+* Lease expiry thread - releases scanners of dead owners in the driver until the manager is destroyed
+**/
+void ClaimManager::RunExpiryCheck()
+{
+    unique_lock<mutex> expiry_lock(expiry_mutex_);
+    while (!expiry_wake_.wait_for(expiry_lock, chrono::milliseconds(settings_.expiry_check_ms), [this] { return stopping_; }))
+    {
+        for (int scanner_id = 1; scanner_id <= MAX_NUM_DEVICES; scanner_id++)
+        {
+            Slot* slot = &slots_[scanner_id];
+            if (slot->owner == kNoOwner || slot->lease_deadline >= Ticks(Clock::now()))
+            {
+                continue;
+            }
+            lock_guard<mutex> lock(slot->mutex);
+            ReleaseIfExpired(slot, scanner_id, Clock::now());
+        }
+    }
+}
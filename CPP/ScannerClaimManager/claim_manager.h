@@ -0,0 +1,181 @@
+/*******************************************************************************************
+* @file claim_manager.h
+* @brief Exclusive scanner ownership with leases and fair hand off on top of CLAIM_DEVICE/RELEASE_DEVICE
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common_defs.h"
+
+/**
+* Result of ClaimManager::Claim()
+**/
+enum ClaimStatus
+{
+    kClaimGranted,
+    kClaimTimedOut,     // Another client kept the scanner until the timeout
+    kClaimLocked,       // Another application kept the device claimed (STATUS_LOCKED) until the timeout
+    kClaimFailed,       // CLAIM_DEVICE failed
+    kClaimCancelled     // Client released with ReleaseClient() while waiting
+};
+
+/**
+* Claim manager settings
+**/
+struct ClaimManagerSettings
+{
+    int locked_retry_initial_ms;    // First CLAIM_DEVICE retry delay after STATUS_LOCKED, doubled per retry
+    int locked_retry_max_ms;
+    int expiry_check_ms;            // Period of the check releasing expired leases nobody waits for
+
+    std::function<long(int scanner_id)> claim_device;   // Sends CLAIM_DEVICE, returns command status
+    std::function<long(int scanner_id)> release_device; // Sends RELEASE_DEVICE, returns command status
+
+    ClaimManagerSettings()
+        : locked_retry_initial_ms(10), locked_retry_max_ms(500), expiry_check_ms(50)
+    {
+    }
+};
+
+/**
+* Arbitrates exclusive use of scanners between clients (lanes, threads, plug-ins) of one application.
+*
+* Each scanner has an ownership slot holding the owner client id and lease deadline in atomics, so
+* OwnerOf()/IsOwner() never lock. Claims are granted in arrival order: a releasing owner hands
+* the scanner directly to the first waiting client and wakes only that client, so nobody spins on
+* STATUS_LOCKED. The device stays claimed in the driver (CLAIM_DEVICE) while it moves between
+* clients and is released (RELEASE_DEVICE) when the last client lets go.
+*
+* An owner has to Renew() its lease; a client that dies without releasing loses the scanner when
+* the lease runs out (the first waiting client takes it over) or at once through ReleaseClient().
+* A background check releases the device in the driver every expiry_check_ms once a lease ran out
+* with nobody waiting, so other applications are not locked out by a dead owner.
+* When another application holds the device, CLAIM_DEVICE is retried with backoff.
+**/
+class ClaimManager
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static const int kNoOwner = 0;
+
+    /**
+    * Claim manager constructor - starts the lease expiry check
+    * @param settings - Driver callbacks and retry settings
+    */
+    explicit ClaimManager(const ClaimManagerSettings& settings);
+
+    /**
+    * Claim manager destructor - releases devices still claimed in the driver
+    */
+    ~ClaimManager();
+
+    ClaimManager(const ClaimManager&) = delete;
+    ClaimManager& operator=(const ClaimManager&) = delete;
+
+    /**
+    * Claim a scanner, waiting in line behind earlier claimants. A claim by the current owner renews
+    * its lease.
+    * @param scanner_id - Scanner to claim (1 - MAX_NUM_DEVICES)
+    * @param client_id - Claiming client (non zero)
+    * @param lease_ms - Lease length, renew before it ends
+    * @param timeout_ms - Maximum wait
+    * return value : Claim status
+    */
+    ClaimStatus Claim(int scanner_id, int client_id, int lease_ms, int timeout_ms);
+
+    /**
+    * Extend the lease of an owned scanner
+    * return value : false if the client does not own the scanner (anymore) or its lease ran out
+    */
+    bool Renew(int scanner_id, int client_id, int lease_ms);
+
+    /**
+    * Release an owned scanner, handing it to the next waiting client
+    * return value : false if the client does not own the scanner
+    */
+    bool Release(int scanner_id, int client_id);
+
+    /**
+    * Release everything a client owns and cancel its waiting claims (client exited or crashed)
+    */
+    void ReleaseClient(int client_id);
+
+    /**
+    * Current owner of a scanner (lock free)
+    * return value : Owner client id, kNoOwner if not owned or the lease expired
+    */
+    int OwnerOf(int scanner_id) const;
+
+    /**
+    * Check ownership (lock free)
+    */
+    bool IsOwner(int scanner_id, int client_id) const { return client_id != kNoOwner && OwnerOf(scanner_id) == client_id; }
+
+    /**
+    * Release-to-grant latencies of client to client hand offs, in microseconds
+    */
+    std::vector<double> HandoffLatencies() const;
+
+    /**
+    * Number of leases that ran out (owner presumed dead)
+    */
+    long ExpiredCount() const { return expired_count_; }
+
+    /**
+    * Number of CLAIM_DEVICE retries after STATUS_LOCKED
+    */
+    long LockedRetryCount() const { return locked_retry_count_; }
+
+private:
+    struct Waiter
+    {
+        int client_id;
+        bool granted;
+        bool cancelled;
+        Clock::time_point released_at;  // When the previous owner let go (for hand off latency)
+        std::condition_variable wake;
+
+        explicit Waiter(int id) : client_id(id), granted(false), cancelled(false) {}
+    };
+
+    struct Slot
+    {
+        std::atomic<int> owner;
+        std::atomic<long long> lease_deadline;  // Clock ticks
+        std::mutex mutex;                       // Guards queue and driver_claimed
+        std::deque<Waiter*> queue;
+        bool driver_claimed;
+
+        Slot() : owner(kNoOwner), lease_deadline(0), driver_claimed(false) {}
+    };
+
+    Slot* SlotOf(int scanner_id);
+    ClaimStatus ClaimDriver(int scanner_id, Clock::time_point deadline);
+    void HandOff(Slot* slot, int scanner_id);
+    bool ReleaseIfExpired(Slot* slot, int scanner_id, Clock::time_point now);
+    void RunExpiryCheck();
+    static long long Ticks(Clock::time_point time) { return time.time_since_epoch().count(); }
+
+    ClaimManagerSettings settings_;
+    std::vector<Slot> slots_;   // Indexed by scanner id
+
+    mutable std::mutex stats_mutex_;
+    std::vector<double> handoff_latencies_us_;
+    std::atomic<long> expired_count_;
+    std::atomic<long> locked_retry_count_;
+
+    std::mutex expiry_mutex_;
+    std::condition_variable expiry_wake_;
+    bool stopping_;
+    std::thread expiry_thread_;
+};
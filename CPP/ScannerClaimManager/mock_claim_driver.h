@@ -0,0 +1,73 @@
+/*******************************************************************************************
+* @file mock_claim_driver.h
+* @brief Simulated driver side of CLAIM_DEVICE/RELEASE_DEVICE
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "common_defs.h"
+
+/**
+* Simulated CoreScanner device claims, used to exercise ClaimManager without hardware.
+* A claimed device answers STATUS_LOCKED to every other claimant (another application, or a
+* client of a retry loop) until it is released. Each command takes command_latency_us.
+**/
+class MockClaimDriver
+{
+public:
+    static const int kMaxScanners = 8;
+
+    /**
+    * Mock driver constructor
+    * @param command_latency_us - Time each command takes
+    */
+    explicit MockClaimDriver(int command_latency_us = 500)
+        : command_latency_us_(command_latency_us), claim_count_(0), release_count_(0)
+    {
+        for (int i = 0; i < kMaxScanners; i++)
+        {
+            holders_[i] = 0;
+        }
+    }
+
+    /**
+    * CLAIM_DEVICE on behalf of a holder (application/client id)
+    * return value : STATUS_SUCCESS or STATUS_LOCKED
+    */
+    long Claim(int scanner_id, int holder)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(command_latency_us_));
+        claim_count_++;
+        int expected = 0;
+        if (holders_[scanner_id].compare_exchange_strong(expected, holder) || expected == holder)
+        {
+            return STATUS_SUCCESS;
+        }
+        return STATUS_LOCKED;
+    }
+
+    /**
+    * RELEASE_DEVICE on behalf of a holder
+    */
+    long Release(int scanner_id, int holder)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(command_latency_us_));
+        release_count_++;
+        int expected = holder;
+        holders_[scanner_id].compare_exchange_strong(expected, 0);
+        return STATUS_SUCCESS;
+    }
+
+    long ClaimCount() const { return claim_count_; }
+    long ReleaseCount() const { return release_count_; }
+
+private:
+    int command_latency_us_;
+    std::atomic<int> holders_[kMaxScanners];
+    std::atomic<long> claim_count_;
+    std::atomic<long> release_count_;
+};
@@ -0,0 +1,471 @@
+/*******************************************************************************************
+* @file scanner_claim_manager.cpp
+* @brief This file contains code snippet to share scanners between clients with CLAIM_DEVICE/RELEASE_DEVICE leases
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "claim_manager.h"
+#include "mock_claim_driver.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+SHORT num_scanners = 0;
+SAFEARRAY* get_scanners_array = NULL;
+SHORT* scanner_id_array;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Get connected scanners
+* return value : GetScanners success/fail status
+*/
+bool GetScanners()
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    HRESULT hr = S_FALSE;
+    LONG status = -1;
+    BSTR out_xml;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    // Get connected scanners
+    hr = scanner_interface->GetScanners(
+        &num_scanners,         // Returns number of scanners discovered 
+        get_scanners_array,    // Returns array of connected scanner ids 
+        &out_xml,              // Output xml containing discovered scanners information 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        cout << "CoreScanner GetScanners()- Success" << endl;
+        cout << " Total Scanners : " << num_scanners << endl;
+        string scanner_id_list = "";
+        HRESULT hr = SafeArrayAccessData(get_scanners_array, (void**)&scanner_id_array);
+        for (int n = 0; n < num_scanners; n++)
+        {
+            scanner_id_list = " " + to_string(scanner_id_array[n]);
+            if (n != num_scanners - 1)
+            {
+                scanner_id_list += ",";
+            }
+        }
+        cout << " Scanner IDs :" << scanner_id_list << endl;
+        wstring out_str(out_xml, SysStringLen(out_xml));
+        string  get_scanners_output_xml(out_str.begin(), out_str.end());
+        cout << " Out xml : " << endl;
+        cout << get_scanners_output_xml << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner GetScanner() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Send CLAIM_DEVICE/RELEASE_DEVICE
+* @tparam Op CLAIM_DEVICE or RELEASE_DEVICE
+* return value : Command status (-1 if the COM call failed)
+*/
+template <OPCODE Op>
+long ExecClaimCommand(int scanner_id)
+{
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, scanner_id);
+    return SUCCEEDED(result.hr) ? result.status : -1;
+}
+
+/*
+* Print median/99th percentile/max of latencies in microseconds
+*/
+void PrintLatencies(const char* name, vector<double> latencies_us)
+{
+    if (latencies_us.empty())
+    {
+        cout << " " << name << " : no hand offs" << endl;
+        return;
+    }
+    sort(latencies_us.begin(), latencies_us.end());
+    cout << " " << name << " : " << latencies_us.size() << " hand offs, median " << latencies_us[latencies_us.size() / 2]
+         << " us, p99 " << latencies_us[latencies_us.size() * 99 / 100] << " us, max " << latencies_us.back() << " us" << endl;
+}
+
+/*
+* Lanes share scanners through the claim manager
+*/
+void RunLaneContention(int lanes, int scanners, int rounds, int hold_us)
+{
+    MockClaimDriver driver;
+    ClaimManagerSettings settings;
+    settings.claim_device = [&driver](int scanner_id) { return driver.Claim(scanner_id, 1); };
+    settings.release_device = [&driver](int scanner_id) { return driver.Release(scanner_id, 1); };
+
+    vector<double> latencies;
+    long driver_claims = 0;
+    {
+        ClaimManager manager(settings);
+        vector<thread> threads;
+        for (int lane = 1; lane <= lanes; lane++)
+        {
+            threads.push_back(thread([&manager, lane, scanners, rounds, hold_us]()
+            {
+                for (int i = 0; i < rounds; i++)
+                {
+                    int scanner_id = 1 + (lane + i) % scanners;
+                    if (manager.Claim(scanner_id, lane, 1000, 5000) == kClaimGranted)
+                    {
+                        this_thread::sleep_for(chrono::microseconds(hold_us));   // Scan with the claimed scanner
+                        manager.Release(scanner_id, lane);
+                    }
+                }
+            }));
+        }
+        for (size_t i = 0; i < threads.size(); i++)
+        {
+            threads[i].join();
+        }
+        latencies = manager.HandoffLatencies();
+        driver_claims = driver.ClaimCount();
+    }
+    PrintLatencies("Claim manager", latencies);
+    cout << "  CLAIM_DEVICE commands : " << driver_claims << " for " << lanes * rounds << " claims" << endl;
+}
+
+/*
+* Same lanes without the claim manager - every lane retries CLAIM_DEVICE while it gets STATUS_LOCKED
+*/
+void RunRetryLoop(int lanes, int scanners, int rounds, int hold_us, int retry_ms)
+{
+    MockClaimDriver driver;
+    atomic<long long> released_at[MockClaimDriver::kMaxScanners];
+    for (int i = 0; i < MockClaimDriver::kMaxScanners; i++)
+    {
+        released_at[i] = 0;
+    }
+    vector<double> latencies;
+    mutex latencies_mutex;
+
+    vector<thread> threads;
+    for (int lane = 1; lane <= lanes; lane++)
+    {
+        threads.push_back(thread([&, lane]()
+        {
+            for (int i = 0; i < rounds; i++)
+            {
+                int scanner_id = 1 + (lane + i) % scanners;
+                bool waited = false;
+                while (driver.Claim(scanner_id, lane) == STATUS_LOCKED)
+                {
+                    waited = true;
+                    this_thread::sleep_for(chrono::milliseconds(retry_ms));
+                }
+                long long now = chrono::steady_clock::now().time_since_epoch().count();
+                if (waited)
+                {
+                    lock_guard<mutex> lock(latencies_mutex);
+                    latencies.push_back(chrono::duration<double, micro>(chrono::steady_clock::duration(now - released_at[scanner_id])).count());
+                }
+                this_thread::sleep_for(chrono::microseconds(hold_us));
+                driver.Release(scanner_id, lane);
+                released_at[scanner_id] = chrono::steady_clock::now().time_since_epoch().count();
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++)
+    {
+        threads[i].join();
+    }
+    PrintLatencies("Retry loop", latencies);
+    cout << "  CLAIM_DEVICE commands : " << driver.ClaimCount() << " for " << lanes * rounds << " claims" << endl;
+}
+
+/*
+* A client dies holding a scanner, another application holds the device for a while, and a
+* client claims a scanner it owns
+*/
+void RunFailureCases()
+{
+    MockClaimDriver driver;
+    ClaimManagerSettings settings;
+    settings.claim_device = [&driver](int scanner_id) { return driver.Claim(scanner_id, 1); };
+    settings.release_device = [&driver](int scanner_id) { return driver.Release(scanner_id, 1); };
+    ClaimManager manager(settings);
+
+    // Client 1 claims with a 50 ms lease and never releases or renews
+    manager.Claim(1, 1, 50, 1000);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    ClaimStatus status = manager.Claim(1, 2, 1000, 1000);
+    double waited_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << " Dead client : client 2 " << (status == kClaimGranted ? "took over" : "did not get the scanner") << " after "
+         << waited_ms << " ms, expired leases : " << manager.ExpiredCount() << ", client 1 renew : "
+         << (manager.Renew(1, 1, 50) ? "accepted" : "rejected") << endl;
+    manager.Release(1, 2);
+
+    // Another application (holder 99) keeps scanner 2 claimed for 100 ms
+    driver.Claim(2, 99);
+    thread other_application([&driver]()
+    {
+        this_thread::sleep_for(chrono::milliseconds(100));
+        driver.Release(2, 99);
+    });
+    start = chrono::steady_clock::now();
+    status = manager.Claim(2, 3, 1000, 2000);
+    waited_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    other_application.join();
+    cout << " Other application : client 3 " << (status == kClaimGranted ? "claimed" : "did not get") << " the device after "
+         << waited_ms << " ms with " << manager.LockedRetryCount() << " CLAIM_DEVICE retries" << endl;
+    manager.Release(2, 3);
+
+    // Client 4 claims scanner 3 twice (the second claim renews), then dies with nobody waiting -
+    // the expiry check releases the device so another application can claim it
+    status = manager.Claim(3, 4, 50, 1000);
+    start = chrono::steady_clock::now();
+    ClaimStatus second_status = manager.Claim(3, 4, 50, 1000);
+    waited_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << " Claim by the owner : " << (status == kClaimGranted && second_status == kClaimGranted ? "renewed" : "failed") << " after "
+         << waited_ms << " ms" << endl;
+    this_thread::sleep_for(chrono::milliseconds(50 + 2 * settings.expiry_check_ms));
+    cout << " Dead client, nobody waiting : another application " << (driver.Claim(3, 99) == STATUS_SUCCESS ? "claimed" : "is locked out of")
+         << " the device, expired leases : " << manager.ExpiredCount() << endl;
+    driver.Release(3, 99);
+}
+
+/*
+* Claim, hand over and release a scanner between two clients
+*/
+void ClaimScanner(int scanner_id)
+{
+    ClaimManagerSettings settings;
+    settings.claim_device = ExecClaimCommand<CLAIM_DEVICE>;
+    settings.release_device = ExecClaimCommand<RELEASE_DEVICE>;
+    ClaimManager manager(settings);
+
+    const int kLane1 = 1;
+    const int kLane2 = 2;
+    ClaimStatus status = manager.Claim(scanner_id, kLane1, 10000, 5000);
+    cout << "CoreScanner ClaimDevice() scanner ID:[" << scanner_id << "] - " << (status == kClaimGranted ? "Success" : "Failed") << endl;
+    if (status != kClaimGranted)
+    {
+        return;
+    }
+    cout << " Owner : client " << manager.OwnerOf(scanner_id) << endl;
+
+    // Lane 2 asks while lane 1 still owns the scanner, lane 1 hands over shortly after
+    thread lane2([&manager, scanner_id, kLane2]()
+    {
+        if (manager.Claim(scanner_id, kLane2, 10000, 5000) == kClaimGranted)
+        {
+            manager.Release(scanner_id, kLane2);
+        }
+    });
+    this_thread::sleep_for(chrono::milliseconds(100));
+    manager.Release(scanner_id, kLane1);
+    lane2.join();
+    PrintLatencies("Hand off", manager.HandoffLatencies());
+    cout << "CoreScanner ReleaseDevice() scanner ID:[" << scanner_id << "] - " << (manager.OwnerOf(scanner_id) == ClaimManager::kNoOwner ? "Success" : "Failed") << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+/*
+* Main Program
+*/
+int main()
+{
+    const int kLanes = 8;
+    const int kScanners = 2;
+    const int kRounds = 100;
+    const int kHoldUs = 1000;
+
+    cout << "Claim hand off, " << kLanes << " lanes sharing " << kScanners << " scanners" << endl;
+    RunLaneContention(kLanes, kScanners, kRounds, kHoldUs);
+    RunRetryLoop(kLanes, kScanners, kRounds, kHoldUs, 10);
+    cout << "Claim failure cases" << endl;
+    RunFailureCases();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (Open())
+    {
+        if (GetScanners())
+        {
+            if (num_scanners > 0)
+            {
+                // Select first scanner found
+                int scanner_id = scanner_id_array[0];
+                ClaimScanner(scanner_id);
+            }
+            else
+            {
+                cout << "No scanners found." << endl;
+            }
+        }
+
+        if (get_scanners_array != NULL)
+        {
+            SafeArrayUnaccessData(get_scanners_array);
+            SafeArrayDestroy(get_scanners_array);
+        }
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
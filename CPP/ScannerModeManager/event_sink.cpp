@@ -0,0 +1,221 @@
+/*******************************************************************************************
+* @file event_sink.cpp
+* @brief Definition of class to handle CoreScanner events
+* @version 1.0.0.1
+* @date 2020-05-21
+* @copyright  2020 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include <iostream>
+#include <string>
+#include "afxdisp.h"  // MFC Automation classes
+#include "common_defs.h"
+
+using namespace std;
+EventSink * ScannerEventSink;
+IMPLEMENT_DYNAMIC(EventSink, CCmdTarget)
+
+/**
+* Event sink constructor
+**/
+EventSink::EventSink()
+{
+    EnableAutomation();
+}
+
+/**
+* Event sink destructor
+**/
+EventSink::~EventSink()
+{
+
+}
+
+/**
+* virtual function called when last OLE reference is released
+*/
+void EventSink::OnFinalRelease()
+{
+    CCmdTarget::OnFinalRelease();
+}
+
+/**
+* Set the function receiving scan data events
+*/
+void EventSink::SetScanDataHandler(const std::function<void(short event_type, const std::string& scan_data)>& handler)
+{
+    scan_data_handler_ = handler;
+}
+
+/**
+* Set the function receiving PNP events
+*/
+void EventSink::SetPnpHandler(const std::function<void(short event_type, const std::string& pnp_data)>& handler)
+{
+    pnp_handler_ = handler;
+}
+
+/**
+* Set the function receiving scanner notification events
+*/
+void EventSink::SetNotificationHandler(const std::function<void(short notification_type, const std::string& scanner_data)>& handler)
+{
+    notification_handler_ = handler;
+}
+
+/**
+* Set the function receiving image and video events
+*/
+void EventSink::SetCaptureHandler(const std::function<void(int event_type, short format, const unsigned char* data, long size, const std::string& scanner_data)>& handler)
+{
+    capture_handler_ = handler;
+}
+
+/**
+* Lock the byte array of an image/video event (NULL if the event carries no byte array)
+**/
+static unsigned char* AccessEventBuffer(VARIANT* buffer)
+{
+    unsigned char* data = NULL;
+    if (buffer != NULL && buffer->vt == (VT_ARRAY | VT_UI1) && buffer->parray != NULL)
+    {
+        if (FAILED(SafeArrayAccessData(buffer->parray, (void**)&data)))
+        {
+            data = NULL;
+        }
+    }
+    return data;
+}
+
+/**
+* Hand an image/video event buffer to the capture handler
+**/
+static void RouteCaptureEvent(const std::function<void(int, short, const unsigned char*, long, const std::string&)>& handler,
+    int event_type, SHORT format, LONG size, VARIANT* buffer, BSTR* scanner_data)
+{
+    if (!handler)
+    {
+        return;
+    }
+    wstring xml_str;
+    if (scanner_data != NULL && *scanner_data != NULL)
+    {
+        xml_str.assign(*scanner_data, SysStringLen(*scanner_data));
+    }
+    unsigned char* data = AccessEventBuffer(buffer);
+    handler(event_type, format, data, data != NULL ? size : 0, string(xml_str.begin(), xml_str.end()));
+    if (data != NULL)
+    {
+        SafeArrayUnaccessData(buffer->parray);
+    }
+}
+
+BEGIN_MESSAGE_MAP(EventSink, CCmdTarget)
+END_MESSAGE_MAP()
+
+BEGIN_DISPATCH_MAP(EventSink, CCmdTarget)
+    DISP_FUNCTION_ID(EventSink, "ScanCmdResponseEvent", 5, OnScanCmdResponseEvent, VT_EMPTY, VTS_I2 VTS_BSTR)
+    DISP_FUNCTION_ID(EventSink, "PnpEvents", 4, OnPnpEvents, VT_EMPTY, VTS_I2 VTS_BSTR)
+    DISP_FUNCTION_ID(EventSink, "ScanDataEvent", 3, OnScanDataEvent, VT_EMPTY, VTS_I2 VTS_BSTR)
+    DISP_FUNCTION_ID(EventSink, "ScanRmdEvent", 6, OnScanRmdEvent, VT_EMPTY, VTS_I2 VTS_BSTR)
+    DISP_FUNCTION_ID(EventSink, "ImageEvent", 1, OnImageEvent, VT_EMPTY, VTS_I2 VTS_I4 VTS_I2 VTS_PVARIANT VTS_BSTR)
+    DISP_FUNCTION_ID(EventSink, "VideoEvent", 2, OnVideoEvent, VT_EMPTY, VTS_I2 VTS_I4 VTS_PVARIANT VTS_BSTR)
+    DISP_FUNCTION_ID(EventSink, "ScannerNotificationEvent", 8, OnScannerNotificationEvent, VT_EMPTY, VTS_I2 VTS_BSTR)
+    DISP_FUNCTION_ID(EventSink, "IoEvent", 7, OnIoNotificationEvent, VT_EMPTY, VTS_I2 VTS_UI1)
+    DISP_FUNCTION_ID(EventSink, "BinaryDataEvent", 9, OnBinaryDataEvent, VT_EMPTY, VTS_I2 VTS_I4 VTS_I2 VTS_PVARIANT VTS_BSTR)
+END_DISPATCH_MAP()
+
+BEGIN_INTERFACE_MAP(EventSink, CCmdTarget)
+    INTERFACE_PART(EventSink, DIID__ICoreScannerEvents, Dispatch)
+END_INTERFACE_MAP()
+
+/**
+* Barcode data event handler
+**/
+void EventSink::OnScanDataEvent(short event_type, BSTR scan_data)
+{
+    wstring out_str(scan_data, SysStringLen(scan_data));
+    string  output_barcode_data(out_str.begin(), out_str.end());
+    if (scan_data_handler_)
+    {
+        scan_data_handler_(event_type, output_barcode_data);
+        return;
+    }
+    cout << "Barcode Event Type : " << event_type << endl;
+    cout << "Output Xml : " << endl;
+    cout << output_barcode_data << endl;
+}
+
+/**
+* Response event handler
+**/
+void EventSink::OnScanCmdResponseEvent(short status, BSTR scan_cmd_response)
+{
+
+}
+
+/**
+* Notification event handler
+**/
+void EventSink::OnIoNotificationEvent(short type, unsigned char data)
+{
+
+}
+
+/**
+* Image event handler
+**/
+void EventSink::OnImageEvent(SHORT event_type, LONG size, SHORT image_format, VARIANT *image_data, BSTR* scanner_data)
+{
+    RouteCaptureEvent(capture_handler_, EVENT_TYPE_IMAGE, image_format, size, image_data, scanner_data);
+}
+
+/**
+* Video event handler
+**/
+void EventSink::OnVideoEvent(SHORT event_type, LONG size, VARIANT *video_data, BSTR* scanner_data)
+{
+    RouteCaptureEvent(capture_handler_, EVENT_TYPE_VIDEO, 0, size, video_data, scanner_data);
+}
+
+/**
+* PNP event handler
+**/
+void EventSink::OnPnpEvents(short event_type, BSTR pnp_data)
+{
+    if (pnp_handler_)
+    {
+        wstring out_str(pnp_data, SysStringLen(pnp_data));
+        pnp_handler_(event_type, string(out_str.begin(), out_str.end()));
+    }
+}
+
+/**
+* Scanner notification event handler
+**/
+void EventSink::OnScannerNotificationEvent(short notification_type, BSTR scanner_data)
+{
+    if (notification_handler_)
+    {
+        wstring out_str(scanner_data, SysStringLen(scanner_data));
+        notification_handler_(notification_type, string(out_str.begin(), out_str.end()));
+    }
+}
+
+/**
+* RMD event handler
+**/
+void EventSink::OnScanRmdEvent(short event_type, BSTR event_data)
+{
+
+}
+
+/**
+* Binary data event handler
+**/
+void EventSink::OnBinaryDataEvent(SHORT event_type, LONG size, SHORT data_format, VARIANT *binary_bata, BSTR* scanner_data)
+{
+
+}
\ No newline at end of file
@@ -0,0 +1,278 @@
+/*******************************************************************************************
+* @file mock_mode_host.h
+* @brief Simulated CoreScanner host switching barcode/image/video modes with per model timings
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common_defs.h"
+#include "xml_reader.h"
+
+/**
+* Timings of a simulated scanner model
+**/
+struct MockScannerModel
+{
+    const char* model_number;
+    int command_ms;             // Any command
+    int switch_ms;              // DEVICE_CAPTURE_BARCODE/IMAGE/VIDEO that changes the mode
+    int capture_ms;             // Trigger pull to image event
+    size_t image_bytes;
+    bool returns_to_barcode;    // Goes back to barcode mode by itself after an image capture
+    int return_notice_ms;       // Its BARCODE_MODE notification comes this long after the image event (CoreScanner does not order them)
+};
+
+/**
+* Simulated CoreScanner host with the ICoreScanner::ExecCommand/ExecCommandAsync signatures.
+* Each scanner runs its commands in order, one after the other, taking the times of its model.
+* Mode changes are reported as BARCODE_MODE/IMAGE_MODE/VIDEO_MODE notifications and captures as
+* image/video events, through the handlers on the host's event thread. ExecCommand returns when
+* the scanner finished the command, ExecCommandAsync at once.
+**/
+class MockModeHost
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<void(short notification_type, const std::string& scanner_data)> NotificationHandler;
+    typedef std::function<void(int event_type, short format, const unsigned char* data, long size, const std::string& scanner_data)> CaptureHandler;
+
+    /**
+    * Mock host constructor - starts the event thread
+    */
+    MockModeHost() : sequence_(0), stopping_(false)
+    {
+        thread_ = std::thread(&MockModeHost::Run, this);
+    }
+
+    ~MockModeHost()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    /**
+    * Add a scanner (in barcode mode)
+    */
+    void AddScanner(int scanner_id, const MockScannerModel& model)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Device& device = devices_[scanner_id];
+        device.model = model;
+    }
+
+    /**
+    * Set the functions receiving the notifications and image/video events (called on the host's event
+    * thread). Returns after an event being handled with the previous functions.
+    */
+    void SetHandlers(const NotificationHandler& notification_handler, const CaptureHandler& capture_handler)
+    {
+        std::lock_guard<std::mutex> dispatch_lock(dispatch_mutex_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        notification_handler_ = notification_handler;
+        capture_handler_ = capture_handler;
+    }
+
+    /**
+    * Mode switches a scanner executed that changed its mode
+    */
+    long ModeChanges(int scanner_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::map<int, Device>::const_iterator it = devices_.find(scanner_id);
+        return it == devices_.end() ? 0 : it->second.mode_changes;
+    }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        *out_xml = NULL;
+        Clock::time_point done = Schedule(opcode, in_xml, status);
+        std::this_thread::sleep_until(done);
+        return S_OK;
+    }
+
+    /**
+    * ExecCommandAsync with the ICoreScanner signature
+    */
+    HRESULT ExecCommandAsync(LONG opcode, BSTR* in_xml, LONG* status)
+    {
+        Schedule(opcode, in_xml, status);
+        return S_OK;
+    }
+
+private:
+    struct Device
+    {
+        MockScannerModel model;
+        int mode;                   // After the commands scheduled so far
+        bool pulled;
+        Clock::time_point busy_until;
+        long mode_changes;
+
+        Device() : model(), mode(BARCODE_MODE), pulled(false), mode_changes(0) {}
+    };
+
+    struct Event
+    {
+        Clock::time_point due;
+        long sequence;          // Keeps events of the same time in order
+        int scanner_id;
+        int event_type;         // EVENT_TYPE_OTHER for a notification
+        short notification_type;
+        size_t size;
+
+        bool operator>(const Event& other) const { return due != other.due ? due > other.due : sequence > other.sequence; }
+    };
+
+    void PushEvent(Clock::time_point due, int scanner_id, int event_type, short notification_type, size_t size)
+    {
+        Event event = { due, sequence_++, scanner_id, event_type, notification_type, size };
+        events_.push(event);
+        wake_.notify_one();
+    }
+
+    /**
+    * Queue a command behind the scanner's earlier commands
+    * return value : When the scanner finishes the command
+    */
+    Clock::time_point Schedule(LONG opcode, BSTR* in_xml, LONG* status)
+    {
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        std::string value;
+        int scanner_id = XmlFindText(in, "scannerID", &value) ? atoi(value.c_str()) : 0;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        Clock::time_point now = Clock::now();
+        std::map<int, Device>::iterator it = devices_.find(scanner_id);
+        if (it == devices_.end())
+        {
+            *status = STATUS_LOCKED;
+            return now;
+        }
+        Device& device = it->second;
+        Clock::time_point start = std::max(now, device.busy_until);
+        Clock::time_point done = start + std::chrono::milliseconds(device.model.command_ms);
+
+        int new_mode = 0;
+        switch (opcode)
+        {
+        case DEVICE_CAPTURE_BARCODE:
+            new_mode = BARCODE_MODE;
+            break;
+        case DEVICE_CAPTURE_IMAGE:
+            new_mode = IMAGE_MODE;
+            break;
+        case DEVICE_CAPTURE_VIDEO:
+            new_mode = VIDEO_MODE;
+            break;
+        case DEVICE_PULL_TRIGGER:
+            if (!device.pulled && device.mode != BARCODE_MODE)
+            {
+                device.pulled = true;
+                Clock::time_point captured = done + std::chrono::milliseconds(device.model.capture_ms);
+                PushEvent(captured, scanner_id, device.mode == VIDEO_MODE ? EVENT_TYPE_VIDEO : EVENT_TYPE_IMAGE, 0,
+                    device.model.image_bytes);
+                if (device.mode == IMAGE_MODE && device.model.returns_to_barcode)
+                {
+                    device.mode = BARCODE_MODE;
+                    device.mode_changes++;
+                    PushEvent(captured + std::chrono::milliseconds(device.model.return_notice_ms), scanner_id, EVENT_TYPE_OTHER, BARCODE_MODE, 0);
+                }
+                // The image transfer keeps the scanner busy
+                done = captured;
+            }
+            break;
+        case DEVICE_RELEASE_TRIGGER:
+            device.pulled = false;
+            break;
+        default:
+            break;
+        }
+        if (new_mode != 0 && new_mode != device.mode)
+        {
+            done += std::chrono::milliseconds(device.model.switch_ms);
+            device.mode = new_mode;
+            device.mode_changes++;
+            PushEvent(done, scanner_id, EVENT_TYPE_OTHER, (short)new_mode, 0);
+        }
+        device.busy_until = done;
+        *status = STATUS_SUCCESS;
+        return done;
+    }
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_)
+        {
+            if (events_.empty())
+            {
+                wake_.wait(lock);
+                continue;
+            }
+            Event event = events_.top();
+            if (Clock::now() < event.due)
+            {
+                wake_.wait_until(lock, event.due);
+                continue;
+            }
+            events_.pop();
+            std::string scanner_data = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><scannerID>" +
+                std::to_string(event.scanner_id) + "</scannerID></outArgs>";
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> dispatch_lock(dispatch_mutex_);
+                NotificationHandler notification_handler;
+                CaptureHandler capture_handler;
+                {
+                    std::lock_guard<std::mutex> handler_lock(mutex_);
+                    notification_handler = notification_handler_;
+                    capture_handler = capture_handler_;
+                }
+                if (event.event_type == EVENT_TYPE_OTHER)
+                {
+                    if (notification_handler)
+                    {
+                        notification_handler(event.notification_type, scanner_data);
+                    }
+                }
+                else if (capture_handler)
+                {
+                    std::vector<unsigned char> image(event.size, 0x80);
+                    capture_handler(event.event_type, 1, image.data(), (long)image.size(), scanner_data);
+                }
+            }
+            lock.lock();
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::mutex dispatch_mutex_;     // Held while a handler runs
+    std::condition_variable wake_;
+    std::map<int, Device> devices_;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event> > events_;
+    long sequence_;
+    NotificationHandler notification_handler_;
+    CaptureHandler capture_handler_;
+    bool stopping_;
+    std::thread thread_;
+};
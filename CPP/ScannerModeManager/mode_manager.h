@@ -0,0 +1,629 @@
+/*******************************************************************************************
+* @file mode_manager.h
+* @brief Barcode/image/video mode tracking with skipped redundant switches and pipelined captures
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+
+/**
+* Scanner mode, values of the mode notification types
+**/
+enum ScannerMode
+{
+    kModeUnknown = 0,
+    kModeBarcode = BARCODE_MODE,
+    kModeImage = IMAGE_MODE,
+    kModeVideo = VIDEO_MODE
+};
+
+/**
+* How a mode request ended
+**/
+enum ModeRequestStatus
+{
+    kModeDone,
+    kModeTimedOut,      // No image/video event before the timeout
+    kModeCommandFailed, // Mode switch or trigger command failed
+    kModeCancelled      // Manager destroyed
+};
+
+/**
+* Result handed to the completion callback of a mode request
+**/
+struct ModeResult
+{
+    int request_id;
+    int scanner_id;
+    ModeRequestStatus status;
+    long command_status;    // Status of the failed command
+    ScannerMode mode;
+    bool switched;          // A mode switch was sent for this request (false: the scanner was in the mode)
+    int event_type;         // EVENT_TYPE_IMAGE/EVENT_TYPE_VIDEO of a capture
+    short format;           // Image format of a capture
+    std::string data;       // Image or first video frame
+    double capture_ms;      // Request start (switch and trigger pull) to image/video event
+};
+
+/**
+* Mode manager settings
+**/
+struct ModeManagerSettings
+{
+    int capture_timeout_ms;     // Trigger pull to giving up on the image/video event
+    ScannerMode home_mode;      // Mode a scanner returns to after captures, unless SetMode() chose another
+
+    ModeManagerSettings() : capture_timeout_ms(2000), home_mode(kModeBarcode) {}
+};
+
+/**
+* Mode manager counters
+**/
+struct ModeMetrics
+{
+    long switches_sent;
+    long switches_skipped;      // Scanner already in the requested mode
+    long restores_deferred;     // Switch back skipped - the next queued capture wants the mode the scanner is in
+    long notifications;
+    long captures;
+    long timeouts;
+    long stray_captures;        // Image/video events with no capture waiting for them
+
+    ModeMetrics() : switches_sent(0), switches_skipped(0), restores_deferred(0), notifications(0), captures(0), timeouts(0), stray_captures(0) {}
+};
+
+/**
+* Send the DEVICE_CAPTURE_BARCODE/IMAGE/VIDEO command switching a scanner to a mode
+**/
+template <typename Scanner>
+CommandResult<NoResponse> ExecModeSwitchAsync(Scanner* scanner, int scanner_id, ScannerMode mode)
+{
+    switch (mode)
+    {
+    case kModeImage:
+        return ExecAsync<DEVICE_CAPTURE_IMAGE>(scanner, scanner_id);
+    case kModeVideo:
+        return ExecAsync<DEVICE_CAPTURE_VIDEO>(scanner, scanner_id);
+    default:
+        return ExecAsync<DEVICE_CAPTURE_BARCODE>(scanner, scanner_id);
+    }
+}
+
+/**
+* Tracks the mode of each scanner and runs mode switches and captures.
+*
+* The mode of a scanner is known from the switches the manager sent and from the BARCODE_MODE/
+* IMAGE_MODE/VIDEO_MODE notifications (OnNotification), so a switch to the mode the scanner is in
+* is skipped - also when the scanner went back to barcode mode on its own after a capture.
+* Many models leave image mode by themselves after a capture, and CoreScanner may deliver that
+* BARCODE_MODE notification after the image event. So after an image capture the mode of a
+* scanner counts as unknown and the next capture switches again, unless SetKeepsImageMode()
+* declared that the scanner stays in image mode.
+*
+* Capture() runs a switch, a trigger pull and the switch back as one sequence: the switch and the
+* pull are sent together with ExecCommandAsync (CoreScanner runs a scanner's commands in order), the
+* trigger is released and the switch back sent when the image/video event arrives (OnCapture).
+* The switch back is left out while the next queued capture of the scanner wants the same mode and
+* the scanner is known to stay in it.
+* Requests of one scanner run one after the other, requests of different scanners concurrently.
+*
+* Commands are sent from the manager thread, which also runs the timeouts and the completion
+* callbacks (callbacks may queue the next request, and must not block).
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommandAsync signature
+**/
+template <typename Scanner>
+class ModeManager
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<Scanner*(int worker)> AttachFunction;
+    typedef std::function<void(int worker, Scanner* scanner)> DetachFunction;
+    typedef std::function<void(const ModeResult& result)> ModeCallback;
+
+    /**
+    * Mode manager constructor - starts the manager thread
+    * @param settings - Capture timeout and home mode
+    * @param attach - Called on the manager thread to get its scanner interface
+    * @param detach - Called on the manager thread when it stops (optional)
+    */
+    ModeManager(const ModeManagerSettings& settings, const AttachFunction& attach, const DetachFunction& detach = DetachFunction())
+        : settings_(settings), attach_(attach), detach_(detach), next_request_id_(1), stopping_(false)
+    {
+        thread_ = std::thread(&ModeManager::Run, this);
+    }
+
+    /**
+    * Cancel the queued requests and stop the manager thread
+    */
+    ~ModeManager()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            std::vector<int> open_requests;
+            for (typename std::unordered_map<int, Request*>::iterator it = requests_.begin(); it != requests_.end(); ++it)
+            {
+                open_requests.push_back(it->first);
+            }
+            for (size_t i = 0; i < open_requests.size(); i++)
+            {
+                FinishLocked(requests_[open_requests[i]], kModeCancelled, STATUS_SUCCESS, NULL);
+            }
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    ModeManager(const ModeManager&) = delete;
+    ModeManager& operator=(const ModeManager&) = delete;
+
+    /**
+    * Capture an image or a video frame: switch, pull the trigger, await the event, release, switch back
+    * @param scanner_id - Scanner to capture with
+    * @param mode - kModeImage or kModeVideo
+    * @param done - Completion callback, called once on the manager thread
+    * return value : Request id
+    */
+    int Capture(int scanner_id, ScannerMode mode, const ModeCallback& done)
+    {
+        return Submit(scanner_id, kCapture, mode, done);
+    }
+
+    /**
+    * Switch a scanner to a mode and keep it there after captures (skipped if the scanner is in the mode)
+    * @param done - Completion callback, called once the switch is sent
+    * return value : Request id
+    */
+    int SetMode(int scanner_id, ScannerMode mode, const ModeCallback& done)
+    {
+        return Submit(scanner_id, kSetMode, mode, done);
+    }
+
+    /**
+    * Declare whether a scanner stays in image mode after an image capture (by default it is assumed
+    * to go back to barcode mode by itself). Forget() clears it.
+    */
+    void SetKeepsImageMode(int scanner_id, bool keeps_image_mode)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        LaneOf(scanner_id).keeps_image_mode = keeps_image_mode;
+    }
+
+    /**
+    * Mode notification (call from the scanner notification event handler)
+    * @param notification_type - BARCODE_MODE, IMAGE_MODE or VIDEO_MODE, other notifications are ignored
+    * @param scanner_data - Notification xml with the scanner id
+    */
+    void OnNotification(short notification_type, const std::string& scanner_data)
+    {
+        if (notification_type != BARCODE_MODE && notification_type != IMAGE_MODE && notification_type != VIDEO_MODE)
+        {
+            return;
+        }
+        int scanner_id = ScannerIdOf(scanner_data);
+        ScannerMode mode = (ScannerMode)notification_type;
+        std::lock_guard<std::mutex> lock(mutex_);
+        metrics_.notifications++;
+        Lane& lane = LaneOf(scanner_id);
+        size_t confirmed = 0;
+        while (confirmed < lane.pending_switches.size() && lane.pending_switches[confirmed].first != mode)
+        {
+            confirmed++;
+        }
+        if (confirmed < lane.pending_switches.size())
+        {
+            // Confirms a switch in flight - the cached mode already includes the later ones. Earlier
+            // switches went to the mode the scanner was in, which sends no notification.
+            lane.switch_latencies_ms.push_back(
+                std::chrono::duration<double, std::milli>(Clock::now() - lane.pending_switches[confirmed].second).count());
+            lane.pending_switches.erase(lane.pending_switches.begin(), lane.pending_switches.begin() + confirmed + 1);
+        }
+        else if (lane.pending_switches.empty())
+        {
+            // Mode changed without us (returned to barcode mode after a capture, another application)
+            lane.mode = mode;
+        }
+    }
+
+    /**
+    * Image or video event (call from the image/video event handlers)
+    * @param event_type - EVENT_TYPE_IMAGE or EVENT_TYPE_VIDEO
+    * @param format - Image format
+    * @param data - Image or video frame bytes
+    * @param size - Size of data
+    * @param scanner_data - Event xml with the scanner id
+    */
+    void OnCapture(int event_type, short format, const unsigned char* data, long size, const std::string& scanner_data)
+    {
+        int scanner_id = ScannerIdOf(scanner_data);
+        std::lock_guard<std::mutex> lock(mutex_);
+        Lane& lane = LaneOf(scanner_id);
+        Request* request = lane.active;
+        ScannerMode event_mode = event_type == EVENT_TYPE_VIDEO ? kModeVideo : kModeImage;
+        if (request == NULL || request->kind != kCapture || !request->triggered || request->mode != event_mode)
+        {
+            metrics_.stray_captures++;
+            return;
+        }
+        CapturedData capture = { event_type, format, std::string((const char*)data, data != NULL ? (size_t)size : 0) };
+        FinishLocked(request, kModeDone, STATUS_SUCCESS, &capture);
+    }
+
+    /**
+    * Forget the mode of a scanner (attached or detached)
+    */
+    void Forget(int scanner_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Lane& lane = LaneOf(scanner_id);
+        lane.mode = kModeUnknown;
+        lane.keeps_image_mode = false;
+        lane.pending_switches.clear();
+    }
+
+    /**
+    * Mode of a scanner as far as the manager knows (including switches it has queued)
+    */
+    ScannerMode ModeOf(int scanner_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        typename std::map<int, Lane>::const_iterator it = lanes_.find(scanner_id);
+        return it == lanes_.end() ? kModeUnknown : it->second.mode;
+    }
+
+    /**
+    * Switch command to mode notification times of a scanner, in milliseconds
+    */
+    std::vector<double> SwitchLatencies(int scanner_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        typename std::map<int, Lane>::const_iterator it = lanes_.find(scanner_id);
+        return it == lanes_.end() ? std::vector<double>() : it->second.switch_latencies_ms;
+    }
+
+    ModeMetrics Metrics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return metrics_;
+    }
+
+private:
+    static const size_t kMaxPendingSwitches = 8;
+
+    enum RequestKind
+    {
+        kCapture,
+        kSetMode
+    };
+
+    struct Request
+    {
+        int id;
+        int scanner_id;
+        RequestKind kind;
+        ScannerMode mode;
+        ModeCallback done;
+        bool switched;
+        bool triggered;     // Switch and trigger pull are on their way, image/video events belong to this request
+        Clock::time_point started_at;
+
+        Request() : id(0), scanner_id(0), kind(kCapture), mode(kModeUnknown), switched(false), triggered(false) {}
+    };
+
+    struct Lane
+    {
+        ScannerMode mode;       // After the switches sent so far
+        ScannerMode home_mode;
+        bool keeps_image_mode;  // Image mode is still valid after an image capture
+        Request* active;
+        std::deque<Request*> waiting;
+        std::deque<std::pair<ScannerMode, Clock::time_point> > pending_switches;   // Sent, not confirmed by a notification
+        std::vector<double> switch_latencies_ms;
+
+        Lane() : mode(kModeUnknown), home_mode(kModeBarcode), keeps_image_mode(false), active(NULL) {}
+    };
+
+    struct CapturedData
+    {
+        int event_type;
+        short format;
+        std::string data;
+    };
+
+    typedef std::function<void(Scanner* scanner)> Action;
+    typedef std::pair<Clock::time_point, int> Deadline;
+
+    static int ScannerIdOf(const std::string& scanner_data)
+    {
+        std::string value;
+        return XmlFindText(scanner_data, "scannerID", &value) ? atoi(value.c_str()) : 0;
+    }
+
+    Lane& LaneOf(int scanner_id)
+    {
+        typename std::map<int, Lane>::iterator it = lanes_.find(scanner_id);
+        if (it == lanes_.end())
+        {
+            it = lanes_.insert(std::make_pair(scanner_id, Lane())).first;
+            it->second.home_mode = settings_.home_mode;
+        }
+        return it->second;
+    }
+
+    int Submit(int scanner_id, RequestKind kind, ScannerMode mode, const ModeCallback& done)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Request* request = new Request();
+        request->id = next_request_id_++;
+        request->scanner_id = scanner_id;
+        request->kind = kind;
+        request->mode = mode;
+        request->done = done;
+        requests_[request->id] = request;
+
+        int request_id = request->id;
+        Lane& lane = LaneOf(scanner_id);
+        lane.waiting.push_back(request);
+        if (stopping_)
+        {
+            FinishLocked(request, kModeCancelled, STATUS_SUCCESS, NULL);
+        }
+        else if (lane.active == NULL)
+        {
+            StartNextLocked(&lane);
+        }
+        return request_id;
+    }
+
+    /**
+    * Record a switch the manager is about to send
+    */
+    void SwitchingLocked(Lane* lane, ScannerMode mode)
+    {
+        lane->mode = mode;
+        lane->pending_switches.push_back(std::make_pair(mode, Clock::now()));
+        if (lane->pending_switches.size() > kMaxPendingSwitches)
+        {
+            lane->pending_switches.pop_front();
+        }
+        metrics_.switches_sent++;
+    }
+
+    /**
+    * Start the first waiting request of a lane - the manager thread sends its commands
+    */
+    void StartNextLocked(Lane* lane)
+    {
+        Request* request = lane->waiting.front();
+        lane->waiting.pop_front();
+        lane->active = request;
+        request->started_at = Clock::now();
+        if (lane->mode == request->mode)
+        {
+            metrics_.switches_skipped++;
+        }
+        else
+        {
+            request->switched = true;
+            SwitchingLocked(lane, request->mode);
+        }
+        if (request->kind == kSetMode)
+        {
+            lane->home_mode = request->mode;
+        }
+        else
+        {
+            request->triggered = true;
+            deadlines_.push(Deadline(request->started_at + std::chrono::milliseconds(settings_.capture_timeout_ms), request->id));
+        }
+
+        int request_id = request->id;
+        int scanner_id = request->scanner_id;
+        ScannerMode mode = request->mode;
+        bool switched = request->switched;
+        bool capture = request->kind == kCapture;
+        actions_.push_back([this, request_id, scanner_id, mode, switched, capture](Scanner* scanner)
+        {
+            CommandResult<NoResponse> result = CommandResult<NoResponse>();
+            result.status = STATUS_SUCCESS;
+            if (scanner == NULL)
+            {
+                result.status = -1;
+            }
+            // Pipelined - the trigger pull goes out without waiting for the mode notification
+            if (scanner != NULL && switched)
+            {
+                result = ExecModeSwitchAsync(scanner, scanner_id, mode);
+            }
+            if (scanner != NULL && capture && result.Succeeded())
+            {
+                result = ExecAsync<DEVICE_PULL_TRIGGER>(scanner, scanner_id);
+            }
+            bool failed = !result.Succeeded() || scanner == NULL;
+            if (!failed && capture)
+            {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            typename std::unordered_map<int, Request*>::iterator it = requests_.find(request_id);
+            if (it != requests_.end())
+            {
+                FinishLocked(it->second, failed ? kModeCommandFailed : kModeDone,
+                    failed ? (result.status == STATUS_SUCCESS ? -1 : result.status) : STATUS_SUCCESS, NULL);
+            }
+        });
+        wake_.notify_one();
+    }
+
+    /**
+    * End a request: queue the trigger release, the switch back and the callback, and start the next request
+    */
+    void FinishLocked(Request* request, ModeRequestStatus status, long command_status, const CapturedData* capture)
+    {
+        ModeResult result = ModeResult();
+        result.request_id = request->id;
+        result.scanner_id = request->scanner_id;
+        result.status = status;
+        result.command_status = command_status;
+        result.mode = request->mode;
+        result.switched = request->switched;
+        if (capture != NULL)
+        {
+            result.event_type = capture->event_type;
+            result.format = capture->format;
+            result.data = capture->data;
+            result.capture_ms = std::chrono::duration<double, std::milli>(Clock::now() - request->started_at).count();
+            metrics_.captures++;
+        }
+        if (status == kModeTimedOut)
+        {
+            metrics_.timeouts++;
+        }
+
+        Lane& lane = LaneOf(request->scanner_id);
+        bool release = request->triggered;
+        ScannerMode restore = kModeUnknown;
+        if (lane.active == request)
+        {
+            lane.active = NULL;
+            if (release && request->mode == kModeImage && lane.mode == kModeImage && !lane.keeps_image_mode)
+            {
+                // The scanner may be back in barcode mode with its notification still on the way
+                lane.mode = kModeUnknown;
+            }
+            if (release && !stopping_)
+            {
+                if (!lane.waiting.empty() && lane.waiting.front()->mode == lane.mode)
+                {
+                    metrics_.restores_deferred++;
+                }
+                else if (lane.waiting.empty() && lane.mode != lane.home_mode && lane.home_mode != kModeUnknown)
+                {
+                    restore = lane.home_mode;
+                    SwitchingLocked(&lane, restore);
+                }
+                // Otherwise the next request switches the scanner itself
+            }
+        }
+        else
+        {
+            for (typename std::deque<Request*>::iterator it = lane.waiting.begin(); it != lane.waiting.end(); ++it)
+            {
+                if (*it == request)
+                {
+                    lane.waiting.erase(it);
+                    break;
+                }
+            }
+        }
+        requests_.erase(request->id);
+
+        int scanner_id = request->scanner_id;
+        ModeCallback done;
+        done.swap(request->done);
+        delete request;
+        actions_.push_back([release, restore, scanner_id, done, result](Scanner* scanner)
+        {
+            if (scanner != NULL && release)
+            {
+                ExecAsync<DEVICE_RELEASE_TRIGGER>(scanner, scanner_id);
+            }
+            if (scanner != NULL && restore != kModeUnknown)
+            {
+                ExecModeSwitchAsync(scanner, scanner_id, restore);
+            }
+            if (done)
+            {
+                done(result);
+            }
+        });
+
+        if (lane.active == NULL && !lane.waiting.empty() && !stopping_)
+        {
+            StartNextLocked(&lane);
+        }
+        wake_.notify_one();
+    }
+
+    /**
+    * Manager thread - runs queued commands and callbacks, and times out captures
+    */
+    void Run()
+    {
+        Scanner* scanner = attach_(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            if (!actions_.empty())
+            {
+                Action action;
+                action.swap(actions_.front());
+                actions_.pop_front();
+                lock.unlock();
+                action(scanner);
+                lock.lock();
+                continue;
+            }
+            if (stopping_)
+            {
+                break;
+            }
+            if (deadlines_.empty())
+            {
+                wake_.wait(lock);
+                continue;
+            }
+            Deadline deadline = deadlines_.top();
+            if (Clock::now() < deadline.first)
+            {
+                wake_.wait_until(lock, deadline.first);
+                continue;
+            }
+            deadlines_.pop();
+            // A capture that ended before its timeout has no entry anymore
+            typename std::unordered_map<int, Request*>::iterator it = requests_.find(deadline.second);
+            if (it != requests_.end())
+            {
+                FinishLocked(it->second, kModeTimedOut, STATUS_SUCCESS, NULL);
+            }
+        }
+        lock.unlock();
+        if (detach_)
+        {
+            detach_(0, scanner);
+        }
+    }
+
+    ModeManagerSettings settings_;
+    AttachFunction attach_;
+    DetachFunction detach_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::unordered_map<int, Request*> requests_;    // Queued and active requests by id
+    std::map<int, Lane> lanes_;                     // By scanner id
+    std::deque<Action> actions_;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline> > deadlines_;
+    int next_request_id_;
+    ModeMetrics metrics_;
+    bool stopping_;
+    std::thread thread_;
+};
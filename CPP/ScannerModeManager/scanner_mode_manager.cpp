@@ -0,0 +1,589 @@
+/*******************************************************************************************
+* @file scanner_mode_manager.cpp
+* @brief This file contains code snippet to capture images while tracking the scanner mode, skipping redundant mode switches
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "mode_manager.h"
+#include "mock_mode_host.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+IGlobalInterfaceTable* global_interface_table = NULL;  // Hands the interface to the mode manager thread
+DWORD scanner_interface_cookie = 0;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for image, video, notification and PNP events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_IMAGE);
+    event_ids.push_back(EVENT_TYPE_VIDEO);
+    event_ids.push_back(EVENT_TYPE_OTHER);
+    event_ids.push_back(EVENT_TYPE_PNP);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Get the ids of the connected scanners
+* @param scanner_ids - Receives scanner ids
+* return value : GetScanners success/fail status
+*/
+bool GetScannerIds(vector<int>* scanner_ids)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+    XmlReader reader(get_scanners_output_xml);
+    XmlSlice text;
+    while (reader.FindElement("scannerID") && reader.ReadElementText(&text))
+    {
+        scanner_ids->push_back((int)text.ToLong());
+    }
+    cout << "CoreScanner GetScanners() - Success, " << scanner_ids->size() << " scanners" << endl;
+    return true;
+}
+
+/*
+* Give the mode manager thread its own CoreScanner interface from the global interface table
+*/
+ICoreScanner* AttachWorkerScanner(int worker)
+{
+    CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    ICoreScanner* worker_scanner = NULL;
+    HRESULT hr = global_interface_table->GetInterfaceFromGlobal(scanner_interface_cookie, IID_ICoreScanner, (void**)&worker_scanner);
+    if FAILED(hr)
+    {
+        cout << "CoreScanner interface unmarshaling for the mode manager thread - Failed" << endl;
+        CoUninitialize();
+        return NULL;
+    }
+    return worker_scanner;
+}
+
+/*
+* Release the CoreScanner interface of the mode manager thread
+*/
+void DetachWorkerScanner(int worker, ICoreScanner* worker_scanner)
+{
+    if (worker_scanner != NULL)
+    {
+        worker_scanner->Release();
+        CoUninitialize();
+    }
+}
+
+const char* ModeName(ScannerMode mode)
+{
+    switch (mode)
+    {
+    case kModeBarcode:
+        return "barcode";
+    case kModeImage:
+        return "image";
+    case kModeVideo:
+        return "video";
+    default:
+        return "unknown";
+    }
+}
+
+const char* ModeRequestStatusName(ModeRequestStatus status)
+{
+    switch (status)
+    {
+    case kModeDone:
+        return "done";
+    case kModeTimedOut:
+        return "timed out";
+    case kModeCommandFailed:
+        return "command failed";
+    default:
+        return "cancelled";
+    }
+}
+
+double Median(vector<double> values)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+/*
+* Capture images the way the snippets do it today: switch to image mode, pull the trigger, wait for
+* the image event, release the trigger and switch back to barcode mode - every command blocking
+*/
+double RunBlockingCaptures(MockModeHost* host, int scanner_id, int batches, int images, int timeout_ms, int* timed_out)
+{
+    mutex image_mutex;
+    condition_variable image_arrived;
+    int image_scanner = 0;
+    host->SetHandlers(nullptr, [&](int event_type, short format, const unsigned char* data, long size, const string& scanner_data)
+    {
+        string value;
+        lock_guard<mutex> lock(image_mutex);
+        image_scanner = XmlFindText(scanner_data, "scannerID", &value) ? atoi(value.c_str()) : 0;
+        image_arrived.notify_one();
+    });
+
+    *timed_out = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int batch = 0; batch < batches; batch++)
+    {
+        for (int image = 0; image < images; image++)
+        {
+            {
+                lock_guard<mutex> lock(image_mutex);
+                image_scanner = 0;
+            }
+            Exec<DEVICE_CAPTURE_IMAGE>(host, scanner_id);
+            Exec<DEVICE_PULL_TRIGGER>(host, scanner_id);
+            bool got_image = false;
+            {
+                unique_lock<mutex> lock(image_mutex);
+                got_image = image_arrived.wait_for(lock, chrono::milliseconds(timeout_ms), [&] { return image_scanner == scanner_id; });
+            }
+            if (!got_image)
+            {
+                (*timed_out)++;
+            }
+            Exec<DEVICE_RELEASE_TRIGGER>(host, scanner_id);
+            Exec<DEVICE_CAPTURE_BARCODE>(host, scanner_id);
+        }
+    }
+    double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    host->SetHandlers(nullptr, nullptr);
+    return elapsed_ms;
+}
+
+/*
+* Same captures through the mode manager: each batch is queued at once, the scanner stays in image
+* mode through the batch and returns to barcode mode after it
+*/
+double RunManagedCaptures(MockModeHost* host, int scanner_id, bool keeps_image_mode, int batches, int images, int timeout_ms, int* timed_out,
+    ModeMetrics* metrics, vector<double>* switch_latencies_ms, vector<double>* capture_ms)
+{
+    ModeManagerSettings settings;
+    settings.capture_timeout_ms = timeout_ms;
+    mutex done_mutex;
+    condition_variable batch_done;
+    int done_count = 0;
+    *timed_out = 0;
+
+    ModeManager<MockModeHost> manager(settings, [host](int) { return host; });
+    manager.SetKeepsImageMode(scanner_id, keeps_image_mode);
+    host->SetHandlers(
+        [&manager](short notification_type, const string& scanner_data) { manager.OnNotification(notification_type, scanner_data); },
+        [&manager](int event_type, short format, const unsigned char* data, long size, const string& scanner_data)
+        {
+            manager.OnCapture(event_type, format, data, size, scanner_data);
+        });
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int batch = 0; batch < batches; batch++)
+    {
+        for (int image = 0; image < images; image++)
+        {
+            manager.Capture(scanner_id, kModeImage, [&](const ModeResult& result)
+            {
+                lock_guard<mutex> lock(done_mutex);
+                if (result.status == kModeDone)
+                {
+                    capture_ms->push_back(result.capture_ms);
+                }
+                else
+                {
+                    (*timed_out)++;
+                }
+                done_count++;
+                batch_done.notify_one();
+            });
+        }
+        unique_lock<mutex> lock(done_mutex);
+        batch_done.wait(lock, [&] { return done_count == (batch + 1) * images; });
+    }
+    double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    // The switch back after the last batch is confirmed after the last capture callback
+    chrono::steady_clock::time_point give_up = chrono::steady_clock::now() + chrono::milliseconds(timeout_ms);
+    while ((long)manager.SwitchLatencies(scanner_id).size() < manager.Metrics().switches_sent && chrono::steady_clock::now() < give_up)
+    {
+        this_thread::sleep_for(chrono::milliseconds(5));
+    }
+    host->SetHandlers(nullptr, nullptr);
+    *metrics = manager.Metrics();
+    *switch_latencies_ms = manager.SwitchLatencies(scanner_id);
+    return elapsed_ms;
+}
+
+/*
+* Image captures of a few scanner models, blocking and through the mode manager, against a
+* simulated host (batches of images with barcode scanning in between)
+*/
+void RunModeBenchmark()
+{
+    const int kBatches = 4;
+    const int kImages = 5;
+    const int kTimeoutMs = 1000;
+    const MockScannerModel kModels[] =
+    {
+        { "DS8178", 4, 120, 60, 60000, false, 0 },
+        { "DS9308", 4, 80, 40, 40000, true, 0 },
+        { "DS9308", 4, 80, 40, 40000, true, 5 },
+        { "MP7000", 6, 200, 90, 120000, false, 0 },
+    };
+
+    for (size_t m = 0; m < sizeof(kModels) / sizeof(kModels[0]); m++)
+    {
+        const MockScannerModel& model = kModels[m];
+        const int scanner_id = 1;
+        cout << model.model_number << " (switch " << model.switch_ms << " ms, capture " << model.capture_ms << " ms"
+             << (model.returns_to_barcode ? ", back to barcode mode after each image" : "")
+             << (model.return_notice_ms > 0 ? ", notified " + to_string(model.return_notice_ms) + " ms after the image" : "") << ")" << endl;
+
+        {
+            MockModeHost host;
+            host.AddScanner(scanner_id, model);
+            int timed_out = 0;
+            double elapsed_ms = RunBlockingCaptures(&host, scanner_id, kBatches, kImages, kTimeoutMs, &timed_out);
+            cout << " Blocking     : " << kBatches * kImages << " images in " << elapsed_ms << " ms, " << timed_out << " timed out, "
+                 << kBatches * kImages * 2 << " switches sent, " << host.ModeChanges(scanner_id) << " mode changes" << endl;
+        }
+
+        {
+            MockModeHost host;
+            host.AddScanner(scanner_id, model);
+            int timed_out = 0;
+            ModeMetrics metrics;
+            vector<double> switch_latencies_ms;
+            vector<double> capture_ms;
+            double elapsed_ms = RunManagedCaptures(&host, scanner_id, !model.returns_to_barcode, kBatches, kImages, kTimeoutMs, &timed_out,
+                &metrics, &switch_latencies_ms, &capture_ms);
+            cout << " ModeManager  : " << kBatches * kImages << " images in " << elapsed_ms << " ms, " << timed_out << " timed out, "
+                 << metrics.switches_sent << " switches sent, " << metrics.switches_skipped << " skipped, "
+                 << metrics.restores_deferred << " switches back deferred, " << host.ModeChanges(scanner_id) << " mode changes" << endl;
+            cout << " Switch to notification : median " << Median(switch_latencies_ms) << " ms over " << switch_latencies_ms.size()
+                 << " switches, request to image : median " << Median(capture_ms) << " ms" << endl;
+        }
+    }
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Mode switch benchmark (simulated host)" << endl;
+    RunModeBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    vector<int> scanner_ids;
+    if (ConnectEvents() && Open() && GetScannerIds(&scanner_ids))
+    {
+        CoCreateInstance(CLSID_StdGlobalInterfaceTable, NULL, CLSCTX_INPROC_SERVER, IID_IGlobalInterfaceTable, (void**)&global_interface_table);
+        if (global_interface_table != NULL &&
+            SUCCEEDED(global_interface_table->RegisterInterfaceInGlobal(scanner_interface, IID_ICoreScanner, &scanner_interface_cookie)))
+        {
+            if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+            {
+                ModeManagerSettings settings;
+                settings.capture_timeout_ms = 5000;
+                {
+                    ModeManager<ICoreScanner> manager(settings, AttachWorkerScanner, DetachWorkerScanner);
+                    scanner_event_sink->SetNotificationHandler([&manager](short notification_type, const string& scanner_data)
+                    {
+                        manager.OnNotification(notification_type, scanner_data);
+                    });
+                    scanner_event_sink->SetCaptureHandler([&manager](int event_type, short format, const unsigned char* data, long size, const string& scanner_data)
+                    {
+                        manager.OnCapture(event_type, format, data, size, scanner_data);
+                    });
+                    scanner_event_sink->SetPnpHandler([&manager](short event_type, const string& pnp_data)
+                    {
+                        string value;
+                        if (XmlFindText(pnp_data, "scannerID", &value))
+                        {
+                            manager.Forget(atoi(value.c_str()));
+                        }
+                    });
+
+                    for (size_t i = 0; i < scanner_ids.size(); i++)
+                    {
+                        manager.Capture(scanner_ids[i], kModeImage, [](const ModeResult& result)
+                        {
+                            cout << "Image capture " << result.request_id << " scanner ID:[" << result.scanner_id << "] - "
+                                 << ModeRequestStatusName(result.status);
+                            if (result.status == kModeDone)
+                            {
+                                cout << " after " << result.capture_ms << " ms, " << result.data.size() << " bytes"
+                                     << (result.switched ? "" : " (mode switch skipped)");
+                            }
+                            else if (result.status == kModeCommandFailed)
+                            {
+                                cout << ". Error Code : " << result.command_status;
+                            }
+                            cout << endl;
+                        });
+                    }
+                    WaitForInput("Trigger pulled in image mode on " + to_string(scanner_ids.size()) + " scanners, press any key to exit.");
+                    scanner_event_sink->SetNotificationHandler(nullptr);
+                    scanner_event_sink->SetCaptureHandler(nullptr);
+                    scanner_event_sink->SetPnpHandler(nullptr);
+
+                    ModeMetrics metrics = manager.Metrics();
+                    cout << metrics.switches_sent << " mode switches sent, " << metrics.switches_skipped << " skipped, "
+                         << metrics.notifications << " mode notifications" << endl;
+                    for (size_t i = 0; i < scanner_ids.size(); i++)
+                    {
+                        cout << "Scanner ID:[" << scanner_ids[i] << "] in " << ModeName(manager.ModeOf(scanner_ids[i]))
+                             << " mode, switch to notification median " << Median(manager.SwitchLatencies(scanner_ids[i])) << " ms" << endl;
+                    }
+                }
+                ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+            }
+            global_interface_table->RevokeInterfaceFromGlobal(scanner_interface_cookie);
+        }
+        else
+        {
+            cout << "CoreScanner interface registration in the global interface table - Failed" << endl;
+        }
+        if (global_interface_table != NULL)
+        {
+            global_interface_table->Release();
+        }
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,227 @@
+/*******************************************************************************************
+* @file mock_provisioning_host.h
+* @brief Simulated CoreScanner host with many scanners answering the provisioning commands
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+
+/**
+* Simulated CoreScanner host with the ICoreScanner::ExecCommand signature, used to benchmark
+* provisioning without hardware. Every command takes command_latency_ms of real time; commands to
+* different scanners overlap, like commands sent to several scanners from several threads.
+* RSM_ATTR_STORE costs one flash write per command, whatever the number of attributes.
+**/
+class MockProvisioningHost
+{
+public:
+    static const LONG kStatusFailed = 1;
+
+    /**
+    * Simulated scanner
+    **/
+    struct Device
+    {
+        int scanner_id;
+        std::string serial_number;
+        std::string model_number;
+        std::map<int, Attribute> current;       // Values in use
+        std::map<int, Attribute> persisted;     // Values restored at power up
+        std::string decode_tone;
+        long flash_writes;
+        long tone_updates;
+    };
+
+    /**
+    * Mock host constructor
+    * @param command_latency_ms - Time each command takes
+    */
+    explicit MockProvisioningHost(int command_latency_ms = 5)
+        : command_latency_ms_(command_latency_ms), command_count_(0)
+    {
+    }
+
+    /**
+    * Add a scanner
+    * @param attributes - Initial (persisted) attribute values
+    * return value : Scanner id
+    */
+    int AddScanner(const std::string& model_number, const std::string& serial_number, const std::vector<Attribute>& attributes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Device device;
+        device.scanner_id = (int)devices_.size() + 1;
+        device.serial_number = serial_number;
+        device.model_number = model_number;
+        for (size_t i = 0; i < attributes.size(); i++)
+        {
+            device.current[attributes[i].id] = attributes[i];
+        }
+        device.persisted = device.current;
+        device.flash_writes = 0;
+        device.tone_updates = 0;
+        devices_.push_back(device);
+        return device.scanner_id;
+    }
+
+    Device Scanner(int scanner_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return devices_[scanner_id - 1];
+    }
+
+    long CommandCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return command_count_;
+    }
+
+    long FlashWriteCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        long count = 0;
+        for (size_t i = 0; i < devices_.size(); i++)
+        {
+            count += devices_[i].flash_writes;
+        }
+        return count;
+    }
+
+    long ToneUpdateCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        long count = 0;
+        for (size_t i = 0; i < devices_.size(); i++)
+        {
+            count += devices_[i].tone_updates;
+        }
+        return count;
+    }
+
+    /**
+    * Scanner list in the format of the GetScanners() outXml
+    */
+    std::string ScannersXml() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><scanners>";
+        for (size_t i = 0; i < devices_.size(); i++)
+        {
+            xml += "<scanner type=\"SNAPI\"><scannerID>" + std::to_string(devices_[i].scanner_id) +
+                "</scannerID><serialnumber>" + devices_[i].serial_number +
+                "</serialnumber><modelnumber>" + devices_[i].model_number + "</modelnumber></scanner>";
+        }
+        xml += "</scanners>";
+        return xml;
+    }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        *out_xml = NULL;
+        *status = kStatusFailed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(command_latency_ms_));
+
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        std::string value;
+        if (!XmlFindText(in, "scannerID", &value))
+        {
+            return S_OK;
+        }
+        int scanner_id = atoi(value.c_str());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        command_count_++;
+        if (scanner_id < 1 || scanner_id > (int)devices_.size())
+        {
+            return S_OK;
+        }
+        Device& device = devices_[scanner_id - 1];
+
+        switch (opcode)
+        {
+        case RSM_ATTR_GET:
+        {
+            if (!XmlFindText(in, "attrib_list", &value))
+            {
+                return S_OK;
+            }
+            std::string out = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><scannerID>" + std::to_string(scanner_id) +
+                "</scannerID><arg-xml><modelnumber>" + device.model_number + "</modelnumber><serialnumber>" +
+                device.serial_number + "</serialnumber><response><opcode>5001</opcode><attrib_list>";
+            const char* ids = value.c_str();
+            char* end = NULL;
+            for (long id = strtol(ids, &end, 10); end != ids; id = strtol(ids, &end, 10))
+            {
+                std::map<int, Attribute>::const_iterator it = device.current.find((int)id);
+                if (it != device.current.end())
+                {
+                    out += "<attribute><id>" + std::to_string(id) + "</id><datatype>" + std::string(1, it->second.datatype) +
+                        "</datatype><permission>7</permission><value>";
+                    XmlAppendEscaped(&out, it->second.value);
+                    out += "</value></attribute>";
+                }
+                ids = (*end == ',') ? end + 1 : end;
+            }
+            out += "</attrib_list></response></arg-xml></outArgs>";
+            std::wstring out_str(out.begin(), out.end());
+            *out_xml = SysAllocString(out_str.c_str());
+            break;
+        }
+        case RSM_ATTR_SET:
+        case RSM_ATTR_STORE:
+        {
+            AttributeResponse attributes;
+            if (!AttributeResponse::Parse(in, &attributes))
+            {
+                return S_OK;
+            }
+            for (size_t i = 0; i < attributes.attributes.size(); i++)
+            {
+                device.current[attributes.attributes[i].id] = attributes.attributes[i];
+                if (opcode == RSM_ATTR_STORE)
+                {
+                    device.persisted[attributes.attributes[i].id] = attributes.attributes[i];
+                }
+            }
+            if (opcode == RSM_ATTR_STORE)
+            {
+                device.flash_writes++;
+            }
+            break;
+        }
+        case UPDATE_DECODE_TONE:
+            if (!XmlFindText(in, "arg-string", &device.decode_tone))
+            {
+                return S_OK;
+            }
+            device.tone_updates++;
+            device.flash_writes++;
+            break;
+        default:
+            return S_OK;
+        }
+        *status = STATUS_SUCCESS;
+        return S_OK;
+    }
+
+private:
+    int command_latency_ms_;
+    mutable std::mutex mutex_;
+    std::vector<Device> devices_;
+    long command_count_;
+};
@@ -0,0 +1,264 @@
+/*******************************************************************************************
+* @file provisioning_engine.h
+* @brief Brings scanners to the state of a provisioning profile with a minimal, grouped command plan
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "opcode_traits.h"
+#include "provisioning_profile.h"
+
+/**
+* Scanner to provision
+**/
+struct ProvisioningTarget
+{
+    int scanner_id;
+    std::string serial_number;
+    std::string model_number;
+};
+
+/**
+* Commands needed to bring one scanner to the profile state
+**/
+struct ProvisioningPlan
+{
+    ProvisioningTarget target;
+    bool read;                          // Live attributes were read
+    bool update_tone;                   // UPDATE_DECODE_TONE
+    std::vector<Attribute> store;       // One RSM_ATTR_STORE (single flash write)
+    std::vector<Attribute> set;         // One RSM_ATTR_SET
+    bool succeeded;                     // Plan executed without errors
+    LONG status;                        // Status of the failed command
+
+    ProvisioningPlan() : read(false), update_tone(false), succeeded(false), status(STATUS_SUCCESS) {}
+
+    /**
+    * Commands the plan sends
+    */
+    int CommandCount() const { return (update_tone ? 1 : 0) + (store.empty() ? 0 : 1) + (set.empty() ? 0 : 1); }
+};
+
+/**
+* Declarative scanner provisioning.
+*
+* Plan() reads the live value of every attribute of the profile with one RSM_ATTR_GET per scanner
+* and keeps only the attributes that differ, so running a profile again on provisioned scanners
+* sends nothing but the reads. The plan of a scanner has at most three commands, sent in this order:
+* UPDATE_DECODE_TONE (when the journal shows another tone), one RSM_ATTR_STORE with every
+* persistent change (one flash write instead of one per attribute) and one RSM_ATTR_SET with
+* the changes that do not survive a power cycle. Nothing in a plan reboots the scanner.
+*
+* RSM_ATTR_GET returns the current value of an attribute, not the value in flash. A [store]
+* attribute that was earlier set with RSM_ATTR_SET (or a [set] section) to its target value
+* reads back as provisioned and is not stored, so it reverts on the next power cycle. Run
+* such profiles on freshly power cycled scanners.
+*
+* Reads and plans run in parallel on a pool of worker threads, one scanner per worker at a time.
+* Each worker gets its own scanner interface from attach() on the worker thread (for COM, a
+* marshalled ICoreScanner), and hands it back through detach().
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommand signature (e.g. MockProvisioningHost)
+**/
+template <typename Scanner>
+class ProvisioningEngine
+{
+public:
+    typedef std::function<Scanner*(int worker)> AttachFunction;
+    typedef std::function<void(int worker, Scanner* scanner)> DetachFunction;
+
+    /**
+    * Provisioning engine constructor
+    * @param profile - Desired state
+    * @param journal - Decode tones deployed so far (updated by Execute())
+    * @param worker_count - Scanners provisioned at the same time
+    * @param attach - Called on each worker thread to get its scanner interface
+    * @param detach - Called on each worker thread when it is done (optional)
+    */
+    ProvisioningEngine(const ProvisioningProfile& profile, ToneJournal* journal, int worker_count,
+        const AttachFunction& attach, const DetachFunction& detach = DetachFunction())
+        : profile_(profile), journal_(journal), worker_count_(worker_count < 1 ? 1 : worker_count),
+          attach_(attach), detach_(detach), command_count_(0)
+    {
+        for (size_t i = 0; i < profile_.store_attributes.size(); i++)
+        {
+            attribute_ids_.push_back(profile_.store_attributes[i].id);
+        }
+        for (size_t i = 0; i < profile_.set_attributes.size(); i++)
+        {
+            attribute_ids_.push_back(profile_.set_attributes[i].id);
+        }
+    }
+
+    /**
+    * Compute the plans of the scanners the profile matches
+    * @param targets - Connected scanners
+    * return value : One plan per matching scanner
+    */
+    std::vector<ProvisioningPlan> Plan(const std::vector<ProvisioningTarget>& targets)
+    {
+        std::vector<ProvisioningPlan> plans;
+        for (size_t i = 0; i < targets.size(); i++)
+        {
+            if (profile_.Matches(targets[i].model_number, targets[i].serial_number))
+            {
+                ProvisioningPlan plan;
+                plan.target = targets[i];
+                plans.push_back(plan);
+            }
+        }
+        ForEach(plans.size(), [this, &plans](Scanner* scanner, size_t index) { PlanScanner(scanner, &plans[index]); });
+        return plans;
+    }
+
+    /**
+    * Execute plans
+    * @param plans - Plans from Plan(), updated with the outcome
+    * return value : Number of scanners in the profile state
+    */
+    int Execute(std::vector<ProvisioningPlan>* plans)
+    {
+        ForEach(plans->size(), [this, plans](Scanner* scanner, size_t index) { ExecutePlan(scanner, &(*plans)[index]); });
+        int provisioned = 0;
+        for (size_t i = 0; i < plans->size(); i++)
+        {
+            provisioned += (*plans)[i].succeeded ? 1 : 0;
+        }
+        return provisioned;
+    }
+
+    /**
+    * Commands sent so far, reads included
+    */
+    long CommandCount() const { return command_count_; }
+
+private:
+    /**
+    * Run a function for items 0 .. count - 1 on the worker pool
+    */
+    void ForEach(size_t count, const std::function<void(Scanner* scanner, size_t index)>& function)
+    {
+        std::atomic<size_t> next_index(0);
+        std::vector<std::thread> workers;
+        int thread_count = (int)std::min<size_t>(worker_count_, count);
+        for (int worker = 0; worker < thread_count; worker++)
+        {
+            workers.push_back(std::thread([this, worker, count, &next_index, &function]()
+            {
+                Scanner* scanner = attach_(worker);
+                size_t index;
+                while (scanner != NULL && (index = next_index++) < count)
+                {
+                    function(scanner, index);
+                }
+                if (detach_)
+                {
+                    detach_(worker, scanner);
+                }
+            }));
+        }
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            workers[i].join();
+        }
+    }
+
+    /**
+    * Read the live attributes of a scanner and keep the settings that differ (the read cannot
+    * tell a stored value from a value set until power cycle, see the class comment)
+    */
+    void PlanScanner(Scanner* scanner, ProvisioningPlan* plan)
+    {
+        plan->update_tone = profile_.decode_tone_hash != 0 &&
+            journal_->ToneOf(plan->target.serial_number) != profile_.decode_tone_hash;
+        if (attribute_ids_.empty())
+        {
+            plan->read = true;
+            return;
+        }
+
+        CommandResult<AttributeResponse> result = Exec<RSM_ATTR_GET>(scanner, plan->target.scanner_id, attribute_ids_);
+        command_count_++;
+        if (!result.Succeeded() || !result.parsed)
+        {
+            plan->status = result.status;
+            return;
+        }
+        plan->read = true;
+
+        std::map<int, const Attribute*> live;
+        for (size_t i = 0; i < result.response.attributes.size(); i++)
+        {
+            live[result.response.attributes[i].id] = &result.response.attributes[i];
+        }
+        Diff(profile_.store_attributes, live, &plan->store);
+        Diff(profile_.set_attributes, live, &plan->set);
+    }
+
+    /**
+    * Desired settings whose live value differs (or could not be read)
+    */
+    static void Diff(const std::vector<AttributeSetting>& desired, const std::map<int, const Attribute*>& live, std::vector<Attribute>* changes)
+    {
+        for (size_t i = 0; i < desired.size(); i++)
+        {
+            std::map<int, const Attribute*>::const_iterator it = live.find(desired[i].id);
+            if (it == live.end() || !AttributeValuesEqual(desired[i].datatype, it->second->value, desired[i].value))
+            {
+                Attribute attribute = { desired[i].id, desired[i].datatype, desired[i].value };
+                changes->push_back(attribute);
+            }
+        }
+    }
+
+    /**
+    * Send the commands of a plan, stopping at the first failure
+    */
+    void ExecutePlan(Scanner* scanner, ProvisioningPlan* plan)
+    {
+        if (!plan->read)
+        {
+            return;
+        }
+        if (plan->update_tone)
+        {
+            if (!Sent(plan, Exec<UPDATE_DECODE_TONE>(scanner, plan->target.scanner_id, profile_.decode_tone_file)))
+            {
+                return;
+            }
+            journal_->Record(plan->target.serial_number, profile_.decode_tone_hash);
+        }
+        if (!plan->store.empty() && !Sent(plan, Exec<RSM_ATTR_STORE>(scanner, plan->target.scanner_id, plan->store)))
+        {
+            return;
+        }
+        if (!plan->set.empty() && !Sent(plan, Exec<RSM_ATTR_SET>(scanner, plan->target.scanner_id, plan->set)))
+        {
+            return;
+        }
+        plan->succeeded = true;
+    }
+
+    bool Sent(ProvisioningPlan* plan, const CommandResult<NoResponse>& result)
+    {
+        command_count_++;
+        plan->status = result.status;
+        return result.Succeeded();
+    }
+
+    const ProvisioningProfile& profile_;
+    ToneJournal* journal_;
+    int worker_count_;
+    AttachFunction attach_;
+    DetachFunction detach_;
+    std::vector<int> attribute_ids_;
+    std::atomic<long> command_count_;
+};
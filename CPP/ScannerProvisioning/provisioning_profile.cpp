@@ -0,0 +1,332 @@
+/*******************************************************************************************
+* @file provisioning_profile.cpp
+* @brief Definition of provisioning profile parsing and decode tone journal
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "provisioning_profile.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+/**
+* Remove leading and trailing white space
+**/
+static string Trim(const string& text)
+{
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && isspace((unsigned char)text[begin]))
+    {
+        begin++;
+    }
+    while (end > begin && isspace((unsigned char)text[end - 1]))
+    {
+        end--;
+    }
+    return text.substr(begin, end - begin);
+}
+
+/**
+* Case insensitive compare
+**/
+static bool EqualsIgnoreCase(const string& a, const string& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+* Add or replace an attribute setting in a list
+**/
+static void PutAttribute(vector<AttributeSetting>* attributes, const AttributeSetting& attribute)
+{
+    for (size_t i = 0; i < attributes->size(); i++)
+    {
+        if ((*attributes)[i].id == attribute.id)
+        {
+            (*attributes)[i] = attribute;
+            return;
+        }
+    }
+    attributes->push_back(attribute);
+}
+
+/**
+* Remove an attribute from a list
+**/
+static void DropAttribute(vector<AttributeSetting>* attributes, int id)
+{
+    for (size_t i = 0; i < attributes->size(); i++)
+    {
+        if ((*attributes)[i].id == id)
+        {
+            attributes->erase(attributes->begin() + i);
+            return;
+        }
+    }
+}
+
+bool ProvisioningProfile::Matches(const string& model_number, const string& serial_number) const
+{
+    if (model_patterns.empty() && serial_numbers.empty())
+    {
+        return true;
+    }
+    for (size_t i = 0; i < serial_numbers.size(); i++)
+    {
+        if (serial_numbers[i] == serial_number)
+        {
+            return true;
+        }
+    }
+    for (size_t i = 0; i < model_patterns.size(); i++)
+    {
+        const string& pattern = model_patterns[i];
+        if (!pattern.empty() && pattern[pattern.size() - 1] == '*')
+        {
+            if (model_number.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0)
+            {
+                return true;
+            }
+        }
+        else if (pattern == model_number)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseProvisioningProfile(const string& text, ProvisioningProfile* profile, string* error)
+{
+    *profile = ProvisioningProfile();
+    istringstream input(text);
+    string line;
+    string section;
+    int line_number = 0;
+    while (getline(input, line))
+    {
+        line_number++;
+        // '#' inside a value (e.g. an ADF rule or a string attribute) is not a comment
+        for (size_t i = 0; i < line.size(); i++)
+        {
+            if (line[i] == '#' && (i == 0 || isspace((unsigned char)line[i - 1])))
+            {
+                line.erase(i);
+                break;
+            }
+        }
+        line = Trim(line);
+        if (line.empty())
+        {
+            continue;
+        }
+
+        if (line[0] == '[' && line[line.size() - 1] == ']')
+        {
+            section = Trim(line.substr(1, line.size() - 2));
+            if (section != "match" && section != "set" && section != "store" && section != "decode_tone")
+            {
+                *error = "line " + to_string(line_number) + ": unknown section [" + section + "]";
+                return false;
+            }
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == string::npos || section.empty())
+        {
+            *error = "line " + to_string(line_number) + ": expected key = value inside a section";
+            return false;
+        }
+        string key = Trim(line.substr(0, equals));
+        string value = Trim(line.substr(equals + 1));
+
+        if (section == "match" && key == "model")
+        {
+            profile->model_patterns.push_back(value);
+        }
+        else if (section == "match" && key == "serial")
+        {
+            profile->serial_numbers.push_back(value);
+        }
+        else if (section == "decode_tone" && key == "file")
+        {
+            profile->decode_tone_file = value;
+        }
+        else if (section == "set" || section == "store")
+        {
+            char* end = NULL;
+            long id = strtol(key.c_str(), &end, 0);
+            if (key.empty() || *end != '\0' || id < 0 || value.empty() || strchr("BCFWDILSAX", value[0]) == NULL ||
+                (value.size() > 1 && !isspace((unsigned char)value[1])))
+            {
+                *error = "line " + to_string(line_number) + ": expected <id> = <datatype> <value>";
+                return false;
+            }
+            AttributeSetting attribute = { (int)id, value[0], Trim(value.substr(1)) };
+            if (section == "set")
+            {
+                PutAttribute(&profile->set_attributes, attribute);
+            }
+            else
+            {
+                PutAttribute(&profile->store_attributes, attribute);
+            }
+        }
+        else
+        {
+            *error = "line " + to_string(line_number) + ": unknown key " + key + " in [" + section + "]";
+            return false;
+        }
+    }
+
+    // A stored attribute is also the current value - do not send it twice
+    for (size_t i = 0; i < profile->store_attributes.size(); i++)
+    {
+        DropAttribute(&profile->set_attributes, profile->store_attributes[i].id);
+    }
+    return true;
+}
+
+bool LoadProvisioningProfile(const string& path, ProvisioningProfile* profile, string* error)
+{
+    ifstream file(path.c_str(), ios::binary);
+    if (!file)
+    {
+        *error = "cannot open " + path;
+        return false;
+    }
+    stringstream text;
+    text << file.rdbuf();
+    if (!ParseProvisioningProfile(text.str(), profile, error))
+    {
+        return false;
+    }
+
+    if (!profile->decode_tone_file.empty())
+    {
+        ifstream tone(profile->decode_tone_file.c_str(), ios::binary);
+        if (!tone)
+        {
+            *error = "cannot open decode tone " + profile->decode_tone_file;
+            return false;
+        }
+        unsigned long long hash = 14695981039346656037ULL;
+        char buffer[4096];
+        while (tone.read(buffer, sizeof(buffer)) || tone.gcount() > 0)
+        {
+            for (streamsize i = 0; i < tone.gcount(); i++)
+            {
+                hash = (hash ^ (unsigned char)buffer[i]) * 1099511628211ULL;
+            }
+        }
+        profile->decode_tone_hash = hash;
+    }
+    return true;
+}
+
+bool AttributeValuesEqual(char datatype, const string& live_value, const string& desired_value)
+{
+    switch (datatype)
+    {
+    case 'B':
+    case 'C':
+    case 'W':
+    case 'I':
+    case 'D':
+    case 'L':
+    {
+        char* live_end = NULL;
+        char* desired_end = NULL;
+        long long live = strtoll(live_value.c_str(), &live_end, 0);
+        long long desired = strtoll(desired_value.c_str(), &desired_end, 0);
+        if (*live_end == '\0' && *desired_end == '\0' && !live_value.empty() && !desired_value.empty())
+        {
+            return live == desired;
+        }
+        return live_value == desired_value;
+    }
+    case 'F':
+    {
+        bool live = EqualsIgnoreCase(live_value, "TRUE") || live_value == "1";
+        bool desired = EqualsIgnoreCase(desired_value, "TRUE") || desired_value == "1";
+        return live == desired;
+    }
+    default:
+        return live_value == desired_value;
+    }
+}
+
+bool ToneJournal::Load(const string& path)
+{
+    lock_guard<mutex> lock(mutex_);
+    path_ = path;
+    tones_.clear();
+    ifstream file(path.c_str());
+    if (!file)
+    {
+        return true;
+    }
+    string serial_number;
+    unsigned long long tone_hash;
+    while (file >> serial_number >> hex >> tone_hash)
+    {
+        tones_[serial_number] = tone_hash;
+    }
+    return true;
+}
+
+bool ToneJournal::Save() const
+{
+    lock_guard<mutex> lock(mutex_);
+    if (path_.empty())
+    {
+        return false;
+    }
+    string temp_path = path_ + ".tmp";
+    {
+        ofstream file(temp_path.c_str(), ios::trunc);
+        for (map<string, unsigned long long>::const_iterator it = tones_.begin(); it != tones_.end(); ++it)
+        {
+            file << it->first << " " << hex << it->second << "\n";
+        }
+        if (!file)
+        {
+            return false;
+        }
+    }
+    remove(path_.c_str());
+    return rename(temp_path.c_str(), path_.c_str()) == 0;
+}
+
+unsigned long long ToneJournal::ToneOf(const string& serial_number) const
+{
+    lock_guard<mutex> lock(mutex_);
+    map<string, unsigned long long>::const_iterator it = tones_.find(serial_number);
+    return it == tones_.end() ? 0 : it->second;
+}
+
+void ToneJournal::Record(const string& serial_number, unsigned long long tone_hash)
+{
+    lock_guard<mutex> lock(mutex_);
+    tones_[serial_number] = tone_hash;
+}
@@ -0,0 +1,113 @@
+/*******************************************************************************************
+* @file provisioning_profile.h
+* @brief Desired state profile of a group of scanners and journal of deployed decode tones
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+* Desired value of a scanner attribute
+**/
+struct AttributeSetting
+{
+    int id;
+    char datatype;      // B, C, F, W, D, I, S, L, A, X ...
+    std::string value;
+};
+
+/**
+* Desired state of the scanners a profile matches.
+*
+* Profile file format - sections of "key = value" lines, '#' at the start of a line or after
+* whitespace starts a comment (a '#' inside a value is kept):
+*
+*   [match]                 scanners the profile applies to (all scanners without this section)
+*   model = DS8178*         model number, '*' at the end matches any suffix (several lines allowed)
+*   serial = 19245010502314 serial number (several lines allowed)
+*
+*   [set]                   attributes set until the scanner power cycles (RSM_ATTR_SET)
+*   <id> = <datatype> <value>
+*
+*   [store]                 attributes written to flash (RSM_ATTR_STORE), see ProvisioningEngine
+*                           for attributes already set to the same value until power cycle
+*   <id> = <datatype> <value>
+*
+*   [decode_tone]
+*   file = C:\tones\lane.wav
+**/
+struct ProvisioningProfile
+{
+    std::vector<std::string> model_patterns;
+    std::vector<std::string> serial_numbers;
+    std::vector<AttributeSetting> set_attributes;
+    std::vector<AttributeSetting> store_attributes;
+    std::string decode_tone_file;
+    unsigned long long decode_tone_hash;    // FNV-1a of the tone file, 0 without a tone
+
+    ProvisioningProfile() : decode_tone_hash(0) {}
+
+    /**
+    * Check if the profile applies to a scanner
+    */
+    bool Matches(const std::string& model_number, const std::string& serial_number) const;
+};
+
+/**
+* Parse profile text
+* @param text - Profile file content
+* @param profile - Receives the profile (decode tone hash not set)
+* @param error - Receives a description of the first error
+* return value : true if the profile is valid
+*/
+bool ParseProvisioningProfile(const std::string& text, ProvisioningProfile* profile, std::string* error);
+
+/**
+* Load a profile file and hash its decode tone file
+* return value : true if the profile is valid and its tone file (if any) could be read
+*/
+bool LoadProvisioningProfile(const std::string& path, ProvisioningProfile* profile, std::string* error);
+
+/**
+* Compare a live attribute value with a desired one - numbers are compared by value
+* (1 = 0x01), booleans ignoring case, strings exactly
+*/
+bool AttributeValuesEqual(char datatype, const std::string& live_value, const std::string& desired_value);
+
+/**
+* Decode tone deployed to each scanner, by serial number. Decode tones cannot be read back from a
+* scanner, so the journal is what makes the tone step idempotent. Thread safe.
+**/
+class ToneJournal
+{
+public:
+    /**
+    * Load the journal ("<serial number> <tone hash>" lines); a missing file is an empty journal
+    */
+    bool Load(const std::string& path);
+
+    /**
+    * Save the journal to the file it was loaded from
+    */
+    bool Save() const;
+
+    /**
+    * Hash of the tone last deployed to a scanner, 0 if none
+    */
+    unsigned long long ToneOf(const std::string& serial_number) const;
+
+    /**
+    * Record a deployed tone
+    */
+    void Record(const std::string& serial_number, unsigned long long tone_hash);
+
+private:
+    std::string path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, unsigned long long> tones_;
+};
@@ -0,0 +1,482 @@
+/*******************************************************************************************
+* @file scanner_provisioning.cpp
+* @brief This file contains code snippet to provision scanners from a desired state profile
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "provisioning_profile.h"
+#include "provisioning_engine.h"
+#include "mock_provisioning_host.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+IGlobalInterfaceTable* global_interface_table = NULL;  // Hands the interface to provisioning workers
+DWORD scanner_interface_cookie = 0;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Profile used by the mock benchmark (the hardware run loads a profile file)
+*/
+const char* kSampleProfile =
+    "[match]\n"
+    "model = DS8178*\n"
+    "model = DS2278*\n"
+    "\n"
+    "[store]\n"
+    "140 = B 1      # Beeper volume\n"
+    "145 = B 2      # Beeper tone\n"
+    "1 = F TRUE\n"
+    "2 = F FALSE\n"
+    "\n"
+    "[set]\n"
+    "6 = F TRUE\n"
+    "\n"
+    "[decode_tone]\n"
+    "file = C:\\tones\\lane.wav\n";
+
+/*
+* Read scanner ids, serial numbers and model numbers from GetScanners() outXml
+*/
+void ParseProvisioningTargets(const string& scanners_xml, vector<ProvisioningTarget>* targets)
+{
+    XmlReader reader(scanners_xml);
+    while (reader.FindElement("scanner"))
+    {
+        int depth = reader.Depth();
+        ProvisioningTarget target = { 0, string(), string() };
+        XmlSlice text;
+        if (reader.FindChild("scannerID", depth) && reader.ReadElementText(&text))
+        {
+            target.scanner_id = (int)text.ToLong();
+        }
+        if (reader.FindChild("serialnumber", depth) && reader.ReadElementText(&text))
+        {
+            target.serial_number = text.ToString();
+        }
+        if (reader.FindChild("modelnumber", depth) && reader.ReadElementText(&text))
+        {
+            target.model_number = text.ToString();
+        }
+        if (target.scanner_id != 0)
+        {
+            targets->push_back(target);
+        }
+    }
+}
+
+/*
+* Get connected scanners with their serial and model numbers
+* @param targets - Receives the scanners
+* return value : GetScanners success/fail status
+*/
+bool GetProvisioningTargets(vector<ProvisioningTarget>* targets)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+    ParseProvisioningTargets(get_scanners_output_xml, targets);
+    cout << "CoreScanner GetScanners() - Success, " << targets->size() << " scanners" << endl;
+    return true;
+}
+
+/*
+* Give a provisioning worker thread its own CoreScanner interface from the global interface table
+*/
+ICoreScanner* AttachWorkerScanner(int worker)
+{
+    CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    ICoreScanner* worker_scanner = NULL;
+    HRESULT hr = global_interface_table->GetInterfaceFromGlobal(scanner_interface_cookie, IID_ICoreScanner, (void**)&worker_scanner);
+    if FAILED(hr)
+    {
+        cout << "CoreScanner interface unmarshaling for provisioning worker " << worker << " - Failed" << endl;
+        CoUninitialize();
+        return NULL;
+    }
+    return worker_scanner;
+}
+
+/*
+* Release the CoreScanner interface of a provisioning worker thread
+*/
+void DetachWorkerScanner(int worker, ICoreScanner* worker_scanner)
+{
+    if (worker_scanner != NULL)
+    {
+        worker_scanner->Release();
+        CoUninitialize();
+    }
+}
+
+/*
+* Print the command plan of each scanner
+*/
+void PrintPlans(const vector<ProvisioningPlan>& plans)
+{
+    for (size_t i = 0; i < plans.size(); i++)
+    {
+        const ProvisioningPlan& plan = plans[i];
+        cout << " Scanner " << plan.target.scanner_id << " (" << plan.target.model_number << " " << plan.target.serial_number << ") : ";
+        if (!plan.read)
+        {
+            cout << "attributes could not be read. Error Code : " << plan.status << endl;
+            continue;
+        }
+        if (plan.CommandCount() == 0)
+        {
+            cout << "already provisioned" << endl;
+            continue;
+        }
+        cout << (plan.update_tone ? "decode tone, " : "") << plan.store.size() << " stored, " << plan.set.size() << " set" << endl;
+    }
+}
+
+/*
+* Provision a fleet of mock scanners, some of them already provisioned, sending one command per
+* profile entry the way provisioning scripts did it and with the provisioning engine. The engine
+* then runs again to show that a provisioned fleet only costs the reads.
+*/
+void RunProvisioningBenchmark()
+{
+    const int kScannerCount = 32;
+    const int kWorkerCount = 8;
+    const char* kModels[] = { "DS8178-SR", "DS2278-SR", "DS8178-HC", "LI4278" };
+
+    ProvisioningProfile profile;
+    string error;
+    if (!ParseProvisioningProfile(kSampleProfile, &profile, &error))
+    {
+        cout << "Provisioning profile - Failed : " << error << endl;
+        return;
+    }
+    profile.decode_tone_hash = 0x6c616e652e776176ULL;   // The tone file is not read by the benchmark
+
+    vector<Attribute> provisioned;
+    vector<Attribute> defaults;
+    for (size_t i = 0; i < profile.store_attributes.size(); i++)
+    {
+        Attribute attribute = { profile.store_attributes[i].id, profile.store_attributes[i].datatype, profile.store_attributes[i].value };
+        provisioned.push_back(attribute);
+    }
+    for (size_t i = 0; i < profile.set_attributes.size(); i++)
+    {
+        Attribute attribute = { profile.set_attributes[i].id, profile.set_attributes[i].datatype, profile.set_attributes[i].value };
+        provisioned.push_back(attribute);
+    }
+    Attribute default_values[] = { { 140, 'B', "0" }, { 145, 'B', "1" }, { 1, 'F', "TRUE" }, { 2, 'F', "TRUE" }, { 6, 'F', "FALSE" } };
+    defaults.assign(default_values, default_values + sizeof(default_values) / sizeof(default_values[0]));
+
+    MockProvisioningHost scripted_host;
+    MockProvisioningHost engine_host;
+    ToneJournal journal;
+    for (int i = 0; i < kScannerCount; i++)
+    {
+        string serial_number = "MOCK" + to_string(100000 + i);
+        const vector<Attribute>& attributes = (i % 2 == 0) ? provisioned : defaults;
+        scripted_host.AddScanner(kModels[i % 4], serial_number, attributes);
+        engine_host.AddScanner(kModels[i % 4], serial_number, attributes);
+        if (i % 2 == 0)
+        {
+            journal.Record(serial_number, profile.decode_tone_hash);
+        }
+    }
+
+    // One command per profile entry, one scanner after the other
+    vector<ProvisioningTarget> targets;
+    ParseProvisioningTargets(scripted_host.ScannersXml(), &targets);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (size_t i = 0; i < targets.size(); i++)
+    {
+        if (!profile.Matches(targets[i].model_number, targets[i].serial_number))
+        {
+            continue;
+        }
+        Exec<UPDATE_DECODE_TONE>(&scripted_host, targets[i].scanner_id, profile.decode_tone_file);
+        for (size_t j = 0; j < profile.store_attributes.size(); j++)
+        {
+            const AttributeSetting& setting = profile.store_attributes[j];
+            Exec<RSM_ATTR_STORE>(&scripted_host, targets[i].scanner_id, vector<Attribute>(1, Attribute{ setting.id, setting.datatype, setting.value }));
+        }
+        for (size_t j = 0; j < profile.set_attributes.size(); j++)
+        {
+            const AttributeSetting& setting = profile.set_attributes[j];
+            Exec<RSM_ATTR_SET>(&scripted_host, targets[i].scanner_id, vector<Attribute>(1, Attribute{ setting.id, setting.datatype, setting.value }));
+        }
+    }
+    double scripted_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // Provisioning engine - one read per scanner, grouped commands, kWorkerCount scanners at a time
+    ProvisioningEngine<MockProvisioningHost> engine(profile, &journal, kWorkerCount,
+        [&engine_host](int worker) { return &engine_host; });
+    targets.clear();
+    ParseProvisioningTargets(engine_host.ScannersXml(), &targets);
+    start = chrono::steady_clock::now();
+    vector<ProvisioningPlan> plans = engine.Plan(targets);
+    int already_provisioned = 0;
+    for (size_t i = 0; i < plans.size(); i++)
+    {
+        already_provisioned += (plans[i].CommandCount() == 0) ? 1 : 0;
+    }
+    int provisioned_count = engine.Execute(&plans);
+    double engine_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    long engine_commands = engine_host.CommandCount();
+    long engine_flash_writes = engine_host.FlashWriteCount();
+
+    start = chrono::steady_clock::now();
+    vector<ProvisioningPlan> again = engine.Plan(targets);
+    int again_commands = 0;
+    for (size_t i = 0; i < again.size(); i++)
+    {
+        again_commands += again[i].CommandCount();
+    }
+    double again_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "Provisioning of " << kScannerCount << " mock scanners (" << plans.size() << " match the profile, "
+         << already_provisioned << " already provisioned)" << endl;
+    cout << " One command per profile entry : " << scripted_ms << " ms, " << scripted_host.CommandCount() << " commands, "
+         << scripted_host.FlashWriteCount() << " flash writes" << endl;
+    cout << " Provisioning engine           : " << engine_ms << " ms, " << engine_commands << " commands, "
+         << engine_flash_writes << " flash writes, " << provisioned_count << "/" << plans.size() << " provisioned" << endl;
+    cout << " Provisioning engine, again    : " << again_ms << " ms, " << engine_host.CommandCount() - engine_commands
+         << " reads, " << again_commands << " commands planned" << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+* Usage : scanner_provisioning [profile file] (lane_profile.ini by default)
+*/
+int main(int argc, char* argv[])
+{
+    RunProvisioningBenchmark();
+    cout << " " << endl;
+
+    const int kWorkerCount = 4;
+    string profile_path = (argc > 1) ? argv[1] : "lane_profile.ini";
+    ProvisioningProfile profile;
+    string error;
+    if (!LoadProvisioningProfile(profile_path, &profile, &error))
+    {
+        cout << "Provisioning profile " << profile_path << " - Failed : " << error << endl;
+        WaitForInput("Press any key to exit.");
+        return false;
+    }
+
+    if (!InitializeCOM())
+        return false;
+
+    vector<ProvisioningTarget> targets;
+    if (Open() && GetProvisioningTargets(&targets))
+    {
+        CoCreateInstance(CLSID_StdGlobalInterfaceTable, NULL, CLSCTX_INPROC_SERVER, IID_IGlobalInterfaceTable, (void**)&global_interface_table);
+        if (global_interface_table != NULL &&
+            SUCCEEDED(global_interface_table->RegisterInterfaceInGlobal(scanner_interface, IID_ICoreScanner, &scanner_interface_cookie)))
+        {
+            ToneJournal journal;
+            journal.Load(profile_path + ".tones");
+            ProvisioningEngine<ICoreScanner> engine(profile, &journal, kWorkerCount, AttachWorkerScanner, DetachWorkerScanner);
+
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            vector<ProvisioningPlan> plans = engine.Plan(targets);
+            cout << "Provisioning plan for " << plans.size() << " scanners" << endl;
+            PrintPlans(plans);
+            int provisioned = engine.Execute(&plans);
+            journal.Save();
+            cout << "Provisioning - " << provisioned << "/" << plans.size() << " scanners provisioned ("
+                 << engine.CommandCount() << " commands, "
+                 << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms)" << endl;
+            for (size_t i = 0; i < plans.size(); i++)
+            {
+                if (plans[i].read && !plans[i].succeeded)
+                {
+                    cout << " Scanner " << plans[i].target.scanner_id << " - Failed. Error Code : " << plans[i].status << endl;
+                }
+            }
+
+            global_interface_table->RevokeInterfaceFromGlobal(scanner_interface_cookie);
+        }
+        else
+        {
+            cout << "CoreScanner interface registration in the global interface table - Failed" << endl;
+        }
+        if (global_interface_table != NULL)
+        {
+            global_interface_table->Release();
+        }
+    }
+    Close();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
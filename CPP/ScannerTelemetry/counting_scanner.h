@@ -0,0 +1,31 @@
+/*******************************************************************************************
+* @file counting_scanner.h
+* @brief ExecCommand wrapper counting command results
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include "scanner_metrics.h"
+
+/**
+* ICoreScanner stand in that counts every command, for Exec<Op>() and other code
+* templated on the scanner type
+**/
+template <typename Scanner>
+class CountingScanner
+{
+public:
+    CountingScanner(Scanner* scanner, ScannerMetrics* metrics) : scanner_(scanner), metrics_(metrics) {}
+
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        HRESULT hr = scanner_->ExecCommand(opcode, in_xml, out_xml, status);
+        metrics_->CountCommand(opcode, hr, *status);
+        return hr;
+    }
+
+private:
+    Scanner* scanner_;
+    ScannerMetrics* metrics_;
+};
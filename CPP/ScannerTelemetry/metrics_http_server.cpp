@@ -0,0 +1,159 @@
+/*******************************************************************************************
+* @file metrics_http_server.cpp
+* @brief Definition of local Prometheus metrics endpoint
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <chrono>
+#include <string>
+#include "metrics_http_server.h"
+
+#pragma comment(lib, "ws2_32.lib")
+
+using namespace std;
+
+static const DWORD kClientTimeoutMs = 2000;     // A client that stalls longer is dropped
+static const int kMaxAcceptBackoffMs = 1000;    // Ceiling of the delay after failed accept() calls
+
+MetricsHttpServer::MetricsHttpServer(const Telemetry& telemetry)
+    : telemetry_(telemetry), listen_socket_((uintptr_t)INVALID_SOCKET), running_(false), scrape_count_(0)
+{
+}
+
+MetricsHttpServer::~MetricsHttpServer()
+{
+    Stop();
+}
+
+bool MetricsHttpServer::Start(unsigned short port)
+{
+    if (running_)
+    {
+        return false;
+    }
+
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+    {
+        return false;
+    }
+
+    SOCKET listen_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listen_socket == INVALID_SOCKET)
+    {
+        WSACleanup();
+        return false;
+    }
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (bind(listen_socket, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR || listen(listen_socket, 8) == SOCKET_ERROR)
+    {
+        closesocket(listen_socket);
+        WSACleanup();
+        return false;
+    }
+
+    listen_socket_ = (uintptr_t)listen_socket;
+    running_ = true;
+    thread_ = thread(&MetricsHttpServer::Serve, this);
+    return true;
+}
+
+void MetricsHttpServer::Stop()
+{
+    if (!running_)
+    {
+        return;
+    }
+    running_ = false;
+    // Closing the listening socket makes the blocked accept() return; a client being answered
+    // is dropped after at most kClientTimeoutMs
+    shutdown((SOCKET)listen_socket_, SD_BOTH);
+    closesocket((SOCKET)listen_socket_);
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+    listen_socket_ = (uintptr_t)INVALID_SOCKET;
+    WSACleanup();
+}
+
+/**
+* Accept loop
+**/
+void MetricsHttpServer::Serve()
+{
+    int backoff_ms = 0;
+    while (running_)
+    {
+        SOCKET client = accept((SOCKET)listen_socket_, NULL, NULL);
+        if (client == INVALID_SOCKET)
+        {
+            // Transient failures (e.g. WSAENOBUFS, WSAEMFILE) repeat at once - back off instead of spinning
+            if (running_)
+            {
+                backoff_ms = backoff_ms == 0 ? 10 : (backoff_ms * 2 > kMaxAcceptBackoffMs ? kMaxAcceptBackoffMs : backoff_ms * 2);
+                this_thread::sleep_for(chrono::milliseconds(backoff_ms));
+            }
+            continue;
+        }
+        backoff_ms = 0;
+        // Requests are answered on this thread - a client that connects and stalls must not hold it
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, (const char*)&kClientTimeoutMs, sizeof(kClientTimeoutMs));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, (const char*)&kClientTimeoutMs, sizeof(kClientTimeoutMs));
+        Answer((uintptr_t)client);
+        closesocket(client);
+    }
+}
+
+/**
+* Read one request and answer it
+**/
+void MetricsHttpServer::Answer(uintptr_t client)
+{
+    // Only the request line matters - read until the end of the headers
+    string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == string::npos && request.size() < 8192)
+    {
+        int received = recv((SOCKET)client, buffer, sizeof(buffer), 0);
+        if (received <= 0)
+        {
+            return;
+        }
+        request.append(buffer, received);
+    }
+
+    string status = "200 OK";
+    string body;
+    if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 13, "GET /metrics?") == 0)
+    {
+        body = telemetry_.PrometheusText();
+        scrape_count_++;
+    }
+    else
+    {
+        status = "404 Not Found";
+        body = "Not found\n";
+    }
+
+    string response = "HTTP/1.0 " + status + "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+        to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    size_t sent = 0;
+    while (sent < response.size())
+    {
+        int count = send((SOCKET)client, response.data() + sent, (int)(response.size() - sent), 0);
+        if (count <= 0)
+        {
+            break;
+        }
+        sent += count;
+    }
+}
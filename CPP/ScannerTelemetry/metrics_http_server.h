@@ -0,0 +1,63 @@
+/*******************************************************************************************
+* @file metrics_http_server.h
+* @brief Local HTTP endpoint serving telemetry counters in Prometheus text format
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "telemetry.h"
+
+/**
+* Minimal HTTP/1.0 server on the loopback interface answering GET /metrics.
+* Requests are served one at a time on a background thread; each scrape aggregates the
+* telemetry slots, so the decode path never waits for the exporter. A client that stalls is
+* dropped after a receive/send timeout, so it cannot block other scrapes or Stop().
+**/
+class MetricsHttpServer
+{
+public:
+    /**
+    * Metrics server constructor
+    * @param telemetry - Counters to export (must outlive the server)
+    */
+    explicit MetricsHttpServer(const Telemetry& telemetry);
+
+    /**
+    * Metrics server destructor - stops the server
+    */
+    ~MetricsHttpServer();
+
+    MetricsHttpServer(const MetricsHttpServer&) = delete;
+    MetricsHttpServer& operator=(const MetricsHttpServer&) = delete;
+
+    /**
+    * Listen on 127.0.0.1
+    * @param port - TCP port
+    * return value : true if listening
+    */
+    bool Start(unsigned short port);
+
+    /**
+    * Stop listening and wait for the server thread
+    */
+    void Stop();
+
+    /**
+    * Number of scrapes answered
+    */
+    long ScrapeCount() const { return scrape_count_; }
+
+private:
+    void Serve();
+    void Answer(uintptr_t client);
+
+    const Telemetry& telemetry_;
+    uintptr_t listen_socket_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<long> scrape_count_;
+};
@@ -0,0 +1,52 @@
+/*******************************************************************************************
+* @file scanner_metrics.cpp
+* @brief Definition of CoreScanner decode and command counters
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "scanner_metrics.h"
+#include "xml_reader.h"
+
+using namespace std;
+
+static const int kMaxSymbology = 256;
+static const int kMaxCommandResults = 512;  // Distinct opcode/status pairs
+
+ScannerMetrics::ScannerMetrics(Telemetry* telemetry)
+    : telemetry_(telemetry)
+{
+    decodes_ = telemetry->AddCounter("scanner_decodes_total", "Good decodes per scanner", "scanner", MAX_NUM_DEVICES + 1);
+    symbology_decodes_ = telemetry->AddCounter("scanner_symbology_decodes_total", "Good decodes per symbology", "symbology", kMaxSymbology);
+    decode_failures_ = telemetry->AddCounter("scanner_decode_failures_total", "Scan data events that were not a good decode", "scanner", MAX_NUM_DEVICES + 1);
+    commands_ = telemetry->AddKeyedCounter("scanner_commands_total", "ExecCommand results per opcode and status", "opcode", "status", kMaxCommandResults);
+    command_com_failures_ = telemetry->AddCounter("scanner_command_com_failures_total", "ExecCommand calls that failed in COM");
+}
+
+void ScannerMetrics::CountScanData(short event_type, const string& scan_data)
+{
+    int scanner_id = 0;
+    int symbology = 0;
+    XmlReader reader(scan_data);
+    XmlReader::Token token;
+    while ((token = reader.Next()) != XmlReader::kEndOfDocument)
+    {
+        if (token != XmlReader::kStartElement)
+        {
+            continue;
+        }
+        XmlSlice name = reader.Name();
+        XmlSlice text;
+        if (scanner_id == 0 && name.Equals("scannerID") && reader.ReadElementText(&text))
+        {
+            scanner_id = (int)text.ToLong();
+        }
+        else if (name.Equals("datatype") && reader.ReadElementText(&text))
+        {
+            symbology = (int)text.ToLong();
+            break;
+        }
+    }
+    CountDecode(scanner_id, symbology, event_type == BARCODE_EVENT_TYPE_GOOD_DECODE);
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************************
+* @file scanner_metrics.h
+* @brief CoreScanner decode and command counters on top of Telemetry
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <string>
+#include "common_defs.h"
+#include "telemetry.h"
+
+/**
+* Scanner counter families:
+*   scanner_decodes_total{scanner}            good decodes per scanner
+*   scanner_symbology_decodes_total{symbology} good decodes per symbology (ST_* value)
+*   scanner_decode_failures_total{scanner}    scan data events that were not a good decode
+*   scanner_commands_total{opcode,status}     ExecCommand results per opcode and status code
+*   scanner_command_com_failures_total        ExecCommand calls that returned a failed HRESULT
+**/
+class ScannerMetrics
+{
+public:
+    /**
+    * Scanner metrics constructor - defines the counter families
+    * @param telemetry - Counter registry (must outlive the metrics)
+    */
+    explicit ScannerMetrics(Telemetry* telemetry);
+
+    /**
+    * Count a decode
+    * @param scanner_id - Scanner that decoded
+    * @param symbology - Symbology (ST_*) of the label
+    * @param good_decode - false for a failed decode
+    */
+    void CountDecode(int scanner_id, int symbology, bool good_decode)
+    {
+        if (good_decode)
+        {
+            telemetry_->Increment(decodes_, scanner_id);
+            telemetry_->Increment(symbology_decodes_, symbology);
+        }
+        else
+        {
+            telemetry_->Increment(decode_failures_, scanner_id);
+        }
+    }
+
+    /**
+    * Count a scan data event from its xml (scannerID and datatype)
+    * @param event_type - Barcode event type (BARCODE_EVENT_TYPE_GOOD_DECODE for a decode)
+    * @param scan_data - Scan data event xml
+    */
+    void CountScanData(short event_type, const std::string& scan_data);
+
+    /**
+    * Count an ExecCommand result
+    */
+    void CountCommand(long opcode, long hr, long status)
+    {
+        if (hr < 0)
+        {
+            telemetry_->Increment(command_com_failures_);
+            return;
+        }
+        telemetry_->Increment(commands_, (int)opcode, (int)status, 1);
+    }
+
+private:
+    Telemetry* telemetry_;
+    int decodes_;
+    int symbology_decodes_;
+    int decode_failures_;
+    int commands_;
+    int command_com_failures_;
+};
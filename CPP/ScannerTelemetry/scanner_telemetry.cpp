@@ -0,0 +1,356 @@
+/*******************************************************************************************
+* @file scanner_telemetry.cpp
+* @brief This file contains code snippet to count decodes and command results and export them to Prometheus
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "telemetry.h"
+#include "scanner_metrics.h"
+#include "counting_scanner.h"
+#include "metrics_http_server.h"
+
+using namespace std;
+
+const unsigned short kMetricsPort = 9464;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for barcode events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param scanner Counting scanner wrapping the CoreScanner interface
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(CountingScanner<ICoreScanner>* scanner, const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_BARCODE);
+    CommandResult<NoResponse> result = Exec<Op>(scanner, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Measure the decode path increment cost with all threads counting at once, against
+* one shared set of atomic counters
+*/
+void RunIncrementBenchmark()
+{
+    const int kIncrementsPerThread = 5000000;
+    int thread_count = (int)thread::hardware_concurrency();
+    thread_count = thread_count < 2 ? 2 : (thread_count > 8 ? 8 : thread_count);
+
+    Telemetry telemetry;
+    ScannerMetrics metrics(&telemetry);
+    vector<thread> threads;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int t = 0; t < thread_count; t++)
+    {
+        threads.push_back(thread([&metrics, t]()
+        {
+            for (int i = 0; i < kIncrementsPerThread; i++)
+            {
+                metrics.CountDecode(1 + (t + i) % 16, ST_EAN13, true);
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    // Two counters per decode
+    double slot_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (2.0 * kIncrementsPerThread);
+
+    vector<atomic<unsigned long long> > shared_counters(MAX_NUM_DEVICES + 1 + 256);
+    threads.clear();
+    start = chrono::steady_clock::now();
+    for (int t = 0; t < thread_count; t++)
+    {
+        threads.push_back(thread([&shared_counters, t]()
+        {
+            for (int i = 0; i < kIncrementsPerThread; i++)
+            {
+                shared_counters[1 + (t + i) % 16].fetch_add(1);
+                shared_counters[MAX_NUM_DEVICES + 1 + ST_EAN13].fetch_add(1);
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    double shared_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (2.0 * kIncrementsPerThread);
+
+    unsigned long long total = 0;
+    vector<TelemetrySample> samples = telemetry.Snapshot();
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        if (samples[i].name == "scanner_decodes_total")
+        {
+            total += samples[i].value;
+        }
+    }
+
+    cout << "Counter increments from " << thread_count << " threads" << endl;
+    cout << " Per thread slots : " << slot_ns << " ns/increment, " << total << " decodes counted" << endl;
+    cout << " Shared atomic counters : " << shared_ns << " ns/increment" << endl;
+}
+
+/*
+* Print non zero counters
+*/
+void PrintSnapshot(const Telemetry& telemetry)
+{
+    vector<TelemetrySample> samples = telemetry.Snapshot();
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        cout << " " << samples[i].name << samples[i].labels << " " << samples[i].value << endl;
+    }
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    RunIncrementBenchmark();
+    cout << " " << endl;
+
+    Telemetry telemetry;
+    ScannerMetrics metrics(&telemetry);
+    MetricsHttpServer server(telemetry);
+    if (server.Start(kMetricsPort))
+    {
+        cout << "Metrics available at http://127.0.0.1:" << kMetricsPort << "/metrics" << endl;
+    }
+    else
+    {
+        cout << "Metrics endpoint on port " << kMetricsPort << " - Failed" << endl;
+    }
+
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        CountingScanner<ICoreScanner> counting_scanner(scanner_interface, &metrics);
+        scanner_event_sink->SetScanDataHandler([&metrics](short event_type, const string& scan_data)
+        {
+            metrics.CountScanData(event_type, scan_data);
+        });
+
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>(&counting_scanner, "RegisterForEvents"))
+        {
+            WaitForInput("Scan barcodes now, press any key to print the counters and exit.");
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>(&counting_scanner, "UnregisterForEvents");
+        }
+        scanner_event_sink->SetScanDataHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+
+    cout << "Counters (" << server.ScrapeCount() << " scrapes) :" << endl;
+    PrintSnapshot(telemetry);
+    server.Stop();
+    WaitForInput("Press any key to exit.");
+}
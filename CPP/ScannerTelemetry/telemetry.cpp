@@ -0,0 +1,244 @@
+/*******************************************************************************************
+* @file telemetry.cpp
+* @brief Definition of telemetry counter registry
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "telemetry.h"
+#include <cstdint>
+#include <new>
+
+using namespace std;
+
+static const size_t kCacheLineSize = 64;
+
+thread_local Telemetry::LocalCache Telemetry::local_ = { 0, NULL };
+atomic<long long> Telemetry::next_serial_(1);
+
+Telemetry::Telemetry(int max_cells)
+    : serial_(next_serial_++), max_cells_(max_cells), used_cells_(0)
+{
+}
+
+Telemetry::~Telemetry()
+{
+    for (size_t i = 0; i < families_.size(); i++)
+    {
+        delete[] families_[i].keys;
+    }
+    for (size_t i = 0; i < slots_.size(); i++)
+    {
+        delete slots_[i];
+    }
+}
+
+int Telemetry::AddCounter(const string& name, const string& help)
+{
+    return AddFamily(name, help, string(), string(), 1, false);
+}
+
+int Telemetry::AddCounter(const string& name, const string& help, const string& label, int label_count)
+{
+    return AddFamily(name, help, label, string(), label_count, false);
+}
+
+int Telemetry::AddKeyedCounter(const string& name, const string& help, const string& label1, const string& label2, int capacity)
+{
+    int size = 1;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+    // One cell more for the label pair that packs to kFreeKey
+    return AddFamily(name, help, label1, label2, size + 1, true);
+}
+
+unsigned long long Telemetry::Value(int family, int label) const
+{
+    const Family& counter_family = families_[family];
+    if ((unsigned int)label >= (unsigned int)counter_family.size)
+    {
+        return 0;
+    }
+    lock_guard<mutex> lock(slots_mutex_);
+    return Sum(counter_family.base + label);
+}
+
+vector<TelemetrySample> Telemetry::Snapshot() const
+{
+    vector<TelemetrySample> samples;
+    lock_guard<mutex> lock(slots_mutex_);
+    for (size_t family = 0; family < families_.size(); family++)
+    {
+        const Family& counter_family = families_[family];
+        for (int index = 0; index < counter_family.size; index++)
+        {
+            unsigned long long value = Sum(counter_family.base + index);
+            if (value == 0)
+            {
+                continue;
+            }
+            TelemetrySample sample;
+            sample.name = counter_family.name;
+            sample.labels = Labels(counter_family, index);
+            sample.value = value;
+            samples.push_back(sample);
+        }
+    }
+    return samples;
+}
+
+string Telemetry::PrometheusText() const
+{
+    string text;
+    lock_guard<mutex> lock(slots_mutex_);
+    for (size_t family = 0; family < families_.size(); family++)
+    {
+        const Family& counter_family = families_[family];
+        text += "# HELP " + counter_family.name + " " + counter_family.help + "\n";
+        text += "# TYPE " + counter_family.name + " counter\n";
+        for (int index = 0; index < counter_family.size; index++)
+        {
+            unsigned long long value = Sum(counter_family.base + index);
+            // Labelled series appear once counted, a family without labels is always reported
+            if (value != 0 || counter_family.label1.empty())
+            {
+                text += counter_family.name + Labels(counter_family, index) + " " + to_string(value) + "\n";
+            }
+        }
+    }
+    return text;
+}
+
+/**
+* Find or allocate the slot of the calling thread and remember it in the thread local cache
+**/
+Telemetry::Cell* Telemetry::AttachThread()
+{
+    thread::id thread_id = this_thread::get_id();
+    lock_guard<mutex> lock(slots_mutex_);
+    ThreadSlot* slot = NULL;
+    for (size_t i = 0; i < slots_.size() && slot == NULL; i++)
+    {
+        if (slots_[i]->thread_id == thread_id)
+        {
+            slot = slots_[i];
+        }
+    }
+
+    if (slot == NULL)
+    {
+        // Round the slot up to whole cache lines and align it, so no two threads write the same line
+        size_t bytes = (max_cells_ * sizeof(Cell) + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+        slot = new ThreadSlot();
+        slot->storage.reset(new char[bytes + kCacheLineSize]);
+        uintptr_t address = (uintptr_t)slot->storage.get();
+        address = (address + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize;
+        slot->cells = (Cell*)address;
+        for (int cell = 0; cell < max_cells_; cell++)
+        {
+            new (&slot->cells[cell]) Cell(0);
+        }
+        slot->thread_id = thread_id;
+        slots_.push_back(slot);
+    }
+
+    local_.telemetry_serial = serial_;
+    local_.cells = slot->cells;
+    return slot->cells;
+}
+
+/**
+* Cell of a label pair in a keyed family, claimed on first use. The family has a power of 2
+* hashed cells and, last, a fixed cell for the (-1, -1) pair that packs to kFreeKey.
+* return value : Cell index, -1 if the family is full
+**/
+int Telemetry::KeyedCell(const Family& family, int label1, int label2)
+{
+    long long key = (long long)(((unsigned long long)(unsigned int)label1 << 32) | (unsigned int)label2);
+    int hashed_cells = family.size - 1;
+    if (key == kFreeKey)
+    {
+        return family.base + hashed_cells;     // Its key slot already holds kFreeKey
+    }
+    unsigned long long hash = (unsigned long long)key * 0x9E3779B97F4A7C15ULL;
+    int mask = hashed_cells - 1;
+    int index = (int)(hash >> 32) & mask;
+    for (int probe = 0; probe < hashed_cells; probe++, index = (index + 1) & mask)
+    {
+        long long current = family.keys[index].load(memory_order_acquire);
+        if (current == key)
+        {
+            return family.base + index;
+        }
+        if (current == kFreeKey)
+        {
+            if (family.keys[index].compare_exchange_strong(current, key) || current == key)
+            {
+                return family.base + index;
+            }
+        }
+    }
+    return -1;
+}
+
+int Telemetry::AddFamily(const string& name, const string& help, const string& label1, const string& label2, int size, bool keyed)
+{
+    if (used_cells_ + size > max_cells_)
+    {
+        return -1;
+    }
+
+    Family family;
+    family.name = name;
+    family.help = help;
+    family.label1 = label1;
+    family.label2 = label2;
+    family.base = used_cells_;
+    family.size = size;
+    family.keys = NULL;
+    if (keyed)
+    {
+        family.keys = new atomic<long long>[size];
+        for (int i = 0; i < size; i++)
+        {
+            family.keys[i] = kFreeKey;
+        }
+    }
+    used_cells_ += size;
+    families_.push_back(family);
+    return (int)families_.size() - 1;
+}
+
+/**
+* Sum of a cell over all thread slots. Called with slots_mutex_ held.
+**/
+unsigned long long Telemetry::Sum(int cell) const
+{
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < slots_.size(); i++)
+    {
+        sum += slots_[i]->cells[cell].load(memory_order_relaxed);
+    }
+    return sum;
+}
+
+/**
+* Prometheus label set of a cell
+**/
+string Telemetry::Labels(const Family& family, int index) const
+{
+    if (family.label1.empty())
+    {
+        return string();
+    }
+    if (family.keys == NULL)
+    {
+        return "{" + family.label1 + "=\"" + to_string(index) + "\"}";
+    }
+    unsigned long long key = (unsigned long long)family.keys[index].load(memory_order_acquire);
+    return "{" + family.label1 + "=\"" + to_string((int)(unsigned int)(key >> 32)) + "\"," +
+        family.label2 + "=\"" + to_string((int)(unsigned int)(key & 0xffffffff)) + "\"}";
+}
@@ -0,0 +1,160 @@
+/*******************************************************************************************
+* @file telemetry.h
+* @brief Counters kept in per thread cache line padded slots, aggregated on scrape
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+* One counter value in a snapshot
+**/
+struct TelemetrySample
+{
+    std::string name;       // Family name
+    std::string labels;     // Prometheus label set, e.g. {scanner="3"} (empty for unlabelled counters)
+    unsigned long long value;
+};
+
+/**
+* Counter registry.
+*
+* Counters are grouped in families. A family has no label, one dense integer label
+* (scanner id, symbology) or two sparse integer labels (opcode and status).
+* Every thread that increments a counter gets its own slot holding all counter cells,
+* allocated on its own cache lines, so an increment is a relaxed load and store to memory
+* no other thread writes. Scrapes (Snapshot(), PrometheusText()) add up the slots.
+*
+* Families are defined before any thread increments counters. Slots of exited threads
+* are kept (their counts stay in the totals) and reused by threads with the same id.
+**/
+class Telemetry
+{
+public:
+    /**
+    * Telemetry constructor
+    * @param max_cells - Counter cells per thread slot (all families together)
+    */
+    explicit Telemetry(int max_cells = 4096);
+
+    ~Telemetry();
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    /**
+    * Define a counter family without labels
+    * return value : Family id, -1 if out of cells
+    */
+    int AddCounter(const std::string& name, const std::string& help);
+
+    /**
+    * Define a counter family with one integer label 0 .. label_count - 1
+    * return value : Family id, -1 if out of cells
+    */
+    int AddCounter(const std::string& name, const std::string& help, const std::string& label, int label_count);
+
+    /**
+    * Define a counter family with two sparse integer labels
+    * @param capacity - Distinct label pairs the family can hold (rounded up to a power of 2, plus one cell for (-1, -1))
+    * return value : Family id, -1 if out of cells
+    */
+    int AddKeyedCounter(const std::string& name, const std::string& help, const std::string& label1, const std::string& label2, int capacity);
+
+    /**
+    * Increment a counter of a family without labels or with a dense label
+    */
+    void Increment(int family, int label = 0, unsigned long long count = 1)
+    {
+        const Family& counter_family = families_[family];
+        if ((unsigned int)label < (unsigned int)counter_family.size)
+        {
+            Add(counter_family.base + label, count);
+        }
+    }
+
+    /**
+    * Increment a counter of a keyed family
+    */
+    void Increment(int family, int label1, int label2, unsigned long long count)
+    {
+        int cell = KeyedCell(families_[family], label1, label2);
+        if (cell >= 0)
+        {
+            Add(cell, count);
+        }
+    }
+
+    /**
+    * Current value of a counter summed over all threads
+    */
+    unsigned long long Value(int family, int label = 0) const;
+
+    /**
+    * All counters that are not zero
+    */
+    std::vector<TelemetrySample> Snapshot() const;
+
+    /**
+    * All counters in Prometheus text exposition format
+    */
+    std::string PrometheusText() const;
+
+private:
+    typedef std::atomic<unsigned long long> Cell;
+
+    struct Family
+    {
+        std::string name;
+        std::string help;
+        std::string label1;
+        std::string label2;
+        int base;
+        int size;
+        std::atomic<long long>* keys;   // Keyed families: label pair of each cell, kFreeKey if unused
+    };
+
+    struct ThreadSlot
+    {
+        std::unique_ptr<char[]> storage;
+        Cell* cells;                    // Cache line aligned inside storage
+        std::thread::id thread_id;
+    };
+
+    struct LocalCache
+    {
+        long long telemetry_serial;
+        Cell* cells;
+    };
+
+    static const long long kFreeKey = -1;      // Packed (-1, -1), which has a cell of its own
+
+    void Add(int cell, unsigned long long count)
+    {
+        Cell* cells = (local_.telemetry_serial == serial_) ? local_.cells : AttachThread();
+        cells[cell].store(cells[cell].load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    Cell* AttachThread();
+    int KeyedCell(const Family& family, int label1, int label2);
+    int AddFamily(const std::string& name, const std::string& help, const std::string& label1, const std::string& label2, int size, bool keyed);
+    unsigned long long Sum(int cell) const;
+    std::string Labels(const Family& family, int index) const;
+
+    static thread_local LocalCache local_;
+    static std::atomic<long long> next_serial_;
+
+    const long long serial_;            // Identifies this instance in the thread local cache
+    const int max_cells_;
+    int used_cells_;
+    std::vector<Family> families_;
+    mutable std::mutex slots_mutex_;
+    std::vector<ThreadSlot*> slots_;
+};
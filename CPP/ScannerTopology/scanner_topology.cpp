@@ -0,0 +1,412 @@
+/*******************************************************************************************
+* @file scanner_topology.cpp
+* @brief This file contains code snippet to cache the scanner/cradle/hub topology and keep it current with PNP events
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "topology_cache.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for PNP events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_PNP);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Load the topology cache with GET_DEVICE_TOPOLOGY
+* return value : Command success/fail status
+*/
+bool LoadTopology(TopologyCache* topology)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    CommandResult<XmlResponse> result = Exec<GET_DEVICE_TOPOLOGY>(scanner_interface);
+    if (!result.Succeeded() || !topology->Load(result.response.xml))
+    {
+        cout << "CoreScanner GetDeviceTopology() - Failed. Error Code : " << result.status << endl;
+        return false;
+    }
+    double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "CoreScanner GetDeviceTopology() - Success (" << topology->DeviceCount() << " devices, " << milliseconds << " ms)" << endl;
+    return true;
+}
+
+/*
+* Print devices behind a cradle/hub, indented by connection level
+*/
+void PrintTopology(const TopologyCache& topology, int scanner_id = 0, int level = 1)
+{
+    vector<int> children;
+    topology.ChildrenOf(scanner_id, &children);
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        const TopologyNode& node = topology.Node(topology.Find(children[i]));
+        cout << string(level * 2, ' ') << "Scanner ID:[" << node.scanner_id << "] " << node.type << " "
+             << node.model_number << " S/N:[" << node.serial_number << "]" << endl;
+        PrintTopology(topology, node.scanner_id, level + 1);
+    }
+}
+
+/*
+* Build topology style xml for a device with given nested devices
+*/
+string MakeDeviceXml(int scanner_id, const char* type, const char* model_number, const string& children)
+{
+    string xml = string("<scanner type=\"") + type + "\"><scannerID>" + to_string(scanner_id) + "</scannerID>"
+        + "<serialnumber>S" + to_string(10000 + scanner_id) + "</serialnumber><modelnumber>" + model_number + "</modelnumber>";
+    if (!children.empty())
+    {
+        xml += "<scanners>" + children + "</scanners>";
+    }
+    return xml + "</scanner>";
+}
+
+/*
+* Build synthetic topology (hubs of cradles with paired scanners) and compare incremental
+* PNP updates with reloading the whole topology
+*/
+void RunSyntheticTopology()
+{
+    const int kHubs = 4;
+    const int kCradlesPerHub = 16;
+    const int kScannersPerCradle = 3;
+    const int kIterations = 2000;
+
+    int next_id = 1;
+    string hubs;
+    for (int h = 0; h < kHubs; h++)
+    {
+        int hub_id = next_id++;
+        string cradles;
+        for (int c = 0; c < kCradlesPerHub; c++)
+        {
+            int cradle_id = next_id++;
+            string scanners;
+            for (int s = 0; s < kScannersPerCradle; s++)
+            {
+                scanners += MakeDeviceXml(next_id++, "SNAPI", "DS8178-SR", "");
+            }
+            cradles += MakeDeviceXml(cradle_id, "SNAPI", "CR8178-SC", scanners);
+        }
+        hubs += MakeDeviceXml(hub_id, "SNAPI", "HUB", cradles);
+    }
+    string topology_xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><arg-xml><scanners>" + hubs + "</scanners></arg-xml></outArgs>";
+
+    TopologyCache topology;
+    topology.Load(topology_xml);
+    int cradle_id = 2;
+    int scanner_id = 3;
+    vector<int> ids;
+    topology.ChildrenOf(cradle_id, &ids);
+    cout << " " << topology.DeviceCount() << " devices, cradle ID:[" << cradle_id << "] has " << ids.size()
+         << " scanners, hub ID:[" << topology.ParentOf(cradle_id) << "] has ";
+    topology.DescendantsOf(topology.ParentOf(cradle_id), &ids);
+    cout << ids.size() << " devices behind it" << endl;
+
+    // Paired scanner leaves and comes back, as seen in the PNP event xml
+    string attach_xml = "<outArgs><arg-xml><scanners>" + MakeDeviceXml(cradle_id, "SNAPI", "CR8178-SC",
+        MakeDeviceXml(scanner_id, "SNAPI", "DS8178-SR", "")) + "</scanners></arg-xml></outArgs>";
+    string detach_xml = "<outArgs><arg-xml><scanners>" + MakeDeviceXml(scanner_id, "SNAPI", "DS8178-SR", "") + "</scanners></arg-xml></outArgs>";
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; i++)
+    {
+        topology.ApplyPnpEvent(PNP_EVENT_DETACHED, detach_xml);
+        topology.ApplyPnpEvent(PNP_EVENT_ATTACHED, attach_xml);
+    }
+    double incremental_us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / (kIterations * 2);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; i++)
+    {
+        topology.Load(topology_xml);
+    }
+    double reload_us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / kIterations;
+
+    start = chrono::steady_clock::now();
+    long lookups = 0;
+    for (int i = 0; i < kIterations * 100; i++)
+    {
+        topology.ChildrenOf(2 + (i % kCradlesPerHub) * (kScannersPerCradle + 1), &ids);
+        lookups += (long)ids.size();
+    }
+    double lookup_ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (kIterations * 100);
+
+    topology.ChildrenOf(cradle_id, &ids);
+    cout << " Cradle ID:[" << cradle_id << "] has " << ids.size() << " scanners after detach/attach, parent of scanner ID:["
+         << scanner_id << "] is " << topology.ParentOf(scanner_id) << endl;
+    cout << " PNP update : " << incremental_us << " us, topology reload (parse only) : " << reload_us
+         << " us, cradle children lookup : " << lookup_ns << " ns" << endl;
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Scanner topology cache with synthetic topology" << endl;
+    RunSyntheticTopology();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    if (ConnectEvents() && Open())
+    {
+        TopologyCache topology;
+        if (LoadTopology(&topology))
+        {
+            PrintTopology(topology);
+        }
+
+        scanner_event_sink->SetPnpHandler([&topology](short event_type, const string& pnp_data)
+        {
+            if (topology.ApplyPnpEvent(event_type, pnp_data))
+            {
+                cout << (event_type == PNP_EVENT_ATTACHED ? "Attached" : "Detached") << ", topology now has "
+                     << topology.DeviceCount() << " devices :" << endl;
+                PrintTopology(topology);
+            }
+        });
+
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            cout << "Connect/disconnect scanners and cradles now, press any key to exit." << endl;
+            MSG msg = { 0 };
+            while (true)   // Message loop to dispatch windows messages while waiting for PNP events
+            {
+                PeekMessage(&msg, NULL, 0, 0, 0);
+                TranslateMessage(&msg);
+                DispatchMessage(&msg);
+                if (_kbhit())
+                {
+                    break;
+                }
+                if (topology.NeedsRefresh())
+                {
+                    // An event could not be applied - fall back to the topology command
+                    if (LoadTopology(&topology))
+                    {
+                        PrintTopology(topology);
+                    }
+                }
+                Sleep(1);
+            }
+            getchar();
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+        }
+        scanner_event_sink->SetPnpHandler(nullptr);
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
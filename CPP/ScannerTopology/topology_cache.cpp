@@ -0,0 +1,334 @@
+/*******************************************************************************************
+* @file topology_cache.cpp
+* @brief Definition of cached scanner/cradle/hub tree
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "topology_cache.h"
+#include "xml_reader.h"
+
+using namespace std;
+
+TopologyCache::TopologyCache()
+    : first_root_(-1), needs_refresh_(false), version_(0)
+{
+}
+
+/**
+* Parse all <scanner> elements of a topology or PNP xml. A <scanner> nested in another one
+* (directly or through a <scanners> list) is a device connected through that cradle/hub.
+**/
+bool TopologyCache::ParseDevices(const string& xml, vector<ParsedDevice>* devices)
+{
+    XmlReader reader(xml);
+    vector<pair<int, int> > open_devices;   // Parsed device index, element depth
+    bool found_list = false;
+
+    while (true)
+    {
+        XmlReader::Token token = reader.Next();
+        if (token == XmlReader::kEndOfDocument)
+        {
+            break;
+        }
+        if (token == XmlReader::kEndElement)
+        {
+            if (!open_devices.empty() && reader.Depth() < open_devices.back().second)
+            {
+                open_devices.pop_back();
+            }
+            continue;
+        }
+        if (token != XmlReader::kStartElement)
+        {
+            continue;
+        }
+
+        XmlSlice name = reader.Name();
+        if (name.Equals("scanners"))
+        {
+            found_list = true;
+        }
+        else if (name.Equals("scanner"))
+        {
+            ParsedDevice device;
+            device.node.scanner_id = 0;
+            device.node.parent = device.node.first_child = device.node.next_sibling = -1;
+            device.parent_device = open_devices.empty() ? -1 : open_devices.back().first;
+            XmlSlice type;
+            if (reader.Attribute("type", &type))
+            {
+                device.node.type = type.ToString();
+            }
+            devices->push_back(device);
+            open_devices.push_back(make_pair((int)devices->size() - 1, reader.Depth()));
+            found_list = true;
+        }
+        else if (!open_devices.empty() && reader.Depth() == open_devices.back().second + 1)
+        {
+            TopologyNode& node = (*devices)[open_devices.back().first].node;
+            XmlSlice text;
+            if (name.Equals("scannerID") && reader.ReadElementText(&text))
+            {
+                node.scanner_id = (int)text.ToLong();
+            }
+            else if (name.Equals("modelnumber") && reader.ReadElementText(&text))
+            {
+                node.model_number = text.ToString();
+            }
+            else if (name.Equals("serialnumber") && reader.ReadElementText(&text))
+            {
+                node.serial_number = text.ToString();
+            }
+            else if (name.Equals("GUID") && reader.ReadElementText(&text))
+            {
+                node.guid = text.ToString();
+            }
+        }
+    }
+    return found_list;
+}
+
+bool TopologyCache::Load(const string& topology_xml)
+{
+    vector<ParsedDevice> devices;
+    if (!ParseDevices(topology_xml, &devices))
+    {
+        return false;
+    }
+
+    nodes_.clear();
+    free_nodes_.clear();
+    index_.clear();
+    first_root_ = -1;
+
+    // Parents are parsed before their children, so parent node indices are known when a child is added
+    vector<int> node_of_device(devices.size(), -1);
+    for (size_t i = 0; i < devices.size(); i++)
+    {
+        if (devices[i].node.scanner_id == 0 || index_.count(devices[i].node.scanner_id) != 0)
+        {
+            continue;
+        }
+        int parent = devices[i].parent_device >= 0 ? node_of_device[devices[i].parent_device] : -1;
+        node_of_device[i] = AddNode(devices[i].node, parent);
+    }
+
+    needs_refresh_ = false;
+    version_++;
+    return true;
+}
+
+bool TopologyCache::ApplyPnpEvent(short event_type, const string& pnp_data)
+{
+    vector<ParsedDevice> devices;
+    if (!ParseDevices(pnp_data, &devices) || devices.empty() ||
+        (event_type != PNP_EVENT_ATTACHED && event_type != PNP_EVENT_DETACHED))
+    {
+        needs_refresh_ = true;
+        return false;
+    }
+
+    if (event_type == PNP_EVENT_DETACHED)
+    {
+        // A detached cradle/hub takes the devices behind it along
+        for (size_t i = 0; i < devices.size(); i++)
+        {
+            int index = Find(devices[i].node.scanner_id);
+            if (index >= 0)
+            {
+                RemoveSubtree(index);
+            }
+        }
+        version_++;
+        return true;
+    }
+
+    vector<int> node_of_device(devices.size(), -1);
+    for (size_t i = 0; i < devices.size(); i++)
+    {
+        const TopologyNode& device = devices[i].node;
+        if (device.scanner_id == 0)
+        {
+            needs_refresh_ = true;
+            continue;
+        }
+
+        int parent = devices[i].parent_device >= 0 ? node_of_device[devices[i].parent_device] : -1;
+        int index = Find(device.scanner_id);
+        if (index < 0)
+        {
+            // Without its parent in the event a new device may still be behind a known cradle/hub
+            // (a scanner pairing to a cradle) - it goes in as a root until the topology is reloaded
+            if (devices[i].parent_device < 0 && !index_.empty())
+            {
+                needs_refresh_ = true;
+            }
+            node_of_device[i] = AddNode(device, parent);
+            continue;
+        }
+
+        // Already known (e.g. attach repeated after a reconnect) - refresh details, keep children
+        TopologyNode& node = nodes_[index];
+        node.type = device.type;
+        node.model_number = device.model_number;
+        node.serial_number = device.serial_number;
+        node.guid = device.guid;
+        if (devices[i].parent_device >= 0 && parent != node.parent)
+        {
+            Unlink(index);
+            Link(index, parent);
+        }
+        node_of_device[i] = index;
+    }
+    version_++;
+    return true;
+}
+
+int TopologyCache::Find(int scanner_id) const
+{
+    unordered_map<int, int>::const_iterator it = index_.find(scanner_id);
+    return it == index_.end() ? -1 : it->second;
+}
+
+int TopologyCache::ParentOf(int scanner_id) const
+{
+    int index = Find(scanner_id);
+    if (index < 0 || nodes_[index].parent < 0)
+    {
+        return 0;
+    }
+    return nodes_[nodes_[index].parent].scanner_id;
+}
+
+void TopologyCache::ChildrenOf(int scanner_id, vector<int>* scanner_ids) const
+{
+    scanner_ids->clear();
+    int child = first_root_;
+    if (scanner_id != 0)
+    {
+        int index = Find(scanner_id);
+        if (index < 0)
+        {
+            return;
+        }
+        child = nodes_[index].first_child;
+    }
+    for (; child >= 0; child = nodes_[child].next_sibling)
+    {
+        scanner_ids->push_back(nodes_[child].scanner_id);
+    }
+}
+
+void TopologyCache::DescendantsOf(int scanner_id, vector<int>* scanner_ids) const
+{
+    scanner_ids->clear();
+    vector<int> pending;
+    int first = first_root_;
+    if (scanner_id != 0)
+    {
+        int index = Find(scanner_id);
+        if (index < 0)
+        {
+            return;
+        }
+        first = nodes_[index].first_child;
+    }
+
+    // Depth first walk: visit a node, then its children, then its next sibling
+    int current = first;
+    while (current >= 0 || !pending.empty())
+    {
+        if (current < 0)
+        {
+            current = pending.back();
+            pending.pop_back();
+        }
+        scanner_ids->push_back(nodes_[current].scanner_id);
+        if (nodes_[current].next_sibling >= 0)
+        {
+            pending.push_back(nodes_[current].next_sibling);
+        }
+        current = nodes_[current].first_child;
+    }
+}
+
+/**
+* Store a node (reusing a freed slot) and link it under parent
+**/
+int TopologyCache::AddNode(const TopologyNode& node, int parent)
+{
+    int index;
+    if (!free_nodes_.empty())
+    {
+        index = free_nodes_.back();
+        free_nodes_.pop_back();
+        nodes_[index] = node;
+    }
+    else
+    {
+        index = (int)nodes_.size();
+        nodes_.push_back(node);
+    }
+    index_[node.scanner_id] = index;
+    Link(index, parent);
+    return index;
+}
+
+/**
+* Append a node to the end of its parent's child list (keeps the topology xml order)
+**/
+void TopologyCache::Link(int index, int parent)
+{
+    TopologyNode& node = nodes_[index];
+    node.parent = parent;
+    node.next_sibling = -1;
+
+    int* link = parent >= 0 ? &nodes_[parent].first_child : &first_root_;
+    while (*link >= 0)
+    {
+        link = &nodes_[*link].next_sibling;
+    }
+    *link = index;
+}
+
+/**
+* Remove a node from its parent's child list
+**/
+void TopologyCache::Unlink(int index)
+{
+    int parent = nodes_[index].parent;
+    int* link = parent >= 0 ? &nodes_[parent].first_child : &first_root_;
+    while (*link >= 0 && *link != index)
+    {
+        link = &nodes_[*link].next_sibling;
+    }
+    if (*link == index)
+    {
+        *link = nodes_[index].next_sibling;
+    }
+    nodes_[index].next_sibling = -1;
+}
+
+/**
+* Remove a node and all nodes behind it, freeing their slots
+**/
+void TopologyCache::RemoveSubtree(int index)
+{
+    Unlink(index);
+    vector<int> pending(1, index);
+    while (!pending.empty())
+    {
+        int current = pending.back();
+        pending.pop_back();
+        for (int child = nodes_[current].first_child; child >= 0; child = nodes_[child].next_sibling)
+        {
+            pending.push_back(child);
+        }
+        index_.erase(nodes_[current].scanner_id);
+        nodes_[current].first_child = nodes_[current].parent = -1;
+        free_nodes_.push_back(current);
+    }
+}
@@ -0,0 +1,136 @@
+/*******************************************************************************************
+* @file topology_cache.h
+* @brief Cached scanner/cradle/hub tree built from GET_DEVICE_TOPOLOGY and kept current with PNP events
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//---- PNP event types ------//
+#define PNP_EVENT_ATTACHED  0
+#define PNP_EVENT_DETACHED  1
+
+/**
+* One device in the topology. Links are indices into the node array, -1 for none.
+**/
+struct TopologyNode
+{
+    int scanner_id;
+    int parent;         // Cradle/hub the device is connected through, -1 for host attached devices
+    int first_child;
+    int next_sibling;
+    std::string type;   // Communication protocol (SNAPI, IBMHID, ...)
+    std::string model_number;
+    std::string serial_number;
+    std::string guid;
+};
+
+/**
+* Device tree stored as a flat node array with parent, first child and next sibling indices.
+*
+* Load() parses the GET_DEVICE_TOPOLOGY outXML once. After that ApplyPnpEvent() patches the
+* tree from attach/detach events so the topology command is not run again for every cable
+* or Bluetooth change: an attach inserts (or updates) the devices in the event xml, using the
+* same <scanner> nesting as the topology xml to find their parent, and a detach removes the
+* device together with everything behind it. A new device that comes without its parent cannot
+* be placed once other devices are known; it is added at the top and NeedsRefresh() is set. Child lookups walk only the sibling chain, so
+* "all scanners behind this cradle" costs O(children). Freed slots are reused, and a device
+* is found by scanner id through a hash index.
+*
+* The cache is not thread safe; feed it from the thread that receives CoreScanner events.
+**/
+class TopologyCache
+{
+public:
+    /**
+    * Topology cache constructor
+    */
+    TopologyCache();
+
+    /**
+    * Rebuild the tree from GET_DEVICE_TOPOLOGY output xml
+    * @param topology_xml - Topology command outXML
+    * return value : true if the xml contained a device list
+    */
+    bool Load(const std::string& topology_xml);
+
+    /**
+    * Update the tree from a PNP event
+    * @param event_type - PNP_EVENT_ATTACHED/PNP_EVENT_DETACHED
+    * @param pnp_data - PNP event xml
+    * return value : true if the tree was updated, false if the event could not be applied
+    *                (NeedsRefresh() then reports that the topology has to be loaded again)
+    */
+    bool ApplyPnpEvent(short event_type, const std::string& pnp_data);
+
+    /**
+    * True when an event could not be applied and the tree may be out of date
+    */
+    bool NeedsRefresh() const { return needs_refresh_; }
+
+    /**
+    * Node index of a device
+    * return value : Index for Node(), -1 if the device is not in the topology
+    */
+    int Find(int scanner_id) const;
+
+    /**
+    * Device at given node index
+    */
+    const TopologyNode& Node(int index) const { return nodes_[index]; }
+
+    /**
+    * Scanner id of the cradle/hub a device is connected through
+    * return value : Parent scanner id, 0 for host attached or unknown devices
+    */
+    int ParentOf(int scanner_id) const;
+
+    /**
+    * Devices directly behind a cradle/hub
+    * @param scanner_id - Cradle/hub scanner id, 0 for host attached devices
+    * @param scanner_ids - Receives child scanner ids
+    */
+    void ChildrenOf(int scanner_id, std::vector<int>* scanner_ids) const;
+
+    /**
+    * All devices behind a cradle/hub, including devices behind nested hubs
+    * @param scanner_id - Cradle/hub scanner id, 0 for all devices
+    * @param scanner_ids - Receives scanner ids in depth first order
+    */
+    void DescendantsOf(int scanner_id, std::vector<int>* scanner_ids) const;
+
+    /**
+    * Number of devices in the topology
+    */
+    size_t DeviceCount() const { return index_.size(); }
+
+    /**
+    * Incremented each time the tree changes
+    */
+    long Version() const { return version_; }
+
+private:
+    struct ParsedDevice
+    {
+        TopologyNode node;
+        int parent_device;  // Index into the parsed device list, -1 if not nested
+    };
+
+    static bool ParseDevices(const std::string& xml, std::vector<ParsedDevice>* devices);
+
+    int AddNode(const TopologyNode& node, int parent);
+    void Link(int index, int parent);
+    void Unlink(int index);
+    void RemoveSubtree(int index);
+
+    std::vector<TopologyNode> nodes_;
+    std::vector<int> free_nodes_;
+    std::unordered_map<int, int> index_;    // Scanner id to node index
+    int first_root_;
+    bool needs_refresh_;
+    long version_;
+};
@@ -0,0 +1,154 @@
+/*******************************************************************************************
+* @file xml_reader.h
+* @brief Lightweight pull parser for CoreScanner outXML / event XML
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+* Non-owning view of a range of characters inside the parsed xml buffer
+**/
+struct XmlSlice
+{
+    const char* data;
+    size_t length;
+
+    /**
+    * Compare slice content with a null terminated string
+    */
+    bool Equals(const char* text) const;
+
+    /**
+    * Copy slice content (xml entities decoded) to a string
+    */
+    std::string ToString() const;
+
+    /**
+    * Parse slice content as a signed decimal (or 0x prefixed hexadecimal) number
+    * return value : Parsed value, 0 if slice is not a number
+    */
+    long ToLong() const;
+
+    /**
+    * Parse slice content as a floating point number
+    */
+    double ToDouble() const;
+
+    /**
+    * Parse slice content as a boolean (TRUE/FALSE/1/0)
+    */
+    bool ToBool() const;
+};
+
+/**
+* Forward-only, allocation free xml reader.
+* CoreScanner xml is small and well formed so the reader does not validate,
+* it only tokenizes elements and text. Attributes of the current start element
+* can be looked up with Attribute().
+**/
+class XmlReader
+{
+public:
+    enum Token
+    {
+        kStartElement,
+        kEndElement,
+        kText,
+        kEndOfDocument
+    };
+
+    /**
+    * Reader constructor
+    * @param data - Xml buffer (must outlive the reader)
+    * @param length - Length of xml buffer
+    */
+    XmlReader(const char* data, size_t length);
+
+    /**
+    * Reader constructor
+    * @param xml - Xml string (must outlive the reader)
+    */
+    explicit XmlReader(const std::string& xml);
+
+    /**
+    * Advance to next token
+    * return value : Type of token read
+    */
+    Token Next();
+
+    /**
+    * Name of current start/end element
+    */
+    XmlSlice Name() const { return name_; }
+
+    /**
+    * Look up an attribute of current start element
+    * @param name - Attribute name
+    * @param value - Receives raw (not entity decoded) attribute value
+    * return value : true if the attribute was found
+    */
+    bool Attribute(const char* name, XmlSlice* value) const;
+
+    /**
+    * Raw (not entity decoded) text of current text token
+    */
+    XmlSlice Text() const { return text_; }
+
+    /**
+    * Nesting depth of current element (1 for the root element)
+    */
+    int Depth() const { return depth_; }
+
+    /**
+    * Advance to next start element with given name
+    * return value : true if element was found
+    */
+    bool FindElement(const char* name);
+
+    /**
+    * Advance to next start element with given name, not leaving the element at given depth
+    * @param name - Element name to look for
+    * @param parent_depth - Depth of the enclosing element
+    * return value : true if element was found before the enclosing element ended
+    */
+    bool FindChild(const char* name, int parent_depth);
+
+    /**
+    * Read text content of current (leaf) element and move past its end tag
+    * @param text - Receives text of the element (empty for <a/> or <a></a>)
+    * return value : true if the element contained only text
+    */
+    bool ReadElementText(XmlSlice* text);
+
+    /**
+    * Skip the remainder of current element including its children
+    */
+    void SkipElement();
+
+private:
+    const char* cursor_;
+    const char* end_;
+    XmlSlice name_;
+    XmlSlice text_;
+    XmlSlice attributes_;   // Raw attribute text of current start element
+    int depth_;
+    bool pending_end_;  // Self closing element, end token not yet reported
+};
+
+/**
+* Find first element with given name and read its text
+* @param xml - Xml document
+* @param name - Element name
+* @param value - Receives decoded element text
+* return value : true if element was found
+*/
+bool XmlFindText(const std::string& xml, const char* name, std::string* value);
+
+/**
+* Append text to an xml string, escaping xml special characters
+*/
+void XmlAppendEscaped(std::string* xml, const std::string& text);
@@ -0,0 +1,469 @@
+/*******************************************************************************************
+* @file bilevel.cpp
+* @brief Definition of ink detection, cropping, binarization and CCITT G4 encoding
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "bilevel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BILEVEL_SSE2 1
+#endif
+
+using namespace std;
+
+void ConvertToGray(const Image& source, Image* gray)
+{
+    if (source.channels == 1)
+    {
+        *gray = source;
+        return;
+    }
+    gray->Resize(source.width, source.height, 1);
+    const unsigned char* in = source.pixels.data();
+    unsigned char* out = gray->pixels.data();
+    size_t count = (size_t)source.width * source.height;
+    for (size_t i = 0; i < count; i++, in += 3)
+    {
+        out[i] = (unsigned char)((77 * in[0] + 150 * in[1] + 29 * in[2] + 128) >> 8);
+    }
+}
+
+int FindInkThreshold(const Image& gray, int min_contrast)
+{
+    // Four histograms, so runs of equal pixels do not wait on the same counter
+    uint32_t histograms[4][256] = {};
+    const unsigned char* pixels = gray.pixels.data();
+    size_t count = (size_t)gray.width * gray.height;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        histograms[0][pixels[i]]++;
+        histograms[1][pixels[i + 1]]++;
+        histograms[2][pixels[i + 2]]++;
+        histograms[3][pixels[i + 3]]++;
+    }
+    for (; i < count; i++)
+    {
+        histograms[0][pixels[i]]++;
+    }
+    double histogram[256];
+    double total_sum = 0;
+    for (int level = 0; level < 256; level++)
+    {
+        histogram[level] = (double)histograms[0][level] + histograms[1][level] + histograms[2][level] + histograms[3][level];
+        total_sum += level * histogram[level];
+    }
+
+    // Threshold with the largest between class variance, the middle of the levels sharing it when
+    // no pixel falls between ink and paper
+    double total = (double)count;
+    double ink_count = 0;
+    double ink_sum = 0;
+    double best_variance = -1;
+    int first_best = 0;
+    int last_best = 0;
+    double ink_mean = 0;
+    double paper_mean = 0;
+    for (int level = 1; level < 256; level++)
+    {
+        ink_count += histogram[level - 1];
+        ink_sum += (level - 1) * histogram[level - 1];
+        double paper_count = total - ink_count;
+        if (ink_count == 0 || paper_count == 0)
+        {
+            continue;
+        }
+        double mean0 = ink_sum / ink_count;
+        double mean1 = (total_sum - ink_sum) / paper_count;
+        double variance = ink_count * paper_count * (mean1 - mean0) * (mean1 - mean0);
+        if (variance > best_variance)
+        {
+            best_variance = variance;
+            first_best = last_best = level;
+            ink_mean = mean0;
+            paper_mean = mean1;
+        }
+        else if (variance == best_variance)
+        {
+            last_best = level;
+        }
+    }
+    return first_best != 0 && paper_mean - ink_mean >= min_contrast ? (first_best + last_best + 1) / 2 : 0;
+}
+
+bool FindInkBounds(const Image& gray, int threshold, int margin, InkBounds* bounds, vector<unsigned char>* column_min)
+{
+    int width = gray.width;
+    column_min->assign(width, 255);
+    unsigned char* columns = column_min->data();
+    int top = -1;
+    int bottom = -1;
+    for (int y = 0; y < gray.height; y++)
+    {
+        const unsigned char* row = &gray.pixels[(size_t)y * width];
+        int row_min = 255;
+        int x = 0;
+#ifdef BILEVEL_SSE2
+        __m128i row_mins = _mm_set1_epi8((char)0xFF);
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i pixels = _mm_loadu_si128((const __m128i*)(row + x));
+            __m128i* column = (__m128i*)(columns + x);
+            _mm_storeu_si128(column, _mm_min_epu8(_mm_loadu_si128(column), pixels));
+            row_mins = _mm_min_epu8(row_mins, pixels);
+        }
+        row_mins = _mm_min_epu8(row_mins, _mm_srli_si128(row_mins, 8));
+        row_mins = _mm_min_epu8(row_mins, _mm_srli_si128(row_mins, 4));
+        row_mins = _mm_min_epu8(row_mins, _mm_srli_si128(row_mins, 2));
+        row_mins = _mm_min_epu8(row_mins, _mm_srli_si128(row_mins, 1));
+        row_min = _mm_cvtsi128_si32(row_mins) & 0xFF;
+#endif
+        for (; x < width; x++)
+        {
+            columns[x] = min(columns[x], row[x]);
+            row_min = min(row_min, (int)row[x]);
+        }
+        if (row_min < threshold)
+        {
+            top = top < 0 ? y : top;
+            bottom = y;
+        }
+    }
+    if (top < 0)
+    {
+        return false;
+    }
+    int left = 0;
+    while (columns[left] >= threshold)
+    {
+        left++;
+    }
+    int right = width - 1;
+    while (columns[right] >= threshold)
+    {
+        right--;
+    }
+    bounds->left = max(0, left - margin);
+    bounds->top = max(0, top - margin);
+    bounds->right = min(width, right + 1 + margin);
+    bounds->bottom = min(gray.height, bottom + 1 + margin);
+    return true;
+}
+
+/**
+* Reverse the bit order of a byte
+**/
+static unsigned char ReverseBits(unsigned int value)
+{
+    return (unsigned char)((((value * 0x0802u & 0x22110u) | (value * 0x8020u & 0x88440u)) * 0x10101u) >> 16);
+}
+
+void Binarize(const Image& gray, const InkBounds& region, int threshold, BilevelImage* bilevel)
+{
+    int width = region.Width();
+    bilevel->Resize(width, region.Height());
+    for (int y = 0; y < bilevel->height; y++)
+    {
+        const unsigned char* row = &gray.pixels[(size_t)(region.top + y) * gray.width + region.left];
+        unsigned char* out = &bilevel->bits[(size_t)y * bilevel->stride];
+        int x = 0;
+#ifdef BILEVEL_SSE2
+        // Ink where min(pixel, threshold - 1) == pixel; the byte mask has the first pixel in bit 0
+        __m128i limit = _mm_set1_epi8((char)(threshold - 1));
+        for (; x + 16 <= width; x += 16)
+        {
+            __m128i pixels = _mm_loadu_si128((const __m128i*)(row + x));
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(pixels, limit), pixels));
+            out[x / 8] = ReverseBits(mask & 0xFF);
+            out[x / 8 + 1] = ReverseBits((unsigned int)mask >> 8);
+        }
+#endif
+        for (; x < width; x += 8)
+        {
+            int bits = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                bits = (bits << 1) | (x + i < width && row[x + i] < threshold ? 1 : 0);
+            }
+            out[x / 8] = (unsigned char)bits;
+        }
+    }
+}
+
+/*
+* CCITT Group 4
+*/
+
+struct G4Code
+{
+    unsigned short code;
+    unsigned char length;
+};
+
+// T.4 run length codes: terminating (0-63) and makeup (64-1728) per color, extended makeup
+// (1792-2560) shared
+static const G4Code kWhiteTerminating[64] =
+{
+    { 0x35, 8 }, { 0x7, 6 }, { 0x7, 4 }, { 0x8, 4 }, { 0xB, 4 }, { 0xC, 4 }, { 0xE, 4 }, { 0xF, 4 },
+    { 0x13, 5 }, { 0x14, 5 }, { 0x7, 5 }, { 0x8, 5 }, { 0x8, 6 }, { 0x3, 6 }, { 0x34, 6 }, { 0x35, 6 },
+    { 0x2A, 6 }, { 0x2B, 6 }, { 0x27, 7 }, { 0xC, 7 }, { 0x8, 7 }, { 0x17, 7 }, { 0x3, 7 }, { 0x4, 7 },
+    { 0x28, 7 }, { 0x2B, 7 }, { 0x13, 7 }, { 0x24, 7 }, { 0x18, 7 }, { 0x2, 8 }, { 0x3, 8 }, { 0x1A, 8 },
+    { 0x1B, 8 }, { 0x12, 8 }, { 0x13, 8 }, { 0x14, 8 }, { 0x15, 8 }, { 0x16, 8 }, { 0x17, 8 }, { 0x28, 8 },
+    { 0x29, 8 }, { 0x2A, 8 }, { 0x2B, 8 }, { 0x2C, 8 }, { 0x2D, 8 }, { 0x4, 8 }, { 0x5, 8 }, { 0xA, 8 },
+    { 0xB, 8 }, { 0x52, 8 }, { 0x53, 8 }, { 0x54, 8 }, { 0x55, 8 }, { 0x24, 8 }, { 0x25, 8 }, { 0x58, 8 },
+    { 0x59, 8 }, { 0x5A, 8 }, { 0x5B, 8 }, { 0x4A, 8 }, { 0x4B, 8 }, { 0x32, 8 }, { 0x33, 8 }, { 0x34, 8 }
+};
+
+static const G4Code kBlackTerminating[64] =
+{
+    { 0x37, 10 }, { 0x2, 3 }, { 0x3, 2 }, { 0x2, 2 }, { 0x3, 3 }, { 0x3, 4 }, { 0x2, 4 }, { 0x3, 5 },
+    { 0x5, 6 }, { 0x4, 6 }, { 0x4, 7 }, { 0x5, 7 }, { 0x7, 7 }, { 0x4, 8 }, { 0x7, 8 }, { 0x18, 9 },
+    { 0x17, 10 }, { 0x18, 10 }, { 0x8, 10 }, { 0x67, 11 }, { 0x68, 11 }, { 0x6C, 11 }, { 0x37, 11 }, { 0x28, 11 },
+    { 0x17, 11 }, { 0x18, 11 }, { 0xCA, 12 }, { 0xCB, 12 }, { 0xCC, 12 }, { 0xCD, 12 }, { 0x68, 12 }, { 0x69, 12 },
+    { 0x6A, 12 }, { 0x6B, 12 }, { 0xD2, 12 }, { 0xD3, 12 }, { 0xD4, 12 }, { 0xD5, 12 }, { 0xD6, 12 }, { 0xD7, 12 },
+    { 0x6C, 12 }, { 0x6D, 12 }, { 0xDA, 12 }, { 0xDB, 12 }, { 0x54, 12 }, { 0x55, 12 }, { 0x56, 12 }, { 0x57, 12 },
+    { 0x64, 12 }, { 0x65, 12 }, { 0x52, 12 }, { 0x53, 12 }, { 0x24, 12 }, { 0x37, 12 }, { 0x38, 12 }, { 0x27, 12 },
+    { 0x28, 12 }, { 0x58, 12 }, { 0x59, 12 }, { 0x2B, 12 }, { 0x2C, 12 }, { 0x5A, 12 }, { 0x66, 12 }, { 0x67, 12 }
+};
+
+static const G4Code kWhiteMakeup[27] =
+{
+    { 0x1B, 5 }, { 0x12, 5 }, { 0x17, 6 }, { 0x37, 7 }, { 0x36, 8 }, { 0x37, 8 }, { 0x64, 8 }, { 0x65, 8 },
+    { 0x68, 8 }, { 0x67, 8 }, { 0xCC, 9 }, { 0xCD, 9 }, { 0xD2, 9 }, { 0xD3, 9 }, { 0xD4, 9 }, { 0xD5, 9 },
+    { 0xD6, 9 }, { 0xD7, 9 }, { 0xD8, 9 }, { 0xD9, 9 }, { 0xDA, 9 }, { 0xDB, 9 }, { 0x98, 9 }, { 0x99, 9 },
+    { 0x9A, 9 }, { 0x18, 6 }, { 0x9B, 9 }
+};
+
+static const G4Code kBlackMakeup[27] =
+{
+    { 0xF, 10 }, { 0xC8, 12 }, { 0xC9, 12 }, { 0x5B, 12 }, { 0x33, 12 }, { 0x34, 12 }, { 0x35, 12 }, { 0x6C, 13 },
+    { 0x6D, 13 }, { 0x4A, 13 }, { 0x4B, 13 }, { 0x4C, 13 }, { 0x4D, 13 }, { 0x72, 13 }, { 0x73, 13 }, { 0x74, 13 },
+    { 0x75, 13 }, { 0x76, 13 }, { 0x77, 13 }, { 0x52, 13 }, { 0x53, 13 }, { 0x54, 13 }, { 0x55, 13 }, { 0x5A, 13 },
+    { 0x5B, 13 }, { 0x64, 13 }, { 0x65, 13 }
+};
+
+static const G4Code kExtendedMakeup[13] =
+{
+    { 0x8, 11 }, { 0xC, 11 }, { 0xD, 11 }, { 0x12, 12 }, { 0x13, 12 }, { 0x14, 12 }, { 0x15, 12 }, { 0x16, 12 },
+    { 0x17, 12 }, { 0x1C, 12 }, { 0x1D, 12 }, { 0x1E, 12 }, { 0x1F, 12 }
+};
+
+/**
+* Bit writer, most significant bit first
+**/
+struct G4BitWriter
+{
+    vector<unsigned char>* out;
+    uint32_t buffer;
+    int count;
+
+    void Put(uint32_t code, int length)
+    {
+        buffer = (buffer << length) | code;
+        count += length;
+        while (count >= 8)
+        {
+            count -= 8;
+            out->push_back((unsigned char)(buffer >> count));
+        }
+    }
+
+    void Flush()
+    {
+        if (count > 0)
+        {
+            out->push_back((unsigned char)(buffer << (8 - count)));
+        }
+        count = 0;
+    }
+};
+
+/**
+* Run length of one color: makeup codes of up to 2560, then a terminating code
+**/
+static void PutRun(G4BitWriter* writer, int run, bool black)
+{
+    const G4Code* terminating = black ? kBlackTerminating : kWhiteTerminating;
+    const G4Code* makeup = black ? kBlackMakeup : kWhiteMakeup;
+    while (run >= 2560 + 64)
+    {
+        writer->Put(kExtendedMakeup[12].code, kExtendedMakeup[12].length);
+        run -= 2560;
+    }
+    if (run >= 64)
+    {
+        int index = run / 64 - 1;
+        const G4Code& code = index < 27 ? makeup[index] : kExtendedMakeup[index - 27];
+        writer->Put(code.code, code.length);
+        run %= 64;
+    }
+    writer->Put(terminating[run].code, terminating[run].length);
+}
+
+/**
+* Changing elements of a row - positions where the color differs from the pixel before, the
+* pixel before the row being white - followed by three sentinels at the row width
+* return value : Number of changing elements
+**/
+static int FindChanges(const unsigned char* row, int width, int* changes)
+{
+    int count = 0;
+    int color = 0;
+    int x = 0;
+    while (x < width)
+    {
+        // Whole bytes of the current color
+        if ((x & 7) == 0)
+        {
+            unsigned char same = color != 0 ? 0xFF : 0x00;
+            while (x + 8 <= width && row[x >> 3] == same)
+            {
+                x += 8;
+            }
+            if (x >= width)
+            {
+                break;
+            }
+        }
+        if (((row[x >> 3] >> (7 - (x & 7))) & 1) != color)
+        {
+            changes[count++] = x;
+            color ^= 1;
+        }
+        x++;
+    }
+    changes[count] = changes[count + 1] = changes[count + 2] = width;
+    return count;
+}
+
+/**
+* T.6 coding: each row is coded against the row above (an imaginary white row for the first) in
+* pass, vertical or horizontal mode
+**/
+static void EncodeG4(const BilevelImage& image, vector<int>* changes, G4BitWriter* writer)
+{
+    // Vertical mode codes for a1 - b1 = -3 .. 3
+    static const G4Code kVertical[7] =
+    {
+        { 0x2, 7 }, { 0x2, 6 }, { 0x2, 3 }, { 0x1, 1 }, { 0x3, 3 }, { 0x3, 6 }, { 0x3, 7 }
+    };
+    int width = image.width;
+    changes->resize(2 * ((size_t)width + 4));
+    int* reference = changes->data();
+    int* coding = reference + width + 4;
+    reference[0] = reference[1] = reference[2] = width;
+
+    for (int y = 0; y < image.height; y++)
+    {
+        FindChanges(&image.bits[(size_t)y * image.stride], width, coding);
+        int a0 = -1;
+        int color = 0;
+        int coding_index = 0;
+        int reference_index = 0;
+        while (a0 < width)
+        {
+            while (coding[coding_index] <= a0)
+            {
+                coding_index++;
+            }
+            while (reference[reference_index] <= a0)
+            {
+                reference_index++;
+            }
+            // b1 changes to the color opposite to a0's: to black at even indexes
+            int b_index = reference_index + ((reference_index & 1) != color ? 1 : 0);
+            int a1 = coding[coding_index];
+            int b1 = reference[b_index];
+            int b2 = reference[b_index + 1];
+            if (b2 < a1)
+            {
+                writer->Put(0x1, 4);
+                a0 = b2;
+            }
+            else if (a1 - b1 >= -3 && a1 - b1 <= 3)
+            {
+                writer->Put(kVertical[a1 - b1 + 3].code, kVertical[a1 - b1 + 3].length);
+                a0 = a1;
+                color ^= 1;
+            }
+            else
+            {
+                int a2 = coding[coding_index + 1];
+                writer->Put(0x1, 3);
+                PutRun(writer, a1 - max(a0, 0), color != 0);
+                PutRun(writer, a2 - a1, color == 0);
+                a0 = a2;
+            }
+        }
+        swap(reference, coding);
+    }
+
+    // EOFB
+    writer->Put(0x1, 12);
+    writer->Put(0x1, 12);
+    writer->Flush();
+}
+
+void EncodeTiffG4(const BilevelImage& image, vector<int>* changes, vector<unsigned char>* out)
+{
+    struct LeWriter
+    {
+        static void U16(vector<unsigned char>* to, uint32_t value)
+        {
+            to->push_back((unsigned char)value);
+            to->push_back((unsigned char)(value >> 8));
+        }
+        static void U32(vector<unsigned char>* to, uint32_t value)
+        {
+            U16(to, value & 0xFFFF);
+            U16(to, value >> 16);
+        }
+        static void Entry(vector<unsigned char>* to, uint32_t tag, uint32_t type, uint32_t count, uint32_t value)
+        {
+            U16(to, tag);
+            U16(to, type);
+            U32(to, count);
+            if (type == 3 && count == 1)
+            {
+                U16(to, value);
+                U16(to, 0);
+            }
+            else
+            {
+                U32(to, value);
+            }
+        }
+    };
+    out->assign({ 'I', 'I', 42, 0, 0, 0, 0, 0 });
+    G4BitWriter writer = { out, 0, 0 };
+    EncodeG4(image, changes, &writer);
+    uint32_t strip_size = (uint32_t)out->size() - 8;
+    if (out->size() & 1)
+    {
+        out->push_back(0);
+    }
+
+    uint32_t ifd = (uint32_t)out->size();
+    (*out)[4] = (unsigned char)ifd;
+    (*out)[5] = (unsigned char)(ifd >> 8);
+    (*out)[6] = (unsigned char)(ifd >> 16);
+    (*out)[7] = (unsigned char)(ifd >> 24);
+    LeWriter::U16(out, 9);
+    LeWriter::Entry(out, 256, 4, 1, (uint32_t)image.width);
+    LeWriter::Entry(out, 257, 4, 1, (uint32_t)image.height);
+    LeWriter::Entry(out, 258, 3, 1, 1);
+    LeWriter::Entry(out, 259, 3, 1, 4);
+    LeWriter::Entry(out, 262, 3, 1, 0);
+    LeWriter::Entry(out, 273, 4, 1, 8);
+    LeWriter::Entry(out, 277, 3, 1, 1);
+    LeWriter::Entry(out, 278, 4, 1, (uint32_t)image.height);
+    LeWriter::Entry(out, 279, 4, 1, strip_size);
+    LeWriter::U32(out, 0);
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************************
+* @file bilevel.h
+* @brief Ink detection, cropping and binarization of gray images, CCITT G4 (TIFF) encoding
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "image_codec.h"
+
+/**
+* Bilevel image: rows of packed bits, most significant bit first, 1 - ink. The bit vector keeps
+* its capacity when the image is reused.
+**/
+struct BilevelImage
+{
+    int width;
+    int height;
+    size_t stride;      // Bytes per row
+    std::vector<unsigned char> bits;
+
+    BilevelImage() : width(0), height(0), stride(0) {}
+
+    void Resize(int new_width, int new_height)
+    {
+        width = new_width;
+        height = new_height;
+        stride = ((size_t)new_width + 7) / 8;
+        bits.resize(stride * new_height);
+    }
+};
+
+/**
+* Rectangle of an image in pixels, right and bottom exclusive
+**/
+struct InkBounds
+{
+    int left;
+    int top;
+    int right;
+    int bottom;
+
+    InkBounds() : left(0), top(0), right(0), bottom(0) {}
+
+    int Width() const { return right - left; }
+    int Height() const { return bottom - top; }
+};
+
+/**
+* Convert an RGB image to gray (ITU-R BT.601 luma), gray images are copied
+*/
+void ConvertToGray(const Image& source, Image* gray);
+
+/**
+* Gray level separating ink from paper, by Otsu's method over the histogram
+* @param min_contrast - Least difference between the mean ink and paper levels, below it the image is blank
+* return value : Pixels below it are ink, 0 for a blank image
+*/
+int FindInkThreshold(const Image& gray, int min_contrast);
+
+/**
+* Bounding box of the ink. Every pixel is read once: row minimums and column minimums are taken
+* together, 16 pixels at a time with SSE2.
+* @param threshold - Pixels below it are ink
+* @param margin - Paper kept around the ink, in pixels
+* @param column_min - Scratch buffer, reused between calls
+* return value : false if there is no ink
+*/
+bool FindInkBounds(const Image& gray, int threshold, int margin, InkBounds* bounds, std::vector<unsigned char>* column_min);
+
+/**
+* Binarize a region of a gray image, 16 pixels at a time with SSE2
+* @param threshold - Pixels below it are ink
+*/
+void Binarize(const Image& gray, const InkBounds& region, int threshold, BilevelImage* bilevel);
+
+/**
+* Encode a single strip TIFF, CCITT Group 4 (T.6) compressed, white is zero
+* @param changes - Scratch buffer for the changing elements of two rows, reused between calls
+* @param out - Receives the file, its capacity is reused
+*/
+void EncodeTiffG4(const BilevelImage& image, std::vector<int>* changes, std::vector<unsigned char>* out);
@@ -0,0 +1,1543 @@
+/*******************************************************************************************
+* @file image_codec.cpp
+* @brief Definition of the scanner image decoders and encoders
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "image_codec.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+static uint16_t ReadLe16(const unsigned char* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t ReadLe32(const unsigned char* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t ReadBe16(const unsigned char* p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t ReadBe32(const unsigned char* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+ImageFileFormat DetectImageFormat(const unsigned char* data, size_t size)
+{
+    if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+    {
+        return kImageJpeg;
+    }
+    if (size >= 2 && data[0] == 'B' && data[1] == 'M')
+    {
+        return kImageBmp;
+    }
+    if (size >= 4 && ((data[0] == 'I' && data[1] == 'I' && data[2] == 42 && data[3] == 0) ||
+        (data[0] == 'M' && data[1] == 'M' && data[2] == 0 && data[3] == 42)))
+    {
+        return kImageTiff;
+    }
+    return kImageUnknown;
+}
+
+/*
+* BMP
+*/
+
+bool DecodeBmp(const unsigned char* data, size_t size, size_t max_pixels, Image* image)
+{
+    const size_t kFileHeaderSize = 14;
+    if (size < kFileHeaderSize + 40 || data[0] != 'B' || data[1] != 'M')
+    {
+        return false;
+    }
+    uint32_t pixel_offset = ReadLe32(data + 10);
+    uint32_t header_size = ReadLe32(data + 14);
+    int64_t width = (int32_t)ReadLe32(data + 18);
+    int64_t height = (int32_t)ReadLe32(data + 22);
+    int bits = ReadLe16(data + 28);
+    uint32_t compression = ReadLe32(data + 30);
+    uint32_t colors_used = ReadLe32(data + 46);
+    bool top_down = height < 0;
+    height = top_down ? -height : height;
+    if (header_size < 40 || header_size > size - kFileHeaderSize || width <= 0 || height <= 0 ||
+        (uint64_t)width * (uint64_t)height > max_pixels)
+    {
+        return false;
+    }
+    // BI_RGB, or BI_BITFIELDS with the usual BGRA masks of 32 bit images
+    if ((bits != 1 && bits != 4 && bits != 8 && bits != 24 && bits != 32) || !(compression == 0 || (compression == 3 && bits == 32)))
+    {
+        return false;
+    }
+    size_t stride = (((size_t)width * bits + 31) / 32) * 4;
+    if (pixel_offset > size || stride * (size_t)height > size - pixel_offset)
+    {
+        return false;
+    }
+
+    // Palette as RGB triplets, gray if every entry has equal components
+    unsigned char palette[256][3] = {};
+    bool gray = false;
+    if (bits <= 8)
+    {
+        size_t entries = colors_used != 0 && colors_used < (1u << bits) ? colors_used : (1u << bits);
+        size_t palette_offset = kFileHeaderSize + header_size;
+        if (palette_offset > pixel_offset || entries > (pixel_offset - palette_offset) / 4)
+        {
+            return false;
+        }
+        gray = true;
+        for (size_t i = 0; i < entries; i++)
+        {
+            const unsigned char* entry = data + palette_offset + i * 4;
+            palette[i][0] = entry[2];
+            palette[i][1] = entry[1];
+            palette[i][2] = entry[0];
+            gray = gray && entry[0] == entry[1] && entry[1] == entry[2];
+        }
+    }
+
+    int channels = gray ? 1 : 3;
+    image->Resize((int)width, (int)height, channels);
+    for (int y = 0; y < (int)height; y++)
+    {
+        const unsigned char* row = data + pixel_offset + (size_t)(top_down ? y : (int)height - 1 - y) * stride;
+        unsigned char* out = &image->pixels[(size_t)y * (size_t)width * channels];
+        if (bits == 24 || bits == 32)
+        {
+            int step = bits / 8;
+            for (int x = 0; x < (int)width; x++, row += step, out += 3)
+            {
+                out[0] = row[2];
+                out[1] = row[1];
+                out[2] = row[0];
+            }
+            continue;
+        }
+        if (bits == 8 && gray)
+        {
+            for (int x = 0; x < (int)width; x++)
+            {
+                out[x] = palette[row[x]][0];
+            }
+            continue;
+        }
+        int per_byte = 8 / bits;
+        int mask = (1 << bits) - 1;
+        for (int x = 0; x < (int)width; x++)
+        {
+            int shift = 8 - bits * (x % per_byte + 1);
+            int index = (row[x / per_byte] >> shift) & mask;
+            if (gray)
+            {
+                *out++ = palette[index][0];
+            }
+            else
+            {
+                *out++ = palette[index][0];
+                *out++ = palette[index][1];
+                *out++ = palette[index][2];
+            }
+        }
+    }
+    return true;
+}
+
+void EncodeBmp(const Image& image, vector<unsigned char>* out)
+{
+    const size_t kHeadersSize = 14 + 40;
+    bool gray = image.channels == 1;
+    size_t palette_size = gray ? 256 * 4 : 0;
+    size_t stride = (((size_t)image.width * (gray ? 8 : 24) + 31) / 32) * 4;
+    size_t pixel_offset = kHeadersSize + palette_size;
+    size_t file_size = pixel_offset + stride * image.height;
+    out->assign(file_size, 0);
+    unsigned char* p = out->data();
+
+    struct LeWriter
+    {
+        static void U16(unsigned char* at, uint32_t value) { at[0] = (unsigned char)value; at[1] = (unsigned char)(value >> 8); }
+        static void U32(unsigned char* at, uint32_t value) { U16(at, value & 0xFFFF); U16(at + 2, value >> 16); }
+    };
+    p[0] = 'B';
+    p[1] = 'M';
+    LeWriter::U32(p + 2, (uint32_t)file_size);
+    LeWriter::U32(p + 10, (uint32_t)pixel_offset);
+    LeWriter::U32(p + 14, 40);
+    LeWriter::U32(p + 18, (uint32_t)image.width);
+    LeWriter::U32(p + 22, (uint32_t)image.height);
+    LeWriter::U16(p + 26, 1);
+    LeWriter::U16(p + 28, gray ? 8 : 24);
+    LeWriter::U32(p + 34, (uint32_t)(stride * image.height));
+    LeWriter::U32(p + 38, 2835);    // 72 dpi
+    LeWriter::U32(p + 42, 2835);
+    if (gray)
+    {
+        LeWriter::U32(p + 46, 256);
+        for (int i = 0; i < 256; i++)
+        {
+            p[kHeadersSize + i * 4] = p[kHeadersSize + i * 4 + 1] = p[kHeadersSize + i * 4 + 2] = (unsigned char)i;
+        }
+    }
+    for (int y = 0; y < image.height; y++)
+    {
+        const unsigned char* row = &image.pixels[(size_t)y * image.width * image.channels];
+        unsigned char* dst = p + pixel_offset + (size_t)(image.height - 1 - y) * stride;
+        if (gray)
+        {
+            memcpy(dst, row, image.width);
+            continue;
+        }
+        for (int x = 0; x < image.width; x++, row += 3, dst += 3)
+        {
+            dst[0] = row[2];
+            dst[1] = row[1];
+            dst[2] = row[0];
+        }
+    }
+}
+
+/*
+* TIFF
+*/
+
+/**
+* Reads the byte order of a TIFF file, bounds checked
+**/
+struct TiffReader
+{
+    const unsigned char* data;
+    size_t size;
+    bool big_endian;
+
+    bool U16(size_t offset, uint32_t* value) const
+    {
+        if (offset > size || size - offset < 2)
+        {
+            return false;
+        }
+        *value = big_endian ? ReadBe16(data + offset) : ReadLe16(data + offset);
+        return true;
+    }
+
+    bool U32(size_t offset, uint32_t* value) const
+    {
+        if (offset > size || size - offset < 4)
+        {
+            return false;
+        }
+        *value = big_endian ? ReadBe32(data + offset) : ReadLe32(data + offset);
+        return true;
+    }
+
+    /**
+    * Values of a SHORT or LONG directory entry
+    */
+    bool Values(size_t entry, vector<uint32_t>* values) const
+    {
+        const uint32_t kMaxValues = 1 << 20;
+        uint32_t type = 0;
+        uint32_t count = 0;
+        if (!U16(entry + 2, &type) || !U32(entry + 4, &count) || (type != 3 && type != 4) || count == 0 || count > kMaxValues)
+        {
+            return false;
+        }
+        size_t item_size = type == 3 ? 2 : 4;
+        size_t offset = entry + 8;
+        if (count * item_size > 4)
+        {
+            uint32_t pointer = 0;
+            if (!U32(entry + 8, &pointer))
+            {
+                return false;
+            }
+            offset = pointer;
+        }
+        values->resize(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (!(type == 3 ? U16(offset + i * item_size, &(*values)[i]) : U32(offset + i * item_size, &(*values)[i])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+* Expand a PackBits strip
+* return value : False if the strip is shorter than expected
+**/
+static bool UnpackBits(const unsigned char* in, size_t in_size, unsigned char* out, size_t out_size)
+{
+    size_t i = 0;
+    size_t o = 0;
+    while (o < out_size && i < in_size)
+    {
+        int n = (signed char)in[i++];
+        if (n >= 0)
+        {
+            size_t count = (size_t)n + 1;
+            if (count > in_size - i || count > out_size - o)
+            {
+                return false;
+            }
+            memcpy(out + o, in + i, count);
+            i += count;
+            o += count;
+        }
+        else if (n != -128)
+        {
+            size_t count = (size_t)(1 - n);
+            if (i >= in_size || count > out_size - o)
+            {
+                return false;
+            }
+            memset(out + o, in[i++], count);
+            o += count;
+        }
+    }
+    return o == out_size;
+}
+
+bool DecodeTiff(const unsigned char* data, size_t size, size_t max_pixels, Image* image)
+{
+    if (DetectImageFormat(data, size) != kImageTiff || size < 8)
+    {
+        return false;
+    }
+    TiffReader tiff = { data, size, data[0] == 'M' };
+    uint32_t ifd = 0;
+    uint32_t entry_count = 0;
+    if (!tiff.U32(4, &ifd) || !tiff.U16(ifd, &entry_count))
+    {
+        return false;
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t bits = 1;
+    uint32_t compression = 1;
+    uint32_t photometric = 1;
+    uint32_t samples = 1;
+    uint32_t rows_per_strip = 0xFFFFFFFF;
+    uint32_t planar = 1;
+    vector<uint32_t> strip_offsets;
+    vector<uint32_t> strip_sizes;
+    vector<uint32_t> values;
+    for (uint32_t i = 0; i < entry_count; i++)
+    {
+        size_t entry = (size_t)ifd + 2 + (size_t)i * 12;
+        uint32_t tag = 0;
+        if (!tiff.U16(entry, &tag))
+        {
+            return false;
+        }
+        switch (tag)
+        {
+        case 256:   // ImageWidth
+        case 257:   // ImageLength
+        case 258:   // BitsPerSample
+        case 259:   // Compression
+        case 262:   // PhotometricInterpretation
+        case 277:   // SamplesPerPixel
+        case 278:   // RowsPerStrip
+        case 284:   // PlanarConfiguration
+            if (!tiff.Values(entry, &values))
+            {
+                return false;
+            }
+            *(tag == 256 ? &width : tag == 257 ? &height : tag == 258 ? &bits : tag == 259 ? &compression :
+                tag == 262 ? &photometric : tag == 277 ? &samples : tag == 278 ? &rows_per_strip : &planar) = values[0];
+            break;
+        case 273:   // StripOffsets
+            if (!tiff.Values(entry, &strip_offsets))
+            {
+                return false;
+            }
+            break;
+        case 279:   // StripByteCounts
+            if (!tiff.Values(entry, &strip_sizes))
+            {
+                return false;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool bilevel = bits == 1 && samples == 1 && photometric <= 1;
+    bool gray = bits == 8 && samples == 1 && photometric <= 1;
+    bool rgb = bits == 8 && samples == 3 && photometric == 2;
+    if (width == 0 || height == 0 || (uint64_t)width * height > max_pixels || !(bilevel || gray || rgb) ||
+        (compression != 1 && compression != 32773) || planar != 1 || rows_per_strip == 0)
+    {
+        return false;
+    }
+    rows_per_strip = min(rows_per_strip, height);
+    size_t strip_count = (height + rows_per_strip - 1) / rows_per_strip;
+    if (strip_offsets.size() < strip_count || (compression != 1 && strip_sizes.size() < strip_count))
+    {
+        return false;
+    }
+
+    size_t row_bytes = ((size_t)width * samples * bits + 7) / 8;
+    int channels = rgb ? 3 : 1;
+    image->Resize((int)width, (int)height, channels);
+    vector<unsigned char> unpacked;
+    for (size_t strip = 0; strip < strip_count; strip++)
+    {
+        uint32_t first_row = (uint32_t)strip * rows_per_strip;
+        uint32_t rows = min(rows_per_strip, height - first_row);
+        size_t strip_bytes = row_bytes * rows;
+        size_t offset = strip_offsets[strip];
+        size_t stored = compression == 1 ? strip_bytes : strip_sizes[strip];
+        if (offset > size || stored > size - offset)
+        {
+            return false;
+        }
+        const unsigned char* rows_data = data + offset;
+        if (compression == 32773)
+        {
+            unpacked.resize(strip_bytes);
+            if (!UnpackBits(data + offset, stored, unpacked.data(), strip_bytes))
+            {
+                return false;
+            }
+            rows_data = unpacked.data();
+        }
+        for (uint32_t r = 0; r < rows; r++)
+        {
+            const unsigned char* row = rows_data + r * row_bytes;
+            unsigned char* out = &image->pixels[(size_t)(first_row + r) * width * channels];
+            if (bilevel)
+            {
+                // WhiteIsZero (0): a set bit is black
+                unsigned char set = photometric == 0 ? 0 : 255;
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    out[x] = (row[x >> 3] & (0x80 >> (x & 7))) ? set : (unsigned char)(255 - set);
+                }
+            }
+            else if (gray && photometric == 0)
+            {
+                for (uint32_t x = 0; x < width; x++)
+                {
+                    out[x] = (unsigned char)(255 - row[x]);
+                }
+            }
+            else
+            {
+                memcpy(out, row, (size_t)width * channels);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+* PackBits compression of one strip: runs of 3 or more equal bytes, literals otherwise
+**/
+static void PackBits(const unsigned char* in, size_t size, vector<unsigned char>* out)
+{
+    size_t i = 0;
+    while (i < size)
+    {
+        size_t run = 1;
+        while (i + run < size && run < 128 && in[i + run] == in[i])
+        {
+            run++;
+        }
+        if (run >= 3)
+        {
+            out->push_back((unsigned char)(1 - (int)run));
+            out->push_back(in[i]);
+            i += run;
+            continue;
+        }
+        size_t literal = 0;
+        while (i + literal < size && literal < 128 &&
+            !(i + literal + 2 < size && in[i + literal] == in[i + literal + 1] && in[i + literal] == in[i + literal + 2]))
+        {
+            literal++;
+        }
+        out->push_back((unsigned char)(literal - 1));
+        out->insert(out->end(), in + i, in + i + literal);
+        i += literal;
+    }
+}
+
+void EncodeTiff(const Image& image, bool pack_bits, vector<unsigned char>* out)
+{
+    struct LeWriter
+    {
+        static void U16(vector<unsigned char>* to, uint32_t value)
+        {
+            to->push_back((unsigned char)value);
+            to->push_back((unsigned char)(value >> 8));
+        }
+        static void U32(vector<unsigned char>* to, uint32_t value)
+        {
+            U16(to, value & 0xFFFF);
+            U16(to, value >> 16);
+        }
+        static void Entry(vector<unsigned char>* to, uint32_t tag, uint32_t type, uint32_t count, uint32_t value)
+        {
+            U16(to, tag);
+            U16(to, type);
+            U32(to, count);
+            if (type == 3 && count == 1)
+            {
+                U16(to, value);
+                U16(to, 0);
+            }
+            else
+            {
+                U32(to, value);
+            }
+        }
+    };
+    size_t row_bytes = (size_t)image.width * image.channels;
+    uint32_t rows_per_strip = (uint32_t)max<size_t>(1, 8192 / max<size_t>(1, row_bytes));
+    uint32_t strip_count = (image.height + rows_per_strip - 1) / rows_per_strip;
+
+    out->assign({ 'I', 'I', 42, 0, 0, 0, 0, 0 });
+    vector<uint32_t> strip_offsets;
+    vector<uint32_t> strip_sizes;
+    for (uint32_t strip = 0; strip < strip_count; strip++)
+    {
+        uint32_t first_row = strip * rows_per_strip;
+        uint32_t rows = min(rows_per_strip, (uint32_t)image.height - first_row);
+        const unsigned char* strip_data = &image.pixels[first_row * row_bytes];
+        strip_offsets.push_back((uint32_t)out->size());
+        if (pack_bits)
+        {
+            for (uint32_t r = 0; r < rows; r++)
+            {
+                // Rows are packed separately, as readers expect
+                PackBits(strip_data + r * row_bytes, row_bytes, out);
+            }
+        }
+        else
+        {
+            out->insert(out->end(), strip_data, strip_data + rows * row_bytes);
+        }
+        strip_sizes.push_back((uint32_t)out->size() - strip_offsets.back());
+        if (out->size() & 1)
+        {
+            out->push_back(0);
+        }
+    }
+
+    // Values that do not fit in a directory entry, then the directory
+    uint32_t bits_offset = (uint32_t)out->size();
+    for (int c = 0; c < image.channels; c++)
+    {
+        LeWriter::U16(out, 8);
+    }
+    uint32_t offsets_offset = (uint32_t)out->size();
+    for (size_t i = 0; i < strip_offsets.size(); i++)
+    {
+        LeWriter::U32(out, strip_offsets[i]);
+    }
+    uint32_t sizes_offset = (uint32_t)out->size();
+    for (size_t i = 0; i < strip_sizes.size(); i++)
+    {
+        LeWriter::U32(out, strip_sizes[i]);
+    }
+    uint32_t ifd = (uint32_t)out->size();
+    (*out)[4] = (unsigned char)ifd;
+    (*out)[5] = (unsigned char)(ifd >> 8);
+    (*out)[6] = (unsigned char)(ifd >> 16);
+    (*out)[7] = (unsigned char)(ifd >> 24);
+    bool color = image.channels == 3;
+    LeWriter::U16(out, 10);
+    LeWriter::Entry(out, 256, 4, 1, (uint32_t)image.width);
+    LeWriter::Entry(out, 257, 4, 1, (uint32_t)image.height);
+    LeWriter::Entry(out, 258, 3, image.channels, color ? bits_offset : 8);
+    LeWriter::Entry(out, 259, 3, 1, pack_bits ? 32773 : 1);
+    LeWriter::Entry(out, 262, 3, 1, color ? 2 : 1);
+    LeWriter::Entry(out, 273, 4, strip_count, strip_count == 1 ? strip_offsets[0] : offsets_offset);
+    LeWriter::Entry(out, 277, 3, 1, (uint32_t)image.channels);
+    LeWriter::Entry(out, 278, 4, 1, rows_per_strip);
+    LeWriter::Entry(out, 279, 4, strip_count, strip_count == 1 ? strip_sizes[0] : sizes_offset);
+    LeWriter::Entry(out, 284, 3, 1, 1);
+    LeWriter::U32(out, 0);
+}
+
+/*
+* JPEG
+*/
+
+static const unsigned char kZigzag[64] =
+{
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/**
+* Huffman table for decoding: a lookup of the codes up to kLookupBits long, canonical code ranges beyond
+**/
+struct JpegHuffman
+{
+    static const int kLookupBits = 9;
+
+    bool defined;
+    unsigned char lookup_length[1 << kLookupBits];  // 0 - longer code
+    unsigned char lookup_value[1 << kLookupBits];
+    int max_code[18];
+    int min_code[17];
+    int value_index[17];
+    unsigned char values[256];
+
+    bool Build(const unsigned char* counts, const unsigned char* table_values, int value_count)
+    {
+        memset(lookup_length, 0, sizeof(lookup_length));
+        memcpy(values, table_values, value_count);
+        int code = 0;
+        int k = 0;
+        for (int length = 1; length <= 16; length++)
+        {
+            value_index[length] = k;
+            min_code[length] = code;
+            for (int i = 0; i < counts[length - 1]; i++, k++, code++)
+            {
+                if (code >= (1 << length))
+                {
+                    return false;
+                }
+                if (length <= kLookupBits)
+                {
+                    int first = code << (kLookupBits - length);
+                    for (int j = 0; j < (1 << (kLookupBits - length)); j++)
+                    {
+                        lookup_length[first + j] = (unsigned char)length;
+                        lookup_value[first + j] = values[k];
+                    }
+                }
+            }
+            max_code[length] = counts[length - 1] != 0 ? code - 1 : -1;
+            code <<= 1;
+        }
+        max_code[17] = 0x7FFFFFFF;
+        defined = true;
+        return true;
+    }
+};
+
+/**
+* Entropy coded segment reader - removes the 0xFF00 stuffing and stops at markers
+**/
+struct JpegBitReader
+{
+    const unsigned char* data;
+    size_t size;
+    size_t position;
+    uint32_t buffer;        // Bits left aligned
+    int count;
+    bool at_marker;
+
+    void Reset(size_t start)
+    {
+        position = start;
+        buffer = 0;
+        count = 0;
+        at_marker = false;
+    }
+
+    void Fill()
+    {
+        while (count <= 24)
+        {
+            uint32_t byte = 0;
+            if (!at_marker && position < size)
+            {
+                byte = data[position];
+                if (byte == 0xFF)
+                {
+                    if (position + 1 < size && data[position + 1] == 0x00)
+                    {
+                        position += 2;
+                    }
+                    else
+                    {
+                        // Marker - pad with zero bits, a corrupt scan fails on its own
+                        at_marker = true;
+                        byte = 0;
+                    }
+                }
+                else
+                {
+                    position++;
+                }
+            }
+            buffer |= byte << (24 - count);
+            count += 8;
+        }
+    }
+
+    int Bits(int n)
+    {
+        if (n == 0)
+        {
+            return 0;
+        }
+        Fill();
+        int value = (int)(buffer >> (32 - n));
+        buffer <<= n;
+        count -= n;
+        return value;
+    }
+
+    /**
+    * return value : Decoded symbol, -1 for an invalid code
+    */
+    int Decode(const JpegHuffman& table)
+    {
+        Fill();
+        int peek = (int)(buffer >> (32 - JpegHuffman::kLookupBits));
+        int length = table.lookup_length[peek];
+        if (length != 0)
+        {
+            buffer <<= length;
+            count -= length;
+            return table.lookup_value[peek];
+        }
+        for (length = JpegHuffman::kLookupBits + 1; length <= 16; length++)
+        {
+            int code = (int)(buffer >> (32 - length));
+            if (code <= table.max_code[length])
+            {
+                buffer <<= length;
+                count -= length;
+                return table.values[table.value_index[length] + code - table.min_code[length]];
+            }
+        }
+        return -1;
+    }
+
+    /**
+    * Skip to the byte after the next RST marker
+    */
+    bool Restart()
+    {
+        size_t p = position;
+        while (p + 1 < size && !(data[p] == 0xFF && data[p + 1] >= 0xD0 && data[p + 1] <= 0xD7))
+        {
+            p++;
+        }
+        if (p + 1 >= size)
+        {
+            return false;
+        }
+        Reset(p + 2);
+        return true;
+    }
+};
+
+static int ExtendSign(int value, int bits)
+{
+    return value < (1 << (bits - 1)) ? value - (1 << bits) + 1 : value;
+}
+
+struct JpegComponent
+{
+    int id;
+    int h;
+    int v;
+    int quant;
+    int dc_table;
+    int ac_table;
+    int blocks_per_line;    // Whole MCUs
+    int block_lines;
+    bool decode;            // Inverse DCT into samples - luma only, chroma is skipped
+    unsigned char* samples; // Whole MCUs wide and high
+};
+
+/**
+* Inverse DCT of a dequantized block (AAN, floating point), 8 bit samples out. The AAN scale
+* factors are folded into the dequantization table.
+**/
+static void InverseDct8x8(float* block, unsigned char* out, size_t stride)
+{
+    for (int pass = 0; pass < 2; pass++)
+    {
+        // Columns, then rows
+        int step = pass == 0 ? 8 : 1;
+        int next = pass == 0 ? 1 : 8;
+        for (int i = 0; i < 8; i++)
+        {
+            float* d = block + i * next;
+            float tmp0 = d[0];
+            float tmp1 = d[2 * step];
+            float tmp2 = d[4 * step];
+            float tmp3 = d[6 * step];
+            float tmp10 = tmp0 + tmp2;
+            float tmp11 = tmp0 - tmp2;
+            float tmp13 = tmp1 + tmp3;
+            float tmp12 = (tmp1 - tmp3) * 1.414213562f - tmp13;
+            tmp0 = tmp10 + tmp13;
+            tmp3 = tmp10 - tmp13;
+            tmp1 = tmp11 + tmp12;
+            tmp2 = tmp11 - tmp12;
+
+            float tmp4 = d[1 * step];
+            float tmp5 = d[3 * step];
+            float tmp6 = d[5 * step];
+            float tmp7 = d[7 * step];
+            float z13 = tmp6 + tmp5;
+            float z10 = tmp6 - tmp5;
+            float z11 = tmp4 + tmp7;
+            float z12 = tmp4 - tmp7;
+            tmp7 = z11 + z13;
+            tmp11 = (z11 - z13) * 1.414213562f;
+            float z5 = (z10 + z12) * 1.847759065f;
+            tmp10 = 1.082392200f * z12 - z5;
+            tmp12 = -2.613125930f * z10 + z5;
+            tmp6 = tmp12 - tmp7;
+            tmp5 = tmp11 - tmp6;
+            tmp4 = tmp10 + tmp5;
+
+            d[0] = tmp0 + tmp7;
+            d[7 * step] = tmp0 - tmp7;
+            d[1 * step] = tmp1 + tmp6;
+            d[6 * step] = tmp1 - tmp6;
+            d[2 * step] = tmp2 + tmp5;
+            d[5 * step] = tmp2 - tmp5;
+            d[4 * step] = tmp3 + tmp4;
+            d[3 * step] = tmp3 - tmp4;
+        }
+    }
+    for (int y = 0; y < 8; y++)
+    {
+        for (int x = 0; x < 8; x++)
+        {
+            // Clamped before the conversion, which then only truncates
+            float value = block[y * 8 + x] * 0.125f + 128.5f;
+            value = value < 0.0f ? 0.0f : (value > 255.0f ? 255.0f : value);
+            out[y * stride + x] = (unsigned char)(int)value;
+        }
+    }
+}
+
+/**
+* Decode one scan, inverse transforming the blocks of the components to decode
+**/
+static bool DecodeJpegScan(JpegBitReader* reader, JpegComponent** scan, int scan_count, int width, int height,
+    int h_max, int v_max, int restart_interval, const JpegHuffman* dc_tables, const JpegHuffman* ac_tables, const float (*dequant)[64])
+{
+    int mcus_per_line = (width + 8 * h_max - 1) / (8 * h_max);
+    int mcu_lines = (height + 8 * v_max - 1) / (8 * v_max);
+    if (scan_count == 1)
+    {
+        // Non-interleaved: the component's own blocks, without the MCU padding
+        JpegComponent* c = scan[0];
+        mcus_per_line = ((width * c->h + h_max - 1) / h_max + 7) / 8;
+        mcu_lines = ((height * c->v + v_max - 1) / v_max + 7) / 8;
+    }
+    int predictions[4] = {};
+    int mcus_to_restart = restart_interval;
+    float block[64];
+    for (int mcu_y = 0; mcu_y < mcu_lines; mcu_y++)
+    {
+        for (int mcu_x = 0; mcu_x < mcus_per_line; mcu_x++)
+        {
+            if (restart_interval != 0 && mcus_to_restart-- == 0)
+            {
+                if (!reader->Restart())
+                {
+                    return false;
+                }
+                memset(predictions, 0, sizeof(predictions));
+                mcus_to_restart = restart_interval - 1;
+            }
+            for (int s = 0; s < scan_count; s++)
+            {
+                JpegComponent* c = scan[s];
+                const float* q = dequant[c->quant];
+                int blocks_h = scan_count == 1 ? 1 : c->h;
+                int blocks_v = scan_count == 1 ? 1 : c->v;
+                for (int by = 0; by < blocks_v; by++)
+                {
+                    for (int bx = 0; bx < blocks_h; bx++)
+                    {
+                        int category = reader->Decode(dc_tables[c->dc_table]);
+                        if (category < 0 || category > 11)
+                        {
+                            return false;
+                        }
+                        if (category != 0)
+                        {
+                            predictions[s] += ExtendSign(reader->Bits(category), category);
+                        }
+                        if (c->decode)
+                        {
+                            memset(block, 0, sizeof(block));
+                            block[0] = predictions[s] * q[0];
+                        }
+                        for (int k = 1; k < 64;)
+                        {
+                            int symbol = reader->Decode(ac_tables[c->ac_table]);
+                            if (symbol < 0)
+                            {
+                                return false;
+                            }
+                            int run = symbol >> 4;
+                            int bits = symbol & 15;
+                            if (bits == 0)
+                            {
+                                if (run != 15)
+                                {
+                                    break;
+                                }
+                                k += 16;
+                                continue;
+                            }
+                            k += run;
+                            int value = reader->Bits(bits);
+                            if (c->decode && k < 64)
+                            {
+                                int n = kZigzag[k];
+                                block[n] = ExtendSign(value, bits) * q[n];
+                            }
+                            k++;
+                        }
+                        if (!c->decode)
+                        {
+                            continue;
+                        }
+                        int block_x = scan_count == 1 ? mcu_x : mcu_x * c->h + bx;
+                        int block_y = scan_count == 1 ? mcu_y : mcu_y * c->v + by;
+                        if (block_x < c->blocks_per_line && block_y < c->block_lines)
+                        {
+                            size_t stride = (size_t)c->blocks_per_line * 8;
+                            InverseDct8x8(block, &c->samples[(size_t)block_y * 8 * stride + (size_t)block_x * 8], stride);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool DecodeJpegLuma(const unsigned char* data, size_t size, size_t max_pixels, Image* image)
+{
+    static const float kAanScale[8] =
+    {
+        1.0f, 1.387039845f, 1.306562965f, 1.175875602f, 1.0f, 0.785694958f, 0.541196100f, 0.275899379f
+    };
+    if (DetectImageFormat(data, size) != kImageJpeg)
+    {
+        return false;
+    }
+    float dequant[4][64];
+    JpegHuffman dc_tables[4];
+    JpegHuffman ac_tables[4];
+    for (int i = 0; i < 4; i++)
+    {
+        dc_tables[i].defined = ac_tables[i].defined = false;
+        fill(dequant[i], dequant[i] + 64, 1.0f);
+    }
+    JpegComponent components[3];
+    int component_count = 0;
+    int width = 0;
+    int height = 0;
+    int h_max = 1;
+    int v_max = 1;
+    int restart_interval = 0;
+    bool scanned = false;
+
+    size_t position = 2;
+    while (position + 4 <= size)
+    {
+        if (data[position] != 0xFF)
+        {
+            position++;
+            continue;
+        }
+        int marker = data[position + 1];
+        // Fill bytes, stuffed bytes left after a scan, standalone markers
+        if (marker == 0xFF || marker == 0x00 || marker == 0x01 || marker == 0xD8 || (marker >= 0xD0 && marker <= 0xD7))
+        {
+            position += marker == 0xFF ? 1 : 2;
+            continue;
+        }
+        if (marker == 0xD9)
+        {
+            break;
+        }
+        size_t length = ReadBe16(data + position + 2);
+        if (length < 2 || length > size - position - 2)
+        {
+            return false;
+        }
+        const unsigned char* segment = data + position + 4;
+        size_t segment_size = length - 2;
+        size_t next = position + 2 + length;
+
+        if (marker == 0xDB)
+        {
+            // Quantization tables, to natural order with the AAN scale factors
+            for (size_t p = 0; p < segment_size;)
+            {
+                int precision = segment[p] >> 4;
+                int id = segment[p] & 15;
+                size_t table_size = precision == 0 ? 64 : 128;
+                if (id > 3 || table_size + 1 > segment_size - p)
+                {
+                    return false;
+                }
+                for (int k = 0; k < 64; k++)
+                {
+                    int n = kZigzag[k];
+                    int q = precision == 0 ? segment[p + 1 + k] : ReadBe16(segment + p + 1 + k * 2);
+                    dequant[id][n] = q * kAanScale[n / 8] * kAanScale[n % 8];
+                }
+                p += table_size + 1;
+            }
+        }
+        else if (marker == 0xC4)
+        {
+            for (size_t p = 0; p < segment_size;)
+            {
+                if (17 > segment_size - p)
+                {
+                    return false;
+                }
+                int table_class = segment[p] >> 4;
+                int id = segment[p] & 15;
+                int value_count = 0;
+                for (int i = 1; i <= 16; i++)
+                {
+                    value_count += segment[p + i];
+                }
+                if (table_class > 1 || id > 3 || value_count > 256 || (size_t)value_count > segment_size - p - 17)
+                {
+                    return false;
+                }
+                JpegHuffman& table = table_class == 0 ? dc_tables[id] : ac_tables[id];
+                if (!table.Build(segment + p + 1, segment + p + 17, value_count))
+                {
+                    return false;
+                }
+                p += 17 + value_count;
+            }
+        }
+        else if (marker == 0xDD)
+        {
+            if (segment_size < 2)
+            {
+                return false;
+            }
+            restart_interval = ReadBe16(segment);
+        }
+        else if (marker == 0xC0 || marker == 0xC1)
+        {
+            // Baseline or extended sequential, Huffman coded
+            if (segment_size < 6 || segment[0] != 8)
+            {
+                return false;
+            }
+            height = ReadBe16(segment + 1);
+            width = ReadBe16(segment + 3);
+            component_count = segment[5];
+            if (width == 0 || height == 0 || (uint64_t)width * height > max_pixels ||
+                (component_count != 1 && component_count != 3) || segment_size < 6 + 3 * (size_t)component_count)
+            {
+                return false;
+            }
+            for (int i = 0; i < component_count; i++)
+            {
+                JpegComponent& c = components[i];
+                c.id = segment[6 + i * 3];
+                c.h = segment[7 + i * 3] >> 4;
+                c.v = segment[7 + i * 3] & 15;
+                c.quant = segment[8 + i * 3] & 3;
+                if (c.h < 1 || c.h > 4 || c.v < 1 || c.v > 4)
+                {
+                    return false;
+                }
+                h_max = max(h_max, c.h);
+                v_max = max(v_max, c.v);
+            }
+            // Luma is sampled at full size in the JPEGs scanners write
+            if (components[0].h != h_max || components[0].v != v_max)
+            {
+                return false;
+            }
+            int mcus_per_line = (width + 8 * h_max - 1) / (8 * h_max);
+            int mcu_lines = (height + 8 * v_max - 1) / (8 * v_max);
+            for (int i = 0; i < component_count; i++)
+            {
+                JpegComponent& c = components[i];
+                c.blocks_per_line = mcus_per_line * c.h;
+                c.block_lines = mcu_lines * c.v;
+                c.decode = i == 0;
+            }
+            // Luma is decoded into the image, padded to whole MCUs until the end
+            JpegComponent& luma = components[0];
+            image->Resize(luma.blocks_per_line * 8, luma.block_lines * 8, 1);
+            memset(image->pixels.data(), 128, image->pixels.size());
+            luma.samples = image->pixels.data();
+        }
+        else if ((marker >= 0xC2 && marker <= 0xCF) && marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+        {
+            // Progressive, lossless, hierarchical or arithmetic coded
+            return false;
+        }
+        else if (marker == 0xDA)
+        {
+            if (component_count == 0 || segment_size < 1)
+            {
+                return false;
+            }
+            int scan_count = segment[0];
+            if (scan_count < 1 || scan_count > component_count || segment_size < 1 + 2 * (size_t)scan_count + 3)
+            {
+                return false;
+            }
+            JpegComponent* scan[3];
+            for (int s = 0; s < scan_count; s++)
+            {
+                int id = segment[1 + s * 2];
+                int tables = segment[2 + s * 2];
+                scan[s] = NULL;
+                for (int i = 0; i < component_count; i++)
+                {
+                    if (components[i].id == id)
+                    {
+                        scan[s] = &components[i];
+                    }
+                }
+                if (scan[s] == NULL || (tables >> 4) > 3 || (tables & 15) > 3 ||
+                    !dc_tables[tables >> 4].defined || !ac_tables[tables & 15].defined)
+                {
+                    return false;
+                }
+                scan[s]->dc_table = tables >> 4;
+                scan[s]->ac_table = tables & 15;
+            }
+            JpegBitReader reader = { data, size, 0, 0, 0, false };
+            reader.Reset(next);
+            if (!DecodeJpegScan(&reader, scan, scan_count, width, height, h_max, v_max, restart_interval,
+                dc_tables, ac_tables, dequant))
+            {
+                return false;
+            }
+            scanned = true;
+            next = reader.position;
+        }
+        position = next;
+    }
+    if (!scanned)
+    {
+        return false;
+    }
+
+    // Drop the MCU padding in place
+    size_t stride = (size_t)components[0].blocks_per_line * 8;
+    unsigned char* pixels = image->pixels.data();
+    for (int y = 1; y < height; y++)
+    {
+        memmove(pixels + (size_t)y * width, pixels + (size_t)y * stride, width);
+    }
+    image->Resize(width, height, 1);
+    return true;
+}
+
+/*
+* JPEG encoding
+*/
+
+static const unsigned char kLumaQuant[64] =
+{
+    16, 11, 10, 16, 24, 40, 51, 61, 12, 12, 14, 19, 26, 58, 60, 55,
+    14, 13, 16, 24, 40, 57, 69, 56, 14, 17, 22, 29, 51, 87, 80, 62,
+    18, 22, 37, 56, 68, 109, 103, 77, 24, 35, 55, 64, 81, 104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99
+};
+
+static const unsigned char kChromaQuant[64] =
+{
+    17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99, 47, 66, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99
+};
+
+// Huffman tables of ITU T.81 annex K: code counts by length, then the symbols
+static const unsigned char kLumaDcCounts[16] = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+static const unsigned char kChromaDcCounts[16] = { 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 };
+static const unsigned char kDcValues[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+static const unsigned char kLumaAcCounts[16] = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D };
+static const unsigned char kLumaAcValues[162] =
+{
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+    0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5,
+    0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+    0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+    0xF9, 0xFA
+};
+static const unsigned char kChromaAcCounts[16] = { 0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77 };
+static const unsigned char kChromaAcValues[162] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0,
+    0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26,
+    0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5,
+    0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+    0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+    0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+    0xF9, 0xFA
+};
+
+/**
+* Huffman table for encoding: code and length of each symbol
+**/
+struct JpegCodeTable
+{
+    uint16_t code[256];
+    unsigned char length[256];
+
+    void Build(const unsigned char* counts, const unsigned char* values)
+    {
+        int code_value = 0;
+        int k = 0;
+        for (int bits = 1; bits <= 16; bits++, code_value <<= 1)
+        {
+            for (int i = 0; i < counts[bits - 1]; i++, k++, code_value++)
+            {
+                code[values[k]] = (uint16_t)code_value;
+                length[values[k]] = (unsigned char)bits;
+            }
+        }
+    }
+};
+
+/**
+* Entropy coded segment writer with 0xFF stuffing
+**/
+struct JpegBitWriter
+{
+    vector<unsigned char>* out;
+    uint32_t buffer;
+    int count;
+
+    void Put(uint32_t bits, int length)
+    {
+        buffer |= bits << (24 - count - length);
+        count += length;
+        while (count >= 8)
+        {
+            unsigned char byte = (unsigned char)(buffer >> 16);
+            out->push_back(byte);
+            if (byte == 0xFF)
+            {
+                out->push_back(0);
+            }
+            buffer = (buffer << 8) & 0xFFFFFF;
+            count -= 8;
+        }
+    }
+
+    void Flush()
+    {
+        if (count > 0)
+        {
+            Put(0x7F, 7);
+        }
+        buffer = 0;
+        count = 0;
+    }
+};
+
+/**
+* Scaled forward DCT of 8 samples (AAN) - the scale factors are folded into the quantization
+**/
+static void ForwardDct8(float* d, int stride)
+{
+    float tmp0 = d[0] + d[7 * stride];
+    float tmp7 = d[0] - d[7 * stride];
+    float tmp1 = d[stride] + d[6 * stride];
+    float tmp6 = d[stride] - d[6 * stride];
+    float tmp2 = d[2 * stride] + d[5 * stride];
+    float tmp5 = d[2 * stride] - d[5 * stride];
+    float tmp3 = d[3 * stride] + d[4 * stride];
+    float tmp4 = d[3 * stride] - d[4 * stride];
+
+    float tmp10 = tmp0 + tmp3;
+    float tmp13 = tmp0 - tmp3;
+    float tmp11 = tmp1 + tmp2;
+    float tmp12 = tmp1 - tmp2;
+    d[0] = tmp10 + tmp11;
+    d[4 * stride] = tmp10 - tmp11;
+    float z1 = (tmp12 + tmp13) * 0.707106781f;
+    d[2 * stride] = tmp13 + z1;
+    d[6 * stride] = tmp13 - z1;
+
+    tmp10 = tmp4 + tmp5;
+    tmp11 = tmp5 + tmp6;
+    tmp12 = tmp6 + tmp7;
+    float z5 = (tmp10 - tmp12) * 0.382683433f;
+    float z2 = tmp10 * 0.541196100f + z5;
+    float z4 = tmp12 * 1.306562965f + z5;
+    float z3 = tmp11 * 0.707106781f;
+    float z11 = tmp7 + z3;
+    float z13 = tmp7 - z3;
+    d[5 * stride] = z13 + z2;
+    d[3 * stride] = z13 - z2;
+    d[stride] = z11 + z4;
+    d[7 * stride] = z11 - z4;
+}
+
+static void PutCategory(JpegBitWriter* writer, const JpegCodeTable& table, int run, int value)
+{
+    int magnitude = value < 0 ? -value : value;
+    int bits = 0;
+    while (magnitude >> bits)
+    {
+        bits++;
+    }
+    int symbol = (run << 4) | bits;
+    writer->Put(table.code[symbol], table.length[symbol]);
+    if (bits != 0)
+    {
+        writer->Put((uint32_t)(value < 0 ? value - 1 : value) & ((1u << bits) - 1), bits);
+    }
+}
+
+/**
+* Transform, quantize and code one 8x8 block (level shifted samples)
+* return value : DC coefficient, the prediction of the next block
+**/
+static int EncodeBlock(JpegBitWriter* writer, float* block, const float* scale, int prediction,
+    const JpegCodeTable& dc_table, const JpegCodeTable& ac_table)
+{
+    for (int row = 0; row < 8; row++)
+    {
+        ForwardDct8(block + row * 8, 1);
+    }
+    for (int column = 0; column < 8; column++)
+    {
+        ForwardDct8(block + column, 8);
+    }
+    int coefficients[64];
+    for (int k = 0; k < 64; k++)
+    {
+        float value = block[kZigzag[k]] * scale[kZigzag[k]];
+        coefficients[k] = (int)(value < 0 ? value - 0.5f : value + 0.5f);
+    }
+
+    PutCategory(writer, dc_table, 0, coefficients[0] - prediction);
+    int last = 63;
+    while (last > 0 && coefficients[last] == 0)
+    {
+        last--;
+    }
+    int run = 0;
+    for (int k = 1; k <= last; k++)
+    {
+        if (coefficients[k] == 0)
+        {
+            run++;
+            continue;
+        }
+        while (run >= 16)
+        {
+            writer->Put(ac_table.code[0xF0], ac_table.length[0xF0]);
+            run -= 16;
+        }
+        PutCategory(writer, ac_table, run, coefficients[k]);
+        run = 0;
+    }
+    if (last < 63)
+    {
+        writer->Put(ac_table.code[0x00], ac_table.length[0x00]);
+    }
+    return coefficients[0];
+}
+
+static void PutMarkerSegment(vector<unsigned char>* out, int marker, const unsigned char* body, size_t size)
+{
+    out->push_back(0xFF);
+    out->push_back((unsigned char)marker);
+    out->push_back((unsigned char)((size + 2) >> 8));
+    out->push_back((unsigned char)(size + 2));
+    out->insert(out->end(), body, body + size);
+}
+
+void EncodeJpeg(const Image& image, int quality, vector<unsigned char>* out)
+{
+    static const float kAanScale[8] =
+    {
+        1.0f * 2.828427125f, 1.387039845f * 2.828427125f, 1.306562965f * 2.828427125f, 1.175875602f * 2.828427125f,
+        1.0f * 2.828427125f, 0.785694958f * 2.828427125f, 0.541196100f * 2.828427125f, 0.275899379f * 2.828427125f
+    };
+    bool color = image.channels == 3;
+    int component_count = color ? 3 : 1;
+    quality = max(1, min(quality, 100));
+    int quality_scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+
+    // Quantization tables in zigzag order for the file, scale factors in natural order for the DCT output
+    unsigned char quant[2][64];
+    float scale[2][64];
+    for (int t = 0; t < 2; t++)
+    {
+        const unsigned char* base = t == 0 ? kLumaQuant : kChromaQuant;
+        for (int k = 0; k < 64; k++)
+        {
+            int n = kZigzag[k];
+            int q = max(1, min((base[n] * quality_scale + 50) / 100, 255));
+            quant[t][k] = (unsigned char)q;
+            scale[t][n] = 1.0f / (q * kAanScale[n / 8] * kAanScale[n % 8]);
+        }
+    }
+
+    out->clear();
+    out->push_back(0xFF);
+    out->push_back(0xD8);
+    static const unsigned char kJfif[14] = { 'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0 };
+    PutMarkerSegment(out, 0xE0, kJfif, sizeof(kJfif));
+
+    unsigned char dqt[130];
+    for (int t = 0; t < component_count && t < 2; t++)
+    {
+        dqt[t * 65] = (unsigned char)t;
+        memcpy(dqt + t * 65 + 1, quant[t], 64);
+    }
+    PutMarkerSegment(out, 0xDB, dqt, color ? 130 : 65);
+
+    unsigned char sof[15] = { 8, (unsigned char)(image.height >> 8), (unsigned char)image.height,
+        (unsigned char)(image.width >> 8), (unsigned char)image.width, (unsigned char)component_count };
+    for (int i = 0; i < component_count; i++)
+    {
+        sof[6 + i * 3] = (unsigned char)(i + 1);
+        sof[7 + i * 3] = 0x11;
+        sof[8 + i * 3] = (unsigned char)(i == 0 ? 0 : 1);
+    }
+    PutMarkerSegment(out, 0xC0, sof, 6 + 3 * component_count);
+
+    struct HuffmanTableSpec
+    {
+        unsigned char class_and_id;
+        const unsigned char* counts;
+        const unsigned char* values;
+    };
+    static const HuffmanTableSpec kTables[4] =
+    {
+        { 0x00, kLumaDcCounts, kDcValues },
+        { 0x10, kLumaAcCounts, kLumaAcValues },
+        { 0x01, kChromaDcCounts, kDcValues },
+        { 0x11, kChromaAcCounts, kChromaAcValues }
+    };
+    vector<unsigned char> dht;
+    for (int t = 0; t < (color ? 4 : 2); t++)
+    {
+        int value_count = 0;
+        for (int i = 0; i < 16; i++)
+        {
+            value_count += kTables[t].counts[i];
+        }
+        dht.push_back(kTables[t].class_and_id);
+        dht.insert(dht.end(), kTables[t].counts, kTables[t].counts + 16);
+        dht.insert(dht.end(), kTables[t].values, kTables[t].values + value_count);
+    }
+    PutMarkerSegment(out, 0xC4, dht.data(), dht.size());
+
+    unsigned char sos[10] = { (unsigned char)component_count };
+    for (int i = 0; i < component_count; i++)
+    {
+        sos[1 + i * 2] = (unsigned char)(i + 1);
+        sos[2 + i * 2] = (unsigned char)(i == 0 ? 0x00 : 0x11);
+    }
+    sos[1 + component_count * 2] = 0;
+    sos[2 + component_count * 2] = 63;
+    sos[3 + component_count * 2] = 0;
+    PutMarkerSegment(out, 0xDA, sos, 4 + 2 * component_count);
+
+    JpegCodeTable dc_tables[2];
+    JpegCodeTable ac_tables[2];
+    dc_tables[0].Build(kLumaDcCounts, kDcValues);
+    ac_tables[0].Build(kLumaAcCounts, kLumaAcValues);
+    dc_tables[1].Build(kChromaDcCounts, kDcValues);
+    ac_tables[1].Build(kChromaAcCounts, kChromaAcValues);
+
+    JpegBitWriter writer = { out, 0, 0 };
+    int predictions[3] = {};
+    float blocks[3][64];
+    for (int block_y = 0; block_y < image.height; block_y += 8)
+    {
+        for (int block_x = 0; block_x < image.width; block_x += 8)
+        {
+            // Edge blocks repeat the last row and column
+            for (int y = 0; y < 8; y++)
+            {
+                const unsigned char* row = &image.pixels[(size_t)min(block_y + y, image.height - 1) * image.width * image.channels];
+                for (int x = 0; x < 8; x++)
+                {
+                    const unsigned char* p = row + (size_t)min(block_x + x, image.width - 1) * image.channels;
+                    if (!color)
+                    {
+                        blocks[0][y * 8 + x] = p[0] - 128.0f;
+                        continue;
+                    }
+                    float r = p[0];
+                    float g = p[1];
+                    float b = p[2];
+                    blocks[0][y * 8 + x] = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+                    blocks[1][y * 8 + x] = -0.168736f * r - 0.331264f * g + 0.5f * b;
+                    blocks[2][y * 8 + x] = 0.5f * r - 0.418688f * g - 0.081312f * b;
+                }
+            }
+            for (int i = 0; i < component_count; i++)
+            {
+                int t = i == 0 ? 0 : 1;
+                predictions[i] = EncodeBlock(&writer, blocks[i], scale[t], predictions[i], dc_tables[t], ac_tables[t]);
+            }
+        }
+    }
+    writer.Flush();
+    out->push_back(0xFF);
+    out->push_back(0xD9);
+}
+
+void EncodeImage(const Image& image, ImageFileFormat format, int jpeg_quality, vector<unsigned char>* out)
+{
+    switch (format)
+    {
+    case kImageBmp:
+        EncodeBmp(image, out);
+        break;
+    case kImageTiff:
+        EncodeTiff(image, true, out);
+        break;
+    default:
+        EncodeJpeg(image, jpeg_quality, out);
+        break;
+    }
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************************
+* @file image_codec.h
+* @brief Decoding of scanner images (BMP, TIFF, JPEG luma) and JPEG/BMP/TIFF encoding
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* Image file formats, values of the image_format of image events
+**/
+enum ImageFileFormat
+{
+    kImageUnknown = 0,
+    kImageJpeg = 1,
+    kImageBmp = 3,
+    kImageTiff = 4
+};
+
+/**
+* Decoded image: 8 bit samples, rows top down without padding. The pixel vector keeps its
+* capacity when the image is reused, so a decoder writing into the same Image does not allocate.
+**/
+struct Image
+{
+    int width;
+    int height;
+    int channels;       // 1 - gray, 3 - RGB
+    std::vector<unsigned char> pixels;
+
+    Image() : width(0), height(0), channels(0) {}
+
+    void Resize(int new_width, int new_height, int new_channels)
+    {
+        width = new_width;
+        height = new_height;
+        channels = new_channels;
+        pixels.resize((size_t)new_width * new_height * new_channels);
+    }
+};
+
+/**
+* Format of an image file from its signature
+*/
+ImageFileFormat DetectImageFormat(const unsigned char* data, size_t size);
+
+/**
+* Decode an uncompressed BMP (1, 4, 8, 24 or 32 bits per pixel). Gray palettes decode to 1 channel.
+* @param max_pixels - Larger images are rejected
+* return value : Decode success/fail status
+*/
+bool DecodeBmp(const unsigned char* data, size_t size, size_t max_pixels, Image* image);
+
+/**
+* Decode a TIFF: first image, strips, no compression or PackBits, bilevel, 8 bit gray or 8 bit RGB
+* return value : Decode success/fail status
+*/
+bool DecodeTiff(const unsigned char* data, size_t size, size_t max_pixels, Image* image);
+
+/**
+* Decode the luma of a baseline JPEG at full size, as a gray image. Chroma is entropy decoded
+* only to find the next block - no inverse DCT or color conversion runs for it. Progressive and
+* arithmetic coded JPEGs are rejected.
+* return value : Decode success/fail status
+*/
+bool DecodeJpegLuma(const unsigned char* data, size_t size, size_t max_pixels, Image* image);
+
+/**
+* Encode a baseline JPEG (gray, or YCbCr without chroma subsampling)
+* @param quality - 1 to 100
+* @param out - Receives the file, its capacity is reused
+*/
+void EncodeJpeg(const Image& image, int quality, std::vector<unsigned char>* out);
+
+/**
+* Encode a BMP (8 bit gray palette or 24 bit)
+*/
+void EncodeBmp(const Image& image, std::vector<unsigned char>* out);
+
+/**
+* Encode a TIFF (8 bit gray or RGB, strips of about 8 KB)
+* @param pack_bits - PackBits compression, otherwise uncompressed
+*/
+void EncodeTiff(const Image& image, bool pack_bits, std::vector<unsigned char>* out);
+
+/**
+* Encode to kImageJpeg, kImageBmp or kImageTiff (PackBits)
+*/
+void EncodeImage(const Image& image, ImageFileFormat format, int jpeg_quality, std::vector<unsigned char>* out);
@@ -0,0 +1,124 @@
+/*******************************************************************************************
+* @file scan_data.cpp
+* @brief Definition of CoreScanner ScanData event xml decoding
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "scan_data.h"
+#include "xml_reader.h"
+#include <cstring>
+
+using namespace std;
+
+/**
+* Values of the hex digits, -1 for other characters
+**/
+struct HexDigitTable
+{
+    signed char value[256];
+
+    HexDigitTable()
+    {
+        memset(value, -1, sizeof(value));
+        for (int i = 0; i < 10; i++)
+        {
+            value['0' + i] = (signed char)i;
+        }
+        for (int i = 0; i < 6; i++)
+        {
+            value['a' + i] = value['A' + i] = (signed char)(10 + i);
+        }
+    }
+};
+
+static const HexDigitTable kHexDigits;
+
+/**
+* Value of a hex digit, -1 if not a hex digit
+**/
+static int HexDigit(char c)
+{
+    return kHexDigits.value[(unsigned char)c];
+}
+
+void HexListToBytes(const char* hex_list, size_t length, string* bytes)
+{
+    bytes->reserve(bytes->size() + length / 5 + 1);
+    size_t i = 0;
+    while (i < length)
+    {
+        // Image data comes as megabytes of "0xHH " - take such a byte and its separator at once
+        if (i + 4 <= length && hex_list[i] == '0' && (hex_list[i + 1] | 0x20) == 'x')
+        {
+            int high = HexDigit(hex_list[i + 2]);
+            int low = HexDigit(hex_list[i + 3]);
+            if (high >= 0 && low >= 0 && (i + 4 == length || HexDigit(hex_list[i + 4]) < 0))
+            {
+                bytes->push_back((char)(high * 16 + low));
+                i += i + 4 < length ? 5 : 4;
+                continue;
+            }
+        }
+
+        // Skip separators and the 0x prefix of each byte
+        if (hex_list[i] == '0' && i + 1 < length && (hex_list[i + 1] == 'x' || hex_list[i + 1] == 'X'))
+        {
+            i += 2;
+        }
+        int value = -1;
+        while (i < length && HexDigit(hex_list[i]) >= 0)
+        {
+            // Only the low byte is kept, so long digit runs cannot overflow
+            value = ((value < 0 ? 0 : value * 16) + HexDigit(hex_list[i])) & 0xFF;
+            i++;
+        }
+        if (value >= 0)
+        {
+            bytes->push_back((char)value);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+bool ParseScanData(const string& scan_data_xml, ScanData* scan_data)
+{
+    scan_data->scanner_id = 0;
+    scan_data->symbology = 0;
+    scan_data->label.clear();
+
+    bool has_label = false;
+    XmlReader reader(scan_data_xml);
+    XmlReader::Token token;
+    while ((token = reader.Next()) != XmlReader::kEndOfDocument)
+    {
+        if (token != XmlReader::kStartElement)
+        {
+            continue;
+        }
+
+        XmlSlice name = reader.Name();
+        XmlSlice text;
+        if (name.Equals("scannerID"))
+        {
+            reader.ReadElementText(&text);
+            scan_data->scanner_id = (int)text.ToLong();
+        }
+        else if (name.Equals("datatype"))
+        {
+            reader.ReadElementText(&text);
+            scan_data->symbology = (int)text.ToLong();
+        }
+        else if (name.Equals("datalabel"))
+        {
+            reader.ReadElementText(&text);
+            HexListToBytes(text.data, text.length, &scan_data->label);
+            has_label = true;
+        }
+    }
+    return has_label;
+}
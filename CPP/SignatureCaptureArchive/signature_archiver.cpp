@@ -0,0 +1,226 @@
+/*******************************************************************************************
+* @file signature_archiver.cpp
+* @brief Definition of the signature capture archiving worker pool
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "signature_archiver.h"
+#include <algorithm>
+
+using namespace std;
+
+static double MillisecondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+ImageFileFormat FindSignatureImage(const string& label, size_t* offset, size_t* size)
+{
+    const size_t kHeaderSize = 6;
+    if (label.size() < kHeaderSize)
+    {
+        return kImageUnknown;
+    }
+    const unsigned char* data = (const unsigned char*)label.data();
+    size_t image_size = ((size_t)data[2] << 24) | ((size_t)data[3] << 16) | ((size_t)data[4] << 8) | data[5];
+    if (image_size > label.size() - kHeaderSize)
+    {
+        return kImageUnknown;
+    }
+    *offset = kHeaderSize;
+    *size = image_size;
+    return DetectImageFormat(data + kHeaderSize, image_size);
+}
+
+SignatureArchiver::SignatureArchiver(const ArchiveSettings& settings, const ResultHandler& handler)
+    : settings_(settings), handler_(handler), next_signature_id_(1), in_flight_(0), stopping_(false)
+{
+    int worker_count = settings_.workers > 0 ? settings_.workers : (int)max(1u, thread::hardware_concurrency());
+    int input_count = max(1, settings_.queued_signatures) + worker_count;
+    for (int i = 0; i < input_count; i++)
+    {
+        all_inputs_.push_back(new string());
+    }
+    free_inputs_ = all_inputs_;
+    for (int i = 0; i < worker_count; i++)
+    {
+        workers_.push_back(thread(&SignatureArchiver::Run, this, i));
+    }
+}
+
+SignatureArchiver::~SignatureArchiver()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    job_ready_.notify_all();
+    for (size_t i = 0; i < workers_.size(); i++)
+    {
+        workers_[i].join();
+    }
+    for (size_t i = 0; i < all_inputs_.size(); i++)
+    {
+        delete all_inputs_[i];
+    }
+}
+
+long SignatureArchiver::Submit(const string& scan_data_xml)
+{
+    unique_lock<mutex> lock(mutex_);
+    if (free_inputs_.empty())
+    {
+        metrics_.submit_waits++;
+        buffer_free_.wait(lock, [this] { return !free_inputs_.empty(); });
+    }
+    string* input = free_inputs_.back();
+    free_inputs_.pop_back();
+    long signature_id = next_signature_id_++;
+    in_flight_++;
+
+    // Copy outside the lock, into a buffer that keeps its capacity
+    lock.unlock();
+    input->assign(scan_data_xml);
+    Job job = { signature_id, input, Clock::now() };
+    lock.lock();
+    jobs_.push_back(job);
+    job_ready_.notify_one();
+    return signature_id;
+}
+
+void SignatureArchiver::Wait()
+{
+    unique_lock<mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+ArchiveMetrics SignatureArchiver::Metrics() const
+{
+    lock_guard<mutex> lock(mutex_);
+    return metrics_;
+}
+
+/**
+* Worker thread - takes the queued signatures in order until the archiver stops and the queue is empty
+**/
+void SignatureArchiver::Run(int worker)
+{
+    WorkerBuffers buffers;
+    unique_lock<mutex> lock(mutex_);
+    while (true)
+    {
+        job_ready_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty())
+        {
+            break;
+        }
+        Job job = jobs_.front();
+        jobs_.pop_front();
+        lock.unlock();
+
+        Clock::time_point started_at = Clock::now();
+        ArchiveResult result = ArchiveResult();
+        result.queued_ms = chrono::duration<double, milli>(started_at - job.submitted_at).count();
+        Archive(worker, &buffers, job, &result);
+        if (handler_)
+        {
+            handler_(result);
+        }
+        double busy_ms = MillisecondsSince(started_at);
+
+        lock.lock();
+        metrics_.signatures++;
+        metrics_.failed += result.succeeded ? 0 : 1;
+        metrics_.blank += result.blank ? 1 : 0;
+        metrics_.source_bytes += (double)result.source_size;
+        metrics_.archive_bytes += (double)result.archive_size;
+        metrics_.parse_ms += result.parse_ms;
+        metrics_.decode_ms += result.decode_ms;
+        metrics_.bilevel_ms += result.bilevel_ms;
+        metrics_.encode_ms += result.encode_ms;
+        metrics_.busy_ms += busy_ms;
+        free_inputs_.push_back(job.input);
+        buffer_free_.notify_one();
+        if (--in_flight_ == 0)
+        {
+            idle_.notify_all();
+        }
+    }
+}
+
+/**
+* Parse, decode, crop, binarize and encode one signature into the worker's buffers
+**/
+void SignatureArchiver::Archive(int worker, WorkerBuffers* buffers, const Job& job, ArchiveResult* result)
+{
+    result->signature_id = job.signature_id;
+    result->worker = worker;
+
+    Clock::time_point stage_start = Clock::now();
+    bool parsed = ParseScanData(*job.input, &buffers->scan_data);
+    result->scanner_id = buffers->scan_data.scanner_id;
+    size_t offset = 0;
+    size_t size = 0;
+    result->source_format = parsed ? FindSignatureImage(buffers->scan_data.label, &offset, &size) : kImageUnknown;
+    result->parse_ms = MillisecondsSince(stage_start);
+    if (result->source_format == kImageUnknown)
+    {
+        return;
+    }
+    const unsigned char* data = (const unsigned char*)buffers->scan_data.label.data() + offset;
+    result->source_size = size;
+
+    stage_start = Clock::now();
+    Image& decoded = buffers->decoded;
+    bool decoded_ok = false;
+    switch (result->source_format)
+    {
+    case kImageJpeg:
+        decoded_ok = DecodeJpegLuma(data, size, settings_.max_pixels, &decoded);
+        break;
+    case kImageBmp:
+        decoded_ok = DecodeBmp(data, size, settings_.max_pixels, &decoded);
+        break;
+    case kImageTiff:
+        decoded_ok = DecodeTiff(data, size, settings_.max_pixels, &decoded);
+        break;
+    default:
+        break;
+    }
+    const Image* gray = &decoded;
+    if (decoded_ok && decoded.channels != 1)
+    {
+        ConvertToGray(decoded, &buffers->gray);
+        gray = &buffers->gray;
+    }
+    result->decode_ms = MillisecondsSince(stage_start);
+    if (!decoded_ok)
+    {
+        return;
+    }
+    result->width = gray->width;
+    result->height = gray->height;
+
+    stage_start = Clock::now();
+    result->threshold = FindInkThreshold(*gray, settings_.min_contrast);
+    result->blank = result->threshold == 0 ||
+        !FindInkBounds(*gray, result->threshold, settings_.margin, &result->ink, &buffers->column_min);
+    if (!result->blank)
+    {
+        Binarize(*gray, result->ink, result->threshold, &buffers->bilevel);
+    }
+    result->bilevel_ms = MillisecondsSince(stage_start);
+    result->succeeded = true;
+    if (result->blank)
+    {
+        return;
+    }
+
+    stage_start = Clock::now();
+    EncodeTiffG4(buffers->bilevel, &buffers->changes, &buffers->archive);
+    result->encode_ms = MillisecondsSince(stage_start);
+    result->archive = buffers->archive.data();
+    result->archive_size = buffers->archive.size();
+}
@@ -0,0 +1,182 @@
+/*******************************************************************************************
+* @file signature_archiver.h
+* @brief Worker pool turning signature captures into cropped, CCITT G4 compressed bilevel TIFFs
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bilevel.h"
+#include "image_codec.h"
+#include "scan_data.h"
+
+/**
+* Signature archiver settings
+**/
+struct ArchiveSettings
+{
+    int workers;                // 0 - one per core
+    int queued_signatures;      // Signatures waiting for a worker, beyond it Submit() waits
+    int margin;                 // Paper kept around the ink, in pixels
+    int min_contrast;           // Least ink to paper contrast, below it a signature is blank
+    size_t max_pixels;          // Larger images are rejected before any buffer is sized for them
+
+    ArchiveSettings() : workers(0), queued_signatures(8), margin(8), min_contrast(48), max_pixels(16 * 1024 * 1024) {}
+};
+
+/**
+* Outcome of one signature. The archive bytes are only valid during the result handler call -
+* the buffer goes back to the worker after it.
+**/
+struct ArchiveResult
+{
+    long signature_id;
+    int scanner_id;
+    bool succeeded;
+    bool blank;                         // No ink, nothing archived
+    ImageFileFormat source_format;
+    size_t source_size;                 // Image file in the decode data
+    int width;                          // Captured size
+    int height;
+    InkBounds ink;                      // Archived region
+    int threshold;
+    const unsigned char* archive;       // Bilevel TIFF, G4 compressed
+    size_t archive_size;
+    int worker;
+    double queued_ms;                   // Submit() to a worker taking the signature
+    double parse_ms;                    // Scan data xml to image file
+    double decode_ms;
+    double bilevel_ms;                  // Threshold, ink bounds and binarization
+    double encode_ms;
+};
+
+/**
+* Signature archiver counters
+**/
+struct ArchiveMetrics
+{
+    long signatures;
+    long failed;
+    long blank;
+    double source_bytes;
+    double archive_bytes;
+    double parse_ms;
+    double decode_ms;
+    double bilevel_ms;
+    double encode_ms;
+    double busy_ms;             // Sum over the workers
+    long submit_waits;          // Submit() calls that waited for a free input buffer
+
+    ArchiveMetrics()
+        : signatures(0), failed(0), blank(0), source_bytes(0), archive_bytes(0), parse_ms(0), decode_ms(0), bilevel_ms(0),
+        encode_ms(0), busy_ms(0), submit_waits(0) {}
+};
+
+/**
+* Archives ST_SIGNATURE_CAPTURE decodes on a pool of worker threads. Each signature image (JPEG,
+* BMP or TIFF) is decoded to gray, cropped to the bounding box of its ink, binarized and stored as
+* a CCITT Group 4 bilevel TIFF, which any TIFF reader opens.
+*
+* The scan data event only copies the xml: Submit() takes one of queued_signatures + workers input
+* buffers and waits while all of them are in use. The hex decode data is parsed on the workers,
+* and each worker decodes, binarizes and encodes into its own buffers, which keep their capacity
+* from signature to signature.
+*
+* The result handler runs on the worker threads, concurrently.
+**/
+class SignatureArchiver
+{
+public:
+    typedef std::function<void(const ArchiveResult& result)> ResultHandler;
+
+    /**
+    * Signature archiver constructor - starts the workers
+    */
+    SignatureArchiver(const ArchiveSettings& settings, const ResultHandler& handler);
+
+    /**
+    * Finish the submitted signatures and stop the workers
+    */
+    ~SignatureArchiver();
+
+    SignatureArchiver(const SignatureArchiver&) = delete;
+    SignatureArchiver& operator=(const SignatureArchiver&) = delete;
+
+    /**
+    * Queue a signature capture (call from the scan data event handler). Waits while every input
+    * buffer is in use.
+    * @param scan_data_xml - Scan data xml of an ST_SIGNATURE_CAPTURE decode
+    * return value : Signature id
+    */
+    long Submit(const std::string& scan_data_xml);
+
+    /**
+    * Wait until every submitted signature is handled
+    */
+    void Wait();
+
+    int WorkerCount() const { return (int)workers_.size(); }
+
+    ArchiveMetrics Metrics() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Job
+    {
+        long signature_id;
+        std::string* input;
+        Clock::time_point submitted_at;
+    };
+
+    /**
+    * Buffers of one worker, reused for every signature
+    */
+    struct WorkerBuffers
+    {
+        ScanData scan_data;
+        Image decoded;
+        Image gray;
+        std::vector<unsigned char> column_min;
+        BilevelImage bilevel;
+        std::vector<int> changes;
+        std::vector<unsigned char> archive;
+    };
+
+    void Run(int worker);
+    void Archive(int worker, WorkerBuffers* buffers, const Job& job, ArchiveResult* result);
+
+    ArchiveSettings settings_;
+    ResultHandler handler_;
+    std::vector<std::thread> workers_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable job_ready_;
+    std::condition_variable buffer_free_;
+    std::condition_variable idle_;
+    std::deque<Job> jobs_;
+    std::vector<std::string*> free_inputs_;
+    std::vector<std::string*> all_inputs_;
+    long next_signature_id_;
+    long in_flight_;            // Submitted, result handler not returned
+    ArchiveMetrics metrics_;
+    bool stopping_;
+};
+
+/**
+* Find the image file in the decode data of a signature capture. The data starts with a 6 byte
+* header - image format, signature type and the image size, 4 bytes big-endian - followed by the
+* file, whose format is taken from its signature.
+* @param offset - Receives the offset of the image file
+* @param size - Receives the size of the image file
+* return value : Image format, kImageUnknown if the header or the image file is not valid
+*/
+ImageFileFormat FindSignatureImage(const std::string& label, size_t* offset, size_t* size);
@@ -0,0 +1,627 @@
+/*******************************************************************************************
+* @file signature_capture_archive.cpp
+* @brief This file contains code snippet to archive signature captures as cropped, G4 compressed bilevel images
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "scan_data.h"
+#include "image_codec.h"
+#include "bilevel.h"
+#include "signature_archiver.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for barcode events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_BARCODE);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Get the ids of the connected scanners
+* @param scanner_ids - Receives scanner ids
+* return value : GetScanners success/fail status
+*/
+bool GetScannerIds(vector<int>* scanner_ids)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+    XmlReader reader(get_scanners_output_xml);
+    XmlSlice text;
+    while (reader.FindElement("scannerID") && reader.ReadElementText(&text))
+    {
+        scanner_ids->push_back((int)text.ToLong());
+    }
+    cout << "CoreScanner GetScanners() - Success, " << scanner_ids->size() << " scanners" << endl;
+    return true;
+}
+
+const char* ImageFormatName(ImageFileFormat format)
+{
+    switch (format)
+    {
+    case kImageJpeg:
+        return "JPEG";
+    case kImageBmp:
+        return "BMP";
+    case kImageTiff:
+        return "TIFF";
+    default:
+        return "unknown";
+    }
+}
+
+/*
+* Save an archived signature
+* return value : File name, empty if the file could not be written
+*/
+string SaveArchive(const ArchiveResult& result)
+{
+    string file_name = "signature_" + to_string(result.scanner_id) + "_" + to_string(result.signature_id) + ".tif";
+    FILE* file = fopen(file_name.c_str(), "wb");
+    if (file == NULL)
+    {
+        return string();
+    }
+    size_t written = fwrite(result.archive, 1, result.archive_size, file);
+    fclose(file);
+    return written == result.archive_size ? file_name : string();
+}
+
+/*
+* Synthetic signature capture: pen strokes on paper with sensor noise and uneven lighting
+* @param ink - false for a blank capture
+*/
+Image MakeSignatureImage(int width, int height, bool ink, unsigned seed)
+{
+    Image image;
+    image.Resize(width, height, 1);
+    mt19937 random(seed);
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            int paper = 215 + 20 * x / width - 10 * y / height;
+            image.pixels[(size_t)y * width + x] = (unsigned char)(paper + (int)(random() % 13) - 6);
+        }
+    }
+    if (!ink)
+    {
+        return image;
+    }
+
+    // Cursive strokes: a pen moving right while looping up and down, lifted between words
+    const double kPi = 3.14159265358979;
+    const int kPenRadius = 2;
+    double left = width * 0.15;
+    double span = width * 0.6;
+    for (int step = 0; step < 20000; step++)
+    {
+        double t = step / 20000.0;
+        if (fmod(t, 0.35) > 0.31)
+        {
+            continue;
+        }
+        double x = left + span * t + width * 0.03 * sin(2 * kPi * 14 * t);
+        double y = height * (0.5 + 0.18 * sin(2 * kPi * 9 * t) * sin(2 * kPi * 1.3 * t + 1) + 0.05 * sin(2 * kPi * 2 * t));
+        for (int dy = -kPenRadius; dy <= kPenRadius; dy++)
+        {
+            for (int dx = -kPenRadius; dx <= kPenRadius; dx++)
+            {
+                int px = (int)x + dx;
+                int py = (int)y + dy;
+                if (dx * dx + dy * dy <= kPenRadius * kPenRadius && px >= 0 && px < width && py >= 0 && py < height)
+                {
+                    image.pixels[(size_t)py * width + px] = (unsigned char)(35 + random() % 15);
+                }
+            }
+        }
+    }
+    return image;
+}
+
+/*
+* Scan data xml of a signature capture, as the scan data event delivers it: the decode data is a
+* header (image format, signature type, image size) followed by the image file, as hex bytes
+*/
+string MakeSignatureScanData(int scanner_id, ImageFileFormat format, const vector<unsigned char>& file)
+{
+    vector<unsigned char> label;
+    label.push_back((unsigned char)format);
+    label.push_back(1);
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        label.push_back((unsigned char)(file.size() >> shift));
+    }
+    label.insert(label.end(), file.begin(), file.end());
+
+    string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><scannerID>" + to_string(scanner_id) +
+        "</scannerID><arg-xml><scandata><modelnumber>DS8178-SR0F007ZZWW</modelnumber><datatype>" +
+        to_string(ST_SIGNATURE_CAPTURE) + "</datatype><datalabel>";
+    static const char kHexDigits[] = "0123456789abcdef";
+    xml.reserve(xml.size() + label.size() * 5 + 64);
+    for (size_t i = 0; i < label.size(); i++)
+    {
+        if (i != 0)
+        {
+            xml += ' ';
+        }
+        xml += '0';
+        xml += 'x';
+        xml += kHexDigits[label[i] >> 4];
+        xml += kHexDigits[label[i] & 15];
+    }
+    xml += "</datalabel></scandata></arg-xml></outArgs>";
+    return xml;
+}
+
+struct BenchmarkInput
+{
+    string name;
+    size_t file_size;
+    size_t raw_size;        // 8 bit gray bitmap
+    string scan_data;
+};
+
+/*
+* Signature captures of 1280x640 from a document imager: JPEG, BMP and TIFF, and a blank JPEG
+*/
+vector<BenchmarkInput> MakeBenchmarkInputs()
+{
+    const int kWidth = 1280;
+    const int kHeight = 640;
+    Image signature = MakeSignatureImage(kWidth, kHeight, true, 1);
+    Image blank = MakeSignatureImage(kWidth, kHeight, false, 2);
+    vector<BenchmarkInput> inputs(4);
+    vector<unsigned char> file;
+    const char* names[4] = { "JPEG", "BMP", "TIFF", "JPEG blank" };
+    for (int i = 0; i < 4; i++)
+    {
+        ImageFileFormat format = i == 1 ? kImageBmp : (i == 2 ? kImageTiff : kImageJpeg);
+        const Image& image = i == 3 ? blank : signature;
+        if (format == kImageJpeg)
+        {
+            EncodeJpeg(image, 80, &file);
+        }
+        else if (format == kImageBmp)
+        {
+            EncodeBmp(image, &file);
+        }
+        else
+        {
+            EncodeTiff(image, false, &file);
+        }
+        inputs[i].name = string(names[i]) + " " + to_string(kWidth) + "x" + to_string(kHeight);
+        inputs[i].file_size = file.size();
+        inputs[i].raw_size = (size_t)kWidth * kHeight;
+        inputs[i].scan_data = MakeSignatureScanData(i, format, file);
+    }
+    return inputs;
+}
+
+/*
+* Results of the signatures made from one benchmark input
+*/
+struct InputResults
+{
+    long signatures;
+    double parse_ms;
+    double decode_ms;
+    double bilevel_ms;
+    double encode_ms;
+    size_t archive_size;
+    InkBounds ink;
+
+    InputResults() : signatures(0), parse_ms(0), decode_ms(0), bilevel_ms(0), encode_ms(0), archive_size(0) {}
+};
+
+/*
+* Submit signatures round robin from the inputs and wait for all of them
+* return value : Elapsed time in milliseconds
+*/
+double RunArchiver(const ArchiveSettings& settings, const vector<BenchmarkInput>& inputs, int signatures,
+    ArchiveMetrics* metrics, vector<InputResults>* input_results)
+{
+    mutex results_mutex;
+    input_results->assign(inputs.size(), InputResults());
+    int failed = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    {
+        // The scanner id carries the input index
+        SignatureArchiver archiver(settings, [&](const ArchiveResult& result)
+        {
+            lock_guard<mutex> lock(results_mutex);
+            if (!result.succeeded)
+            {
+                failed++;
+                return;
+            }
+            InputResults& results = (*input_results)[result.scanner_id];
+            results.signatures++;
+            results.parse_ms += result.parse_ms;
+            results.decode_ms += result.decode_ms;
+            results.bilevel_ms += result.bilevel_ms;
+            results.encode_ms += result.encode_ms;
+            results.archive_size = result.archive_size;
+            results.ink = result.ink;
+        });
+        for (int i = 0; i < signatures; i++)
+        {
+            archiver.Submit(inputs[i % inputs.size()].scan_data);
+        }
+        archiver.Wait();
+        *metrics = archiver.Metrics();
+    }
+    if (failed != 0)
+    {
+        cout << " " << failed << " signatures failed" << endl;
+    }
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/*
+* Archive simulated signature capture events with 1 worker up to one per core
+*/
+void RunArchiveBenchmark()
+{
+    const int kSignatures = 200;
+    vector<BenchmarkInput> inputs = MakeBenchmarkInputs();
+
+    int cores = (int)max(1u, thread::hardware_concurrency());
+    vector<int> worker_counts;
+    for (int workers = 1; workers < cores; workers *= 2)
+    {
+        worker_counts.push_back(workers);
+    }
+    worker_counts.push_back(cores);
+
+    ArchiveSettings settings;
+    vector<InputResults> single_worker_results;
+    for (size_t w = 0; w < worker_counts.size(); w++)
+    {
+        settings.workers = worker_counts[w];
+        ArchiveMetrics metrics;
+        vector<InputResults> input_results;
+        double elapsed_ms = RunArchiver(settings, inputs, kSignatures, &metrics, &input_results);
+        double signatures_per_second = kSignatures * 1000.0 / elapsed_ms;
+        cout << "Archiving, " << settings.workers << " workers : " << kSignatures << " signatures in " << elapsed_ms << " ms, "
+             << signatures_per_second << " signatures/s, " << metrics.source_bytes / 1048576.0 / (elapsed_ms / 1000.0) << " MB/s of images, "
+             << metrics.signatures * 1000.0 / metrics.busy_ms << " signatures/s per busy core, " << metrics.submit_waits << " submits waited" << endl;
+        if (w == 0)
+        {
+            single_worker_results = input_results;
+        }
+    }
+
+    cout << "Per signature, 1 worker (parse / decode / bilevel / encode ms)" << endl;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        const InputResults& results = single_worker_results[i];
+        if (results.signatures == 0)
+        {
+            continue;
+        }
+        cout << " " << inputs[i].name << " : " << results.parse_ms / results.signatures << " / " << results.decode_ms / results.signatures
+             << " / " << results.bilevel_ms / results.signatures << " / " << results.encode_ms / results.signatures << endl;
+    }
+    cout << "Storage per signature (image file -> archive)" << endl;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        const InputResults& results = single_worker_results[i];
+        cout << " " << inputs[i].name << " : " << inputs[i].file_size << " -> " << results.archive_size << " bytes";
+        if (results.archive_size == 0)
+        {
+            cout << " (blank, not archived)" << endl;
+            continue;
+        }
+        cout << ", " << results.ink.Width() << "x" << results.ink.Height() << " ink region, "
+             << (double)inputs[i].file_size / results.archive_size << "x smaller, "
+             << (double)inputs[i].raw_size / results.archive_size << "x smaller than the 8 bit bitmap" << endl;
+    }
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Signature archiving benchmark (simulated signature captures)" << endl;
+    RunArchiveBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    vector<int> scanner_ids;
+    if (ConnectEvents() && Open() && GetScannerIds(&scanner_ids))
+    {
+        if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+        {
+            ArchiveSettings settings;
+            {
+                SignatureArchiver archiver(settings, [](const ArchiveResult& result)
+                {
+                    cout << "Signature " << result.signature_id << " scanner ID:[" << result.scanner_id << "] - ";
+                    if (!result.succeeded)
+                    {
+                        cout << ImageFormatName(result.source_format) << " signature could not be decoded" << endl;
+                        return;
+                    }
+                    if (result.blank)
+                    {
+                        cout << "blank " << result.width << "x" << result.height << " signature, not archived" << endl;
+                        return;
+                    }
+                    string file_name = SaveArchive(result);
+                    cout << ImageFormatName(result.source_format) << " " << result.width << "x" << result.height << " "
+                         << result.source_size << " bytes -> " << result.ink.Width() << "x" << result.ink.Height() << " G4 "
+                         << result.archive_size << " bytes" << (file_name.empty() ? ", could not be saved" : ", saved to " + file_name) << endl;
+                });
+                scanner_event_sink->SetScanDataHandler([&archiver](short event_type, const string& scan_data_xml)
+                {
+                    // Other barcodes are printed, the signature itself is parsed on the archiver's workers
+                    string data_type;
+                    if (XmlFindText(scan_data_xml, "datatype", &data_type) && atoi(data_type.c_str()) == ST_SIGNATURE_CAPTURE)
+                    {
+                        archiver.Submit(scan_data_xml);
+                        return;
+                    }
+                    ScanData scan_data;
+                    if (ParseScanData(scan_data_xml, &scan_data))
+                    {
+                        cout << "Barcode scanner ID:[" << scan_data.scanner_id << "] type " << scan_data.symbology << " : " << scan_data.label << endl;
+                    }
+                });
+                WaitForInput("Scan signature capture barcodes on " + to_string(scanner_ids.size()) + " scanners, " +
+                    to_string(archiver.WorkerCount()) + " archiving workers, press any key to exit.");
+                scanner_event_sink->SetScanDataHandler(nullptr);
+                archiver.Wait();
+
+                ArchiveMetrics metrics = archiver.Metrics();
+                if (metrics.archive_bytes != 0)
+                {
+                    cout << metrics.signatures << " signatures, " << metrics.blank << " blank, " << metrics.failed << " failed, "
+                         << metrics.source_bytes / metrics.archive_bytes << "x smaller archived" << endl;
+                }
+            }
+            ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+        }
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,435 @@
+/*******************************************************************************************
+* @file capture_session.h
+* @brief Asynchronous capture sessions - pull the trigger, await the first decode or time out, release
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "scan_data.h"
+
+/**
+* How a capture session ended
+**/
+enum CaptureStatus
+{
+    kCaptureDecoded,
+    kCaptureTimedOut,       // No decode before the timeout
+    kCaptureTriggerFailed,  // DEVICE_PULL_TRIGGER failed
+    kCaptureCancelled       // Cancel() or manager destroyed
+};
+
+/**
+* Result handed to the completion callback of a capture session
+**/
+struct CaptureResult
+{
+    int session_id;
+    int scanner_id;
+    CaptureStatus status;
+    long command_status;    // Status of DEVICE_PULL_TRIGGER
+    ScanData scan_data;     // The decode (kCaptureDecoded)
+    double queued_ms;       // Waiting behind earlier sessions of the scanner
+    double decode_ms;       // Trigger pull to decode (kCaptureDecoded)
+};
+
+/**
+* Capture session settings
+**/
+struct CaptureSettings
+{
+    int timeout_ms;     // Trigger pull to giving up
+    bool aim;           // DEVICE_AIM_ON before the pull, DEVICE_AIM_OFF after the release
+
+    CaptureSettings() : timeout_ms(1000), aim(false) {}
+};
+
+/**
+* Ties software trigger pulls to the decodes they produce.
+*
+* Start() returns at once. A session pulls the trigger of its scanner, takes the first decode the
+* scanner reports after the pull, then releases the trigger and calls its completion callback; a
+* session without a decode is released when its timeout runs out. Sessions on different scanners
+* run concurrently, sessions on one scanner wait for each other (a scanner has one trigger).
+*
+* Trigger commands are sent with ExecCommandAsync from the session thread, which also runs the
+* timeouts and the completion callbacks - callbacks may start the next session, and must not block.
+* OnScanData() is called from the scan data event handler and only matches the decode to its
+* session. A decode with no pulled trigger on its scanner is counted as stray and dropped.
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommandAsync signature
+**/
+template <typename Scanner>
+class CaptureSessionManager
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<Scanner*(int worker)> AttachFunction;
+    typedef std::function<void(int worker, Scanner* scanner)> DetachFunction;
+    typedef std::function<void(const CaptureResult& result)> CaptureCallback;
+
+    /**
+    * Capture session manager constructor - starts the session thread
+    * @param settings - Timeout and aiming
+    * @param attach - Called on the session thread to get its scanner interface
+    * @param detach - Called on the session thread when it stops (optional)
+    */
+    CaptureSessionManager(const CaptureSettings& settings, const AttachFunction& attach, const DetachFunction& detach = DetachFunction())
+        : settings_(settings), attach_(attach), detach_(detach), next_session_id_(1), stray_decode_count_(0), stopping_(false)
+    {
+        thread_ = std::thread(&CaptureSessionManager::Run, this);
+    }
+
+    /**
+    * Cancel the open sessions, release their triggers and stop the session thread
+    */
+    ~CaptureSessionManager()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            std::vector<int> open_sessions;
+            for (typename std::unordered_map<int, Session*>::iterator it = sessions_.begin(); it != sessions_.end(); ++it)
+            {
+                open_sessions.push_back(it->first);
+            }
+            for (size_t i = 0; i < open_sessions.size(); i++)
+            {
+                FinishLocked(sessions_[open_sessions[i]], kCaptureCancelled, STATUS_SUCCESS, NULL);
+            }
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    CaptureSessionManager(const CaptureSessionManager&) = delete;
+    CaptureSessionManager& operator=(const CaptureSessionManager&) = delete;
+
+    /**
+    * Start a capture session
+    * @param scanner_id - Scanner to trigger
+    * @param done - Completion callback, called once on the session thread
+    * return value : Session id (for Cancel)
+    */
+    int Start(int scanner_id, const CaptureCallback& done)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Session* session = new Session();
+        session->id = next_session_id_++;
+        session->scanner_id = scanner_id;
+        session->done = done;
+        session->queued_at = Clock::now();
+        sessions_[session->id] = session;
+
+        int session_id = session->id;
+        Lane& lane = lanes_[scanner_id];
+        if (stopping_)
+        {
+            FinishLocked(session, kCaptureCancelled, STATUS_SUCCESS, NULL);
+        }
+        else if (lane.active == NULL)
+        {
+            ActivateLocked(&lane, session);
+        }
+        else
+        {
+            lane.waiting.push_back(session);
+        }
+        return session_id;
+    }
+
+    /**
+    * Cancel a session - releases the trigger if it was pulled
+    * return value : false if the session already ended
+    */
+    bool Cancel(int session_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        typename std::unordered_map<int, Session*>::iterator it = sessions_.find(session_id);
+        if (it == sessions_.end())
+        {
+            return false;
+        }
+        FinishLocked(it->second, kCaptureCancelled, STATUS_SUCCESS, NULL);
+        return true;
+    }
+
+    /**
+    * Match a decode to the session that pulled the trigger of its scanner (call from the scan data event handler)
+    */
+    void OnScanData(const ScanData& scan_data)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        typename std::map<int, Lane>::iterator lane = lanes_.find(scan_data.scanner_id);
+        if (lane == lanes_.end() || lane->second.active == NULL || !lane->second.active->triggered)
+        {
+            stray_decode_count_++;
+            return;
+        }
+        FinishLocked(lane->second.active, kCaptureDecoded, STATUS_SUCCESS, &scan_data);
+    }
+
+    /**
+    * Trigger pull to decode times of the decoded sessions, in milliseconds
+    */
+    std::vector<double> DecodeLatencies() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return decode_latencies_ms_;
+    }
+
+    /**
+    * Decodes that arrived with no pulled trigger on their scanner
+    */
+    long StrayDecodeCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stray_decode_count_;
+    }
+
+    /**
+    * Sessions started and not completed yet
+    */
+    size_t OpenSessionCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sessions_.size();
+    }
+
+private:
+    struct Session
+    {
+        int id;
+        int scanner_id;
+        CaptureCallback done;
+        Clock::time_point queued_at;
+        Clock::time_point triggered_at;
+        bool triggered;     // DEVICE_PULL_TRIGGER is on its way, decodes of the scanner belong to this session
+
+        Session() : id(0), scanner_id(0), triggered(false) {}
+    };
+
+    struct Lane
+    {
+        Session* active;            // Session owning the trigger
+        std::deque<Session*> waiting;
+
+        Lane() : active(NULL) {}
+    };
+
+    typedef std::function<void(Scanner* scanner)> Action;
+    typedef std::pair<Clock::time_point, int> Deadline;
+
+    /**
+    * Give the trigger of a lane to a session - the session thread pulls it
+    */
+    void ActivateLocked(Lane* lane, Session* session)
+    {
+        lane->active = session;
+        int session_id = session->id;
+        actions_.push_back([this, session_id](Scanner* scanner) { Pull(scanner, session_id); });
+        wake_.notify_one();
+    }
+
+    /**
+    * End a session: queue the trigger release and the callback, and hand the trigger to the next session
+    */
+    void FinishLocked(Session* session, CaptureStatus status, long command_status, const ScanData* scan_data)
+    {
+        CaptureResult result = CaptureResult();
+        result.session_id = session->id;
+        result.scanner_id = session->scanner_id;
+        result.status = status;
+        result.command_status = command_status;
+        if (scan_data != NULL)
+        {
+            result.scan_data = *scan_data;
+        }
+        Clock::time_point now = Clock::now();
+        if (session->triggered)
+        {
+            result.queued_ms = std::chrono::duration<double, std::milli>(session->triggered_at - session->queued_at).count();
+            if (status == kCaptureDecoded)
+            {
+                result.decode_ms = std::chrono::duration<double, std::milli>(now - session->triggered_at).count();
+                decode_latencies_ms_.push_back(result.decode_ms);
+            }
+        }
+        else
+        {
+            result.queued_ms = std::chrono::duration<double, std::milli>(now - session->queued_at).count();
+        }
+
+        Lane& lane = lanes_[session->scanner_id];
+        if (lane.active == session)
+        {
+            lane.active = NULL;
+        }
+        else
+        {
+            for (typename std::deque<Session*>::iterator it = lane.waiting.begin(); it != lane.waiting.end(); ++it)
+            {
+                if (*it == session)
+                {
+                    lane.waiting.erase(it);
+                    break;
+                }
+            }
+        }
+        sessions_.erase(session->id);
+
+        bool release = session->triggered;
+        int scanner_id = session->scanner_id;
+        CaptureCallback done;
+        done.swap(session->done);
+        delete session;
+        bool aim = settings_.aim;
+        actions_.push_back([release, aim, scanner_id, done, result](Scanner* scanner)
+        {
+            if (release && scanner != NULL)
+            {
+                ExecAsync<DEVICE_RELEASE_TRIGGER>(scanner, scanner_id);
+                if (aim)
+                {
+                    ExecAsync<DEVICE_AIM_OFF>(scanner, scanner_id);
+                }
+            }
+            if (done)
+            {
+                done(result);
+            }
+        });
+
+        if (lane.active == NULL && !lane.waiting.empty() && !stopping_)
+        {
+            Session* next = lane.waiting.front();
+            lane.waiting.pop_front();
+            ActivateLocked(&lane, next);
+        }
+        wake_.notify_one();
+    }
+
+    /**
+    * Pull the trigger for a session (session thread)
+    */
+    void Pull(Scanner* scanner, int session_id)
+    {
+        int scanner_id = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            typename std::unordered_map<int, Session*>::iterator it = sessions_.find(session_id);
+            if (it == sessions_.end())
+            {
+                return;
+            }
+            // Marked before the command is sent: the decode may be reported before ExecCommandAsync returns
+            Session* session = it->second;
+            session->triggered = true;
+            session->triggered_at = Clock::now();
+            deadlines_.push(Deadline(session->triggered_at + std::chrono::milliseconds(settings_.timeout_ms), session_id));
+            scanner_id = session->scanner_id;
+        }
+
+        long status = STATUS_SUCCESS;
+        if (scanner == NULL)
+        {
+            status = -1;
+        }
+        else
+        {
+            if (settings_.aim)
+            {
+                ExecAsync<DEVICE_AIM_ON>(scanner, scanner_id);
+            }
+            CommandResult<NoResponse> result = ExecAsync<DEVICE_PULL_TRIGGER>(scanner, scanner_id);
+            status = result.Succeeded() ? STATUS_SUCCESS : (result.status == STATUS_SUCCESS ? -1 : result.status);
+        }
+        if (status != STATUS_SUCCESS)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            typename std::unordered_map<int, Session*>::iterator it = sessions_.find(session_id);
+            if (it != sessions_.end())
+            {
+                FinishLocked(it->second, kCaptureTriggerFailed, status, NULL);
+            }
+        }
+    }
+
+    /**
+    * Session thread - runs queued trigger commands and callbacks, and times out sessions
+    */
+    void Run()
+    {
+        Scanner* scanner = attach_(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            if (!actions_.empty())
+            {
+                Action action;
+                action.swap(actions_.front());
+                actions_.pop_front();
+                lock.unlock();
+                action(scanner);
+                lock.lock();
+                continue;
+            }
+            if (stopping_)
+            {
+                break;
+            }
+            if (deadlines_.empty())
+            {
+                wake_.wait(lock);
+                continue;
+            }
+            Deadline deadline = deadlines_.top();
+            if (Clock::now() < deadline.first)
+            {
+                wake_.wait_until(lock, deadline.first);
+                continue;
+            }
+            deadlines_.pop();
+            // A session that ended before its timeout has no entry anymore
+            typename std::unordered_map<int, Session*>::iterator it = sessions_.find(deadline.second);
+            if (it != sessions_.end())
+            {
+                FinishLocked(it->second, kCaptureTimedOut, STATUS_SUCCESS, NULL);
+            }
+        }
+        lock.unlock();
+        if (detach_)
+        {
+            detach_(0, scanner);
+        }
+    }
+
+    CaptureSettings settings_;
+    AttachFunction attach_;
+    DetachFunction detach_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::unordered_map<int, Session*> sessions_;    // Open sessions by id
+    std::map<int, Lane> lanes_;                     // By scanner id
+    std::deque<Action> actions_;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline> > deadlines_;
+    int next_session_id_;
+    std::vector<double> decode_latencies_ms_;
+    long stray_decode_count_;
+    bool stopping_;
+    std::thread thread_;
+};
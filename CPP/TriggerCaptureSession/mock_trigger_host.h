@@ -0,0 +1,185 @@
+/*******************************************************************************************
+* @file mock_trigger_host.h
+* @brief Simulated CoreScanner host decoding after a software trigger pull
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common_defs.h"
+#include "scan_data.h"
+#include "xml_reader.h"
+
+/**
+* Simulated CoreScanner host with the ICoreScanner::ExecCommand/ExecCommandAsync signatures.
+* After DEVICE_PULL_TRIGGER a scanner reports one decode through the scan data handler, on the
+* host's event thread, after a log-normal delay around decode_median_ms - unless the item has no
+* readable label (no_read_ratio) or the trigger is released first. ExecCommand takes
+* command_latency_ms, ExecCommandAsync returns at once.
+**/
+class MockTriggerHost
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+    * Mock host constructor - starts the event thread
+    */
+    MockTriggerHost(int command_latency_ms, int decode_median_ms, double no_read_ratio)
+        : command_latency_ms_(command_latency_ms), decode_median_ms_(decode_median_ms), no_read_ratio_(no_read_ratio),
+        random_(11), pull_count_(0), stopping_(false)
+    {
+        thread_ = std::thread(&MockTriggerHost::Run, this);
+    }
+
+    ~MockTriggerHost()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    /**
+    * Set the function receiving the decodes (called on the host's event thread)
+    */
+    void SetScanDataHandler(const std::function<void(const ScanData& scan_data)>& handler)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handler_ = handler;
+    }
+
+    long PullCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pull_count_;
+    }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        *out_xml = NULL;
+        std::this_thread::sleep_for(std::chrono::milliseconds(command_latency_ms_));
+        return ExecCommandAsync(opcode, in_xml, status);
+    }
+
+    /**
+    * ExecCommandAsync with the ICoreScanner signature
+    */
+    HRESULT ExecCommandAsync(LONG opcode, BSTR* in_xml, LONG* status)
+    {
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        std::string value;
+        int scanner_id = XmlFindText(in, "scannerID", &value) ? atoi(value.c_str()) : 0;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        Device& device = devices_[scanner_id];
+        if (opcode == DEVICE_PULL_TRIGGER && !device.pulled)
+        {
+            pull_count_++;
+            device.pulled = true;
+            device.generation++;
+            if (std::uniform_real_distribution<double>(0, 1)(random_) >= no_read_ratio_)
+            {
+                double delay_ms = decode_median_ms_ * exp(std::normal_distribution<double>(0, 0.4)(random_));
+                Decode decode = { Clock::now() + std::chrono::microseconds((long long)(delay_ms * 1000)), scanner_id, device.generation };
+                decodes_.push(decode);
+                wake_.notify_one();
+            }
+        }
+        else if (opcode == DEVICE_RELEASE_TRIGGER)
+        {
+            device.pulled = false;
+            device.generation++;
+        }
+        *status = STATUS_SUCCESS;
+        return S_OK;
+    }
+
+private:
+    struct Device
+    {
+        bool pulled;
+        long generation;    // Pull/release count - a decode of an earlier pull is dropped
+        long decoded;
+
+        Device() : pulled(false), generation(0), decoded(0) {}
+    };
+
+    struct Decode
+    {
+        Clock::time_point due;
+        int scanner_id;
+        long generation;
+
+        bool operator>(const Decode& other) const { return due > other.due; }
+    };
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_)
+        {
+            if (decodes_.empty())
+            {
+                wake_.wait(lock);
+                continue;
+            }
+            Decode decode = decodes_.top();
+            if (Clock::now() < decode.due)
+            {
+                wake_.wait_until(lock, decode.due);
+                continue;
+            }
+            decodes_.pop();
+            Device& device = devices_[decode.scanner_id];
+            if (!device.pulled || device.generation != decode.generation)
+            {
+                continue;
+            }
+            // One decode per pull
+            device.pulled = false;
+            ScanData scan_data;
+            scan_data.scanner_id = decode.scanner_id;
+            scan_data.symbology = ST_EAN13;
+            scan_data.label = std::to_string(4006381333931LL + decode.scanner_id * 1000 + device.decoded++);
+            std::function<void(const ScanData&)> handler = handler_;
+            lock.unlock();
+            if (handler)
+            {
+                handler(scan_data);
+            }
+            lock.lock();
+        }
+    }
+
+    int command_latency_ms_;
+    int decode_median_ms_;
+    double no_read_ratio_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::mt19937 random_;
+    std::map<int, Device> devices_;
+    std::priority_queue<Decode, std::vector<Decode>, std::greater<Decode> > decodes_;
+    std::function<void(const ScanData&)> handler_;
+    long pull_count_;
+    bool stopping_;
+    std::thread thread_;
+};
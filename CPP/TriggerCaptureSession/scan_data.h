@@ -0,0 +1,36 @@
+/*******************************************************************************************
+* @file scan_data.h
+* @brief Decoding of CoreScanner ScanData event xml
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <string>
+
+/**
+* Decoded barcode from a ScanData event
+**/
+struct ScanData
+{
+    int scanner_id;
+    int symbology;          // ST_xxx data type
+    std::string label;      // Decoded label bytes (datalabel)
+};
+
+/**
+* Decode ScanData event xml
+* (<outArgs><scannerID>..</scannerID><arg-xml><scandata>..<datatype>..</datatype><datalabel>0x31 0x32 ..</datalabel>..)
+* @param scan_data_xml - Xml received with OnScanDataEvent
+* @param scan_data - Receives scanner id, symbology and label bytes
+* return value : true if the xml contained a decoded label
+*/
+bool ParseScanData(const std::string& scan_data_xml, ScanData* scan_data);
+
+/**
+* Convert datalabel/rawdata hex byte list ("0x31 0x32 ...") to bytes
+* @param hex_list - Hex byte list text
+* @param length - Length of hex byte list text
+* @param bytes - Receives bytes (appended)
+*/
+void HexListToBytes(const char* hex_list, size_t length, std::string* bytes);
@@ -0,0 +1,531 @@
+/*******************************************************************************************
+* @file trigger_capture_session.cpp
+* @brief This file contains code snippet to pull the trigger from software and await the decode it produces
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "event_sink.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "scan_data.h"
+#include "capture_session.h"
+#include "mock_trigger_host.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+DWORD cookie = 0;
+EventSink* scanner_event_sink = NULL;
+LPUNKNOWN scanner_event_sink_unknown = NULL;
+IGlobalInterfaceTable* global_interface_table = NULL;  // Hands the interface to the capture session thread
+DWORD scanner_interface_cookie = 0;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Create the event sink and connect it to CoreScanner events
+* return value : Connection success/fail status
+*/
+bool ConnectEvents()
+{
+    scanner_event_sink = new EventSink();
+    scanner_event_sink_unknown = scanner_event_sink->GetIDispatch(FALSE);
+    if (!AfxConnectionAdvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, &cookie))
+    {
+        cout << "CoreScanner event connection - Failed" << endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+* Disconnect the event sink and release it
+*/
+void DisconnectEvents()
+{
+    if (cookie != 0 && scanner_event_sink)
+    {
+        AfxConnectionUnadvise(scanner_interface, DIID__ICoreScannerEvents, scanner_event_sink_unknown, FALSE, cookie);
+        cookie = 0;
+    }
+    delete scanner_event_sink;
+    scanner_event_sink = NULL;
+}
+
+/*
+* Register/unregister for barcode events
+* @tparam Op REGISTER_FOR_EVENTS or UNREGISTER_FOR_EVENTS
+* @param name Command name to display
+* return value : Command success/fail status
+*/
+template <OPCODE Op>
+bool ExecEventRegistration(const char* name)
+{
+    vector<int> event_ids;
+    event_ids.push_back(EVENT_TYPE_BARCODE);
+    CommandResult<NoResponse> result = Exec<Op>(scanner_interface, event_ids);
+    if (result.Succeeded())
+    {
+        cout << "CoreScanner " << name << "() - Success" << endl;
+        return true;
+    }
+    cout << "CoreScanner " << name << "() - Failed. Error Code : " << result.status << endl;
+    return false;
+}
+
+/*
+* Get the ids of the connected scanners
+* @param scanner_ids - Receives scanner ids
+* return value : GetScanners success/fail status
+*/
+bool GetScannerIds(vector<int>* scanner_ids)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+    XmlReader reader(get_scanners_output_xml);
+    XmlSlice text;
+    while (reader.FindElement("scannerID") && reader.ReadElementText(&text))
+    {
+        scanner_ids->push_back((int)text.ToLong());
+    }
+    cout << "CoreScanner GetScanners() - Success, " << scanner_ids->size() << " scanners" << endl;
+    return true;
+}
+
+/*
+* Give the capture session thread its own CoreScanner interface from the global interface table
+*/
+ICoreScanner* AttachWorkerScanner(int worker)
+{
+    CoInitializeEx(NULL, COINIT_MULTITHREADED);
+    ICoreScanner* worker_scanner = NULL;
+    HRESULT hr = global_interface_table->GetInterfaceFromGlobal(scanner_interface_cookie, IID_ICoreScanner, (void**)&worker_scanner);
+    if FAILED(hr)
+    {
+        cout << "CoreScanner interface unmarshaling for the capture session thread - Failed" << endl;
+        CoUninitialize();
+        return NULL;
+    }
+    return worker_scanner;
+}
+
+/*
+* Release the CoreScanner interface of the capture session thread
+*/
+void DetachWorkerScanner(int worker, ICoreScanner* worker_scanner)
+{
+    if (worker_scanner != NULL)
+    {
+        worker_scanner->Release();
+        CoUninitialize();
+    }
+}
+
+const char* CaptureStatusName(CaptureStatus status)
+{
+    switch (status)
+    {
+    case kCaptureDecoded:
+        return "decoded";
+    case kCaptureTimedOut:
+        return "timed out";
+    case kCaptureTriggerFailed:
+        return "trigger failed";
+    default:
+        return "cancelled";
+    }
+}
+
+/*
+* Print the trigger to decode distribution: percentiles and a histogram of 20 ms buckets
+*/
+void PrintLatencies(vector<double> latencies_ms)
+{
+    const double kBucketMs = 20;
+    const int kBuckets = 10;
+    if (latencies_ms.empty())
+    {
+        cout << " Trigger to decode : no decodes" << endl;
+        return;
+    }
+    sort(latencies_ms.begin(), latencies_ms.end());
+    size_t count = latencies_ms.size();
+    cout << " Trigger to decode : " << count << " decodes, median " << latencies_ms[count / 2] << " ms, p90 "
+         << latencies_ms[count * 90 / 100] << " ms, p99 " << latencies_ms[count * 99 / 100] << " ms, max " << latencies_ms.back() << " ms" << endl;
+
+    vector<int> buckets(kBuckets + 1, 0);
+    for (size_t i = 0; i < count; i++)
+    {
+        buckets[min((int)(latencies_ms[i] / kBucketMs), kBuckets)]++;
+    }
+    for (int b = 0; b <= kBuckets; b++)
+    {
+        if (buckets[b] == 0)
+        {
+            continue;
+        }
+        cout << "  " << (b < kBuckets ? to_string((int)(b * kBucketMs)) + "-" + to_string((int)((b + 1) * kBucketMs)) + " ms" :
+            ">= " + to_string((int)(kBuckets * kBucketMs)) + " ms") << " : " << string(buckets[b] * 60 / count + 1, '#') << " " << buckets[b] << endl;
+    }
+}
+
+/*
+* Capture one decode per session the way the snippets do it today: pull the trigger, wait for the
+* decode event, release, one session at a time
+*/
+vector<double> RunBlockingCaptures(MockTriggerHost* host, int scanners, int rounds, int timeout_ms, int* timed_out)
+{
+    mutex decode_mutex;
+    condition_variable decoded;
+    int decoded_scanner = 0;
+    host->SetScanDataHandler([&](const ScanData& scan_data)
+    {
+        lock_guard<mutex> lock(decode_mutex);
+        decoded_scanner = scan_data.scanner_id;
+        decoded.notify_one();
+    });
+
+    vector<double> latencies_ms;
+    *timed_out = 0;
+    for (int round = 0; round < rounds; round++)
+    {
+        for (int scanner_id = 1; scanner_id <= scanners; scanner_id++)
+        {
+            {
+                lock_guard<mutex> lock(decode_mutex);
+                decoded_scanner = 0;
+            }
+            chrono::steady_clock::time_point pulled = chrono::steady_clock::now();
+            Exec<DEVICE_PULL_TRIGGER>(host, scanner_id);
+            bool got_decode = false;
+            {
+                unique_lock<mutex> lock(decode_mutex);
+                got_decode = decoded.wait_for(lock, chrono::milliseconds(timeout_ms), [&] { return decoded_scanner == scanner_id; });
+            }
+            if (got_decode)
+            {
+                latencies_ms.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - pulled).count());
+            }
+            else
+            {
+                (*timed_out)++;
+            }
+            Exec<DEVICE_RELEASE_TRIGGER>(host, scanner_id);
+        }
+    }
+    host->SetScanDataHandler(nullptr);
+    return latencies_ms;
+}
+
+/*
+* Same captures one at a time and as concurrent capture sessions, against a simulated host
+* (decode after about 60 ms, no label on one item in twenty)
+*/
+void RunCaptureBenchmark()
+{
+    const int kScanners = 8;
+    const int kRounds = 8;
+    const int kTimeoutMs = 300;
+    const int kSessions = kScanners * kRounds;
+
+    {
+        MockTriggerHost host(5, 60, 0.05);
+        int timed_out = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        vector<double> latencies_ms = RunBlockingCaptures(&host, kScanners, kRounds, kTimeoutMs, &timed_out);
+        double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "One capture at a time (snippets today)" << endl;
+        cout << " " << kSessions << " captures in " << elapsed_ms << " ms, " << timed_out << " timed out" << endl;
+        PrintLatencies(latencies_ms);
+    }
+
+    {
+        MockTriggerHost host(5, 60, 0.05);
+        CaptureSettings settings;
+        settings.timeout_ms = kTimeoutMs;
+        mutex done_mutex;
+        condition_variable all_done;
+        int done_count = 0;
+        int timed_out = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        {
+            CaptureSessionManager<MockTriggerHost> sessions(settings, [&host](int) { return &host; });
+            host.SetScanDataHandler([&sessions](const ScanData& scan_data) { sessions.OnScanData(scan_data); });
+            for (int round = 0; round < kRounds; round++)
+            {
+                for (int scanner_id = 1; scanner_id <= kScanners; scanner_id++)
+                {
+                    sessions.Start(scanner_id, [&](const CaptureResult& result)
+                    {
+                        lock_guard<mutex> lock(done_mutex);
+                        timed_out += (result.status == kCaptureTimedOut) ? 1 : 0;
+                        if (++done_count == kSessions)
+                        {
+                            all_done.notify_one();
+                        }
+                    });
+                }
+            }
+            {
+                unique_lock<mutex> lock(done_mutex);
+                all_done.wait(lock, [&] { return done_count == kSessions; });
+            }
+            double elapsed_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            host.SetScanDataHandler(nullptr);
+            cout << "CaptureSessionManager, concurrent sessions" << endl;
+            cout << " " << kSessions << " captures in " << elapsed_ms << " ms, " << timed_out << " timed out, "
+                 << sessions.StrayDecodeCount() << " stray decodes" << endl;
+            PrintLatencies(sessions.DecodeLatencies());
+        }
+    }
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+*/
+int main()
+{
+    cout << "Capture session benchmark (simulated host)" << endl;
+    RunCaptureBenchmark();
+    cout << " " << endl;
+
+    if (!InitializeCOM())
+        return false;
+
+    vector<int> scanner_ids;
+    if (ConnectEvents() && Open() && GetScannerIds(&scanner_ids))
+    {
+        CoCreateInstance(CLSID_StdGlobalInterfaceTable, NULL, CLSCTX_INPROC_SERVER, IID_IGlobalInterfaceTable, (void**)&global_interface_table);
+        if (global_interface_table != NULL &&
+            SUCCEEDED(global_interface_table->RegisterInterfaceInGlobal(scanner_interface, IID_ICoreScanner, &scanner_interface_cookie)))
+        {
+            if (ExecEventRegistration<REGISTER_FOR_EVENTS>("RegisterForEvents"))
+            {
+                CaptureSettings settings;
+                settings.timeout_ms = 5000;
+                settings.aim = true;
+                {
+                    CaptureSessionManager<ICoreScanner> sessions(settings, AttachWorkerScanner, DetachWorkerScanner);
+                    scanner_event_sink->SetScanDataHandler([&sessions](short event_type, const string& scan_data_xml)
+                    {
+                        ScanData scan_data;
+                        if (ParseScanData(scan_data_xml, &scan_data))
+                        {
+                            sessions.OnScanData(scan_data);
+                        }
+                    });
+
+                    for (size_t i = 0; i < scanner_ids.size(); i++)
+                    {
+                        sessions.Start(scanner_ids[i], [](const CaptureResult& result)
+                        {
+                            cout << "Capture session " << result.session_id << " scanner ID:[" << result.scanner_id << "] - "
+                                 << CaptureStatusName(result.status);
+                            if (result.status == kCaptureDecoded)
+                            {
+                                cout << " after " << result.decode_ms << " ms : " << result.scan_data.label;
+                            }
+                            else if (result.status == kCaptureTriggerFailed)
+                            {
+                                cout << ". Error Code : " << result.command_status;
+                            }
+                            cout << endl;
+                        });
+                    }
+                    WaitForInput("Trigger pulled on " + to_string(scanner_ids.size()) + " scanners, present barcodes within " +
+                        to_string(settings.timeout_ms / 1000) + " s, press any key to exit.");
+                    scanner_event_sink->SetScanDataHandler(nullptr);
+                    PrintLatencies(sessions.DecodeLatencies());
+                }
+                ExecEventRegistration<UNREGISTER_FOR_EVENTS>("UnregisterForEvents");
+            }
+            global_interface_table->RevokeInterfaceFromGlobal(scanner_interface_cookie);
+        }
+        else
+        {
+            cout << "CoreScanner interface registration in the global interface table - Failed" << endl;
+        }
+        if (global_interface_table != NULL)
+        {
+            global_interface_table->Release();
+        }
+    }
+    Close();
+    DisconnectEvents();
+    UninitializeCOM();
+    WaitForInput("Press any key to exit.");
+}
@@ -0,0 +1,205 @@
+/*******************************************************************************************
+* @file inventory_discovery.h
+* @brief Full attribute discovery of the connected scanners and revalidation of a cached inventory
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <algorithm>
+#include <ctime>
+#include <string>
+#include <vector>
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "inventory_snapshot.h"
+
+/**
+* Reads the attribute values of the connected scanners.
+*
+* Discover() is the cold start: RSM_ATTR_GETALL for the attribute ids of each scanner, then
+* RSM_ATTR_GET in batches of kAttributesPerGet ids. Revalidate() refreshes a snapshot loaded from
+* disk: scanners are matched by serial number (scanner ids are assigned by CoreScanner and may
+* change on a restart), the cached ids are read back with RSM_ATTR_GET and RSM_ATTR_GETALL is
+* skipped. A scanner whose attribute set changed (an id no longer answered, e.g. after a firmware
+* update), a new scanner or a scanner of another model is discovered in full.
+*
+* @tparam Scanner ICoreScanner or any object with the same ExecCommand signature (e.g. MockInventoryHost)
+**/
+template <typename Scanner>
+class InventoryDiscovery
+{
+public:
+    static const size_t kAttributesPerGet = 64;
+
+    /**
+    * Inventory discovery constructor
+    * @param scanner - CoreScanner interface
+    */
+    explicit InventoryDiscovery(Scanner* scanner)
+        : scanner_(scanner), last_status_(STATUS_SUCCESS), command_count_(0)
+    {
+    }
+
+    /**
+    * Read every attribute of the connected scanners
+    * @param connected - Scanners from GetScanners() (attributes are not used)
+    * @param snapshot - Receives the inventory
+    * return value : false if a command failed (LastStatus())
+    */
+    bool Discover(const std::vector<InventoryScanner>& connected, InventorySnapshot* snapshot)
+    {
+        *snapshot = InventorySnapshot();
+        for (size_t i = 0; i < connected.size(); i++)
+        {
+            InventoryScanner scanner = connected[i];
+            if (!ReadAll(&scanner))
+            {
+                return false;
+            }
+            snapshot->scanners.push_back(scanner);
+        }
+        snapshot->saved_time = (long long)time(NULL);
+        return true;
+    }
+
+    /**
+    * Bring a cached inventory up to date with the connected scanners
+    * @param cached - Inventory loaded from the snapshot file
+    * @param connected - Scanners from GetScanners() (attributes are not used)
+    * @param fresh - Receives the current inventory
+    * @param changes - Receives what differed from the cached inventory
+    * return value : false if a command failed (LastStatus()) - the cached inventory is then all there is
+    */
+    bool Revalidate(const InventorySnapshot& cached, const std::vector<InventoryScanner>& connected,
+        InventorySnapshot* fresh, InventoryChanges* changes)
+    {
+        long first_command = command_count_;
+        *fresh = InventorySnapshot();
+        *changes = InventoryChanges();
+        for (size_t i = 0; i < connected.size(); i++)
+        {
+            InventoryScanner scanner = connected[i];
+            scanner.attributes.clear();
+            const InventoryScanner* known = scanner.serial_number.empty() ? NULL : cached.FindSerial(scanner.serial_number);
+            if (known == NULL || known->model_number != scanner.model_number)
+            {
+                changes->added++;
+                if (!ReadAll(&scanner))
+                {
+                    return false;
+                }
+                fresh->scanners.push_back(scanner);
+                continue;
+            }
+
+            if (known->scanner_id != scanner.scanner_id)
+            {
+                changes->renumbered++;
+            }
+            std::vector<int> ids(known->attributes.size());
+            for (size_t a = 0; a < ids.size(); a++)
+            {
+                ids[a] = known->attributes[a].id;
+            }
+            if (!ReadValues(scanner.scanner_id, ids, &scanner.attributes))
+            {
+                return false;
+            }
+            if (scanner.attributes.size() != ids.size())
+            {
+                changes->rediscovered++;
+                if (!ReadAll(&scanner))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                for (size_t a = 0; a < ids.size(); a++)
+                {
+                    const InventoryAttribute& was = known->attributes[a];
+                    const InventoryAttribute& is = scanner.attributes[a];
+                    if (was.id != is.id || was.datatype != is.datatype || was.value != is.value)
+                    {
+                        changes->attributes_changed++;
+                    }
+                }
+            }
+            fresh->scanners.push_back(scanner);
+        }
+
+        for (size_t i = 0; i < cached.scanners.size(); i++)
+        {
+            if (fresh->FindSerial(cached.scanners[i].serial_number) == NULL)
+            {
+                changes->removed++;
+            }
+        }
+        fresh->saved_time = (long long)time(NULL);
+        changes->commands = command_count_ - first_command;
+        return true;
+    }
+
+    /**
+    * Status of the last command
+    */
+    LONG LastStatus() const { return last_status_; }
+
+    /**
+    * Commands sent
+    */
+    long CommandCount() const { return command_count_; }
+
+private:
+    /**
+    * Attribute ids with RSM_ATTR_GETALL, then their values
+    */
+    bool ReadAll(InventoryScanner* scanner)
+    {
+        CommandResult<AttributeIdResponse> result = Exec<RSM_ATTR_GETALL>(scanner_, scanner->scanner_id);
+        command_count_++;
+        last_status_ = result.status;
+        if (!result.Succeeded() || !result.parsed)
+        {
+            return false;
+        }
+        std::vector<int> ids = result.response.ids;
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ReadValues(scanner->scanner_id, ids, &scanner->attributes);
+    }
+
+    /**
+    * Values of attribute ids with RSM_ATTR_GET in batches, sorted by id
+    */
+    bool ReadValues(int scanner_id, const std::vector<int>& ids, std::vector<InventoryAttribute>* attributes)
+    {
+        attributes->clear();
+        attributes->reserve(ids.size());
+        for (size_t first = 0; first < ids.size(); first += kAttributesPerGet)
+        {
+            std::vector<int> batch(ids.begin() + first, ids.begin() + std::min(ids.size(), first + kAttributesPerGet));
+            CommandResult<AttributeResponse> result = Exec<RSM_ATTR_GET>(scanner_, scanner_id, batch);
+            command_count_++;
+            last_status_ = result.status;
+            if (!result.Succeeded() || !result.parsed)
+            {
+                return false;
+            }
+            for (size_t i = 0; i < result.response.attributes.size(); i++)
+            {
+                const Attribute& attribute = result.response.attributes[i];
+                InventoryAttribute value = { attribute.id, attribute.datatype, attribute.value };
+                attributes->push_back(value);
+            }
+        }
+        std::sort(attributes->begin(), attributes->end(),
+            [](const InventoryAttribute& a, const InventoryAttribute& b) { return a.id < b.id; });
+        return true;
+    }
+
+    Scanner* scanner_;
+    LONG last_status_;
+    long command_count_;
+};
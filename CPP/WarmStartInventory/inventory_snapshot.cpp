@@ -0,0 +1,304 @@
+/*******************************************************************************************
+* @file inventory_snapshot.cpp
+* @brief Definition of inventory snapshot encoding and persistence
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "inventory_snapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+static const char kInventoryMagic[4] = { 'C', 'S', 'I', 'V' };
+static const size_t kInventoryHeaderSize = 16;
+
+const InventoryAttribute* InventoryScanner::Find(int id) const
+{
+    size_t low = 0;
+    size_t high = attributes.size();
+    while (low < high)
+    {
+        size_t middle = (low + high) / 2;
+        if (attributes[middle].id < id)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low < attributes.size() && attributes[low].id == id ? &attributes[low] : NULL;
+}
+
+const InventoryScanner* InventorySnapshot::FindSerial(const string& serial_number) const
+{
+    for (size_t i = 0; i < scanners.size(); i++)
+    {
+        if (scanners[i].serial_number == serial_number)
+        {
+            return &scanners[i];
+        }
+    }
+    return NULL;
+}
+
+size_t InventorySnapshot::AttributeCount() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < scanners.size(); i++)
+    {
+        count += scanners[i].attributes.size();
+    }
+    return count;
+}
+
+static unsigned int Fnv1a(const char* data, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ (unsigned char)data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void PutFixed(string* out, unsigned long long value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        out->push_back((char)(value >> (8 * i)));
+    }
+}
+
+static void PutVarint(string* out, unsigned long long value)
+{
+    while (value >= 0x80)
+    {
+        out->push_back((char)(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back((char)value);
+}
+
+static void PutString(string* out, const string& text)
+{
+    PutVarint(out, text.size());
+    out->append(text);
+}
+
+/**
+* Bounds checked reader of a payload
+**/
+class PayloadReader
+{
+public:
+    PayloadReader(const char* data, size_t length) : data_(data), end_(data + length), failed_(false) {}
+
+    unsigned long long Fixed(int bytes)
+    {
+        if (end_ - data_ < bytes)
+        {
+            failed_ = true;
+            return 0;
+        }
+        unsigned long long value = 0;
+        for (int i = 0; i < bytes; i++)
+        {
+            value |= (unsigned long long)(unsigned char)data_[i] << (8 * i);
+        }
+        data_ += bytes;
+        return value;
+    }
+
+    unsigned long long Varint()
+    {
+        unsigned long long value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (data_ == end_)
+            {
+                break;
+            }
+            unsigned char byte = (unsigned char)*data_++;
+            value |= (unsigned long long)(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        failed_ = true;
+        return 0;
+    }
+
+    /**
+    * Count of items that take at least one byte each - larger counts are a damaged file
+    */
+    size_t Count()
+    {
+        unsigned long long count = Varint();
+        if (count > (unsigned long long)(end_ - data_))
+        {
+            failed_ = true;
+            return 0;
+        }
+        return (size_t)count;
+    }
+
+    string String()
+    {
+        size_t length = Count();
+        string text(data_, failed_ ? 0 : length);
+        data_ += text.size();
+        return text;
+    }
+
+    char Byte() { return (char)Fixed(1); }
+
+    bool Failed() const { return failed_; }
+
+    bool AtEnd() const { return data_ == end_; }
+
+private:
+    const char* data_;
+    const char* end_;
+    bool failed_;
+};
+
+string EncodeInventorySnapshot(const InventorySnapshot& snapshot)
+{
+    string payload;
+    PutFixed(&payload, (unsigned long long)snapshot.saved_time, 8);
+    PutVarint(&payload, snapshot.scanners.size());
+    for (size_t i = 0; i < snapshot.scanners.size(); i++)
+    {
+        const InventoryScanner& scanner = snapshot.scanners[i];
+        PutVarint(&payload, (unsigned int)scanner.scanner_id);
+        PutString(&payload, scanner.type);
+        PutString(&payload, scanner.model_number);
+        PutString(&payload, scanner.serial_number);
+        PutString(&payload, scanner.guid);
+        PutVarint(&payload, scanner.attributes.size());
+        int previous_id = 0;
+        for (size_t a = 0; a < scanner.attributes.size(); a++)
+        {
+            const InventoryAttribute& attribute = scanner.attributes[a];
+            PutVarint(&payload, (unsigned int)(attribute.id - previous_id));
+            payload.push_back(attribute.datatype);
+            PutString(&payload, attribute.value);
+            previous_id = attribute.id;
+        }
+    }
+
+    string image(kInventoryMagic, sizeof(kInventoryMagic));
+    PutFixed(&image, kInventoryFormatVersion, 2);
+    PutFixed(&image, 0, 2);
+    PutFixed(&image, payload.size(), 4);
+    PutFixed(&image, Fnv1a(payload.data(), payload.size()), 4);
+    image += payload;
+    return image;
+}
+
+bool DecodeInventorySnapshot(const string& image, InventorySnapshot* snapshot, string* error)
+{
+    *snapshot = InventorySnapshot();
+    if (image.size() < kInventoryHeaderSize || memcmp(image.data(), kInventoryMagic, sizeof(kInventoryMagic)) != 0)
+    {
+        *error = "not an inventory snapshot";
+        return false;
+    }
+    PayloadReader header(image.data() + sizeof(kInventoryMagic), kInventoryHeaderSize - sizeof(kInventoryMagic));
+    unsigned int version = (unsigned int)header.Fixed(2);
+    header.Fixed(2);
+    unsigned long long payload_length = header.Fixed(4);
+    unsigned int payload_hash = (unsigned int)header.Fixed(4);
+    if (version != kInventoryFormatVersion)
+    {
+        *error = "snapshot format version " + to_string(version) + " is not supported";
+        return false;
+    }
+    if (payload_length != image.size() - kInventoryHeaderSize)
+    {
+        *error = "snapshot is truncated";
+        return false;
+    }
+    const char* payload = image.data() + kInventoryHeaderSize;
+    if (Fnv1a(payload, (size_t)payload_length) != payload_hash)
+    {
+        *error = "snapshot checksum mismatch";
+        return false;
+    }
+
+    PayloadReader reader(payload, (size_t)payload_length);
+    snapshot->saved_time = (long long)reader.Fixed(8);
+    size_t scanner_count = reader.Count();
+    for (size_t i = 0; i < scanner_count && !reader.Failed(); i++)
+    {
+        InventoryScanner scanner;
+        scanner.scanner_id = (int)reader.Varint();
+        scanner.type = reader.String();
+        scanner.model_number = reader.String();
+        scanner.serial_number = reader.String();
+        scanner.guid = reader.String();
+        size_t attribute_count = reader.Count();
+        scanner.attributes.reserve(attribute_count);
+        int id = 0;
+        for (size_t a = 0; a < attribute_count && !reader.Failed(); a++)
+        {
+            InventoryAttribute attribute;
+            id += (int)reader.Varint();
+            attribute.id = id;
+            attribute.datatype = reader.Byte();
+            attribute.value = reader.String();
+            scanner.attributes.push_back(attribute);
+        }
+        snapshot->scanners.push_back(scanner);
+    }
+    if (reader.Failed() || !reader.AtEnd())
+    {
+        *snapshot = InventorySnapshot();
+        *error = "snapshot payload is malformed";
+        return false;
+    }
+    return true;
+}
+
+bool SaveInventorySnapshot(const string& path, const InventorySnapshot& snapshot, string* error)
+{
+    string image = EncodeInventorySnapshot(snapshot);
+    string temp_path = path + ".tmp";
+    {
+        ofstream file(temp_path.c_str(), ios::binary | ios::trunc);
+        file.write(image.data(), image.size());
+        if (!file)
+        {
+            *error = "cannot write " + temp_path;
+            return false;
+        }
+    }
+    remove(path.c_str());
+    if (rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        *error = "cannot rename " + temp_path + " to " + path;
+        return false;
+    }
+    return true;
+}
+
+bool LoadInventorySnapshot(const string& path, InventorySnapshot* snapshot, string* error)
+{
+    ifstream file(path.c_str(), ios::binary);
+    if (!file)
+    {
+        *error = "no snapshot " + path;
+        return false;
+    }
+    stringstream image;
+    image << file.rdbuf();
+    return DecodeInventorySnapshot(image.str(), snapshot, error);
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************************
+* @file inventory_snapshot.h
+* @brief Scanner inventory and attribute cache persisted in a compact versioned binary file
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+* Cached attribute value
+**/
+struct InventoryAttribute
+{
+    int id;
+    char datatype;      // B, C, F, W, D, I, S, L, A, X ...
+    std::string value;
+};
+
+/**
+* One scanner of the inventory with its attribute values, sorted by id
+**/
+struct InventoryScanner
+{
+    int scanner_id;             // Assigned by CoreScanner - may change when the service restarts
+    std::string type;           // Communication protocol (SNAPI, IBMHID, ...)
+    std::string model_number;
+    std::string serial_number;  // Identifies the scanner across restarts
+    std::string guid;
+    std::vector<InventoryAttribute> attributes;
+
+    /**
+    * Cached attribute value
+    * return value : Attribute, NULL if not cached
+    */
+    const InventoryAttribute* Find(int id) const;
+};
+
+/**
+* Device inventory at a point in time
+**/
+struct InventorySnapshot
+{
+    long long saved_time;       // Seconds since 1970-01-01 UTC when discovered or revalidated
+    std::vector<InventoryScanner> scanners;
+
+    InventorySnapshot() : saved_time(0) {}
+
+    /**
+    * Scanner by serial number
+    * return value : Scanner, NULL if not in the inventory
+    */
+    const InventoryScanner* FindSerial(const std::string& serial_number) const;
+
+    /**
+    * Number of cached attribute values over all scanners
+    */
+    size_t AttributeCount() const;
+};
+
+/**
+* Snapshot file format, all integers little endian:
+*
+*   offset 0   "CSIV"          magic
+*          4   u16             format version (kInventoryFormatVersion)
+*          6   u16             reserved, 0
+*          8   u32             payload length
+*         12   u32             payload FNV-1a hash
+*         16   payload         saved time (u64), scanner count, then per scanner: scanner id,
+*                              type, model, serial, guid, attribute count and per attribute
+*                              the id delta to the previous id, the datatype byte and the value
+*
+* Counts, ids and string lengths are LEB128 varints; strings are length prefixed bytes.
+* A file with another magic, another version, a truncated payload or a wrong hash is rejected
+* as a whole, so a damaged snapshot means a cold start, never a wrong inventory.
+**/
+static const unsigned short kInventoryFormatVersion = 1;
+
+/**
+* Encode a snapshot in the file format
+*/
+std::string EncodeInventorySnapshot(const InventorySnapshot& snapshot);
+
+/**
+* Decode a snapshot file image
+* @param error - Receives the reason a file is rejected
+* return value : true if the image is a valid snapshot
+*/
+bool DecodeInventorySnapshot(const std::string& image, InventorySnapshot* snapshot, std::string* error);
+
+/**
+* Write a snapshot file - written to a temporary file and renamed, so a crash never leaves half a snapshot
+*/
+bool SaveInventorySnapshot(const std::string& path, const InventorySnapshot& snapshot, std::string* error);
+
+/**
+* Read a snapshot file
+* return value : false if the file is missing or rejected
+*/
+bool LoadInventorySnapshot(const std::string& path, InventorySnapshot* snapshot, std::string* error);
+
+/**
+* Differences found when a snapshot is revalidated against the connected scanners
+**/
+struct InventoryChanges
+{
+    int added;                  // Scanners not in the snapshot
+    int removed;                // Snapshot scanners no longer connected
+    int renumbered;             // Same scanner with a new scanner id
+    int rediscovered;           // Attribute set changed (e.g. new firmware), read again in full
+    int attributes_changed;     // Cached values that differed
+    long commands;              // Commands sent
+
+    InventoryChanges() : added(0), removed(0), renumbered(0), rediscovered(0), attributes_changed(0), commands(0) {}
+
+    bool Any() const { return added + removed + renumbered + rediscovered + attributes_changed > 0; }
+};
+
+/**
+* Current inventory shared between the thread revalidating it and the threads using it.
+* Readers take an immutable snapshot; the revalidating thread publishes a new one.
+**/
+class InventoryStore
+{
+public:
+    /**
+    * Current snapshot, NULL before the first Publish()
+    */
+    std::shared_ptr<const InventorySnapshot> Current() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_;
+    }
+
+    /**
+    * Replace the current snapshot
+    */
+    void Publish(const InventorySnapshot& snapshot)
+    {
+        std::shared_ptr<const InventorySnapshot> published = std::make_shared<InventorySnapshot>(snapshot);
+        std::lock_guard<std::mutex> lock(mutex_);
+        current_ = published;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::shared_ptr<const InventorySnapshot> current_;
+};
@@ -0,0 +1,211 @@
+/*******************************************************************************************
+* @file mock_inventory_host.h
+* @brief Simulated CoreScanner host answering the attribute discovery commands
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+#pragma once
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+
+/**
+* Simulated CoreScanner host with the ICoreScanner::ExecCommand signature, used to measure
+* startup without hardware. Connect() stands for CoInitialize, CoCreateInstance and Open and
+* takes connect_latency_ms; every command and the scanner list take command_latency_ms.
+**/
+class MockInventoryHost
+{
+public:
+    static const LONG kStatusFailed = 1;
+
+    /**
+    * Mock host constructor
+    */
+    MockInventoryHost(int connect_latency_ms, int command_latency_ms)
+        : connect_latency_ms_(connect_latency_ms), command_latency_ms_(command_latency_ms), command_count_(0)
+    {
+    }
+
+    /**
+    * Add a scanner
+    * return value : Scanner id
+    */
+    int AddScanner(const std::string& model_number, const std::string& serial_number, const std::vector<Attribute>& attributes)
+    {
+        Device device;
+        device.scanner_id = (int)devices_.size() + 1;
+        device.model_number = model_number;
+        device.serial_number = serial_number;
+        for (size_t i = 0; i < attributes.size(); i++)
+        {
+            device.attributes[attributes[i].id] = attributes[i];
+        }
+        devices_.push_back(device);
+        return device.scanner_id;
+    }
+
+    /**
+    * Disconnect a scanner
+    */
+    void RemoveScanner(const std::string& serial_number)
+    {
+        for (size_t i = 0; i < devices_.size(); i++)
+        {
+            if (devices_[i].serial_number == serial_number)
+            {
+                devices_.erase(devices_.begin() + i);
+                return;
+            }
+        }
+    }
+
+    /**
+    * Change an attribute value, or add the attribute
+    */
+    void SetAttribute(const std::string& serial_number, const Attribute& attribute)
+    {
+        for (size_t i = 0; i < devices_.size(); i++)
+        {
+            if (devices_[i].serial_number == serial_number)
+            {
+                devices_[i].attributes[attribute.id] = attribute;
+            }
+        }
+    }
+
+    /**
+    * Restart the simulated CoreScanner service - scanner ids are assigned again
+    */
+    void Restart()
+    {
+        for (size_t i = 0; i < devices_.size(); i++)
+        {
+            devices_[i].scanner_id = (int)(devices_.size() - i) + 100;
+        }
+    }
+
+    /**
+    * Simulated COM initialization, CoCreateInstance and Open
+    */
+    void Connect() const
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(connect_latency_ms_));
+    }
+
+    long CommandCount() const { return command_count_; }
+
+    /**
+    * Scanner list in the format of the GetScanners() outXml
+    */
+    std::string ScannersXml()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(command_latency_ms_));
+        command_count_++;
+        std::string xml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><scanners>";
+        for (size_t i = 0; i < devices_.size(); i++)
+        {
+            xml += "<scanner type=\"SNAPI\"><scannerID>" + std::to_string(devices_[i].scanner_id) +
+                "</scannerID><serialnumber>" + devices_[i].serial_number +
+                "</serialnumber><GUID>" + devices_[i].serial_number + "-GUID</GUID><modelnumber>" +
+                devices_[i].model_number + "</modelnumber></scanner>";
+        }
+        xml += "</scanners>";
+        return xml;
+    }
+
+    /**
+    * ExecCommand with the ICoreScanner signature
+    */
+    HRESULT ExecCommand(LONG opcode, BSTR* in_xml, BSTR* out_xml, LONG* status)
+    {
+        *out_xml = NULL;
+        *status = kStatusFailed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(command_latency_ms_));
+        command_count_++;
+
+        std::wstring in_str(*in_xml, SysStringLen(*in_xml));
+        std::string in(in_str.begin(), in_str.end());
+        std::string value;
+        if (!XmlFindText(in, "scannerID", &value))
+        {
+            return S_OK;
+        }
+        int scanner_id = atoi(value.c_str());
+        Device* device = NULL;
+        for (size_t i = 0; i < devices_.size(); i++)
+        {
+            if (devices_[i].scanner_id == scanner_id)
+            {
+                device = &devices_[i];
+            }
+        }
+        if (device == NULL)
+        {
+            return S_OK;
+        }
+
+        std::string out = "<?xml version=\"1.0\" encoding=\"UTF-8\"?><outArgs><scannerID>" + std::to_string(scanner_id) +
+            "</scannerID><arg-xml><modelnumber>" + device->model_number + "</modelnumber><serialnumber>" +
+            device->serial_number + "</serialnumber><response><opcode>" + std::to_string(opcode) + "</opcode><attrib_list>";
+        switch (opcode)
+        {
+        case RSM_ATTR_GETALL:
+            for (std::map<int, Attribute>::const_iterator it = device->attributes.begin(); it != device->attributes.end(); ++it)
+            {
+                out += "<attribute>" + std::to_string(it->first) + "</attribute>";
+            }
+            break;
+        case RSM_ATTR_GET:
+        {
+            if (!XmlFindText(in, "attrib_list", &value))
+            {
+                return S_OK;
+            }
+            const char* ids = value.c_str();
+            char* end = NULL;
+            for (long id = strtol(ids, &end, 10); end != ids; id = strtol(ids, &end, 10))
+            {
+                std::map<int, Attribute>::const_iterator it = device->attributes.find((int)id);
+                if (it != device->attributes.end())
+                {
+                    out += "<attribute><id>" + std::to_string(id) + "</id><datatype>" + std::string(1, it->second.datatype) +
+                        "</datatype><permission>7</permission><value>";
+                    XmlAppendEscaped(&out, it->second.value);
+                    out += "</value></attribute>";
+                }
+                ids = (*end == ',') ? end + 1 : end;
+            }
+            break;
+        }
+        default:
+            return S_OK;
+        }
+        out += "</attrib_list></response></arg-xml></outArgs>";
+        std::wstring out_str(out.begin(), out.end());
+        *out_xml = SysAllocString(out_str.c_str());
+        *status = STATUS_SUCCESS;
+        return S_OK;
+    }
+
+private:
+    struct Device
+    {
+        int scanner_id;
+        std::string model_number;
+        std::string serial_number;
+        std::map<int, Attribute> attributes;
+    };
+
+    int connect_latency_ms_;
+    int command_latency_ms_;
+    std::vector<Device> devices_;
+    long command_count_;
+};
@@ -0,0 +1,452 @@
+/*******************************************************************************************
+* @file warm_start_inventory.cpp
+* @brief This file contains code snippet to start from a persisted scanner inventory and revalidate it in the background
+* @version 1.0.0.1
+* @date 2026-10-19
+* @copyright  2026 Zebra Technologies Corporation and/or its affiliates. All rights reserved.
+********************************************************************************************/
+
+#include "afxctl.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <conio.h>
+#include "targetver.h"
+#include "_core_scanner_i.c"
+#include "_core_scanner.h"
+#include "common_defs.h"
+#include "opcode_traits.h"
+#include "xml_reader.h"
+#include "inventory_snapshot.h"
+#include "inventory_discovery.h"
+#include "mock_inventory_host.h"
+
+using namespace std;
+
+ICoreScanner *scanner_interface;  // Main CoreScanner COM Interface
+LONG  app_handle = 0;
+
+/*
+* Initialize COM - Create the CoreScanner COM object
+*/
+bool InitializeCOM()
+{
+    HRESULT hr = S_FALSE;
+
+    // Initialize COM
+    CoInitialize(NULL);
+
+    //Create the CoreScanner COM object
+    cout << "Initializing CoreScanner COM object" << endl;
+    hr = CoCreateInstance(CLSID_CCoreScanner, NULL, CLSCTX_ALL, IID_ICoreScanner, ((void**)&scanner_interface));
+    if FAILED(hr)
+    {
+        cout << "CoreScanner COM object creation - Failed" << endl;
+        return false;
+    }
+
+    if (scanner_interface)
+    {
+        cout << "CoreScanner COM object creation  - Success" << endl;
+        return true;
+    }
+    else
+    {
+        cout << "CoreScanner COM interface creation failed" << endl;
+        return false;
+    }
+}
+
+/*
+* Uninitialize COM
+*/
+void UninitializeCOM()
+{
+    // Uninitialize COM
+    CoUninitialize();
+}
+
+/*
+* Opens scanner connection
+* return value : Open scanner success/fail status
+*/
+bool Open()
+{
+    const SHORT kNumberOfScannerTypes = 1;
+    HRESULT hr = S_FALSE;
+    SHORT scanner_types[kNumberOfScannerTypes];
+    LONG status = -1;
+
+    SAFEARRAY* scanner_types_array = NULL;
+    SAFEARRAYBOUND bound[kNumberOfScannerTypes];
+    bound[0].lLbound = 0;
+    bound[0].cElements = kNumberOfScannerTypes;
+    scanner_types[0] = SCANNER_TYPES_ALL;  //  All scanner types
+    scanner_types_array = SafeArrayCreate(VT_I2, 1, bound);
+    for (long i = 0; i < kNumberOfScannerTypes; i++)
+    {
+        SafeArrayPutElement(scanner_types_array, &i, &scanner_types[i]);
+    }
+
+    // Open scanner connection
+    hr = scanner_interface->Open(
+        app_handle,            // Application handle
+        scanner_types_array,   // Array of scanner types    
+        kNumberOfScannerTypes, // Length of scanner types array 
+        &status);              // Command execution success/failure return status   
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Open() - Success" << endl;
+            SafeArrayDestroy(scanner_types_array);
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Open() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Open() - Failed" << endl;
+    }
+    SafeArrayDestroy(scanner_types_array);
+    return false;
+}
+
+/*
+* Close scanner connection
+* return value : Close scanner success/fail status
+*/
+bool Close()
+{
+    LONG status = -1;
+    HRESULT hr = S_FALSE;
+
+    // Close scanner connection 
+    hr = scanner_interface->Close(app_handle,  // Application handle
+        &status);                              // Command execution success/failure return status  
+
+    if ((hr == S_OK) && (status == STATUS_SUCCESS))
+    {
+        if (status == STATUS_SUCCESS)
+        {
+            cout << "CoreScanner Close() - Success" << endl;
+            return true;
+        }
+        else
+        {
+            cout << "CoreScanner Close() - Failed. Error Code : " << status << endl;
+        }
+    }
+    else
+    {
+        cout << "COM CoreScanner Close() - Failed" << endl;
+    }
+    return false;
+}
+
+/*
+* Read scanners from GetScanners() outXml
+*/
+void ParseInventoryScanners(const string& scanners_xml, vector<InventoryScanner>* scanners)
+{
+    XmlReader reader(scanners_xml);
+    while (reader.FindElement("scanner"))
+    {
+        int depth = reader.Depth();
+        InventoryScanner scanner;
+        scanner.scanner_id = 0;
+        XmlSlice type;
+        if (reader.Attribute("type", &type))
+        {
+            scanner.type = type.ToString();
+        }
+        XmlReader::Token token;
+        while ((token = reader.Next()) != XmlReader::kEndOfDocument)
+        {
+            if (token == XmlReader::kEndElement && reader.Depth() < depth)
+            {
+                break;
+            }
+            if (token != XmlReader::kStartElement)
+            {
+                continue;
+            }
+            XmlSlice name = reader.Name();
+            XmlSlice text;
+            reader.ReadElementText(&text);
+            if (name.Equals("scannerID"))           scanner.scanner_id = (int)text.ToLong();
+            else if (name.Equals("serialnumber"))   scanner.serial_number = text.ToString();
+            else if (name.Equals("modelnumber"))    scanner.model_number = text.ToString();
+            else if (name.Equals("GUID"))           scanner.guid = text.ToString();
+        }
+        if (scanner.scanner_id != 0)
+        {
+            scanners->push_back(scanner);
+        }
+    }
+}
+
+/*
+* Get connected scanners
+* @param scanners - Receives the scanners (without attributes)
+* return value : GetScanners success/fail status
+*/
+bool GetConnectedScanners(vector<InventoryScanner>* scanners)
+{
+    SAFEARRAYBOUND bound_get_scanner_array[MAX_NUM_DEVICES];
+    SHORT num_scanners = 0;
+    LONG status = -1;
+    BSTR out_xml = NULL;
+    bound_get_scanner_array[0].lLbound = 0;
+    bound_get_scanner_array[0].cElements = MAX_NUM_DEVICES;
+    SAFEARRAY* get_scanners_array = SafeArrayCreate(VT_I2, 1, bound_get_scanner_array);
+
+    HRESULT hr = scanner_interface->GetScanners(&num_scanners, get_scanners_array, &out_xml, &status);
+    SafeArrayDestroy(get_scanners_array);
+    if (hr != S_OK || status != STATUS_SUCCESS)
+    {
+        cout << "CoreScanner GetScanners() - Failed. Error Code : " << status << endl;
+        return false;
+    }
+
+    wstring out_str(out_xml, SysStringLen(out_xml));
+    string get_scanners_output_xml(out_str.begin(), out_str.end());
+    SysFreeString(out_xml);
+    ParseInventoryScanners(get_scanners_output_xml, scanners);
+    cout << "CoreScanner GetScanners() - Success, " << scanners->size() << " scanners" << endl;
+    return true;
+}
+
+/*
+* Milliseconds elapsed since a time point
+*/
+double MillisecondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void PrintInventory(const InventorySnapshot& snapshot)
+{
+    for (size_t i = 0; i < snapshot.scanners.size(); i++)
+    {
+        const InventoryScanner& scanner = snapshot.scanners[i];
+        cout << " Scanner ID:[" << scanner.scanner_id << "] " << scanner.model_number << " S/N " << scanner.serial_number
+             << " - " << scanner.attributes.size() << " attributes" << endl;
+    }
+}
+
+void PrintChanges(const InventoryChanges& changes)
+{
+    if (!changes.Any())
+    {
+        cout << " Snapshot was current" << endl;
+        return;
+    }
+    cout << " Scanners added : " << changes.added << ", removed : " << changes.removed << ", renumbered : " << changes.renumbered
+         << ", rediscovered : " << changes.rediscovered << ", attribute values changed : " << changes.attributes_changed << endl;
+}
+
+/*
+* Simulated lane controller: scanners with a few hundred attributes each
+*/
+void AddBenchmarkScanners(MockInventoryHost* host, int count, int first_serial)
+{
+    const int kAttributeCount = 300;
+    for (int s = 0; s < count; s++)
+    {
+        vector<Attribute> attributes;
+        for (int a = 0; a < kAttributeCount; a++)
+        {
+            // Ids spread over the parameter range like a real attribute list
+            Attribute attribute = { a < 250 ? a * 2 + 1 : 20000 + a, a % 3 == 0 ? 'F' : 'B', a % 3 == 0 ? "True" : to_string(a % 7) };
+            attributes.push_back(attribute);
+        }
+        host->AddScanner(s % 2 == 0 ? "DS8178-SR7U2100SGW" : "DS9308-SR4U2100AZW", "S" + to_string(first_serial + s), attributes);
+    }
+}
+
+/*
+* Startup to ready with a simulated host: cold discovery, then a restart that loads the snapshot
+* and revalidates it in the background
+*/
+void RunWarmStartBenchmark()
+{
+    const char* kSnapshotPath = "inventory_benchmark.bin";
+    const int kConnectLatencyMs = 150;  // CoInitialize + CoCreateInstance + Open, first start of the service
+    const int kCommandLatencyMs = 4;
+    MockInventoryHost host(kConnectLatencyMs, kCommandLatencyMs);
+    AddBenchmarkScanners(&host, 8, 1000);
+
+    // Cold start - ready after the full discovery
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    host.Connect();
+    vector<InventoryScanner> connected;
+    ParseInventoryScanners(host.ScannersXml(), &connected);
+    InventoryDiscovery<MockInventoryHost> cold_discovery(&host);
+    InventorySnapshot snapshot;
+    if (!cold_discovery.Discover(connected, &snapshot))
+    {
+        cout << "Cold discovery - Failed" << endl;
+        return;
+    }
+    double cold_ms = MillisecondsSince(start);
+    string error;
+    SaveInventorySnapshot(kSnapshotPath, snapshot, &error);
+    cout << "Cold start  : ready after " << cold_ms << " ms (" << host.CommandCount() << " commands, "
+         << snapshot.scanners.size() << " scanners, " << snapshot.AttributeCount() << " attributes)" << endl;
+    cout << "Snapshot    : " << EncodeInventorySnapshot(snapshot).size() << " bytes" << endl;
+
+    // While the service was down: ids are reassigned, a value changes, a scanner is swapped
+    host.Restart();
+    Attribute changed = { 3, 'B', "6" };
+    host.SetAttribute("S1001", changed);
+    host.RemoveScanner("S1007");
+    AddBenchmarkScanners(&host, 1, 2000);
+
+    // Warm start - ready once the snapshot is loaded, revalidated in the background
+    long commands_before = host.CommandCount();
+    start = chrono::steady_clock::now();
+    InventoryStore store;
+    InventorySnapshot cached;
+    if (!LoadInventorySnapshot(kSnapshotPath, &cached, &error))
+    {
+        cout << "Warm start - Failed : " << error << endl;
+        return;
+    }
+    store.Publish(cached);
+    double ready_ms = MillisecondsSince(start);
+
+    double revalidated_ms = 0;
+    InventoryChanges changes;
+    thread revalidation([&]()
+    {
+        host.Connect();
+        vector<InventoryScanner> now_connected;
+        ParseInventoryScanners(host.ScannersXml(), &now_connected);
+        InventoryDiscovery<MockInventoryHost> discovery(&host);
+        InventorySnapshot fresh;
+        if (discovery.Revalidate(cached, now_connected, &fresh, &changes))
+        {
+            store.Publish(fresh);
+            string save_error;
+            SaveInventorySnapshot(kSnapshotPath, fresh, &save_error);
+        }
+        revalidated_ms = MillisecondsSince(start);
+    });
+    // The service answers from the published snapshot while the revalidation runs
+    shared_ptr<const InventorySnapshot> serving = store.Current();
+    cout << "Warm start  : ready after " << ready_ms << " ms (" << serving->scanners.size() << " scanners from the snapshot)" << endl;
+    revalidation.join();
+    cout << "Revalidated : after " << revalidated_ms << " ms in the background (" << host.CommandCount() - commands_before
+         << " commands, GETALL only for new scanners)" << endl;
+    PrintChanges(changes);
+    cout << "Startup to ready : " << cold_ms << " ms -> " << ready_ms << " ms" << endl;
+
+    // A damaged snapshot is rejected as a whole and means a cold start
+    string image = EncodeInventorySnapshot(*store.Current());
+    image[image.size() / 2] ^= 0x20;
+    InventorySnapshot damaged;
+    bool accepted = DecodeInventorySnapshot(image, &damaged, &error);
+    cout << "Damaged snapshot : " << (accepted ? "accepted - WRONG" : "rejected (" + error + ")") << endl;
+    remove(kSnapshotPath);
+}
+
+/*
+* Wait display message and wait for user input
+*/
+void WaitForInput(string message)
+{
+    cout << message << endl;
+    MSG msg = { 0 };
+    while (true)   // Message loop to dispatch windows messages while waiting for barcode events
+    {
+        PeekMessage(&msg, NULL, 0, 0, 0);
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+        if (_kbhit())
+        {
+            break;
+        }
+    }
+    getchar();
+}
+
+/*
+* Main Program
+* Usage : warm_start_inventory [snapshot file] (scanner_inventory.bin by default)
+*/
+int main(int argc, char* argv[])
+{
+    cout << "Warm start benchmark (simulated host)" << endl;
+    RunWarmStartBenchmark();
+    cout << " " << endl;
+
+    string snapshot_path = (argc > 1) ? argv[1] : "scanner_inventory.bin";
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    InventoryStore store;
+    InventorySnapshot cached;
+    string error;
+    bool warm = LoadInventorySnapshot(snapshot_path, &cached, &error);
+    if (warm)
+    {
+        store.Publish(cached);
+        cout << "Ready from snapshot " << snapshot_path << " after " << MillisecondsSince(start) << " ms - "
+             << cached.scanners.size() << " scanners, " << cached.AttributeCount() << " attributes" << endl;
+        PrintInventory(cached);
+    }
+    else
+    {
+        cout << "Cold start - " << error << endl;
+    }
+
+    // Discovery runs on its own thread (and COM apartment); the cached inventory is served meanwhile
+    bool revalidated = false;
+    InventoryChanges changes;
+    thread revalidation([&]()
+    {
+        if (!InitializeCOM())
+            return;
+        vector<InventoryScanner> connected;
+        if (Open() && GetConnectedScanners(&connected))
+        {
+            InventoryDiscovery<ICoreScanner> discovery(scanner_interface);
+            InventorySnapshot fresh;
+            revalidated = warm ? discovery.Revalidate(cached, connected, &fresh, &changes) : discovery.Discover(connected, &fresh);
+            if (revalidated)
+            {
+                store.Publish(fresh);
+                string save_error;
+                if (!SaveInventorySnapshot(snapshot_path, fresh, &save_error))
+                {
+                    cout << "Inventory snapshot save - Failed : " << save_error << endl;
+                }
+            }
+            else
+            {
+                cout << "Attribute discovery - Failed. Error Code : " << discovery.LastStatus() << endl;
+            }
+        }
+        Close();
+        UninitializeCOM();
+    });
+    revalidation.join();
+
+    if (revalidated)
+    {
+        cout << (warm ? "Revalidated" : "Ready") << " after " << MillisecondsSince(start) << " ms" << endl;
+        if (warm)
+        {
+            PrintChanges(changes);
+        }
+        PrintInventory(*store.Current());
+    }
+    WaitForInput("Press any key to exit.");
+}